@@ -1,36 +1,147 @@
 #include "Client.h"
+#include "../protocol/HandshakePacket.h"
 #include <asio.hpp>
-#include <chrono>
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <utility>
+#include <vector>
+
+namespace
+{
+// 进行中的握手：request 为当前阶段待重发的报文（HELLO 或 CONNECT）
+struct PendingHandshake
+{
+    NetAddress server;
+    HandshakePacket request;
+    uint32_t lastSentMs = 0;
+    uint32_t attempts = 0;
+    Client::ConnectHandler handler;
+};
+} // namespace
 
 // Pimpl 实现
 struct Client::Impl
 {
     asio::io_context ioc;
+    asio::any_io_executor executor;
+    std::vector<PendingHandshake> handshakes;
+    std::mt19937 rng{std::random_device{}()};
+
+    Impl() : ioc(), executor(ioc.get_executor()) {}
+    explicit Impl(const asio::any_io_executor& exec) : ioc(), executor(exec) {}
 
-    Impl() : ioc() {}
+    PendingHandshake* findHandshake(const NetAddress& from, uint32_t nonce)
+    {
+        auto it = std::ranges::find_if(handshakes,
+                                       [&](const PendingHandshake& pending)
+                                       { return pending.request.nonce == nonce && pending.server == from; });
+        return it == handshakes.end() ? nullptr : &*it;
+    }
 };
 
 Client::Client(IUdpTransport& transport) : KcpEndpoint(transport), m_impl(std::make_unique<Impl>()) {}
 
+Client::Client(IUdpTransport& transport, const asio::any_io_executor& exec)
+    : KcpEndpoint(transport), m_impl(std::make_unique<Impl>(exec))
+{
+}
+
 Client::~Client() = default;
 
 std::shared_ptr<KcpSession> Client::connect(uint32_t conv, const NetAddress& server_addr)
 {
-    auto [iter, inserted] = m_sessions.try_emplace(conv);
-    if (inserted)
+    return openSession(conv, server_addr);
+}
+
+void Client::handshake(const NetAddress& server_addr, ConnectHandler handler)
+{
+    const auto nonce = static_cast<uint32_t>(m_impl->rng());
+    PendingHandshake pending{.server = server_addr,
+                             .request = HandshakePacket{.type = HandshakeType::Hello, .nonce = nonce},
+                             .lastSentMs = nowMs(),
+                             .attempts = 1,
+                             .handler = std::move(handler)};
+    m_transport.send(server_addr, handshakeBytes(pending.request));
+    m_impl->handshakes.push_back(std::move(pending));
+}
+
+size_t Client::pendingHandshakes() const noexcept
+{
+    return m_impl->handshakes.size();
+}
+
+void Client::update(uint32_t now_ms, std::chrono::seconds timeout_sec)
+{
+    // 先收集超时的握手再回调：回调中可能发起新的握手
+    std::vector<ConnectHandler> timedOut;
+    std::erase_if(m_impl->handshakes,
+                  [&](PendingHandshake& pending)
+                  {
+                      if (now_ms - pending.lastSentMs < HANDSHAKE_RETRY_MS)
+                      {
+                          return false;
+                      }
+                      if (pending.attempts >= HANDSHAKE_MAX_ATTEMPTS)
+                      {
+                          timedOut.push_back(std::move(pending.handler));
+                          return true;
+                      }
+                      m_transport.send(pending.server, handshakeBytes(pending.request));
+                      pending.lastSentMs = now_ms;
+                      ++pending.attempts;
+                      return false;
+                  });
+    for (auto& handler : timedOut)
+    {
+        handler(std::unexpected(std::make_error_code(std::errc::timed_out)));
+    }
+
+    KcpEndpoint::update(now_ms, timeout_sec);
+}
+
+bool Client::admitUnknown(const NetAddress& from, uint32_t conv, std::span<const uint8_t> data)
+{
+    if (conv != HANDSHAKE_CONV)
+    {
+        return true;
+    }
+
+    const auto packet = parseHandshake(data);
+    auto* pending = packet ? m_impl->findHandshake(from, packet->nonce) : nullptr;
+    if (pending == nullptr)
+    {
+        countRejected();
+        return false;
+    }
+
+    if (packet->type == HandshakeType::Challenge && pending->request.type == HandshakeType::Hello)
+    {
+        // 进入第二阶段：回送 cookie，重发计数重新开始
+        pending->request.type = HandshakeType::Connect;
+        pending->request.timestamp = packet->timestamp;
+        pending->request.cookie = packet->cookie;
+        pending->lastSentMs = nowMs();
+        pending->attempts = 1;
+        m_transport.send(from, handshakeBytes(pending->request));
+    }
+    else if (packet->type == HandshakeType::Accept && pending->request.type == HandshakeType::Connect &&
+             packet->assignedConv != HANDSHAKE_CONV)
+    {
+        auto handler = std::move(pending->handler);
+        std::erase_if(m_impl->handshakes, [pending](const PendingHandshake& item) { return &item == pending; });
+        handler(openSession(packet->assignedConv, from));
+    }
+    else
     {
-        iter->second = createSession(conv, server_addr);
-        m_lastActive[conv] = std::chrono::steady_clock::now();
-        onSession(conv, iter->second);
+        countRejected(); // 重复或乱序的应答
     }
-    return iter->second;
+    return false;
 }
 
 std::shared_ptr<KcpSession> Client::createSession(uint32_t conv, const NetAddress& peer)
 {
-    return std::make_shared<KcpSession>(conv, m_transport, peer, m_impl->ioc.get_executor());
+    return std::make_shared<KcpSession>(conv, m_transport, peer, m_impl->executor, m_packetPool, m_sessionProfile);
 }
 
 uint32_t Client::selectConv([[maybe_unused]] const NetAddress& from, std::span<const uint8_t> data)
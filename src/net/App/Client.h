@@ -14,34 +14,68 @@
  */
 #pragma once
 #include "KcpEndpoint.h"
+#include <chrono>
+#include <expected>
+#include <functional>
 #include <memory>
+#include <system_error>
 #include <utility>
 #include "PeekConv.h"
 
 class Client : public KcpEndpoint
 {
 public:
+    using ConnectHandler = std::function<void(std::expected<std::shared_ptr<KcpSession>, std::error_code>)>;
+
+    static constexpr uint32_t HANDSHAKE_RETRY_MS = 250;   // 当前阶段无应答时的重发间隔
+    static constexpr uint32_t HANDSHAKE_MAX_ATTEMPTS = 8; // 每个阶段的最大发送次数
+
     /**
      * @brief 构造函数
      * @param transport UDP 传输层实现
      */
     explicit Client(IUdpTransport& transport);
+
+    /**
+     * @brief 构造函数：会话运行在外部提供的执行器上（recvAsync 回调在该执行器上执行）
+     * @param transport UDP 传输层实现
+     * @param exec 会话使用的 ASIO 执行器
+     */
+    Client(IUdpTransport& transport, const asio::any_io_executor& exec);
     ~Client();
 
     /**
-     * @brief 主动连接服务器
-     * @param conv 预先分配的会话 ID
-     * @param server_addr 服务器的 UDP 地址
+     * @brief 以调用方指定的 conv 直接建立会话，不经过握手
+     *
+     * 只适用于接受未知 conv 的对端（另一个 Client、测试用的端点等）。Server 只接受经 cookie 握手分配的 conv，
+     * 对这里建立的会话不会有任何应答；连接 Server 请使用 handshake()。
+     * @param conv 双方约定的会话 ID
+     * @param server_addr 对端的 UDP 地址
      * @return 建立好的会话对象
      */
     std::shared_ptr<KcpSession> connect(uint32_t conv, const NetAddress& server_addr);
 
     /**
-     * @brief 更新所有会话状态
+     * @brief 与 Server 握手，由服务器分配 conv（Server 只接受握手建立的会话）
+     *
+     * 发送 HELLO，收到 CHALLENGE 后回送 CONNECT，收到 ACCEPT 后建立会话并回调。
+     * 握手报文由 update 驱动重发；某一阶段发送 HANDSHAKE_MAX_ATTEMPTS 次仍无应答时以 timed_out 回调。
+     * @param server_addr 服务器的 UDP 地址
+     * @param handler 完成回调，在调用 input / update 的线程上执行
+     */
+    void handshake(const NetAddress& server_addr, ConnectHandler handler);
+
+    /**
+     * @brief 进行中的握手数量
+     */
+    [[nodiscard]] size_t pendingHandshakes() const noexcept;
+
+    /**
+     * @brief 重发到期的握手报文，再更新所有会话状态
      * @param now_ms 当前时间点
      * @param timeout_sec 会话超时阈值（默认30秒）
      */
-    using KcpEndpoint::update;
+    void update(uint32_t now_ms, std::chrono::seconds timeout_sec = std::chrono::seconds(30));
 
 protected:
     /**
@@ -49,6 +83,11 @@ protected:
      */
     uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override;
 
+    /**
+     * @brief 处理服务器的握手应答；其余未知 conv 仍按 conv 建立会话
+     */
+    bool admitUnknown(const NetAddress& from, uint32_t conv, std::span<const uint8_t> data) override;
+
     /**
      * @brief 创建 KCP 会话
      */
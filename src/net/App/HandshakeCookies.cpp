@@ -0,0 +1,69 @@
+/**
+ * ************************************************************************
+ *
+ * @file HandshakeCookies.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 无状态握手 cookie 实现
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include "HandshakeCookies.h"
+#include "../protocol/HandshakePacket.h"
+#include <array>
+#include <cstring>
+#include <random>
+
+namespace
+{
+constexpr uint8_t CONV_DOMAIN = 0xC0; // 区分 cookie 与 conv 两种用途的输入
+
+SipHashKey randomKey()
+{
+    std::random_device device;
+    auto next64 = [&device] { return (static_cast<uint64_t>(device()) << 32) | device(); };
+    return SipHashKey{next64(), next64()};
+}
+} // namespace
+
+HandshakeCookies::HandshakeCookies(uint32_t lifetimeSec) : HandshakeCookies(randomKey(), lifetimeSec) {}
+
+HandshakeCookies::HandshakeCookies(const SipHashKey& key, uint32_t lifetimeSec)
+    : m_key(key), m_lifetimeSec(lifetimeSec)
+{
+}
+
+uint64_t HandshakeCookies::issue(const NetAddress& peer, uint32_t nonce, uint32_t timestamp) const noexcept
+{
+    // sockaddr 已包含地址族、端口与地址，未使用的尾部字节恒为 0
+    std::array<uint8_t, NetAddress::STORAGE_SIZE + (2 * sizeof(uint32_t))> input{};
+    std::memcpy(input.data(), peer.sockaddrData(), NetAddress::STORAGE_SIZE);
+    std::memcpy(input.data() + NetAddress::STORAGE_SIZE, &nonce, sizeof(nonce));
+    std::memcpy(input.data() + NetAddress::STORAGE_SIZE + sizeof(nonce), &timestamp, sizeof(timestamp));
+    return sipHash24(m_key, input);
+}
+
+bool HandshakeCookies::verify(
+    const NetAddress& peer, uint32_t nonce, uint32_t timestamp, uint64_t cookie, uint32_t nowSec) const noexcept
+{
+    // 无符号回绕：timestamp 晚于 nowSec 时差值极大，同样视为过期
+    if (nowSec - timestamp > m_lifetimeSec)
+    {
+        return false;
+    }
+    return issue(peer, nonce, timestamp) == cookie;
+}
+
+uint32_t HandshakeCookies::convFor(uint64_t cookie) const noexcept
+{
+    std::array<uint8_t, sizeof(cookie) + 1> input{};
+    std::memcpy(input.data(), &cookie, sizeof(cookie));
+    input.back() = CONV_DOMAIN;
+    const auto conv = static_cast<uint32_t>(sipHash24(m_key, input));
+    return conv == HANDSHAKE_CONV ? 1 : conv;
+}
@@ -0,0 +1,64 @@
+/**
+ * ************************************************************************
+ *
+ * @file HandshakeCookies.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 无状态握手 cookie：签发、校验与 conv 派生
+ *
+ * cookie = SipHash(密钥, 对端 sockaddr（地址 + 端口）, nonce, timestamp)。服务端不记录签发过的 cookie，
+ * 收到 CONNECT 时重新计算比对即可；conv 由 cookie 派生，重发的 CONNECT 得到同一个 conv，
+ * 丢失 ACCEPT 后客户端重试不会建立第二个会话。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../common/NetAddress.h"
+#include "../common/SipHash.h"
+#include <cstdint>
+
+class HandshakeCookies
+{
+public:
+    static constexpr uint32_t DEFAULT_LIFETIME_SEC = 10;
+
+    /**
+     * @brief 使用随机密钥（进程重启后旧 cookie 全部失效）
+     * @param lifetimeSec cookie 有效期
+     */
+    explicit HandshakeCookies(uint32_t lifetimeSec = DEFAULT_LIFETIME_SEC);
+
+    /**
+     * @brief 使用指定密钥（多进程共享或测试）
+     */
+    HandshakeCookies(const SipHashKey& key, uint32_t lifetimeSec);
+
+    /**
+     * @brief 为对端签发 cookie
+     * @param timestamp 签发时间（秒）
+     */
+    [[nodiscard]] uint64_t issue(const NetAddress& peer, uint32_t nonce, uint32_t timestamp) const noexcept;
+
+    /**
+     * @brief 校验 cookie：由同一密钥为同一地址、端口、nonce、timestamp 签发，且未过期
+     * @param nowSec 当前时间（秒，与签发时同一时钟）
+     */
+    [[nodiscard]] bool verify(
+        const NetAddress& peer, uint32_t nonce, uint32_t timestamp, uint64_t cookie, uint32_t nowSec) const noexcept;
+
+    /**
+     * @brief 由 cookie 派生的 conv（非 0，0 保留给握手报文）
+     */
+    [[nodiscard]] uint32_t convFor(uint64_t cookie) const noexcept;
+
+    [[nodiscard]] uint32_t lifetimeSec() const noexcept { return m_lifetimeSec; }
+
+private:
+    SipHashKey m_key;
+    uint32_t m_lifetimeSec;
+};
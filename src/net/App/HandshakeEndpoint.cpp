@@ -0,0 +1,79 @@
+/**
+ * ************************************************************************
+ *
+ * @file HandshakeEndpoint.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 要求 cookie 握手的服务端端点实现
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include "HandshakeEndpoint.h"
+
+bool HandshakeEndpoint::admitUnknown(const NetAddress& from, uint32_t conv, std::span<const uint8_t> data)
+{
+    if (conv == HANDSHAKE_CONV)
+    {
+        if (auto packet = parseHandshake(data))
+        {
+            handleHandshake(from, *packet);
+            return false;
+        }
+    }
+    countRejected();
+    return false;
+}
+
+void HandshakeEndpoint::handleHandshake(const NetAddress& from, const HandshakePacket& packet)
+{
+    const uint32_t now = nowSec();
+    switch (packet.type)
+    {
+    case HandshakeType::Hello:
+    {
+        // 只计算 cookie 并回复，不记录任何状态
+        const HandshakePacket reply{.type = HandshakeType::Challenge,
+                                    .nonce = packet.nonce,
+                                    .timestamp = now,
+                                    .cookie = m_cookies.issue(from, packet.nonce, now)};
+        m_transport.send(from, handshakeBytes(reply));
+        return;
+    }
+
+    case HandshakeType::Connect:
+        if (!m_cookies.verify(from, packet.nonce, packet.timestamp, packet.cookie, now))
+        {
+            countRejected();
+            return;
+        }
+        onHandshakeVerified(m_cookies.convFor(packet.cookie), from, packet.nonce);
+        return;
+
+    default: // 服务端不接收 CHALLENGE / ACCEPT
+        countRejected();
+        return;
+    }
+}
+
+void HandshakeEndpoint::completeHandshake(uint32_t conv, const NetAddress& from, uint32_t nonce)
+{
+    if (const auto* entry = m_sessions.find(conv))
+    {
+        if (!(entry->session->peer() == from))
+        {
+            countRejected();
+            return;
+        }
+    }
+    else
+    {
+        openSession(conv, from);
+    }
+    const HandshakePacket reply{.type = HandshakeType::Accept, .nonce = nonce, .assignedConv = conv};
+    m_transport.send(from, handshakeBytes(reply));
+}
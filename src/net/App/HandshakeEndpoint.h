@@ -0,0 +1,61 @@
+/**
+ * ************************************************************************
+ *
+ * @file HandshakeEndpoint.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 要求 cookie 握手的服务端端点（Server 与 ShardedServer 的分片共用）
+ *
+ * conv 为 HANDSHAKE_CONV 的报文在 admitUnknown 中处理：HELLO 只回复 CHALLENGE，不记录状态；
+ * CONNECT 校验 cookie 后由 cookie 派生 conv、建立会话并回复 ACCEPT。
+ * 其余未知 conv 一律丢弃并计入 packetsRejected。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "KcpEndpoint.h"
+#include "HandshakeCookies.h"
+#include "../protocol/HandshakePacket.h"
+
+class HandshakeEndpoint : public KcpEndpoint
+{
+protected:
+    HandshakeEndpoint(IUdpTransport& transport, const HandshakeCookies& cookies)
+        : KcpEndpoint(transport), m_cookies(cookies)
+    {
+    }
+
+    /**
+     * @brief 处理握手报文；其余未知 conv 一律丢弃
+     */
+    bool admitUnknown(const NetAddress& from, uint32_t conv, std::span<const uint8_t> data) override;
+
+    /**
+     * @brief CONNECT 的 cookie 校验通过
+     *
+     * 默认在本端点 completeHandshake；会话需要建在其他端点上时（ShardedServer 按 conv 分片）由子类转交。
+     * @param conv 由 cookie 派生的 conv
+     */
+    virtual void onHandshakeVerified(uint32_t conv, const NetAddress& from, uint32_t nonce)
+    {
+        completeHandshake(conv, from, nonce);
+    }
+
+    /**
+     * @brief 以 conv 建立会话并回复 ACCEPT
+     *
+     * 重发的 CONNECT（ACCEPT 丢失）命中同一对端的已有会话，只重发 ACCEPT；
+     * conv 已属于其他对端（极少数碰撞）时拒绝，客户端换 nonce 重新握手。
+     */
+    void completeHandshake(uint32_t conv, const NetAddress& from, uint32_t nonce);
+
+private:
+    void handleHandshake(const NetAddress& from, const HandshakePacket& packet);
+
+    HandshakeCookies m_cookies;
+};
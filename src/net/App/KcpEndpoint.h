@@ -18,9 +18,14 @@
 #pragma once
 #include "../Session/KcpSession.h"
 #include "../common/NetAddress.h"
-#include <unordered_map>
+#include "../common/NetMetrics.h"
+#include "../common/TimerWheel.h"
+#include "../protocol/UnreliableHeader.h"
+#include "SessionTable.h"
 #include <chrono>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 class KcpEndpoint
 {
@@ -37,60 +42,139 @@ public:
     {
         if (data.size() < 4) [[unlikely]]
         {
+            m_counters.packetRejected();
             return;
         }
+        m_counters.packetIn(data.size());
 
         uint32_t conv = selectConv(from, data);
 
-        // 优化：try_emplace 避免了重复查找和冗余构造
-        auto [iter, inserted] = m_sessions.try_emplace(conv);
+        auto* entry = m_sessions.find(conv);
+        if (entry == nullptr) [[unlikely]]
+        {
+            // 未知 conv：由子类决定是否为其分配会话（Server 要求先完成握手）
+            if (!admitUnknown(from, conv, data))
+            {
+                return;
+            }
+            openSession(conv, from);
+
+            // 回调中可能增删会话导致表重排，重新定位条目
+            entry = m_sessions.find(conv);
+            if (entry == nullptr) [[unlikely]]
+            {
+                return;
+            }
+        }
 
-        if (inserted) [[unlikely]]
+        // 更新活跃时间，并让会话在下一个 tick 回复 ACK / 交付数据；不可靠数据报在 input 中直接交付，无需 ACK
+        entry->lastActiveMs = m_nowMs;
+        if (!isUnreliableDatagram(data))
         {
-            iter->second = createSession(conv, from);
-            onSession(conv, iter->second); // 传递 shared_ptr 保证生命周期
+            wake(*entry);
         }
+        entry->session->input(data);
+    }
 
-        iter->second->input(data);
-        m_lastActive[conv] = std::chrono::steady_clock::now(); // 更新活跃时间
+    /**
+     * @brief 批量处理一次唤醒中收到的多个 UDP 包（配合 AsioUdpTransport::startBatchRecvLoop）
+     */
+    void input(std::span<const UdpDatagram> batch)
+    {
+        for (const auto& datagram : batch)
+        {
+            input(datagram.from, datagram.payload);
+        }
     }
 
     /**
-     * @brief 更新所有会话状态，并清理超时会话
-     * @param now_ms 当前时间点
+     * @brief 更新到期的会话，并清理超时会话
+     * @param now_ms 当前时间点；早于上一次的时间点按上一次处理
      * @param timeout_sec 会话超时阈值（默认30秒）
+     *
+     * 每个会话在时间轮上只有一个定时器：有待发送数据时取 ikcp_check 给出的下一次更新时间，
+     * 静默时挂到空闲超时时间点；收到数据或 send 的会话进入就绪表，在下一次 update 中立即 flush。
+     * 因此每次 update 只处理到期或被唤醒的会话。
      */
     void update(uint32_t now_ms, std::chrono::seconds timeout_sec = std::chrono::seconds(30))
     {
-        auto now_tp = std::chrono::steady_clock::now();
-        for (auto iter = m_sessions.begin(); iter != m_sessions.end();)
+        const auto begin = std::chrono::steady_clock::now();
+        if (!m_clockStarted) [[unlikely]]
         {
-            auto& [conv, sess] = *iter;
-
-            // 驱动 KCP
-            sess->update(now_ms);
-
-            // 检查超时清理
-            auto last_iter = m_lastActive.find(conv);
-            if (last_iter == m_lastActive.end())
+            // 时间轮以首个时间点为起点（此前还没有定时器），此前建立的会话以它作为活跃时间
+            m_clockStarted = true;
+            m_timers = Timers(now_ms);
+            m_elapsedMs = now_ms;
+            for (auto& entry : m_sessions)
             {
-                m_lastActive.emplace(conv, now_tp);
-                ++iter;
-                continue;
+                entry.lastActiveMs = now_ms;
             }
-
-            if (now_tp - last_iter->second > timeout_sec)
-            {
-                sess->close();
-                onSessionClosed(conv);
-                m_lastActive.erase(conv);
-                iter = m_sessions.erase(iter); // 安全删除
-            }
-            else
+        }
+        else
+        {
+            // 调用方的时钟倒退（非单调时钟、多个时间源）时停在上一次的时间，不让会话与时间轮倒退
+            if (static_cast<int32_t>(now_ms - m_nowMs) < 0) [[unlikely]]
             {
-                ++iter;
+                now_ms = m_nowMs;
             }
+            // 按无符号差累加，32 位毫秒时钟回绕（约 49.7 天）时仍然单调
+            m_elapsedMs += now_ms - m_nowMs;
+        }
+        m_nowMs = now_ms;
+        m_idleTimeoutMs = static_cast<uint32_t>(std::chrono::milliseconds(timeout_sec).count());
+
+        drainWakeups();
+
+        // 本轮所有会话的 KCP 输出先进入发送队列，循环结束后一次性发出
+        m_transport.beginBatch();
+        m_readyScratch.swap(m_ready);
+        for (uint32_t conv : m_readyScratch)
+        {
+            serviceSession(conv);
+        }
+        m_readyScratch.clear();
+        m_timers.advance(now_ms,
+                         [this](uint32_t conv)
+                         {
+                             if (auto* entry = m_sessions.find(conv))
+                             {
+                                 entry->timer = Timers::INVALID_HANDLE;
+                             }
+                             serviceSession(conv);
+                         });
+        m_transport.flush();
+
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        m_counters.updateFinished(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    /**
+     * @brief 设置此后新建会话使用的 KCP 参数预设（已有会话可用 KcpSession::setProfile 单独切换）
+     */
+    void setSessionProfile(const KcpProfile& profile) { m_sessionProfile = profile; }
+
+    [[nodiscard]] const KcpProfile& sessionProfile() const noexcept { return m_sessionProfile; }
+
+    /**
+     * @brief 端点指标快照（收包量、会话数、update 耗时）
+     * @note 无锁读取，可在任意线程调用
+     */
+    [[nodiscard]] EndpointMetrics metrics() const noexcept { return m_counters.snapshot(); }
+
+    /**
+     * @brief 所有会话的指标快照
+     * @note 需在驱动本端点的网络线程上调用（遍历会话表）；单个会话的 metrics() 可在任意线程读取
+     */
+    [[nodiscard]] std::vector<SessionMetrics> sessionMetrics() const
+    {
+        std::vector<SessionMetrics> result;
+        result.reserve(m_sessions.size());
+        for (const auto& entry : m_sessions)
+        {
+            result.push_back(entry.session->metrics());
         }
+        return result;
     }
 
 protected:
@@ -105,6 +189,20 @@ protected:
      */
     virtual uint32_t selectConv(const NetAddress&, std::span<const uint8_t>) = 0;
 
+    /**
+     * @brief 收到不属于任何现有会话的数据报时调用
+     * @param from 来源地址
+     * @param conv selectConv 给出的 conv
+     * @param data 数据报
+     * @return true 以该 conv 创建会话并交付数据报（默认）；false 丢弃，不分配任何状态
+     */
+    virtual bool admitUnknown([[maybe_unused]] const NetAddress& from,
+                              [[maybe_unused]] uint32_t conv,
+                              [[maybe_unused]] std::span<const uint8_t> data)
+    {
+        return true;
+    }
+
     /**
      * @brief 会话创建回调
      * @param conv 会话的 Conv ID
@@ -118,8 +216,175 @@ protected:
      */
     virtual void onSessionClosed([[maybe_unused]] uint32_t conv) {}
 
+    /**
+     * @brief 以指定 conv 建立会话并纳入调度（握手完成、客户端主动连接或 admitUnknown 放行时）
+     * @return 新会话；conv 已存在时返回原会话
+     */
+    std::shared_ptr<KcpSession> openSession(uint32_t conv, const NetAddress& peer)
+    {
+        auto [entry, inserted] = m_sessions.tryEmplace(conv);
+        if (!inserted)
+        {
+            return entry->session;
+        }
+
+        auto session = createSession(conv, peer);
+        entry->session = session;
+        trackSession(*entry);
+        onSession(conv, session); // 传递 shared_ptr 保证生命周期
+        return session;
+    }
+
+    /**
+     * @brief 记一个被拒绝的数据报（子类在 admitUnknown 中丢弃数据报时调用）
+     */
+    void countRejected() noexcept { m_counters.packetRejected(); }
+
+    /**
+     * @brief 关闭并移除全部会话（子类析构时调用，保证会话先于其执行器销毁）
+     */
+    void closeAllSessions()
+    {
+        for (auto& entry : m_sessions)
+        {
+            entry.session->setWakeCallback(nullptr);
+            entry.session->close();
+            m_counters.sessionClosed();
+        }
+        m_sessions.clear();
+        m_counters.setActiveSessions(0);
+    }
+
+    /**
+     * @brief 最近一次 update 传入的时间（毫秒）
+     */
+    [[nodiscard]] uint32_t nowMs() const noexcept { return m_nowMs; }
+
+    /**
+     * @brief 由 update 的毫秒增量累加出的秒数，不随 32 位毫秒时钟回绕（握手 cookie 的时间戳）
+     */
+    [[nodiscard]] uint32_t nowSec() const noexcept { return static_cast<uint32_t>(m_elapsedMs / 1'000); }
+
+    /**
+     * @brief 为新加入 m_sessions 的会话建立调度状态（活跃时间、定时器、send 唤醒）
+     * @param entry 已填好 session 的表项
+     */
+    void trackSession(SessionTable::Entry& entry)
+    {
+        m_counters.sessionOpened();
+        m_counters.setActiveSessions(m_sessions.size());
+        entry.lastActiveMs = m_nowMs;
+        wake(entry);
+
+        entry.session->setWakeCallback(
+            [wakeups = m_wakeups, conv = entry.conv]
+            {
+                std::lock_guard lock(wakeups->mutex);
+                wakeups->convs.push_back(conv);
+            });
+    }
+
+private:
+    using Timers = TimerWheel<uint32_t>;
+
+    // send 可能来自业务线程，唤醒请求先排队，由 update 在网络线程统一处理
+    struct WakeQueue
+    {
+        std::mutex mutex;
+        std::vector<uint32_t> convs;
+    };
+
+    // 让会话在下一次 update 中被立即处理（不经过时间轮，避免多等一个 tick）
+    void wake(SessionTable::Entry& entry)
+    {
+        if (!std::exchange(entry.woken, true))
+        {
+            m_ready.push_back(entry.conv);
+        }
+    }
+
+    void drainWakeups()
+    {
+        {
+            std::lock_guard lock(m_wakeups->mutex);
+            m_wakeupScratch.swap(m_wakeups->convs);
+        }
+        for (uint32_t conv : m_wakeupScratch)
+        {
+            if (auto* entry = m_sessions.find(conv))
+            {
+                wake(*entry);
+            }
+        }
+        m_wakeupScratch.clear();
+    }
+
+    // 定时器到期或被唤醒：检查空闲超时，驱动 KCP，再按下一次到期时间重新挂回时间轮
+    void serviceSession(uint32_t conv)
+    {
+        auto* entry = m_sessions.find(conv);
+        if (entry == nullptr) [[unlikely]]
+        {
+            return;
+        }
+        m_counters.sessionServiced();
+        if (entry->timer != Timers::INVALID_HANDLE)
+        {
+            m_timers.cancel(entry->timer);
+            entry->timer = Timers::INVALID_HANDLE;
+        }
+
+        if (m_nowMs - entry->lastActiveMs >= m_idleTimeoutMs)
+        {
+            // 先移出表（删除会移动其他条目），再关闭会话并通知子类
+            auto closed = std::move(entry->session);
+            m_sessions.erase(conv);
+            m_counters.sessionClosed();
+            m_counters.setActiveSessions(m_sessions.size());
+            closed->setWakeCallback(nullptr);
+            closed->close();
+            onSessionClosed(conv);
+            return;
+        }
+        auto& session = entry->session;
+
+        // 被唤醒时立即发出 ACK 与新数据，否则按 KCP 自身的 interval 节奏更新
+        if (std::exchange(entry->woken, false))
+        {
+            session->flush(m_nowMs);
+        }
+        else
+        {
+            session->update(m_nowMs);
+        }
+
+        uint32_t due = entry->lastActiveMs + m_idleTimeoutMs;
+        if (session->hasPendingOutput())
+        {
+            const uint32_t next = session->check(m_nowMs);
+            if (static_cast<int32_t>(next - due) < 0)
+            {
+                due = next;
+            }
+        }
+        entry->timer = m_timers.schedule(due, conv);
+    }
+
 protected:
     IUdpTransport& m_transport;
-    std::unordered_map<uint32_t, std::shared_ptr<KcpSession>> m_sessions;
-    std::unordered_map<uint32_t, std::chrono::steady_clock::time_point> m_lastActive;
-};
\ No newline at end of file
+    std::shared_ptr<PacketPool> m_packetPool = std::make_shared<PacketPool>(); // 所有会话共享的接收缓冲池
+    SessionTable m_sessions; // conv -> 会话与调度状态（活跃时间、定时器、唤醒标记）
+    KcpProfile m_sessionProfile; // 子类 createSession 时传给新会话
+
+private:
+    Timers m_timers;
+    std::shared_ptr<WakeQueue> m_wakeups = std::make_shared<WakeQueue>();
+    std::vector<uint32_t> m_wakeupScratch;
+    std::vector<uint32_t> m_ready; // 已唤醒、等待本轮 update 处理的会话
+    std::vector<uint32_t> m_readyScratch;
+    EndpointCounters m_counters;
+    uint32_t m_nowMs = 0;
+    uint64_t m_elapsedMs = 0; // 首次 update 的时间加上此后的累计增量
+    uint32_t m_idleTimeoutMs = 30'000;
+    bool m_clockStarted = false;
+};
@@ -0,0 +1,112 @@
+/**
+ * ************************************************************************
+ *
+ * @file RoomBroadcaster.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间广播实现
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include "RoomBroadcaster.h"
+#include <algorithm>
+#include <utility>
+
+void RoomBroadcaster::join(RoomId room, std::shared_ptr<KcpSession> session)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+    auto& members = m_rooms[room];
+    if (std::ranges::find(members, session) == members.end())
+    {
+        members.push_back(std::move(session));
+    }
+}
+
+bool RoomBroadcaster::leave(RoomId room, const KcpSession& session)
+{
+    auto it = m_rooms.find(room);
+    if (it == m_rooms.end())
+    {
+        return false;
+    }
+    auto& members = it->second;
+    auto member = std::ranges::find_if(members, [&session](const auto& m) { return m.get() == &session; });
+    if (member == members.end())
+    {
+        return false;
+    }
+
+    // 成员顺序无意义，与末尾交换后删除
+    std::swap(*member, members.back());
+    members.pop_back();
+    if (members.empty())
+    {
+        m_rooms.erase(it);
+    }
+    return true;
+}
+
+void RoomBroadcaster::removeRoom(RoomId room)
+{
+    m_rooms.erase(room);
+}
+
+size_t RoomBroadcaster::memberCount(RoomId room) const
+{
+    auto it = m_rooms.find(room);
+    return it == m_rooms.end() ? 0 : it->second.size();
+}
+
+size_t RoomBroadcaster::broadcast(RoomId room, const SharedFrame& frame)
+{
+    auto it = m_rooms.find(room);
+    if (it == m_rooms.end())
+    {
+        return 0;
+    }
+
+    auto& members = it->second;
+    size_t delivered = 0;
+    for (size_t i = 0; i < members.size();)
+    {
+        if (members[i]->queueSharedFrame(frame))
+        {
+            ++delivered;
+            ++i;
+        }
+        else
+        {
+            // 会话已关闭（超时或主动断开），不再保留
+            std::swap(members[i], members.back());
+            members.pop_back();
+        }
+    }
+    if (members.empty())
+    {
+        m_rooms.erase(it);
+    }
+    return delivered;
+}
+
+std::expected<size_t, CodecError>
+    RoomBroadcaster::broadcast(RoomId room, uint16_t cmd, std::span<const uint8_t> payload)
+{
+    if (!m_rooms.contains(room))
+    {
+        return 0;
+    }
+    auto frame = m_compression ? SharedFrame::encode(cmd, payload, *m_compression) : SharedFrame::encode(cmd, payload);
+    if (!frame) [[unlikely]]
+    {
+        return std::unexpected(frame.error());
+    }
+    return broadcast(room, *frame);
+}
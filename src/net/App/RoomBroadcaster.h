@@ -0,0 +1,80 @@
+/**
+ * ************************************************************************
+ *
+ * @file RoomBroadcaster.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间广播：一帧编码一次，以共享引用扇出到房间内所有会话
+ *
+ * 出牌、伤害结算等事件需要发给房间里的每个玩家。broadcast 只编码（与压缩）一次，
+ * 得到 SharedFrame 后逐个会话 queueSharedFrame，每个接收方只增加一次引用计数；
+ * 各会话在下一次 Endpoint::update 中把帧并入各自的批量消息，整轮输出经传输层批量发送。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../Session/KcpSession.h"
+#include "../protocol/SharedFrame.h"
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 房间成员表与广播入口
+ * @note 成员表本身不加锁，应在同一线程（通常是房间逻辑线程）上调用；
+ *       queueSharedFrame 是线程安全的，因此该线程不必是驱动会话的网络线程
+ */
+class RoomBroadcaster
+{
+public:
+    using RoomId = uint32_t;
+
+    /**
+     * @brief 把会话加入房间，已在房间中时忽略
+     */
+    void join(RoomId room, std::shared_ptr<KcpSession> session);
+
+    /**
+     * @brief 把会话移出房间，房间变空时一并删除
+     * @return 会话原本在房间中时返回 true
+     */
+    bool leave(RoomId room, const KcpSession& session);
+
+    /**
+     * @brief 解散房间
+     */
+    void removeRoom(RoomId room);
+
+    [[nodiscard]] size_t memberCount(RoomId room) const;
+    [[nodiscard]] size_t roomCount() const noexcept { return m_rooms.size(); }
+
+    /**
+     * @brief 设置 broadcast(room, cmd, payload) 的帧压缩选项，std::nullopt 关闭压缩（默认）
+     */
+    void setFrameCompression(std::optional<FrameCompression> compression) { m_compression = compression; }
+
+    /**
+     * @brief 把已编码的帧排入房间内所有会话，已关闭的会话顺带移出房间
+     * @return 实际排入的会话数
+     */
+    size_t broadcast(RoomId room, const SharedFrame& frame);
+
+    /**
+     * @brief 编码一次后广播
+     * @return 排入的会话数；载荷超过帧长度上限时返回 PayloadTooLarge
+     */
+    std::expected<size_t, CodecError> broadcast(RoomId room, uint16_t cmd, std::span<const uint8_t> payload);
+
+private:
+    std::unordered_map<RoomId, std::vector<std::shared_ptr<KcpSession>>> m_rooms;
+    std::optional<FrameCompression> m_compression;
+};
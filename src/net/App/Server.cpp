@@ -6,48 +6,43 @@
 // Pimpl 实现
 struct Server::Impl
 {
-    asio::io_context ioc;
     asio::thread_pool pool;
 
-    explicit Impl(size_t thread_count) : ioc(), pool(thread_count) {}
+    explicit Impl(size_t thread_count) : pool(thread_count) {}
 
-    // 玩家业务协程
-    static asio::awaitable<void> playerRoutine(uint32_t conv, std::shared_ptr<KcpSession> session)
+    // 玩家业务协程：直接等待会话的接收通道，数据到达即恢复
+    static asio::awaitable<void> playerRoutine([[maybe_unused]] uint32_t conv, std::shared_ptr<KcpSession> session)
     {
-        try
+        while (true)
         {
-            while (true)
+            auto result = co_await session->recv();
+            if (!result)
             {
-                // 使用回调模式接收数据
-                std::optional<std::expected<KcpSession::Packet, std::error_code>> result;
-                session->recvAsync([&result](auto res) { result = std::move(res); });
-
-                // 等待结果（简化示例，实际应使用同步机制）
-                co_await asio::steady_timer(co_await asio::this_coro::executor, std::chrono::milliseconds(10))
-                    .async_wait(asio::use_awaitable);
-
-                if (!result || !result->has_value())
-                {
-                    break;
-                }
-
-                const auto& msg = **result;
-                // 处理业务逻辑
-                session->send(msg);
+                break;
             }
-        }
-        catch (const std::exception&)
-        {
+
+            // 处理业务逻辑
+            session->send(*result);
         }
     }
 };
 
 Server::Server(IUdpTransport& transport, size_t thread_count)
-    : KcpEndpoint(transport), m_impl(std::make_unique<Impl>(thread_count))
+    : Server(transport, thread_count, HandshakeCookies())
 {
 }
 
-Server::~Server() = default;
+Server::Server(IUdpTransport& transport, size_t thread_count, const HandshakeCookies& cookies)
+    : HandshakeEndpoint(transport, cookies), m_impl(std::make_unique<Impl>(thread_count))
+{
+}
+
+Server::~Server()
+{
+    // 会话的 strand 与玩家协程都依赖线程池：先关闭会话让协程退出，再等待线程池清空
+    closeAllSessions();
+    m_impl->pool.join();
+}
 
 void Server::stop()
 {
@@ -61,11 +56,13 @@ uint32_t Server::selectConv([[maybe_unused]] const NetAddress& from, std::span<c
 
 std::shared_ptr<KcpSession> Server::createSession(uint32_t conv, const NetAddress& peer)
 {
-    return std::make_shared<KcpSession>(conv, m_transport, peer, m_impl->ioc.get_executor());
+    // 每个会话一个 strand：会话的接收通道与玩家协程在同一执行器上，消息之间无需再切换线程
+    return std::make_shared<KcpSession>(
+        conv, m_transport, peer, asio::make_strand(m_impl->pool), m_packetPool, m_sessionProfile);
 }
 
 void Server::onSession(std::uint32_t conv, std::shared_ptr<KcpSession> session)
 {
-    auto player_executor = asio::make_strand(m_impl->pool.get_executor());
+    auto player_executor = session->executor();
     asio::co_spawn(player_executor, Impl::playerRoutine(conv, std::move(session)), asio::detached);
 }
\ No newline at end of file
@@ -1,16 +1,26 @@
 #pragma once
-#include "KcpEndpoint.h"
+#include "HandshakeEndpoint.h"
 #include <bit>
 #include <cstring>
 #include <utility>
 #include <memory>
 #include "PeekConv.h"
 
-class Server : public KcpEndpoint
+/**
+ * @brief KCP 服务器：客户端先完成 cookie 握手（见 HandshakePacket.h），由服务器分配 conv
+ *
+ * 握手完成前不为对端分配任何状态；携带未知 conv 的数据报直接丢弃并计入 packetsRejected（见 HandshakeEndpoint）。
+ */
+class Server : public HandshakeEndpoint
 {
 public:
     // 构造函数：需要 UDP 传输层和线程池大小
     Server(IUdpTransport& transport, size_t thread_count);
+
+    /**
+     * @brief 构造函数：指定握手 cookie 的密钥与有效期（多进程共享密钥或测试）
+     */
+    Server(IUdpTransport& transport, size_t thread_count, const HandshakeCookies& cookies);
     ~Server();
     // 停止服务器，等待线程池结束
     void stop();
@@ -0,0 +1,229 @@
+/**
+ * ************************************************************************
+ *
+ * @file SessionTable.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 以 conv 为键的开放寻址会话表
+ *
+ * 线性探测 + 删除时后移（backward shift），没有墓碑。条目内联保存 conv、
+ * 活跃时间、时间轮句柄和会话指针，收包分发只需一次探测，插入之外不分配内存。
+ * @note 插入（可能扩容）与删除（后移）会使已取得的 Entry 指针失效
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../Session/KcpSession.h"
+#include "../common/TimerWheel.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class SessionTable
+{
+public:
+    using TimerHandle = TimerWheel<uint32_t>::Handle;
+
+    struct Entry
+    {
+        uint32_t conv = 0;
+        uint32_t lastActiveMs = 0;                                // 最近一次收包时间（毫秒）
+        TimerHandle timer = TimerWheel<uint32_t>::INVALID_HANDLE; // 时间轮上的定时器
+        bool woken = false;                                       // 已进入就绪表，等待本轮 update 处理
+        bool occupied = false;                                    // 表内部使用：槽位是否有效
+        std::shared_ptr<KcpSession> session;
+    };
+
+    template <typename EntryType>
+    class Iterator
+    {
+    public:
+        Iterator(EntryType* slot, EntryType* end) noexcept : m_slot(slot), m_end(end) { skipEmpty(); }
+
+        EntryType& operator*() const noexcept { return *m_slot; }
+        EntryType* operator->() const noexcept { return m_slot; }
+
+        Iterator& operator++() noexcept
+        {
+            ++m_slot;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const noexcept { return m_slot == other.m_slot; }
+
+    private:
+        void skipEmpty() noexcept
+        {
+            while (m_slot != m_end && !m_slot->occupied)
+            {
+                ++m_slot;
+            }
+        }
+
+        EntryType* m_slot;
+        EntryType* m_end;
+    };
+
+    using iterator = Iterator<Entry>;
+    using const_iterator = Iterator<const Entry>;
+
+    explicit SessionTable(size_t initialCapacity = DEFAULT_CAPACITY)
+        : m_slots(std::bit_ceil(std::max<size_t>(initialCapacity, MIN_CAPACITY)))
+    {
+        m_mask = m_slots.size() - 1;
+        m_shift = static_cast<uint32_t>(32 - std::countr_zero(m_slots.size()));
+    }
+
+    /**
+     * @brief 查找 conv，不存在时插入一个空条目（session 为空，由调用方填充）
+     * @return 条目指针与是否新插入
+     */
+    std::pair<Entry*, bool> tryEmplace(uint32_t conv)
+    {
+        if ((m_size + 1) * MAX_LOAD_DEN > m_slots.size() * MAX_LOAD_NUM) [[unlikely]]
+        {
+            rehash(m_slots.size() * 2);
+        }
+
+        size_t index = home(conv);
+        while (m_slots[index].occupied)
+        {
+            if (m_slots[index].conv == conv)
+            {
+                return {&m_slots[index], false};
+            }
+            index = (index + 1) & m_mask;
+        }
+
+        Entry& entry = m_slots[index];
+        entry = Entry{};
+        entry.conv = conv;
+        entry.occupied = true;
+        ++m_size;
+        return {&entry, true};
+    }
+
+    [[nodiscard]] Entry* find(uint32_t conv) noexcept
+    {
+        size_t index = home(conv);
+        while (m_slots[index].occupied)
+        {
+            if (m_slots[index].conv == conv)
+            {
+                return &m_slots[index];
+            }
+            index = (index + 1) & m_mask;
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] const Entry* find(uint32_t conv) const noexcept
+    {
+        return const_cast<SessionTable*>(this)->find(conv);
+    }
+
+    /**
+     * @brief 删除 conv，并把后续探测链上的条目前移填补空位
+     */
+    bool erase(uint32_t conv)
+    {
+        Entry* entry = find(conv);
+        if (entry == nullptr)
+        {
+            return false;
+        }
+
+        size_t hole = static_cast<size_t>(entry - m_slots.data());
+        size_t next = (hole + 1) & m_mask;
+        while (m_slots[next].occupied)
+        {
+            // 条目的理想位置不在 (hole, next] 区间内时，才能前移到空位
+            const size_t ideal = home(m_slots[next].conv);
+            const bool stays = hole < next ? (ideal > hole && ideal <= next) : (ideal > hole || ideal <= next);
+            if (!stays)
+            {
+                m_slots[hole] = std::move(m_slots[next]);
+                hole = next;
+            }
+            next = (next + 1) & m_mask;
+        }
+        m_slots[hole] = Entry{};
+        --m_size;
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        for (auto& slot : m_slots)
+        {
+            slot = Entry{};
+        }
+        m_size = 0;
+    }
+
+    void reserve(size_t count)
+    {
+        const size_t required = std::bit_ceil((count * MAX_LOAD_DEN / MAX_LOAD_NUM) + 1);
+        if (required > m_slots.size())
+        {
+            rehash(required);
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return m_slots.size(); }
+
+    iterator begin() noexcept { return {m_slots.data(), m_slots.data() + m_slots.size()}; }
+    iterator end() noexcept { return {m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()}; }
+    const_iterator begin() const noexcept { return {m_slots.data(), m_slots.data() + m_slots.size()}; }
+    const_iterator end() const noexcept
+    {
+        return {m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()};
+    }
+
+private:
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+    static constexpr size_t MIN_CAPACITY = 8;
+    static constexpr size_t MAX_LOAD_NUM = 7; // 最大装载因子 7/8
+    static constexpr size_t MAX_LOAD_DEN = 8;
+
+    // Fibonacci 哈希：连续分配的 conv 也能均匀散开
+    [[nodiscard]] size_t home(uint32_t conv) const noexcept { return (conv * 2654435769U) >> m_shift; }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<Entry> old(capacity);
+        old.swap(m_slots);
+        m_mask = m_slots.size() - 1;
+        m_shift = static_cast<uint32_t>(32 - std::countr_zero(m_slots.size()));
+        for (auto& slot : old)
+        {
+            if (!slot.occupied)
+            {
+                continue;
+            }
+            size_t index = home(slot.conv);
+            while (m_slots[index].occupied)
+            {
+                index = (index + 1) & m_mask;
+            }
+            m_slots[index] = std::move(slot);
+        }
+    }
+
+    std::vector<Entry> m_slots;
+    size_t m_size = 0;
+    size_t m_mask = 0;
+    uint32_t m_shift = 0;
+};
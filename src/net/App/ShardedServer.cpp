@@ -0,0 +1,424 @@
+/**
+ * ************************************************************************
+ *
+ * @file ShardedServer.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 按 conv 分片的多线程 KCP 服务器实现
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include "ShardedServer.h"
+#include "HandshakeEndpoint.h"
+#include "PeekConv.h"
+#include "../transport/AsioUdpTransport.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/**
+ * @brief 共享 socket 模式下各分片的发送包装
+ * 每个分片各自排队，flush 时在锁内把整批交给共享 socket 的发送队列
+ */
+class SharedSocketTransport final : public IUdpTransport
+{
+public:
+    SharedSocketTransport(AsioUdpTransport& socket, std::mutex& mutex) : m_socket(socket), m_mutex(mutex) {}
+
+    void send(const NetAddress& address, std::span<const uint8_t> data) override
+    {
+        if (!m_batching)
+        {
+            std::lock_guard lock(m_mutex);
+            m_socket.send(address, data);
+            return;
+        }
+        m_queue.push_back(Queued{.to = address, .offset = m_bytes.size(), .size = data.size()});
+        m_bytes.insert(m_bytes.end(), data.begin(), data.end());
+    }
+
+    void beginBatch() override { m_batching = true; }
+
+    void flush() override
+    {
+        m_batching = false;
+        if (m_queue.empty())
+        {
+            return;
+        }
+        {
+            std::lock_guard lock(m_mutex);
+            m_socket.beginBatch();
+            for (const auto& queued : m_queue)
+            {
+                m_socket.send(queued.to, std::span<const uint8_t>(m_bytes).subspan(queued.offset, queued.size));
+            }
+            m_socket.flush();
+        }
+        m_queue.clear();
+        m_bytes.clear();
+    }
+
+    [[nodiscard]] SendBatchStats sendStats() const override
+    {
+        std::lock_guard lock(m_mutex);
+        return m_socket.sendStats();
+    }
+
+private:
+    struct Queued
+    {
+        NetAddress to;
+        size_t offset;
+        size_t size;
+    };
+
+    AsioUdpTransport& m_socket;
+    std::mutex& m_mutex;
+    bool m_batching = false;
+    std::vector<Queued> m_queue;
+    std::vector<uint8_t> m_bytes;
+};
+
+/**
+ * @brief 分片内的会话表，会话运行在分片自己的 io_context 上
+ *
+ * 握手报文的 conv 为 0，总是落到分片 0；cookie 校验通过后由 handoff 把会话交给 conv 所属的分片建立。
+ */
+class ShardEndpoint final : public HandshakeEndpoint
+{
+public:
+    using Handoff = std::function<void(uint32_t conv, const NetAddress& from, uint32_t nonce)>;
+
+    ShardEndpoint(IUdpTransport& transport,
+                  const HandshakeCookies& cookies,
+                  const asio::any_io_executor& exec,
+                  const ShardedServer::SessionHandler& handler,
+                  Handoff handoff)
+        : HandshakeEndpoint(transport, cookies), m_executor(exec), m_handler(handler), m_handoff(std::move(handoff))
+    {
+    }
+
+    // 由 conv 所属分片的线程调用
+    using HandshakeEndpoint::closeAllSessions;
+    using HandshakeEndpoint::completeHandshake;
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_executor, m_packetPool, m_sessionProfile);
+    }
+
+    uint32_t selectConv([[maybe_unused]] const NetAddress& from, std::span<const uint8_t> data) override
+    {
+        return peekConv(data);
+    }
+
+    void onSession(uint32_t conv, std::shared_ptr<KcpSession> session) override
+    {
+        if (m_handler)
+        {
+            m_handler(conv, session);
+        }
+    }
+
+    void onHandshakeVerified(uint32_t conv, const NetAddress& from, uint32_t nonce) override
+    {
+        m_handoff(conv, from, nonce);
+    }
+
+private:
+    asio::any_io_executor m_executor;
+    const ShardedServer::SessionHandler& m_handler;
+    Handoff m_handoff;
+};
+
+uint32_t steadyNowMs()
+{
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+} // namespace
+
+// Pimpl 实现
+struct ShardedServer::Impl
+{
+    struct Shard
+    {
+        asio::io_context ioc{1};
+        asio::executor_work_guard<asio::io_context::executor_type> work{ioc.get_executor()};
+        std::unique_ptr<AsioUdpTransport> socket;          // reuseport 模式下每个分片一个；共享模式下仅分片 0 持有
+        std::unique_ptr<SharedSocketTransport> sharedSend; // 共享模式下的加锁发送包装
+        std::unique_ptr<ShardEndpoint> endpoint;
+        asio::steady_timer ticker{ioc};
+        std::thread thread;
+        bool updatePosted = false;
+    };
+
+    Options options;
+    SessionHandler handler;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::mutex sharedSocketMutex;
+    PacketPool forwardPool;
+    std::atomic<uint64_t> forwarded{0};
+    bool steering = false;
+    bool running = false;
+
+    Impl(const Options& opts, SessionHandler sessionHandler) : options(opts), handler(std::move(sessionHandler))
+    {
+        if (options.shardCount == 0)
+        {
+            options.shardCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        shards.reserve(options.shardCount);
+        for (size_t i = 0; i < options.shardCount; ++i)
+        {
+            shards.push_back(std::make_unique<Shard>());
+        }
+
+#if defined(SO_REUSEPORT)
+        const bool reusePort = options.reusePort;
+#else
+        const bool reusePort = false;
+#endif
+        if (reusePort)
+        {
+            // 首个 socket 确定端口，其余分片绑定到同一端口组成 reuseport 组（组内顺序即分片下标）
+            uint16_t port = options.port;
+            for (auto& shard : shards)
+            {
+                shard->socket = std::make_unique<AsioUdpTransport>(shard->ioc.get_executor(), port, true);
+                port = shard->socket->localPort();
+                shard->endpoint = std::make_unique<ShardEndpoint>(
+                    *shard->socket, options.cookies, shard->ioc.get_executor(), handler, handoffFrom(shard.get()));
+                shard->endpoint->setSessionProfile(options.profile);
+            }
+            steering = shards.front()->socket->steerByConv(static_cast<uint32_t>(shards.size()));
+        }
+        else
+        {
+            auto& owner = *shards.front();
+            owner.socket = std::make_unique<AsioUdpTransport>(owner.ioc.get_executor(), options.port);
+            for (auto& shard : shards)
+            {
+                shard->sharedSend = std::make_unique<SharedSocketTransport>(*owner.socket, sharedSocketMutex);
+                shard->endpoint = std::make_unique<ShardEndpoint>(
+                    *shard->sharedSend, options.cookies, shard->ioc.get_executor(), handler, handoffFrom(shard.get()));
+                shard->endpoint->setSessionProfile(options.profile);
+            }
+        }
+    }
+
+    [[nodiscard]] size_t shardOf(uint32_t conv) const noexcept { return conv % shards.size(); }
+
+    // 握手完成：会话建在 conv 所属的分片上，ACCEPT 也由该分片发出（reuseport 组内各 socket 端口相同）
+    ShardEndpoint::Handoff handoffFrom(Shard* self)
+    {
+        return [this, self](uint32_t conv, const NetAddress& from, uint32_t nonce)
+        {
+            Shard* owner = shards[shardOf(conv)].get();
+            if (owner == self)
+            {
+                owner->endpoint->completeHandshake(conv, from, nonce);
+                return;
+            }
+            asio::post(owner->ioc,
+                       [this, owner, conv, from, nonce]
+                       {
+                           owner->endpoint->completeHandshake(conv, from, nonce);
+                           postUpdate(*owner);
+                       });
+        };
+    }
+
+    // 收包分片上执行：属于自己的直接交给本分片的会话表，其余拷贝后投递到所属分片
+    void route(size_t self, std::span<const UdpDatagram> batch)
+    {
+        Shard& local = *shards[self];
+        for (const auto& datagram : batch)
+        {
+            if (datagram.payload.size() < 4) [[unlikely]]
+            {
+                continue;
+            }
+
+            const size_t target = shardOf(peekConv(datagram.payload));
+            if (target == self) [[likely]]
+            {
+                local.endpoint->input(datagram.from, datagram.payload);
+                continue;
+            }
+
+            PacketBuffer copy = forwardPool.acquire(datagram.payload.size());
+            std::memcpy(copy.data(), datagram.payload.data(), datagram.payload.size());
+            forwarded.fetch_add(1, std::memory_order_relaxed);
+            Shard* owner = shards[target].get();
+            asio::post(owner->ioc,
+                       [this, owner, from = datagram.from, packet = std::move(copy)]
+                       {
+                           owner->endpoint->input(from, packet.span());
+                           postUpdate(*owner);
+                       });
+        }
+        postUpdate(local);
+    }
+
+    /**
+     * @brief 收包后追加一次 update（同一轮只投递一次）
+     * 排在本轮数据触发的接收回调之后执行，回调中 send 的回复和 ACK 随即发出，不必等到下一个 tick
+     */
+    void postUpdate(Shard& shard)
+    {
+        if (std::exchange(shard.updatePosted, true))
+        {
+            return;
+        }
+        asio::post(shard.ioc,
+                   [this, &shard]
+                   {
+                       shard.updatePosted = false;
+                       shard.endpoint->update(steadyNowMs(), options.idleTimeout);
+                   });
+    }
+
+    void armTicker(Shard& shard)
+    {
+        shard.ticker.expires_after(options.tickInterval);
+        shard.ticker.async_wait(
+            [this, &shard](const asio::error_code& ec)
+            {
+                if (ec)
+                {
+                    return;
+                }
+                shard.endpoint->update(steadyNowMs(), options.idleTimeout);
+                armTicker(shard);
+            });
+    }
+
+    void start()
+    {
+        if (running)
+        {
+            return;
+        }
+        running = true;
+        for (size_t i = 0; i < shards.size(); ++i)
+        {
+            Shard& shard = *shards[i];
+            // 先以当前时间起动端点时钟：首个 tick 之前到达的 HELLO 也按真实时间签发 cookie
+            shard.endpoint->update(steadyNowMs(), options.idleTimeout);
+            if (shard.socket != nullptr)
+            {
+                shard.socket->startBatchRecvLoop([this, i](std::span<const UdpDatagram> batch) { route(i, batch); },
+                                                 options.recvBatch);
+            }
+            armTicker(shard);
+            shard.thread = std::thread([&shard] { shard.ioc.run(); });
+        }
+    }
+
+    void stop()
+    {
+        if (!running)
+        {
+            return;
+        }
+        running = false;
+        // 先在各分片线程上关闭会话：阻塞在 recv() 的业务协程被唤醒后随即在本分片上退出，
+        // 之后再投递 stop，保证协程不会在 socket 销毁后继续收发
+        for (auto& shard : shards)
+        {
+            asio::post(shard->ioc,
+                       [&shard = *shard]
+                       {
+                           shard.endpoint->closeAllSessions();
+                           shard.ticker.cancel();
+                           asio::post(shard.ioc, [&shard] { shard.ioc.stop(); });
+                       });
+            shard->work.reset();
+        }
+        for (auto& shard : shards)
+        {
+            if (shard->thread.joinable())
+            {
+                shard->thread.join();
+            }
+        }
+    }
+};
+
+ShardedServer::ShardedServer(const Options& options, SessionHandler handler)
+    : m_impl(std::make_unique<Impl>(options, std::move(handler)))
+{
+}
+
+ShardedServer::~ShardedServer()
+{
+    stop();
+}
+
+void ShardedServer::start()
+{
+    m_impl->start();
+}
+
+void ShardedServer::stop()
+{
+    m_impl->stop();
+}
+
+size_t ShardedServer::shardCount() const noexcept
+{
+    return m_impl->shards.size();
+}
+
+size_t ShardedServer::shardOf(uint32_t conv) const noexcept
+{
+    return m_impl->shardOf(conv);
+}
+
+uint16_t ShardedServer::localPort() const
+{
+    return m_impl->shards.front()->socket->localPort();
+}
+
+bool ShardedServer::kernelSteering() const noexcept
+{
+    return m_impl->steering;
+}
+
+uint64_t ShardedServer::forwardedPackets() const noexcept
+{
+    return m_impl->forwarded.load(std::memory_order_relaxed);
+}
+
+EndpointMetrics ShardedServer::metrics() const
+{
+    EndpointMetrics total;
+    for (const auto& shard : m_impl->shards)
+    {
+        total += shard->endpoint->metrics();
+    }
+    return total;
+}
+
+EndpointMetrics ShardedServer::shardMetrics(size_t shard) const
+{
+    return m_impl->shards.at(shard)->endpoint->metrics();
+}
@@ -0,0 +1,109 @@
+/**
+ * ************************************************************************
+ *
+ * @file ShardedServer.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 按 conv 分片的多线程 KCP 服务器
+ *
+ * conv % N 决定会话归属的工作分片。每个分片独占一个线程、io_context、
+ * 会话表（KcpEndpoint）、tick 定时器，以及（支持时）一个 SO_REUSEPORT socket，
+ * 会话的收发、KCP 状态和业务回调始终在同一线程上执行，无需加锁。
+ * 与 Server 相同，会话只能经 cookie 握手建立（见 HandshakeEndpoint），conv 由服务器分配。
+ *
+ * Linux 下为 reuseport 组安装按 conv 取模的内核过滤器，数据报直接落到所属分片；
+ * 其余情况（过滤器不可用、不支持 reuseport 时的共享 socket、回环上未切分的 GSO 报文
+ * 整体落到首段所属的 socket）由收包分片转发给所属分片。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../Session/KcpSession.h"
+#include "../common/NetMetrics.h"
+#include "HandshakeCookies.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+class ShardedServer
+{
+public:
+    /**
+     * @brief 新会话回调，在会话所属分片的线程上调用；会话的 recvAsync 回调同样在该线程执行
+     */
+    using SessionHandler = std::function<void(uint32_t conv, const std::shared_ptr<KcpSession>& session)>;
+
+    struct Options
+    {
+        uint16_t port = 0;                            // 监听端口（0 表示由系统分配）
+        size_t shardCount = 0;                        // 分片数（0 表示使用硬件线程数）
+        bool reusePort = true;                        // 每个分片独立的 SO_REUSEPORT socket
+        std::chrono::milliseconds tickInterval{10};   // 分片驱动 KcpEndpoint::update 的周期
+        std::chrono::seconds idleTimeout{30};         // 会话空闲超时
+        size_t recvBatch = 32;                        // 单次 recvmmsg 的最大数据报数
+        KcpProfile profile;                           // 新会话的 KCP 参数预设
+        HandshakeCookies cookies;                     // 握手 cookie 的密钥与有效期（默认随机密钥）
+    };
+
+    ShardedServer(const Options& options, SessionHandler handler);
+    ~ShardedServer();
+
+    // 禁止拷贝和移动
+    ShardedServer(const ShardedServer&) = delete;
+    ShardedServer& operator=(const ShardedServer&) = delete;
+    ShardedServer(ShardedServer&&) = delete;
+    ShardedServer& operator=(ShardedServer&&) = delete;
+
+    /**
+     * @brief 启动所有分片线程
+     */
+    void start();
+
+    /**
+     * @brief 关闭各分片的全部会话，再停止分片并等待线程退出
+     */
+    void stop();
+
+    [[nodiscard]] size_t shardCount() const noexcept;
+
+    /**
+     * @brief conv 所属的分片下标
+     */
+    [[nodiscard]] size_t shardOf(uint32_t conv) const noexcept;
+
+    /**
+     * @brief 实际监听端口
+     */
+    [[nodiscard]] uint16_t localPort() const;
+
+    /**
+     * @brief 是否由内核按 conv 直接分流（reuseport + 过滤器安装成功）
+     */
+    [[nodiscard]] bool kernelSteering() const noexcept;
+
+    /**
+     * @brief 被收包分片转发到其他分片的数据报总数
+     */
+    [[nodiscard]] uint64_t forwardedPackets() const noexcept;
+
+    /**
+     * @brief 所有分片端点指标之和（无锁读取，可在任意线程调用）
+     */
+    [[nodiscard]] EndpointMetrics metrics() const;
+
+    /**
+     * @brief 单个分片的端点指标
+     */
+    [[nodiscard]] EndpointMetrics shardMetrics(size_t shard) const;
+
+private:
+    // Pimpl 声明：隐藏 ASIO 实现细节
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,79 @@
+/**
+ * ************************************************************************
+ *
+ * @file KcpProfile.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief KCP 会话参数预设（turbo / normal / bulk）
+ *
+ * 不同业务对延迟与开销的取舍不同：出牌等实时操作用 turbo，聊天、房间列表用 normal，
+ * 大块数据（回放、资源同步）用 bulk。预设在创建会话时指定，也可运行时通过 KcpSession::setProfile 切换。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief KCP 会话参数
+ */
+struct KcpProfile
+{
+    bool nodelay = true;            // 无延迟模式：超时后 RTO 只增加一半而不是翻倍
+    uint32_t intervalMs = 10;       // 内部 flush 周期（KCP 限定在 10 ~ 5000 ms）
+    uint32_t fastResend = 2;        // 被跳过多少次 ACK 后快速重传，0 表示关闭
+    bool congestionControl = false; // 是否启用拥塞窗口
+    uint32_t sendWindow = 32;       // 发送窗口（段）
+    uint32_t recvWindow = 128;      // 接收窗口（段）
+    uint32_t mtu = 1400;            // 单个 UDP 数据报的最大字节数
+    uint32_t minRtoMs = 10;         // 最小重传超时
+
+    // 自适应周期：没有收发的会话每次 update 把周期翻倍直到 maxIntervalMs；一旦有收发、有未确认的段或待发的 ACK，
+    // 立即回到 intervalMs，重传不会被拉长的周期推迟
+    bool adaptiveInterval = false;
+    uint32_t maxIntervalMs = 100;
+
+    /**
+     * @brief 实时操作：nodelay(1, 10, 2, 1)，最小 RTO 10 ms（会话的默认参数）
+     */
+    static constexpr KcpProfile turbo() noexcept { return {}; }
+
+    /**
+     * @brief 一般交互：20 ms 周期、开启拥塞控制，最小 RTO 30 ms
+     */
+    static constexpr KcpProfile normal() noexcept
+    {
+        return {.nodelay = false,
+                .intervalMs = 20,
+                .fastResend = 2,
+                .congestionControl = true,
+                .sendWindow = 64,
+                .recvWindow = 128,
+                .minRtoMs = 30,
+                .adaptiveInterval = true,
+                .maxIntervalMs = 200};
+    }
+
+    /**
+     * @brief 大块数据：40 ms 周期、大窗口、开启拥塞控制，不做快速重传
+     */
+    static constexpr KcpProfile bulk() noexcept
+    {
+        return {.nodelay = false,
+                .intervalMs = 40,
+                .fastResend = 0,
+                .congestionControl = true,
+                .sendWindow = 256,
+                .recvWindow = 256,
+                .minRtoMs = 100,
+                .adaptiveInterval = true,
+                .maxIntervalMs = 400};
+    }
+
+    bool operator==(const KcpProfile&) const = default;
+};
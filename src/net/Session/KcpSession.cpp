@@ -14,40 +14,119 @@
  */
 
 #include "KcpSession.h"
+#include "../common/RingQueue.h"
+#include "../protocol/UnreliableHeader.h"
 #include <asio.hpp>
-#include <asio/experimental/channel.hpp>
+#include <asio/experimental/concurrent_channel.hpp>
 #include <ikcp.h>
+#include <algorithm>
+#include <array>
 #include <system_error>
 #include <atomic>
+#include <cstring>
 #include <queue>
 #include <mutex>
+#include <vector>
 
 namespace
 {
 constexpr size_t CHANNEL_CAPACITY = 64;
-constexpr int KCP_UPDATE_INTERVAL_MS = 10;
-constexpr int KCP_MIN_RTO_MS = 10;
-constexpr size_t RECV_BUFFER_SIZE = 2048;
+constexpr size_t STANDALONE_POOL_PREALLOCATED = 4;
+constexpr size_t KCP_SEGMENT_HEADER = 24; // conv(4) cmd(1) frg(1) wnd(2) ts(4) sn(4) una(4) len(4)
+constexpr uint8_t KCP_CMD_PUSH = 81;
+
+uint32_t loadLe32(const uint8_t* p) noexcept
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
 } // namespace
 
 // Pimpl 实现
 struct KcpSession::Impl
 {
+    uint32_t conv;
     ikcpcb* kcp{nullptr};
     IUdpTransport& transport;
     NetAddress peer;
-    asio::experimental::channel<asio::any_io_executor, void(std::error_code, Packet)> channel;
+    std::shared_ptr<PacketPool> pool;
+    asio::any_io_executor executor;
+    // 网络线程 try_send、任意线程 close、会话 strand 上 async_receive，须用带锁的 concurrent_channel
+    asio::experimental::basic_concurrent_channel<asio::any_io_executor,
+                                                 RingChannelTraits<>,
+                                                 void(std::error_code, Packet)>
+        channel;
+    WakeCallback wakeCallback;
+    std::vector<uint8_t> frameBatch; // 尚未提交给 KCP 的帧
+    std::optional<FrameCompression> frameCompression;
+
+    // 收件箱：send 与 queueSharedFrame 可来自任意线程，网络线程在 update/flush 时取出，
+    // 共享帧排入 frameBatch，send 的消息单独作为一条 KCP 消息提交；frameBatch 与 kcp 只在网络线程读写
+    struct OutboxEntry
+    {
+        SharedFrame bytes;
+        bool message = false; // true 表示 send 排入的独立消息，不与帧合并
+    };
+    std::mutex outboxMutex;
+    std::vector<OutboxEntry> outbox;
+    std::vector<OutboxEntry> outboxScratch;
+    std::atomic<bool> outboxPending{false};
+
+    // 不可靠通道：各通道的发送序号与已收到的最大序号，只在网络线程读写
+    std::array<uint32_t, UNRELIABLE_CHANNELS> unreliableSendSeq{};
+    std::array<uint32_t, UNRELIABLE_CHANNELS> unreliableRecvSeq{};
+    std::vector<uint8_t> unreliableBuffer;
+    std::atomic<uint64_t> unreliableIn{0};
+    std::atomic<uint64_t> unreliableOut{0};
+    std::atomic<uint64_t> unreliableStale{0};
     std::atomic<size_t> droppedPackets{0};
+
+    // 指标：计数只由网络线程写；channelDepth 由接收协程递减，使用原子 RMW
+    std::atomic<uint64_t> packetsIn{0};
+    std::atomic<uint64_t> bytesIn{0};
+    std::atomic<uint64_t> packetsOut{0};
+    std::atomic<uint64_t> bytesOut{0};
+    std::atomic<uint64_t> messagesIn{0};
+    std::atomic<uint64_t> messagesOut{0};
+    std::atomic<uint32_t> channelDepth{0};
+    std::atomic<uint32_t> rtt{0};
+    std::atomic<uint32_t> rttVar{0};
+    std::atomic<uint32_t> rto{0};
+    std::atomic<uint32_t> sendWindow{0};
+    std::atomic<uint32_t> recvWindow{0};
+    std::atomic<uint32_t> remoteWindow{0};
+    std::atomic<uint32_t> congestionWindow{0};
+    std::atomic<uint32_t> waitSend{0};
+    std::atomic<uint64_t> retransmits{0};
+    std::atomic<uint32_t> interval{0};
     std::atomic<bool> closed{false};
+    uint32_t nextNewSn = 0; // 尚未发出过的最小数据段序号
+
+    // 参数预设：profile 只在网络线程读写；setProfile 可来自任意线程，
+    // 先记入 requestedProfile，下一次 update/flush 时生效
+    KcpProfile profile;
+    std::mutex profileMutex;
+    KcpProfile requestedProfile;
+    std::atomic<bool> profilePending{false};
+    std::atomic<bool> active{false}; // 上次 update 以来是否有收发（自适应周期）
 
-    Impl(uint32_t conv, IUdpTransport& trans, const NetAddress& peerAddr, const asio::any_io_executor& exec)
-        : kcp(ikcp_create(conv, this)), transport(trans), peer(peerAddr), channel(exec, CHANNEL_CAPACITY)
+    Impl(uint32_t conv,
+         IUdpTransport& trans,
+         const NetAddress& peerAddr,
+         const asio::any_io_executor& exec,
+         std::shared_ptr<PacketPool> packetPool,
+         const KcpProfile& initialProfile)
+        : conv(conv), kcp(ikcp_create(conv, this)), transport(trans), peer(peerAddr),
+          pool(packetPool != nullptr
+                   ? std::move(packetPool)
+                   : std::make_shared<PacketPool>(PacketPool::DEFAULT_SLAB_SIZE, STANDALONE_POOL_PREALLOCATED)),
+          executor(exec), channel(exec, CHANNEL_CAPACITY), requestedProfile(initialProfile)
     {
         if (kcp != nullptr)
         {
             kcp->output = &Impl::kcpOutput;
-            ikcp_nodelay(kcp, 1, KCP_UPDATE_INTERVAL_MS, 2, 1);
-            kcp->rx_minrto = KCP_MIN_RTO_MS;
+            applyProfile(initialProfile);
+            publishKcpState();
         }
     }
 
@@ -74,33 +153,234 @@ struct KcpSession::Impl
 
         self->transport.send(self->peer,
                              std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(buf), static_cast<size_t>(len)));
+        detail::bump(self->packetsOut);
+        detail::bump(self->bytesOut, static_cast<uint64_t>(len));
+        self->countRetransmits(reinterpret_cast<const uint8_t*>(buf), static_cast<size_t>(len));
         return 0;
     }
 
-    // 协程接收
-    asio::awaitable<std::expected<Packet, std::error_code>> recvCoro()
+    // 统计重传段：序号早于 nextNewSn 的数据段都发过至少一次。ikcpcb::xmit 只计超时重传，不含快速重传
+    void countRetransmits(const uint8_t* data, size_t size) noexcept
     {
-        try
+        uint64_t resent = 0;
+        for (size_t offset = 0; offset + KCP_SEGMENT_HEADER <= size;)
         {
-            if (closed.load(std::memory_order_acquire))
+            const uint8_t* segment = data + offset;
+            if (segment[4] == KCP_CMD_PUSH)
             {
-                co_return std::unexpected(std::make_error_code(std::errc::operation_canceled));
+                const uint32_t sn = loadLe32(segment + 12);
+                if (static_cast<int32_t>(sn - nextNewSn) < 0)
+                {
+                    ++resent;
+                }
+                else
+                {
+                    nextNewSn = sn + 1;
+                }
             }
-            Packet data = co_await channel.async_receive(asio::use_awaitable);
-            co_return data;
+            offset += KCP_SEGMENT_HEADER + loadLe32(segment + 20);
+        }
+        if (resent != 0)
+        {
+            detail::bump(retransmits, resent);
+        }
+    }
+
+    void applyProfile(const KcpProfile& next)
+    {
+        ikcp_nodelay(kcp,
+                     next.nodelay ? 1 : 0,
+                     static_cast<int>(next.intervalMs),
+                     static_cast<int>(next.fastResend),
+                     next.congestionControl ? 0 : 1);
+        ikcp_wndsize(kcp, static_cast<int>(next.sendWindow), static_cast<int>(next.recvWindow));
+        ikcp_setmtu(kcp, static_cast<int>(next.mtu)); // 过小的 MTU 被 KCP 拒绝，保留原值
+        kcp->rx_minrto = static_cast<IINT32>(next.minRtoMs);
+        profile = next;
+    }
+
+    // 在网络线程上应用 setProfile 请求的参数
+    void applyRequestedProfile()
+    {
+        if (!profilePending.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+        KcpProfile next;
+        {
+            std::lock_guard lock(profileMutex);
+            next = requestedProfile;
+        }
+        applyProfile(next);
+    }
+
+    // 自适应周期：静默时逐次翻倍；有收发、有未确认的段或待发的 ACK 时回到基础周期，
+    // 否则丢失的段要等一个被拉长的周期才会在 flush 中重传，而不是在 RTO 到期时
+    void adaptInterval(uint32_t now)
+    {
+        if (!profile.adaptiveInterval)
+        {
+            return;
         }
-        catch (const std::system_error& e)
+        const bool busy =
+            active.exchange(false, std::memory_order_relaxed) || ikcp_waitsnd(kcp) > 0 || kcp->ackcount > 0;
+        const uint32_t next = busy ? profile.intervalMs : std::min(kcp->interval * 2, profile.maxIntervalMs);
+        ikcp_nodelay(kcp, -1, static_cast<int>(std::max(next, profile.intervalMs)), -1, -1); // 负值表示保持不变
+
+        // 周期缩短时把按旧周期排定的下一次 flush 提前
+        if (busy && kcp->updated != 0 && static_cast<int32_t>(kcp->ts_flush - (now + kcp->interval)) > 0)
         {
-            co_return std::unexpected(e.code());
+            kcp->ts_flush = now + kcp->interval;
         }
     }
+
+    // 把 KCP 内部状态发布到原子变量，供其他线程读取
+    void publishKcpState() noexcept
+    {
+        rtt.store(static_cast<uint32_t>(kcp->rx_srtt), std::memory_order_relaxed);
+        rttVar.store(static_cast<uint32_t>(kcp->rx_rttval), std::memory_order_relaxed);
+        rto.store(static_cast<uint32_t>(kcp->rx_rto), std::memory_order_relaxed);
+        sendWindow.store(kcp->snd_wnd, std::memory_order_relaxed);
+        recvWindow.store(kcp->rcv_wnd, std::memory_order_relaxed);
+        remoteWindow.store(kcp->rmt_wnd, std::memory_order_relaxed);
+        congestionWindow.store(kcp->cwnd, std::memory_order_relaxed);
+        waitSend.store(static_cast<uint32_t>(ikcp_waitsnd(kcp)), std::memory_order_relaxed);
+        interval.store(kcp->interval, std::memory_order_relaxed);
+    }
+
+    // 为即将追加的 frameSize 字节腾出批量缓冲：超过段数上限时先提交已有的帧
+    void reserveBatch(size_t frameSize)
+    {
+        const size_t batchLimit = static_cast<size_t>(kcp->mss) * MAX_FRAME_BATCH_SEGMENTS;
+        if (!frameBatch.empty() && frameBatch.size() + frameSize > batchLimit)
+        {
+            commitFrames();
+        }
+    }
+
+    // 任意线程：排入收件箱，收件箱由空变为非空时才唤醒，同一 tick 内的后续条目不再重复排队
+    void enqueue(OutboxEntry entry)
+    {
+        {
+            std::lock_guard lock(outboxMutex);
+            outbox.push_back(std::move(entry));
+        }
+        active.store(true, std::memory_order_relaxed);
+        if (!outboxPending.exchange(true, std::memory_order_release) && wakeCallback)
+        {
+            wakeCallback();
+        }
+    }
+
+    // 把收件箱按排入顺序交给 KCP：共享帧追加到批量缓冲，独立消息先提交已有的帧再单独发送，随后释放引用
+    void drainOutbox()
+    {
+        if (!outboxPending.exchange(false, std::memory_order_acquire))
+        {
+            return;
+        }
+        {
+            std::lock_guard lock(outboxMutex);
+            outboxScratch.swap(outbox);
+        }
+        if (outboxScratch.size() == 1 && frameBatch.empty())
+        {
+            // 常见情形：本 tick 只有一个广播帧或一条消息，直接交给 KCP，省去拷入批量缓冲
+            sendMessage(outboxScratch.front().bytes.bytes());
+            outboxScratch.clear();
+            return;
+        }
+        for (const auto& entry : outboxScratch)
+        {
+            if (entry.message)
+            {
+                commitFrames();
+                sendMessage(entry.bytes.bytes());
+                continue;
+            }
+            reserveBatch(entry.bytes.size());
+            frameBatch.insert(frameBatch.end(), entry.bytes.bytes().begin(), entry.bytes.bytes().end());
+        }
+        outboxScratch.clear();
+    }
+
+    void sendMessage(std::span<const uint8_t> bytes)
+    {
+        ikcp_send(kcp, reinterpret_cast<const char*>(bytes.data()), static_cast<int>(bytes.size()));
+        detail::bump(messagesOut);
+    }
+
+    void commitFrames()
+    {
+        if (frameBatch.empty())
+        {
+            return;
+        }
+        ikcp_send(kcp, reinterpret_cast<const char*>(frameBatch.data()), static_cast<int>(frameBatch.size()));
+        detail::bump(messagesOut);
+        frameBatch.clear();
+    }
+
+    // 把一条完整消息推入接收通道，通道满时丢弃并计数
+    void deliver(Packet packet)
+    {
+        // 先计入占用再投递：接收协程可能在其他线程上立即取走并递减
+        channelDepth.fetch_add(1, std::memory_order_relaxed);
+        if (!channel.try_send(std::error_code{}, std::move(packet)))
+        {
+            channelDepth.fetch_sub(1, std::memory_order_relaxed);
+            droppedPackets.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // 不可靠数据报：不经过 KCP，只保留比已收到的更新的一个，其余丢弃
+    void inputUnreliable(std::span<const uint8_t> data)
+    {
+        const auto header = parseUnreliableHeader(data);
+        if (!header || header->conv != conv) [[unlikely]]
+        {
+            return;
+        }
+        auto& last = unreliableRecvSeq[header->channel];
+        if (!isNewerSequence(header->sequence, last))
+        {
+            detail::bump(unreliableStale);
+            return;
+        }
+        last = header->sequence;
+
+        const auto frames = data.subspan(UNRELIABLE_HEADER_SIZE);
+        Packet packet = pool->acquire(frames.size());
+        std::ranges::copy(frames, packet.data());
+        detail::bump(unreliableIn);
+        deliver(std::move(packet));
+    }
+
+    // 协程接收
+    asio::awaitable<std::expected<Packet, std::error_code>> recvCoro()
+    {
+        if (closed.load(std::memory_order_acquire))
+        {
+            co_return std::unexpected(std::make_error_code(std::errc::operation_canceled));
+        }
+        std::error_code ec;
+        Packet data = co_await channel.async_receive(asio::redirect_error(asio::use_awaitable, ec));
+        if (ec)
+        {
+            co_return std::unexpected(ec);
+        }
+        channelDepth.fetch_sub(1, std::memory_order_relaxed);
+        co_return data;
+    }
 };
 
 KcpSession::KcpSession(uint32_t conv,
                        IUdpTransport& transport,
                        const NetAddress& peer,
-                       const asio::any_io_executor& exec)
-    : m_impl(std::make_unique<Impl>(conv, transport, peer, exec))
+                       const asio::any_io_executor& exec,
+                       std::shared_ptr<PacketPool> pool,
+                       const KcpProfile& profile)
+    : m_impl(std::make_unique<Impl>(conv, transport, peer, exec, std::move(pool), profile))
 {
 }
 
@@ -116,22 +396,38 @@ void KcpSession::input(std::span<const uint8_t> data)
         return;
     }
 
+    m_impl->active.store(true, std::memory_order_relaxed);
+    detail::bump(m_impl->packetsIn);
+    detail::bump(m_impl->bytesIn, data.size());
+    if (isUnreliableDatagram(data))
+    {
+        m_impl->inputUnreliable(data);
+        return;
+    }
+
     ikcp_input(m_impl->kcp, reinterpret_cast<const char*>(data.data()), static_cast<long>(data.size()));
 
-    // 提取完整包并推入通道
-    std::vector<uint8_t> recvBuffer(RECV_BUFFER_SIZE);
-    int bytesReceived = 0;
-    while ((bytesReceived = ikcp_recv(
-                m_impl->kcp, reinterpret_cast<char*>(recvBuffer.data()), static_cast<int>(recvBuffer.size()))) > 0)
+    // 提取完整包并推入通道：先查询消息大小再从池中取缓冲区，超过 slab 的消息由池走溢出分配
+    int messageSize = 0;
+    while ((messageSize = ikcp_peeksize(m_impl->kcp)) > 0)
     {
-        recvBuffer.resize(static_cast<size_t>(bytesReceived));
-        if (!m_impl->channel.try_send(std::error_code{}, recvBuffer))
+        Packet packet = m_impl->pool->acquire(static_cast<size_t>(messageSize));
+        const int bytesReceived = ikcp_recv(m_impl->kcp, reinterpret_cast<char*>(packet.data()), messageSize);
+        if (bytesReceived <= 0) [[unlikely]]
         {
-            m_impl->droppedPackets.fetch_add(1, std::memory_order_relaxed);
+            break;
         }
-        recvBuffer.clear();
-        recvBuffer.resize(RECV_BUFFER_SIZE);
+        packet.resize(static_cast<size_t>(bytesReceived));
+        detail::bump(m_impl->messagesIn);
+        m_impl->deliver(std::move(packet));
     }
+    m_impl->publishKcpState();
+}
+
+asio::awaitable<std::expected<KcpSession::Packet, std::error_code>> KcpSession::recv()
+{
+    auto self = shared_from_this(); // 等待期间保持会话存活
+    co_return co_await m_impl->recvCoro();
 }
 
 void KcpSession::recvAsync(RecvCallback callback)
@@ -153,24 +449,207 @@ void KcpSession::send(std::span<const uint8_t> data)
     {
         return;
     }
-    ikcp_send(m_impl->kcp, reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size()));
+    // 调用方可能不在网络线程：拷贝一份排入收件箱，由 update/flush 提交给 KCP
+    m_impl->enqueue({.bytes = SharedFrame::copyOf(data), .message = true});
+}
+
+std::expected<void, CodecError> KcpSession::queueFrame(uint16_t cmd, std::span<const uint8_t> payload)
+{
+    if (m_impl->kcp == nullptr || m_impl->closed.load(std::memory_order_acquire))
+    {
+        return std::unexpected(CodecError::SessionClosed);
+    }
+
+    const size_t frameSize = FRAME_HEADER_SIZE + payload.size();
+    m_impl->reserveBatch(frameSize);
+    auto& batch = m_impl->frameBatch;
+
+    // 直接在批量缓冲尾部编码，不经过中间缓冲区
+    const size_t offset = batch.size();
+    batch.resize(offset + frameSize);
+    const auto target = std::span<uint8_t>(batch).subspan(offset);
+    auto encoded = m_impl->frameCompression ? encodeFrame(target, cmd, payload, *m_impl->frameCompression)
+                                            : encodeFrame(target, cmd, payload);
+    if (!encoded) [[unlikely]]
+    {
+        batch.resize(offset);
+        return std::unexpected(encoded.error());
+    }
+    batch.resize(offset + encoded->size()); // 压缩帧比预留的短
+
+    m_impl->active.store(true, std::memory_order_relaxed);
+
+    // 本批的第一帧：通知 Endpoint 在下一次 update 中处理该会话
+    if (offset == 0 && m_impl->wakeCallback)
+    {
+        m_impl->wakeCallback();
+    }
+    return {};
+}
+
+std::expected<void, CodecError>
+    KcpSession::sendUnreliable(uint16_t cmd, std::span<const uint8_t> payload, uint8_t channel)
+{
+    if (m_impl->kcp == nullptr || m_impl->closed.load(std::memory_order_acquire))
+    {
+        return std::unexpected(CodecError::SessionClosed);
+    }
+    if (channel >= UNRELIABLE_CHANNELS) [[unlikely]]
+    {
+        return std::unexpected(CodecError::InvalidChannel);
+    }
+
+    // 数据报头之后直接编码帧，整个数据报只写一次
+    auto& buffer = m_impl->unreliableBuffer;
+    buffer.resize(UNRELIABLE_HEADER_SIZE + FRAME_HEADER_SIZE + payload.size());
+    const auto target = std::span<uint8_t>(buffer).subspan(UNRELIABLE_HEADER_SIZE);
+    auto encoded = m_impl->frameCompression ? encodeFrame(target, cmd, payload, *m_impl->frameCompression)
+                                            : encodeFrame(target, cmd, payload);
+    if (!encoded) [[unlikely]]
+    {
+        return std::unexpected(encoded.error());
+    }
+    const size_t size = UNRELIABLE_HEADER_SIZE + encoded->size();
+    if (size > m_impl->kcp->mtu) [[unlikely]]
+    {
+        return std::unexpected(CodecError::PayloadTooLarge);
+    }
+
+    const UnreliableHeader header{
+        .conv = m_impl->conv, .channel = channel, .sequence = ++m_impl->unreliableSendSeq[channel]};
+    std::memcpy(buffer.data(), &header, UNRELIABLE_HEADER_SIZE);
+    m_impl->transport.send(m_impl->peer, std::span<const uint8_t>(buffer.data(), size));
+    detail::bump(m_impl->packetsOut);
+    detail::bump(m_impl->bytesOut, static_cast<uint64_t>(size));
+    detail::bump(m_impl->unreliableOut);
+    return {};
+}
+
+bool KcpSession::queueSharedFrame(SharedFrame frame)
+{
+    if (m_impl->kcp == nullptr || m_impl->closed.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    m_impl->enqueue({.bytes = std::move(frame), .message = false});
+    return true;
+}
+
+void KcpSession::setFrameCompression(std::optional<FrameCompression> compression)
+{
+    m_impl->frameCompression = compression;
+}
+
+void KcpSession::commitFrames()
+{
+    if (m_impl->kcp != nullptr && !m_impl->closed.load(std::memory_order_acquire))
+    {
+        m_impl->drainOutbox();
+        m_impl->commitFrames();
+    }
+}
+
+size_t KcpSession::queuedFrameBytes() const noexcept
+{
+    return m_impl->frameBatch.size();
 }
 
 void KcpSession::update(uint32_t now)
 {
     if (m_impl->kcp != nullptr && !m_impl->closed.load(std::memory_order_acquire))
     {
+        m_impl->drainOutbox();
+        m_impl->commitFrames();
+        m_impl->adaptInterval(now);
+        m_impl->applyRequestedProfile();
         ikcp_update(m_impl->kcp, now);
+        m_impl->publishKcpState();
     }
 }
 
+void KcpSession::flush(uint32_t now)
+{
+    if (m_impl->kcp == nullptr || m_impl->closed.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    m_impl->drainOutbox();
+    m_impl->commitFrames();
+    m_impl->adaptInterval(now);
+    m_impl->applyRequestedProfile();
+    if (m_impl->kcp->updated == 0)
+    {
+        ikcp_update(m_impl->kcp, now);
+    }
+    else
+    {
+        // 与 ikcp_update 一致：本次 flush 后下一个周期从 now 起算，避免 ikcp_check 因落后的 ts_flush 反复判定到期
+        m_impl->kcp->current = now;
+        m_impl->kcp->ts_flush = now + m_impl->kcp->interval;
+        ikcp_flush(m_impl->kcp);
+    }
+    m_impl->publishKcpState();
+}
+
+const asio::any_io_executor& KcpSession::executor() const noexcept
+{
+    return m_impl->executor;
+}
+
+const NetAddress& KcpSession::peer() const noexcept
+{
+    return m_impl->peer;
+}
+
 uint32_t KcpSession::check(uint32_t now) const
 {
     if (m_impl->kcp == nullptr)
     {
         return now;
     }
-    return ikcp_check(m_impl->kcp, now);
+    // ikcp_update 只在 ts_flush 到达时 flush（重传也在 flush 中处理），ikcp_check 因重传到期给出的更早时间点
+    // 只会带来空转；周期被自适应拉长时尤其明显
+    const auto* kcp = m_impl->kcp;
+    const uint32_t next = ikcp_check(kcp, now);
+    if (kcp->updated != 0 && static_cast<int32_t>(kcp->ts_flush - next) > 0)
+    {
+        return kcp->ts_flush;
+    }
+    return next;
+}
+
+bool KcpSession::hasPendingOutput() const noexcept
+{
+    if (m_impl->kcp == nullptr)
+    {
+        return false;
+    }
+    return ikcp_waitsnd(m_impl->kcp) > 0 || m_impl->kcp->ackcount > 0 || m_impl->kcp->probe != 0 ||
+           !m_impl->frameBatch.empty() || m_impl->outboxPending.load(std::memory_order_relaxed);
+}
+
+void KcpSession::setProfile(const KcpProfile& profile)
+{
+    {
+        std::lock_guard lock(m_impl->profileMutex);
+        m_impl->requestedProfile = profile;
+    }
+    m_impl->profilePending.store(true, std::memory_order_release);
+    if (m_impl->wakeCallback)
+    {
+        m_impl->wakeCallback();
+    }
+}
+
+KcpProfile KcpSession::profile() const
+{
+    std::lock_guard lock(m_impl->profileMutex);
+    return m_impl->requestedProfile;
+}
+
+void KcpSession::setWakeCallback(WakeCallback callback)
+{
+    m_impl->wakeCallback = std::move(callback);
 }
 
 void KcpSession::close()
@@ -185,4 +664,33 @@ void KcpSession::close()
 size_t KcpSession::droppedPackets() const noexcept
 {
     return m_impl->droppedPackets.load(std::memory_order_relaxed);
-}
\ No newline at end of file
+}
+
+SessionMetrics KcpSession::metrics() const noexcept
+{
+    const auto& impl = *m_impl;
+    return SessionMetrics{
+        .conv = impl.conv,
+        .rttMs = impl.rtt.load(std::memory_order_relaxed),
+        .rttVarMs = impl.rttVar.load(std::memory_order_relaxed),
+        .rtoMs = impl.rto.load(std::memory_order_relaxed),
+        .sendWindow = impl.sendWindow.load(std::memory_order_relaxed),
+        .recvWindow = impl.recvWindow.load(std::memory_order_relaxed),
+        .remoteWindow = impl.remoteWindow.load(std::memory_order_relaxed),
+        .congestionWindow = impl.congestionWindow.load(std::memory_order_relaxed),
+        .waitSend = impl.waitSend.load(std::memory_order_relaxed),
+        .intervalMs = impl.interval.load(std::memory_order_relaxed),
+        .channelOccupancy = impl.channelDepth.load(std::memory_order_relaxed),
+        .retransmits = impl.retransmits.load(std::memory_order_relaxed),
+        .packetsIn = impl.packetsIn.load(std::memory_order_relaxed),
+        .bytesIn = impl.bytesIn.load(std::memory_order_relaxed),
+        .packetsOut = impl.packetsOut.load(std::memory_order_relaxed),
+        .bytesOut = impl.bytesOut.load(std::memory_order_relaxed),
+        .messagesIn = impl.messagesIn.load(std::memory_order_relaxed),
+        .messagesOut = impl.messagesOut.load(std::memory_order_relaxed),
+        .droppedMessages = impl.droppedPackets.load(std::memory_order_relaxed),
+        .unreliableIn = impl.unreliableIn.load(std::memory_order_relaxed),
+        .unreliableOut = impl.unreliableOut.load(std::memory_order_relaxed),
+        .unreliableStale = impl.unreliableStale.load(std::memory_order_relaxed),
+    };
+}
@@ -15,24 +15,28 @@
 #pragma once
 #include "../transport/IUdpTransport.h"
 #include "../common/NetAddress.h"
+#include "../common/PacketPool.h"
+#include "../common/NetMetrics.h"
+#include "../protocol/FrameCodec.h"
+#include "../protocol/SharedFrame.h"
+#include "KcpProfile.h"
+#include <asio/any_io_executor.hpp>
+#include <asio/awaitable.hpp>
 #include <expected>
 #include <span>
 #include <memory>
-#include <vector>
+#include <optional>
 #include <system_error>
 #include <functional>
 
-// 前向声明
-namespace asio
-{
-class any_io_executor;
-}
-
 class KcpSession : public std::enable_shared_from_this<KcpSession>
 {
 public:
-    using Packet = std::vector<uint8_t>;
+    using Packet = PacketBuffer; // 池化缓冲区，只可移动
     using RecvCallback = std::function<void(std::expected<Packet, std::error_code>)>;
+    using WakeCallback = std::function<void()>;
+
+    static constexpr size_t MAX_FRAME_BATCH_SEGMENTS = 16; // 单条批量消息最多占用的 KCP 段数
 
     /**
      * @brief 构造函数
@@ -40,8 +44,15 @@ public:
      * @param transport 底层 UDP 传输实现
      * @param peer 对端 UDP 地址
      * @param exec ASIO 执行器（内部使用）
+     * @param pool 接收缓冲池（通常由 Endpoint 持有并在会话间共享，为空时会话自建一个小池）
+     * @param profile KCP 参数预设
      */
-    KcpSession(uint32_t conv, IUdpTransport& transport, const NetAddress& peer, const asio::any_io_executor& exec);
+    KcpSession(uint32_t conv,
+               IUdpTransport& transport,
+               const NetAddress& peer,
+               const asio::any_io_executor& exec,
+               std::shared_ptr<PacketPool> pool = nullptr,
+               const KcpProfile& profile = KcpProfile::turbo());
 
     ~KcpSession();
 
@@ -56,6 +67,15 @@ public:
      */
     void input(std::span<const uint8_t> data);
 
+    /**
+     * @brief 异步接收一个 KCP 完整包（协程模式）
+     * 直接等待内部 channel，数据到达即恢复协程；会话关闭时返回 operation_canceled 等错误
+     * @code
+     *   while (auto packet = co_await session->recv()) { ... }
+     * @endcode
+     */
+    asio::awaitable<std::expected<Packet, std::error_code>> recv();
+
     /**
      * @brief 异步接收一个 KCP 完整包（回调模式）
      * @param callback 接收完成回调
@@ -63,10 +83,60 @@ public:
     void recvAsync(RecvCallback callback);
 
     /**
-     * @brief 发送数据
+     * @brief 发送一条独立的 KCP 消息，可在任意线程调用
+     *
+     * 数据拷贝一份排入收件箱，下一次 update/flush 时在网络线程提交给 KCP；与 send、queueSharedFrame
+     * 排入的内容按排入顺序发出。提交前会先提交批量缓冲中 queueFrame 的帧。
      */
     void send(std::span<const uint8_t> data);
 
+    /**
+     * @brief 将一帧（FrameHeader + 载荷）追加到批量缓冲
+     *
+     * 两次 update/flush 之间排入的帧合并为一条 KCP 消息发送，省去每帧一个 KCP 段的开销；
+     * 接收方用 decodeFrames 逐帧遍历。批量缓冲超过 MAX_FRAME_BATCH_SEGMENTS 个段时提前提交。
+     * 设置了 setFrameCompression 时，达到阈值的载荷压缩后再排入。
+     * @return 载荷超过帧长度上限时返回 PayloadTooLarge，会话已关闭时返回 SessionClosed
+     */
+    std::expected<void, CodecError> queueFrame(uint16_t cmd, std::span<const uint8_t> payload);
+
+    /**
+     * @brief 经不可靠有序通道发送一帧：不经过 KCP，直接作为一个 UDP 数据报发出
+     *
+     * 适合只关心最新值的数据（光标悬停、"正在选择"提示、心跳计时）：不重传、不受可靠流的队头阻塞，
+     * 接收端丢弃比同一通道已收到的更旧的数据报，交付的消息与可靠消息进入同一个接收通道，按帧解码即可。
+     * 设置了 setFrameCompression 时同样压缩。与 queueFrame 相同，在驱动会话的网络线程调用。
+     * @param channel 不可靠通道编号（0 ~ UNRELIABLE_CHANNELS - 1），各通道独立编号、互不丢弃
+     * @return 整个数据报超过 MTU 时返回 PayloadTooLarge，通道编号越界时返回 InvalidChannel，
+     *         会话已关闭时返回 SessionClosed
+     */
+    std::expected<void, CodecError> sendUnreliable(uint16_t cmd, std::span<const uint8_t> payload, uint8_t channel = 0);
+
+    /**
+     * @brief 排入一个已编码的共享帧（广播用），可在任意线程调用
+     *
+     * 只持有帧的引用，下一次 update/flush 时在网络线程追加到批量缓冲，与 queueFrame 的帧合并为一条 KCP 消息；
+     * 同一线程排入的共享帧保持先后顺序。帧已按发送方的压缩选项编码，不再经过 setFrameCompression。
+     * @return 会话已关闭时返回 false
+     */
+    bool queueSharedFrame(SharedFrame frame);
+
+    /**
+     * @brief 设置 queueFrame 的帧压缩选项，std::nullopt 关闭压缩（默认）
+     * @note 与 queueFrame 在同一线程调用；字典必须比会话活得久，且与对端 decodeFrames 使用的一致
+     */
+    void setFrameCompression(std::optional<FrameCompression> compression);
+
+    /**
+     * @brief 立即把批量缓冲中的帧作为一条 KCP 消息提交（update/flush 会自动调用）
+     */
+    void commitFrames();
+
+    /**
+     * @brief 批量缓冲中尚未提交的字节数
+     */
+    [[nodiscard]] size_t queuedFrameBytes() const noexcept;
+
     /**
      * @brief 主动关闭会话
      */
@@ -77,17 +147,62 @@ public:
      */
     [[nodiscard]] size_t droppedPackets() const noexcept;
 
+    /**
+     * @brief 会话指标快照（RTT/RTO、窗口、重传、收发量、通道占用）
+     * @note 无锁读取，可在任意线程调用；KCP 状态在每次 input/update/flush 后刷新
+     */
+    [[nodiscard]] SessionMetrics metrics() const noexcept;
+
     /**
      * @brief 更新 KCP 状态，需定期调用
      * @param now 当前时间戳（毫秒）
      */
     void update(uint32_t now);
 
+    /**
+     * @brief 立即发出待发送的数据与 ACK，不等待 KCP 的 interval 周期
+     * @param now 当前时间戳（毫秒）
+     */
+    void flush(uint32_t now);
+
+    /**
+     * @brief 会话使用的执行器（recvAsync 回调在其上执行，业务协程也可直接 co_spawn 到它上面）
+     */
+    [[nodiscard]] const asio::any_io_executor& executor() const noexcept;
+
+    /**
+     * @brief 对端 UDP 地址
+     */
+    [[nodiscard]] const NetAddress& peer() const noexcept;
+
     /**
      * @brief 获取下一次更新的时间点
      */
     [[nodiscard]] uint32_t check(uint32_t now) const;
 
+    /**
+     * @brief 是否还有待发送/待重传的数据或待回复的 ACK
+     * @note 返回 false 时会话处于静默状态，在收到数据或调用 send 之前无需 update
+     */
+    [[nodiscard]] bool hasPendingOutput() const noexcept;
+
+    /**
+     * @brief 切换 KCP 参数预设
+     * @note 可在任意线程调用，在下一次 update/flush 时于网络线程生效；MTU 变化只影响之后发送的消息
+     */
+    void setProfile(const KcpProfile& profile);
+
+    /**
+     * @brief 最近一次指定的参数预设
+     */
+    [[nodiscard]] KcpProfile profile() const;
+
+    /**
+     * @brief 设置唤醒回调：send 排入新数据后调用，通知 Endpoint 尽快 update 该会话
+     * @note 回调可能在调用 send 的任意线程上执行
+     */
+    void setWakeCallback(WakeCallback callback);
+
 private:
     // Pimpl 模式：隐藏 KCP 和 ASIO 实现
     struct Impl;
@@ -16,87 +16,77 @@
 #include "NetAddress.h"
 #include <asio.hpp>
 
-// Pimpl 实现
-struct NetAddress::Impl
+namespace
 {
-    asio::ip::udp::endpoint endpoint;
+using Endpoint = asio::ip::udp::endpoint;
 
-    Impl() = default;
+// endpoint(address, port) 从值初始化的 sockaddr 开始填充，未使用字节（sin_zero、flowinfo 等）均为 0
+void store(std::array<uint8_t, NetAddress::STORAGE_SIZE>& storage, const Endpoint& endpoint) noexcept
+{
+    const Endpoint canonical(endpoint.address(), endpoint.port());
+    static_assert(sizeof(asio::detail::sockaddr_in6_type) == NetAddress::STORAGE_SIZE);
+    storage.fill(0);
+    std::memcpy(storage.data(), canonical.data(), canonical.size());
+}
+} // namespace
 
-    explicit Impl(const asio::ip::udp::endpoint& ep) : endpoint(ep) {}
+NetAddress::NetAddress() noexcept
+{
+    store(m_storage, Endpoint(asio::ip::udp::v4(), 0));
+}
 
-    Impl(const std::string& ip, uint16_t port)
+NetAddress::NetAddress(const std::string& ip, uint16_t port)
+{
+    asio::error_code ec;
+    auto addr = asio::ip::make_address(ip, ec);
+    if (!ec)
     {
-        asio::error_code ec;
-        auto addr = asio::ip::make_address(ip, ec);
-        if (!ec)
-        {
-            endpoint = asio::ip::udp::endpoint(addr, port);
-        }
-        else
-        {
-            // 默认为 IPv4 的 0.0.0.0
-            endpoint = asio::ip::udp::endpoint(asio::ip::udp::v4(), port);
-        }
+        store(m_storage, Endpoint(addr, port));
     }
-};
-
-NetAddress::NetAddress() : m_impl(std::make_unique<Impl>()) {}
-
-NetAddress::NetAddress(const std::string& ip, uint16_t port) : m_impl(std::make_unique<Impl>(ip, port)) {}
-
-NetAddress::NetAddress(const asio::ip::udp::endpoint& endpoint) : m_impl(std::make_unique<Impl>(endpoint)) {}
-
-NetAddress::~NetAddress() = default;
-
-NetAddress::NetAddress(const NetAddress& other) : m_impl(std::make_unique<Impl>(other.m_impl->endpoint)) {}
-
-NetAddress& NetAddress::operator=(const NetAddress& other)
-{
-    if (this != &other)
+    else
     {
-        m_impl = std::make_unique<Impl>(other.m_impl->endpoint);
+        // 默认为 IPv4 的 0.0.0.0
+        store(m_storage, Endpoint(asio::ip::udp::v4(), port));
     }
-    return *this;
 }
 
-NetAddress::NetAddress(NetAddress&& other) noexcept = default;
-NetAddress& NetAddress::operator=(NetAddress&& other) noexcept = default;
-
-std::string NetAddress::ip() const
+NetAddress::NetAddress(const asio::ip::udp::endpoint& endpoint) noexcept
 {
-    return m_impl->endpoint.address().to_string();
+    store(m_storage, endpoint);
 }
 
-uint16_t NetAddress::port() const
+NetAddress NetAddress::fromSockaddr(const void* data, size_t size) noexcept
 {
-    return m_impl->endpoint.port();
+    Endpoint endpoint;
+    const size_t copied = std::min(size, STORAGE_SIZE);
+    std::memcpy(endpoint.data(), data, copied);
+    return NetAddress(endpoint);
 }
 
-std::string NetAddress::toString() const
+std::string NetAddress::ip() const
 {
-    return ip() + ":" + std::to_string(port());
+    return toAsioEndpoint().address().to_string();
 }
 
-const asio::ip::udp::endpoint& NetAddress::toAsioEndpoint() const
+uint16_t NetAddress::port() const noexcept
 {
-    return m_impl->endpoint;
+    return toAsioEndpoint().port();
 }
 
-bool NetAddress::operator==(const NetAddress& other) const
+std::string NetAddress::toString() const
 {
-    return m_impl->endpoint == other.m_impl->endpoint;
+    return ip() + ":" + std::to_string(port());
 }
 
-bool NetAddress::operator!=(const NetAddress& other) const
+asio::ip::udp::endpoint NetAddress::toAsioEndpoint() const noexcept
 {
-    return !(*this == other);
+    // endpoint 按 sa_family 判断 IPv4 / IPv6，拷贝完整存储即可
+    Endpoint endpoint;
+    std::memcpy(endpoint.data(), m_storage.data(), STORAGE_SIZE);
+    return endpoint;
 }
 
-size_t NetAddress::hash() const noexcept
+size_t NetAddress::sockaddrSize() const noexcept
 {
-    // 组合 IP 和端口的哈希值
-    size_t h1 = std::hash<std::string>{}(m_impl->endpoint.address().to_string());
-    size_t h2 = std::hash<uint16_t>{}(m_impl->endpoint.port());
-    return h1 ^ (h2 << 1);
+    return toAsioEndpoint().size();
 }
@@ -14,9 +14,13 @@
  */
 
 #pragma once
-#include <string>
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <memory>
+#include <cstring>
+#include <string>
+#include <type_traits>
 
 // 前向声明，避免在头文件中包含 ASIO
 namespace asio::ip
@@ -29,14 +33,19 @@ using udp_endpoint = basic_endpoint<udp>;
 
 /**
  * @brief 网络地址封装，隔离底层传输层实现细节
+ *
+ * 内联保存 28 字节的 sockaddr（sockaddr_in / sockaddr_in6），可平凡拷贝，构造、拷贝、比较、哈希均不分配内存。
+ * 未使用的尾部字节始终为 0，因此相等比较与哈希可直接按字节进行。
  */
 class NetAddress
 {
 public:
+    static constexpr size_t STORAGE_SIZE = 28; // sizeof(sockaddr_in6)
+
     /**
-     * @brief 默认构造函数
+     * @brief 默认构造函数（IPv4 0.0.0.0:0）
      */
-    NetAddress();
+    NetAddress() noexcept;
 
     /**
      * @brief 从 IP 地址和端口构造
@@ -48,15 +57,14 @@ public:
     /**
      * @brief 从 ASIO endpoint 构造（内部使用）
      */
-    explicit NetAddress(const asio::ip::udp_endpoint& endpoint);
+    explicit NetAddress(const asio::ip::udp_endpoint& endpoint) noexcept;
 
-    ~NetAddress();
-
-    // 支持拷贝和移动
-    NetAddress(const NetAddress& other);
-    NetAddress& operator=(const NetAddress& other);
-    NetAddress(NetAddress&& other) noexcept;
-    NetAddress& operator=(NetAddress&& other) noexcept;
+    /**
+     * @brief 从系统调用返回的 sockaddr 构造（recvmmsg 等，内部使用）
+     * @param data sockaddr 起始地址
+     * @param size sockaddr 长度（msg_namelen）
+     */
+    static NetAddress fromSockaddr(const void* data, size_t size) noexcept;
 
     /**
      * @brief 获取 IP 地址字符串
@@ -66,7 +74,7 @@ public:
     /**
      * @brief 获取端口号
      */
-    [[nodiscard]] uint16_t port() const;
+    [[nodiscard]] uint16_t port() const noexcept;
 
     /**
      * @brief 获取地址的字符串表示（格式：ip:port）
@@ -76,25 +84,49 @@ public:
     /**
      * @brief 转换为 ASIO endpoint（内部使用）
      */
-    [[nodiscard]] const asio::ip::udp_endpoint& toAsioEndpoint() const;
+    [[nodiscard]] asio::ip::udp_endpoint toAsioEndpoint() const noexcept;
+
+    /**
+     * @brief 原始 sockaddr，可直接用于 sendto / sendmmsg 的 msg_name（内部使用）
+     */
+    [[nodiscard]] const void* sockaddrData() const noexcept { return m_storage.data(); }
+
+    /**
+     * @brief 原始 sockaddr 的有效长度（IPv4 16 字节，IPv6 28 字节）
+     */
+    [[nodiscard]] size_t sockaddrSize() const noexcept;
 
     /**
      * @brief 比较运算符
      */
-    bool operator==(const NetAddress& other) const;
-    bool operator!=(const NetAddress& other) const;
+    bool operator==(const NetAddress& other) const noexcept
+    {
+        return std::memcmp(m_storage.data(), other.m_storage.data(), STORAGE_SIZE) == 0;
+    }
 
     /**
-     * @brief 支持 std::hash（用于 unordered_map）
+     * @brief 支持 std::hash（用于 unordered_map），O(1)：按 8 字节分块混合
      */
-    [[nodiscard]] size_t hash() const noexcept;
+    [[nodiscard]] size_t hash() const noexcept
+    {
+        uint64_t h = 0x9E3779B97F4A7C15ULL;
+        for (size_t offset = 0; offset < STORAGE_SIZE; offset += sizeof(uint64_t))
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, m_storage.data() + offset, std::min(sizeof(word), STORAGE_SIZE - offset));
+            h = (h ^ word) * 0xFF51AFD7ED558CCDULL;
+            h ^= h >> 32;
+        }
+        return static_cast<size_t>(h);
+    }
 
 private:
-    // Pimpl 模式：隐藏 ASIO 实现
-    struct Impl;
-    std::unique_ptr<Impl> m_impl;
+    alignas(4) std::array<uint8_t, STORAGE_SIZE> m_storage{};
 };
 
+static_assert(sizeof(NetAddress) == NetAddress::STORAGE_SIZE);
+static_assert(std::is_trivially_copyable_v<NetAddress>);
+
 // std::hash 特化
 namespace std
 {
@@ -0,0 +1,102 @@
+/**
+ * ************************************************************************
+ *
+ * @file NetMetrics.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 网络指标的汇总与 JSON 导出
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include "NetMetrics.h"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+nlohmann::json toJsonObject(const SessionMetrics& m)
+{
+    return {
+        {"conv", m.conv},
+        {"rttMs", m.rttMs},
+        {"rttVarMs", m.rttVarMs},
+        {"rtoMs", m.rtoMs},
+        {"sendWindow", m.sendWindow},
+        {"recvWindow", m.recvWindow},
+        {"remoteWindow", m.remoteWindow},
+        {"congestionWindow", m.congestionWindow},
+        {"waitSend", m.waitSend},
+        {"intervalMs", m.intervalMs},
+        {"channelOccupancy", m.channelOccupancy},
+        {"retransmits", m.retransmits},
+        {"packetsIn", m.packetsIn},
+        {"bytesIn", m.bytesIn},
+        {"packetsOut", m.packetsOut},
+        {"bytesOut", m.bytesOut},
+        {"messagesIn", m.messagesIn},
+        {"messagesOut", m.messagesOut},
+        {"droppedMessages", m.droppedMessages},
+        {"unreliableIn", m.unreliableIn},
+        {"unreliableOut", m.unreliableOut},
+        {"unreliableStale", m.unreliableStale},
+    };
+}
+
+nlohmann::json toJsonObject(const EndpointMetrics& m)
+{
+    return {
+        {"activeSessions", m.activeSessions},
+        {"sessionsOpened", m.sessionsOpened},
+        {"sessionsClosed", m.sessionsClosed},
+        {"packetsIn", m.packetsIn},
+        {"bytesIn", m.bytesIn},
+        {"packetsRejected", m.packetsRejected},
+        {"updates", m.updates},
+        {"sessionsServiced", m.sessionsServiced},
+        {"lastUpdateNs", m.lastUpdateNs},
+        {"maxUpdateNs", m.maxUpdateNs},
+        {"totalUpdateNs", m.totalUpdateNs},
+    };
+}
+} // namespace
+
+EndpointMetrics& EndpointMetrics::operator+=(const EndpointMetrics& other) noexcept
+{
+    activeSessions += other.activeSessions;
+    sessionsOpened += other.sessionsOpened;
+    sessionsClosed += other.sessionsClosed;
+    packetsIn += other.packetsIn;
+    bytesIn += other.bytesIn;
+    packetsRejected += other.packetsRejected;
+    updates += other.updates;
+    sessionsServiced += other.sessionsServiced;
+    lastUpdateNs = std::max(lastUpdateNs, other.lastUpdateNs);
+    maxUpdateNs = std::max(maxUpdateNs, other.maxUpdateNs);
+    totalUpdateNs += other.totalUpdateNs;
+    return *this;
+}
+
+std::string toJson(const SessionMetrics& metrics, int indent)
+{
+    return toJsonObject(metrics).dump(indent);
+}
+
+std::string toJson(const EndpointMetrics& metrics, int indent)
+{
+    return toJsonObject(metrics).dump(indent);
+}
+
+std::string toJson(const EndpointMetrics& endpoint, std::span<const SessionMetrics> sessions, int indent)
+{
+    nlohmann::json array = nlohmann::json::array();
+    for (const auto& session : sessions)
+    {
+        array.push_back(toJsonObject(session));
+    }
+    return nlohmann::json{{"endpoint", toJsonObject(endpoint)}, {"sessions", std::move(array)}}.dump(indent);
+}
@@ -0,0 +1,153 @@
+/**
+ * ************************************************************************
+ *
+ * @file NetMetrics.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 网络指标：会话 / 端点计数器与快照
+ *
+ * 计数器由网络线程单写（relaxed load + store，无 RMW 开销），任意线程可随时读取快照，
+ * 不加锁、不阻塞网络线程。快照是普通结构体，可直接记录日志或导出为 JSON。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+
+/**
+ * @brief 单个会话的指标快照
+ */
+struct SessionMetrics
+{
+    uint32_t conv = 0;
+    uint32_t rttMs = 0;            // 平滑 RTT（ikcpcb::rx_srtt）
+    uint32_t rttVarMs = 0;         // RTT 偏差（ikcpcb::rx_rttval）
+    uint32_t rtoMs = 0;            // 重传超时（ikcpcb::rx_rto）
+    uint32_t sendWindow = 0;       // 本端发送窗口
+    uint32_t recvWindow = 0;       // 本端接收窗口
+    uint32_t remoteWindow = 0;     // 对端通告的接收窗口
+    uint32_t congestionWindow = 0; // 拥塞窗口
+    uint32_t waitSend = 0;         // 待发送 + 待确认的段数
+    uint32_t intervalMs = 0;       // 当前 flush 周期（自适应模式下随负载变化）
+    uint32_t channelOccupancy = 0; // 已交付但业务尚未取走的消息数
+    uint64_t retransmits = 0;      // 累计重传段数（超时重传 + 快速重传）
+    uint64_t packetsIn = 0;        // 收到的 UDP 数据报
+    uint64_t bytesIn = 0;
+    uint64_t packetsOut = 0;       // 发出的 UDP 数据报
+    uint64_t bytesOut = 0;
+    uint64_t messagesIn = 0;       // 交付给业务的 KCP 消息
+    uint64_t messagesOut = 0;      // 提交给 KCP 的消息
+    uint64_t droppedMessages = 0;  // 因通道满而丢弃的消息
+    uint64_t unreliableIn = 0;     // 交付给业务的不可靠数据报
+    uint64_t unreliableOut = 0;    // 发出的不可靠数据报
+    uint64_t unreliableStale = 0;  // 因不比已收到的更新而丢弃的不可靠数据报（乱序、重复）
+};
+
+/**
+ * @brief 端点（一个网络线程）的指标快照
+ */
+struct EndpointMetrics
+{
+    uint64_t activeSessions = 0;
+    uint64_t sessionsOpened = 0;
+    uint64_t sessionsClosed = 0;
+    uint64_t packetsIn = 0;
+    uint64_t bytesIn = 0;
+    uint64_t packetsRejected = 0;  // 过短无法识别 conv、或被端点拒绝（未握手的 conv、握手校验失败）的数据报
+    uint64_t updates = 0;          // update 调用次数
+    uint64_t sessionsServiced = 0; // update 中被处理（到期或唤醒）的会话累计数
+    uint64_t lastUpdateNs = 0;     // 最近一次 update 耗时
+    uint64_t maxUpdateNs = 0;
+    uint64_t totalUpdateNs = 0;
+
+    // 汇总多个端点（如 ShardedServer 的各分片）：计数相加，lastUpdateNs / maxUpdateNs 取最大值
+    EndpointMetrics& operator+=(const EndpointMetrics& other) noexcept;
+};
+
+namespace detail
+{
+// 单写者计数：写端只有网络线程，避免 fetch_add 的总线锁
+inline void bump(std::atomic<uint64_t>& counter, uint64_t delta = 1) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+} // namespace detail
+
+/**
+ * @brief 端点计数器（网络线程写，任意线程读）
+ */
+class EndpointCounters
+{
+public:
+    void packetIn(size_t bytes) noexcept
+    {
+        detail::bump(m_packetsIn);
+        detail::bump(m_bytesIn, bytes);
+    }
+    void packetRejected() noexcept { detail::bump(m_packetsRejected); }
+    void sessionOpened() noexcept { detail::bump(m_sessionsOpened); }
+    void sessionClosed() noexcept { detail::bump(m_sessionsClosed); }
+    void sessionServiced() noexcept { detail::bump(m_sessionsServiced); }
+    void setActiveSessions(size_t count) noexcept { m_activeSessions.store(count, std::memory_order_relaxed); }
+
+    void updateFinished(uint64_t elapsedNs) noexcept
+    {
+        detail::bump(m_updates);
+        detail::bump(m_totalUpdateNs, elapsedNs);
+        m_lastUpdateNs.store(elapsedNs, std::memory_order_relaxed);
+        if (elapsedNs > m_maxUpdateNs.load(std::memory_order_relaxed))
+        {
+            m_maxUpdateNs.store(elapsedNs, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] EndpointMetrics snapshot() const noexcept
+    {
+        return EndpointMetrics{
+            .activeSessions = m_activeSessions.load(std::memory_order_relaxed),
+            .sessionsOpened = m_sessionsOpened.load(std::memory_order_relaxed),
+            .sessionsClosed = m_sessionsClosed.load(std::memory_order_relaxed),
+            .packetsIn = m_packetsIn.load(std::memory_order_relaxed),
+            .bytesIn = m_bytesIn.load(std::memory_order_relaxed),
+            .packetsRejected = m_packetsRejected.load(std::memory_order_relaxed),
+            .updates = m_updates.load(std::memory_order_relaxed),
+            .sessionsServiced = m_sessionsServiced.load(std::memory_order_relaxed),
+            .lastUpdateNs = m_lastUpdateNs.load(std::memory_order_relaxed),
+            .maxUpdateNs = m_maxUpdateNs.load(std::memory_order_relaxed),
+            .totalUpdateNs = m_totalUpdateNs.load(std::memory_order_relaxed),
+        };
+    }
+
+private:
+    std::atomic<uint64_t> m_activeSessions{0};
+    std::atomic<uint64_t> m_sessionsOpened{0};
+    std::atomic<uint64_t> m_sessionsClosed{0};
+    std::atomic<uint64_t> m_packetsIn{0};
+    std::atomic<uint64_t> m_bytesIn{0};
+    std::atomic<uint64_t> m_packetsRejected{0};
+    std::atomic<uint64_t> m_updates{0};
+    std::atomic<uint64_t> m_sessionsServiced{0};
+    std::atomic<uint64_t> m_lastUpdateNs{0};
+    std::atomic<uint64_t> m_maxUpdateNs{0};
+    std::atomic<uint64_t> m_totalUpdateNs{0};
+};
+
+/**
+ * @brief 导出为 JSON 字符串
+ * @param indent 缩进空格数，-1 表示紧凑单行（适合逐行写日志）
+ */
+std::string toJson(const SessionMetrics& metrics, int indent = -1);
+std::string toJson(const EndpointMetrics& metrics, int indent = -1);
+
+/**
+ * @brief 端点指标连同各会话指标一起导出：{"endpoint": {...}, "sessions": [...]}
+ */
+std::string toJson(const EndpointMetrics& endpoint, std::span<const SessionMetrics> sessions, int indent = -1);
@@ -0,0 +1,175 @@
+/**
+ * ************************************************************************
+ *
+ * @file PacketPool.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 数据包缓冲池实现
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include "PacketPool.h"
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace detail
+{
+/**
+ * @brief slab 的实际持有者，生命周期可长于 PacketPool
+ *
+ * PacketPool 析构时只标记 closed，仍在外的 slab 归还时直接释放，
+ * 最后一个 slab 释放后 arena 自行销毁。
+ */
+struct PacketArena
+{
+    std::mutex mutex;
+    std::vector<PacketSlab*> freeList;
+    size_t liveSlabs = 0; // 空闲 + 在外的 slab 总数
+    bool closed = false;
+    uint32_t slabSize = 0;
+
+    std::atomic<uint64_t> acquired{0};
+    std::atomic<uint64_t> overflow{0};
+    std::atomic<uint64_t> slabsAllocated{0};
+};
+} // namespace detail
+
+namespace
+{
+detail::PacketSlab* allocateSlab(uint32_t capacity, detail::PacketArena* arena)
+{
+    void* memory = ::operator new(sizeof(detail::PacketSlab) + capacity);
+    auto* slab = new (memory) detail::PacketSlab();
+    slab->capacity = capacity;
+    slab->arena = arena;
+    return slab;
+}
+
+void freeSlab(detail::PacketSlab* slab) noexcept
+{
+    slab->~PacketSlab();
+    ::operator delete(slab);
+}
+
+// 在持有 arena 锁的前提下新增一个 slab，保证空闲表容量足以容纳全部 slab，归还时不会再分配
+detail::PacketSlab* growLocked(detail::PacketArena& arena)
+{
+    auto* slab = allocateSlab(arena.slabSize, &arena);
+    ++arena.liveSlabs;
+    arena.freeList.reserve(arena.liveSlabs);
+    arena.slabsAllocated.fetch_add(1, std::memory_order_relaxed);
+    return slab;
+}
+} // namespace
+
+void PacketBuffer::release() noexcept
+{
+    detail::PacketSlab* slab = m_slab;
+    m_slab = nullptr;
+    m_size = 0;
+    if (slab == nullptr || slab->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    detail::PacketArena* arena = slab->arena;
+    if (arena == nullptr)
+    {
+        freeSlab(slab);
+        return;
+    }
+
+    bool destroyArena = false;
+    {
+        std::lock_guard lock(arena->mutex);
+        if (!arena->closed)
+        {
+            arena->freeList.push_back(slab);
+            return;
+        }
+        freeSlab(slab);
+        destroyArena = --arena->liveSlabs == 0;
+    }
+    if (destroyArena)
+    {
+        delete arena;
+    }
+}
+
+PacketPool::PacketPool(size_t slabSize, size_t preallocate) : m_arena(new detail::PacketArena())
+{
+    m_arena->slabSize = static_cast<uint32_t>(slabSize);
+    std::lock_guard lock(m_arena->mutex);
+    for (size_t i = 0; i < preallocate; ++i)
+    {
+        m_arena->freeList.push_back(growLocked(*m_arena));
+    }
+}
+
+PacketPool::~PacketPool()
+{
+    bool destroyArena = false;
+    {
+        std::lock_guard lock(m_arena->mutex);
+        m_arena->closed = true;
+        for (auto* slab : m_arena->freeList)
+        {
+            freeSlab(slab);
+        }
+        m_arena->liveSlabs -= m_arena->freeList.size();
+        m_arena->freeList.clear();
+        destroyArena = m_arena->liveSlabs == 0;
+    }
+    if (destroyArena)
+    {
+        delete m_arena;
+    }
+}
+
+PacketBuffer PacketPool::acquire(size_t size)
+{
+    m_arena->acquired.fetch_add(1, std::memory_order_relaxed);
+
+    // 溢出路径：超大消息单独分配，释放时直接归还系统
+    if (size > m_arena->slabSize) [[unlikely]]
+    {
+        m_arena->overflow.fetch_add(1, std::memory_order_relaxed);
+        return PacketBuffer(allocateSlab(static_cast<uint32_t>(size), nullptr), size);
+    }
+
+    detail::PacketSlab* slab = nullptr;
+    {
+        std::lock_guard lock(m_arena->mutex);
+        if (m_arena->freeList.empty()) [[unlikely]]
+        {
+            slab = growLocked(*m_arena);
+        }
+        else
+        {
+            slab = m_arena->freeList.back();
+            m_arena->freeList.pop_back();
+        }
+    }
+    slab->refs.store(1, std::memory_order_relaxed);
+    return PacketBuffer(slab, size);
+}
+
+size_t PacketPool::slabSize() const noexcept
+{
+    return m_arena->slabSize;
+}
+
+PacketPool::Stats PacketPool::stats() const noexcept
+{
+    return {
+        .acquired = m_arena->acquired.load(std::memory_order_relaxed),
+        .overflow = m_arena->overflow.load(std::memory_order_relaxed),
+        .slabsAllocated = m_arena->slabsAllocated.load(std::memory_order_relaxed),
+    };
+}
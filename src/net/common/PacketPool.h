@@ -0,0 +1,154 @@
+/**
+ * ************************************************************************
+ *
+ * @file PacketPool.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 数据包缓冲池：固定大小 slab + 引用计数句柄
+ *
+ * 接收路径从池中取出 slab 承载一个完整的 KCP 消息，句柄只可移动，
+ * 析构时 slab 自动归还；超过 slab 大小的消息走溢出路径单独分配。
+ * 池可以先于句柄销毁，未归还的 slab 在最后一个句柄释放时回收。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace detail
+{
+struct PacketArena;
+
+/**
+ * @brief slab 头部，载荷紧随其后分配
+ */
+struct PacketSlab
+{
+    std::atomic<uint32_t> refs{1};
+    uint32_t capacity = 0;
+    PacketArena* arena = nullptr; // 为空表示溢出分配，释放时直接归还系统
+
+    [[nodiscard]] uint8_t* bytes() noexcept { return reinterpret_cast<uint8_t*>(this + 1); } // NOLINT
+};
+} // namespace detail
+
+/**
+ * @brief 池化数据包缓冲区（只可移动，可显式共享）
+ */
+class PacketBuffer
+{
+public:
+    PacketBuffer() noexcept = default;
+    ~PacketBuffer() { release(); }
+
+    PacketBuffer(const PacketBuffer&) = delete;
+    PacketBuffer& operator=(const PacketBuffer&) = delete;
+
+    PacketBuffer(PacketBuffer&& other) noexcept : m_slab(other.m_slab), m_size(other.m_size)
+    {
+        other.m_slab = nullptr;
+        other.m_size = 0;
+    }
+
+    PacketBuffer& operator=(PacketBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_slab = other.m_slab;
+            m_size = other.m_size;
+            other.m_slab = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 共享同一块缓冲区（引用计数 +1），共享后的内容应视为只读
+     */
+    [[nodiscard]] PacketBuffer share() const noexcept
+    {
+        if (m_slab != nullptr)
+        {
+            m_slab->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        return PacketBuffer(m_slab, m_size);
+    }
+
+    [[nodiscard]] uint8_t* data() noexcept { return m_slab != nullptr ? m_slab->bytes() : nullptr; }
+    [[nodiscard]] const uint8_t* data() const noexcept { return m_slab != nullptr ? m_slab->bytes() : nullptr; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return m_slab != nullptr ? m_slab->capacity : 0; }
+
+    /**
+     * @brief 调整有效长度（不超过容量，不会重新分配）
+     */
+    void resize(size_t size) noexcept { m_size = size <= capacity() ? size : capacity(); }
+
+    [[nodiscard]] const uint8_t* begin() const noexcept { return data(); }
+    [[nodiscard]] const uint8_t* end() const noexcept { return data() + m_size; }
+
+    [[nodiscard]] std::span<uint8_t> span() noexcept { return {data(), m_size}; }
+    [[nodiscard]] std::span<const uint8_t> span() const noexcept { return {data(), m_size}; }
+    operator std::span<const uint8_t>() const noexcept { return span(); } // NOLINT
+
+private:
+    friend class PacketPool;
+
+    PacketBuffer(detail::PacketSlab* slab, size_t size) noexcept : m_slab(slab), m_size(size) {}
+
+    void release() noexcept;
+
+    detail::PacketSlab* m_slab = nullptr;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief 数据包缓冲池（线程安全，归还可发生在任意线程）
+ */
+class PacketPool
+{
+public:
+    static constexpr size_t DEFAULT_SLAB_SIZE = 2048;
+    static constexpr size_t DEFAULT_PREALLOCATED = 64;
+
+    struct Stats
+    {
+        uint64_t acquired = 0;       // 总获取次数
+        uint64_t overflow = 0;       // 超过 slab 大小、走溢出分配的次数
+        uint64_t slabsAllocated = 0; // 池内 slab 的累计分配次数（稳态下不再增长）
+    };
+
+    /**
+     * @param slabSize 每个 slab 的载荷容量
+     * @param preallocate 预先分配的 slab 数量
+     */
+    explicit PacketPool(size_t slabSize = DEFAULT_SLAB_SIZE, size_t preallocate = DEFAULT_PREALLOCATED);
+    ~PacketPool();
+
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+    PacketPool(PacketPool&&) = delete;
+    PacketPool& operator=(PacketPool&&) = delete;
+
+    /**
+     * @brief 获取一个容量至少为 size 的缓冲区，有效长度初始化为 size
+     */
+    [[nodiscard]] PacketBuffer acquire(size_t size);
+
+    [[nodiscard]] size_t slabSize() const noexcept;
+
+    [[nodiscard]] Stats stats() const noexcept;
+
+private:
+    detail::PacketArena* m_arena;
+};
@@ -0,0 +1,149 @@
+/**
+ * ************************************************************************
+ *
+ * @file RingQueue.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 可增长环形队列，以及以其为缓冲容器的 asio channel traits
+ *
+ * asio channel 默认用 std::deque 缓存未被取走的消息，deque 在头尾推进时
+ * 会反复申请/释放块。环形队列容量只增不减，稳态收发不再分配内存。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <asio/experimental/channel_traits.hpp>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+/**
+ * @brief 可增长的环形队列（容量为 2 的幂，满时翻倍）
+ */
+template <typename T>
+class RingQueue
+{
+public:
+    RingQueue() noexcept = default;
+
+    ~RingQueue()
+    {
+        clear();
+        deallocate();
+    }
+
+    RingQueue(const RingQueue&) = delete;
+    RingQueue& operator=(const RingQueue&) = delete;
+
+    RingQueue(RingQueue&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_capacity(std::exchange(other.m_capacity, 0)),
+          m_head(std::exchange(other.m_head, 0)), m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    RingQueue& operator=(RingQueue&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            deallocate();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_head = std::exchange(other.m_head, 0);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    void push_back(T&& value) // NOLINT(readability-identifier-naming)：与 std 容器接口保持一致
+    {
+        if (m_size == m_capacity)
+        {
+            grow();
+        }
+        std::construct_at(m_data + ((m_head + m_size) & (m_capacity - 1)), std::move(value));
+        ++m_size;
+    }
+
+    T& front() noexcept { return m_data[m_head]; }
+
+    void pop_front() noexcept // NOLINT(readability-identifier-naming)
+    {
+        std::destroy_at(m_data + m_head);
+        m_head = (m_head + 1) & (m_capacity - 1);
+        --m_size;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+    void clear() noexcept
+    {
+        while (m_size > 0)
+        {
+            pop_front();
+        }
+        m_head = 0;
+    }
+
+private:
+    static constexpr size_t INITIAL_CAPACITY = 8;
+
+    void grow()
+    {
+        const size_t newCapacity = m_capacity == 0 ? INITIAL_CAPACITY : m_capacity * 2;
+        T* newData = std::allocator<T>().allocate(newCapacity);
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            T* source = m_data + ((m_head + i) & (m_capacity - 1));
+            std::construct_at(newData + i, std::move(*source));
+            std::destroy_at(source);
+        }
+        deallocate();
+        m_data = newData;
+        m_capacity = newCapacity;
+        m_head = 0;
+    }
+
+    void deallocate() noexcept
+    {
+        if (m_data != nullptr)
+        {
+            std::allocator<T>().deallocate(m_data, m_capacity);
+            m_data = nullptr;
+        }
+    }
+
+    T* m_data = nullptr;
+    size_t m_capacity = 0;
+    size_t m_head = 0;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief 使用 RingQueue 作为缓冲容器的 channel traits
+ *
+ * 用法：asio::experimental::basic_channel / basic_concurrent_channel<Executor, RingChannelTraits<>, Signature>
+ */
+template <typename... Signatures>
+struct RingChannelTraits : asio::experimental::channel_traits<Signatures...>
+{
+    template <typename... NewSignatures>
+    struct rebind
+    {
+        using other = RingChannelTraits<NewSignatures...>;
+    };
+
+    template <typename Element>
+    struct container
+    {
+        using type = RingQueue<Element>;
+    };
+};
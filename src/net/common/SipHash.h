@@ -0,0 +1,98 @@
+/**
+ * ************************************************************************
+ *
+ * @file SipHash.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief SipHash-2-4：带密钥的 64 位短消息 MAC（握手 cookie 使用）
+ *
+ * 不知道密钥就无法伪造输出，对几十字节的输入只需几十纳秒，适合在收包路径上逐包计算。
+ * 参考：Aumasson & Bernstein, "SipHash: a fast short-input PRF"。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+/**
+ * @brief 128 位密钥
+ */
+struct SipHashKey
+{
+    uint64_t k0 = 0;
+    uint64_t k1 = 0;
+};
+
+/**
+ * @brief 计算 SipHash-2-4
+ * @param key 密钥
+ * @param data 输入（按字节处理，结果与平台字节序无关）
+ */
+inline uint64_t sipHash24(const SipHashKey& key, std::span<const uint8_t> data) noexcept
+{
+    uint64_t v0 = 0x736F6D6570736575ULL ^ key.k0;
+    uint64_t v1 = 0x646F72616E646F6DULL ^ key.k1;
+    uint64_t v2 = 0x6C7967656E657261ULL ^ key.k0;
+    uint64_t v3 = 0x7465646279746573ULL ^ key.k1;
+
+    auto sipRound = [&]
+    {
+        v0 += v1;
+        v1 = std::rotl(v1, 13);
+        v1 ^= v0;
+        v0 = std::rotl(v0, 32);
+        v2 += v3;
+        v3 = std::rotl(v3, 16);
+        v3 ^= v2;
+        v0 += v3;
+        v3 = std::rotl(v3, 21);
+        v3 ^= v0;
+        v2 += v1;
+        v1 = std::rotl(v1, 17);
+        v1 ^= v2;
+        v2 = std::rotl(v2, 32);
+    };
+
+    const size_t size = data.size();
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+    {
+        uint64_t m = 0;
+        std::memcpy(&m, data.data() + offset, sizeof(m));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            m = std::byteswap(m);
+        }
+        v3 ^= m;
+        sipRound();
+        sipRound();
+        v0 ^= m;
+    }
+
+    // 最后一块：剩余字节 + 总长度的低 8 位放在最高字节
+    uint64_t last = static_cast<uint64_t>(size) << 56;
+    for (size_t i = 0; offset + i < size; ++i)
+    {
+        last |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+    }
+    v3 ^= last;
+    sipRound();
+    sipRound();
+    v0 ^= last;
+
+    v2 ^= 0xFF;
+    sipRound();
+    sipRound();
+    sipRound();
+    sipRound();
+    return v0 ^ v1 ^ v2 ^ v3;
+}
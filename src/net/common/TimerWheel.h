@@ -0,0 +1,268 @@
+/**
+ * ************************************************************************
+ *
+ * @file TimerWheel.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 分层时间轮（4 层 × 256 槽，1 ms 精度）
+ *
+ * 时间戳为 32 位毫秒（与 KCP 时钟一致，允许回绕）。定时器节点存放在连续数组中，
+ * 通过下标串成双向链表并复用空闲节点，调度、改期、取消均为 O(1)；
+ * advance 只访问到期的槽，低层为空时直接跳到下一个进位点。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class TimerWheel
+{
+public:
+    using Handle = uint32_t;
+    static constexpr Handle INVALID_HANDLE = UINT32_MAX;
+
+    /**
+     * @param now 时间轮的起始时间（毫秒）
+     */
+    explicit TimerWheel(uint32_t now = 0) noexcept : m_now(now)
+    {
+        for (auto& level : m_slots)
+        {
+            level.fill(INVALID_HANDLE);
+        }
+    }
+
+    /**
+     * @brief 添加定时器，已过期的时间会被推迟到下一个 tick
+     * @return 定时器句柄，到期触发或取消后失效
+     */
+    Handle schedule(uint32_t expiry, T value)
+    {
+        Handle handle = INVALID_HANDLE;
+        if (m_freeHead != INVALID_HANDLE)
+        {
+            handle = m_freeHead;
+            m_freeHead = m_nodes[handle].next;
+            m_nodes[handle].value = std::move(value);
+        }
+        else
+        {
+            handle = static_cast<Handle>(m_nodes.size());
+            m_nodes.push_back(Node{.value = std::move(value)});
+        }
+        link(handle, clamp(expiry));
+        ++m_size;
+        return handle;
+    }
+
+    /**
+     * @brief 修改定时器的到期时间
+     */
+    void reschedule(Handle handle, uint32_t expiry)
+    {
+        expiry = clamp(expiry);
+        if (m_nodes[handle].expiry == expiry)
+        {
+            return;
+        }
+        unlink(handle);
+        link(handle, expiry);
+    }
+
+    /**
+     * @brief 取消定时器
+     */
+    void cancel(Handle handle)
+    {
+        unlink(handle);
+        release(handle);
+        --m_size;
+    }
+
+    [[nodiscard]] uint32_t expiry(Handle handle) const noexcept { return m_nodes[handle].expiry; }
+
+    /**
+     * @brief 推进时间轮到 now，依次触发到期的定时器
+     * @param callback 形如 void(T&&) 的回调；触发前节点已从时间轮移除，回调内可安全地调度/取消其他定时器
+     * @note now 早于当前时间（按有符号差判断，兼容回绕）时忽略：否则会被当作向前推进约 49.7 天，触发所有定时器
+     */
+    template <typename Callback>
+    void advance(uint32_t now, Callback&& callback)
+    {
+        if (static_cast<int32_t>(now - m_now) < 0) [[unlikely]]
+        {
+            return;
+        }
+        while (m_now != now)
+        {
+            if (skipEmptyTicks(now))
+            {
+                break;
+            }
+
+            ++m_now;
+            // 进位：先从最高的进位层开始逐层下放
+            if ((m_now & SLOT_MASK) == 0)
+            {
+                int top = 1;
+                while (top < LEVELS - 1 && ((m_now >> (SLOT_BITS * top)) & SLOT_MASK) == 0)
+                {
+                    ++top;
+                }
+                for (int level = top; level > 0; --level)
+                {
+                    cascade(level, (m_now >> (SLOT_BITS * level)) & SLOT_MASK);
+                }
+            }
+
+            // 逐个弹出当前槽的节点再回调，回调中新增的定时器至少落在下一个 tick
+            Handle& head = m_slots[0][m_now & SLOT_MASK];
+            while (head != INVALID_HANDLE)
+            {
+                const Handle handle = head;
+                unlink(handle);
+                T value = std::move(m_nodes[handle].value);
+                release(handle);
+                --m_size;
+                callback(std::move(value));
+            }
+        }
+    }
+
+    [[nodiscard]] uint32_t now() const noexcept { return m_now; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr uint32_t SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1U << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+
+    struct Node
+    {
+        T value{};
+        uint32_t expiry = 0;
+        Handle prev = INVALID_HANDLE;
+        Handle next = INVALID_HANDLE;
+        uint8_t level = 0;
+        uint8_t slot = 0;
+    };
+
+    [[nodiscard]] uint32_t clamp(uint32_t expiry) const noexcept
+    {
+        return static_cast<int32_t>(expiry - m_now) > 0 ? expiry : m_now + 1;
+    }
+
+    // 选择与当前时间共享全部更高位的最低层，保证槽位总在当前指针之后
+    void link(Handle handle, uint32_t expiry)
+    {
+        int level = 0;
+        while (level < LEVELS - 1 && (expiry >> (SLOT_BITS * (level + 1))) != (m_now >> (SLOT_BITS * (level + 1))))
+        {
+            ++level;
+        }
+        const uint32_t slot = (expiry >> (SLOT_BITS * level)) & SLOT_MASK;
+
+        Node& node = m_nodes[handle];
+        node.expiry = expiry;
+        node.level = static_cast<uint8_t>(level);
+        node.slot = static_cast<uint8_t>(slot);
+        node.prev = INVALID_HANDLE;
+        node.next = m_slots[level][slot];
+        if (node.next != INVALID_HANDLE)
+        {
+            m_nodes[node.next].prev = handle;
+        }
+        m_slots[level][slot] = handle;
+        ++m_levelCounts[level];
+    }
+
+    void unlink(Handle handle)
+    {
+        Node& node = m_nodes[handle];
+        if (node.prev != INVALID_HANDLE)
+        {
+            m_nodes[node.prev].next = node.next;
+        }
+        else
+        {
+            m_slots[node.level][node.slot] = node.next;
+        }
+        if (node.next != INVALID_HANDLE)
+        {
+            m_nodes[node.next].prev = node.prev;
+        }
+        --m_levelCounts[node.level];
+    }
+
+    void release(Handle handle)
+    {
+        Node& node = m_nodes[handle];
+        node.value = T{};
+        node.next = m_freeHead;
+        m_freeHead = handle;
+    }
+
+    void cascade(int level, uint32_t slot)
+    {
+        Handle handle = std::exchange(m_slots[level][slot], INVALID_HANDLE);
+        while (handle != INVALID_HANDLE)
+        {
+            const Handle next = m_nodes[handle].next;
+            --m_levelCounts[level];
+            link(handle, m_nodes[handle].expiry);
+            handle = next;
+        }
+    }
+
+    /**
+     * @brief 低层全空时直接跳到下一个进位点的前一个 tick
+     * @return true 表示在 now 之前没有需要处理的 tick，已直接推进到 now
+     */
+    bool skipEmptyTicks(uint32_t now)
+    {
+        int level = 0;
+        while (level < LEVELS && m_levelCounts[level] == 0)
+        {
+            ++level;
+        }
+        if (level == 0)
+        {
+            return false;
+        }
+
+        const uint32_t remaining = now - m_now;
+        if (level == LEVELS)
+        {
+            m_now = now;
+            return true;
+        }
+        const uint32_t span = 1U << (SLOT_BITS * level);
+        const uint32_t steps = span - (m_now & (span - 1)); // 到下一个进位点的距离
+        if (steps > remaining)
+        {
+            m_now = now;
+            return true;
+        }
+        m_now += steps - 1;
+        return false;
+    }
+
+    std::vector<Node> m_nodes;
+    std::array<std::array<Handle, SLOTS>, LEVELS> m_slots{};
+    std::array<size_t, LEVELS> m_levelCounts{};
+    Handle m_freeHead = INVALID_HANDLE;
+    size_t m_size = 0;
+    uint32_t m_now = 0;
+};
@@ -18,13 +18,39 @@
 #include <expected>
 #include <bit>
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <vector>
 #include "FrameHeader.h"
+#include "FrameCompression.h"
 
 enum class CodecError : std::uint8_t
 {
-    BufferTooSmall,   // 缓冲区过小
-    InvalidMagic,     // 无效的魔数
-    IncompletePayload // 不完整的载荷
+    BufferTooSmall,    // 缓冲区过小
+    InvalidMagic,      // 无效的魔数
+    IncompletePayload, // 不完整的载荷
+    PayloadTooLarge,   // 载荷超过帧头长度字段的表示范围
+    CompressedPayload, // 压缩帧需要解压缓冲区，请使用带 scratch 的 decodeFrame 或 decodeFrames
+    CorruptPayload,    // 压缩载荷损坏，或压缩时用了字典而解码方没有提供
+    InvalidChannel,    // 不可靠通道编号超出范围（见 UnreliableHeader.h）
+    SessionClosed      // 会话已关闭，帧未发送（KcpSession::queueFrame / sendUnreliable）
+};
+
+constexpr size_t FRAME_HEADER_SIZE = sizeof(FrameHeader);
+constexpr size_t MAX_FRAME_PAYLOAD = UINT16_MAX;
+constexpr size_t DEFAULT_COMPRESSION_THRESHOLD = 64;
+
+/**
+ * @brief 帧压缩选项
+ *
+ * 载荷达到阈值时尝试压缩，压缩结果不小于原载荷则按原样发送，因此对已压缩、随机数据无害。
+ * 收发双方必须使用同一份字典。
+ */
+struct FrameCompression
+{
+    size_t threshold = DEFAULT_COMPRESSION_THRESHOLD; // 载荷字节数达到该值才尝试压缩
+    const FrameDictionary* dictionary = nullptr;      // 预置字典，nullptr 表示不用字典
 };
 
 /**
@@ -39,6 +65,10 @@ inline std::expected<std::span<uint8_t>, CodecError>
 {
     const size_t total_size = sizeof(FrameHeader) + payload.size();
 
+    if (payload.size() > MAX_FRAME_PAYLOAD) [[unlikely]]
+    {
+        return std::unexpected(CodecError::PayloadTooLarge);
+    }
     if (buffer.size() < total_size) [[unlikely]]
     {
         return std::unexpected(CodecError::BufferTooSmall);
@@ -57,6 +87,92 @@ inline std::expected<std::span<uint8_t>, CodecError>
     return buffer.subspan(0, total_size);
 }
 
+/**
+ * @brief 编码帧数据包，载荷达到阈值且压缩有收益时写出压缩帧
+ * @param buffer 输出缓冲区，不可与 payload 重叠；按未压缩大小准备即可
+ * @param cmd 命令ID
+ * @param payload 载荷数据
+ * @param compression 压缩选项
+ * @return 成功返回编码后的子切片，失败返回错误码
+ */
+inline std::expected<std::span<uint8_t>, CodecError> encodeFrame(std::span<uint8_t> buffer,
+                                                                 uint16_t cmd,
+                                                                 std::span<const uint8_t> payload,
+                                                                 const FrameCompression& compression)
+{
+    if (payload.size() >= compression.threshold && payload.size() <= MAX_FRAME_PAYLOAD &&
+        buffer.size() > FRAME_HEADER_SIZE)
+    {
+        // 压缩结果必须严格小于原载荷，否则放弃压缩
+        const size_t limit = std::min(buffer.size() - FRAME_HEADER_SIZE, payload.size() - 1);
+        const size_t packed =
+            compressPayload(payload, buffer.subspan(FRAME_HEADER_SIZE, limit), compression.dictionary);
+        if (packed != 0)
+        {
+            auto* header = reinterpret_cast<FrameHeader*>(buffer.data()); // NOLINT
+            *header = FrameHeader{.magic = FRAME_MAGIC_COMPRESSED, .cmd = cmd, .length = static_cast<uint16_t>(packed)};
+            return buffer.subspan(0, FRAME_HEADER_SIZE + packed);
+        }
+    }
+    return encodeFrame(buffer, cmd, payload);
+}
+
+/**
+ * @brief 就地编码：为已写入缓冲区的载荷补写帧头
+ *
+ * 调用方先在缓冲区开头预留 FRAME_HEADER_SIZE 字节，载荷直接序列化到其后，
+ * 最后调用本函数填写帧头，整个过程不拷贝载荷。
+ * @param frame 预留的帧头 + 已写入的载荷
+ * @param cmd 命令ID
+ * @param magic 帧魔数，载荷已被压缩时传 FRAME_MAGIC_COMPRESSED
+ * @return 成功返回 frame 本身，失败返回错误码
+ */
+inline std::expected<std::span<uint8_t>, CodecError>
+    patchFrameHeader(std::span<uint8_t> frame, uint16_t cmd, uint16_t magic = FRAME_MAGIC)
+{
+    if (frame.size() < FRAME_HEADER_SIZE) [[unlikely]]
+    {
+        return std::unexpected(CodecError::BufferTooSmall);
+    }
+
+    const size_t payload_size = frame.size() - FRAME_HEADER_SIZE;
+    if (payload_size > MAX_FRAME_PAYLOAD) [[unlikely]]
+    {
+        return std::unexpected(CodecError::PayloadTooLarge);
+    }
+
+    auto* header = reinterpret_cast<FrameHeader*>(frame.data()); // NOLINT
+    *header = FrameHeader{.magic = magic, .cmd = cmd, .length = static_cast<uint16_t>(payload_size)};
+    return frame;
+}
+
+/**
+ * @brief 校验并读取帧头（魔数正确且载荷完整）
+ * @param buffer 输入缓冲区
+ * @return 成功返回帧头，帧在线上占 FRAME_HEADER_SIZE + length 字节
+ */
+inline std::expected<FrameHeader, CodecError> peekFrameHeader(std::span<const uint8_t> buffer)
+{
+    if (buffer.size() < sizeof(FrameHeader)) [[unlikely]]
+    {
+        return std::unexpected(CodecError::BufferTooSmall);
+    }
+
+    // 使用 bit_cast 或指针映射，避免 memcpy 整个结构体
+    const auto& header = *reinterpret_cast<const FrameHeader*>(buffer.data()); // NOLINT
+
+    if (header.magic != FRAME_MAGIC && header.magic != FRAME_MAGIC_COMPRESSED) [[unlikely]]
+    {
+        return std::unexpected(CodecError::InvalidMagic);
+    }
+
+    if (buffer.size() < sizeof(FrameHeader) + header.length) [[unlikely]]
+    {
+        return std::unexpected(CodecError::IncompletePayload);
+    }
+    return header;
+}
+
 /**
  * @brief 解码帧数据包
  * @param buffer 输入缓冲区
@@ -68,26 +184,156 @@ struct DecodeResult
     std::span<const uint8_t> payload;
 };
 
+/**
+ * @note 压缩帧返回 CodecError::CompressedPayload；对端可能压缩时使用带 scratch 的重载
+ */
 inline std::expected<DecodeResult, CodecError> decodeFrame(std::span<const uint8_t> buffer)
 {
-    if (buffer.size() < sizeof(FrameHeader)) [[unlikely]]
+    auto header = peekFrameHeader(buffer);
+    if (!header) [[unlikely]]
     {
-        return std::unexpected(CodecError::BufferTooSmall);
+        return std::unexpected(header.error());
+    }
+    if (header->compressed()) [[unlikely]]
+    {
+        return std::unexpected(CodecError::CompressedPayload);
     }
+    return DecodeResult{.cmd = header->cmd, .payload = buffer.subspan(sizeof(FrameHeader), header->length)};
+}
 
-    // 使用 bit_cast 或指针映射，避免 memcpy 整个结构体
-    const auto& header = *reinterpret_cast<const FrameHeader*>(buffer.data()); // NOLINT
+/**
+ * @brief 解码帧数据包，压缩帧解压到 scratch
+ * @param buffer 输入缓冲区
+ * @param scratch 解压缓冲区，跨调用复用可避免分配
+ * @param dictionary 对端压缩时使用的预置字典
+ * @return 成功返回命令ID 和载荷；压缩帧的载荷指向 scratch，下次使用 scratch 前有效
+ */
+inline std::expected<DecodeResult, CodecError> decodeFrame(std::span<const uint8_t> buffer,
+                                                           std::vector<uint8_t>& scratch,
+                                                           const FrameDictionary* dictionary = nullptr)
+{
+    auto header = peekFrameHeader(buffer);
+    if (!header) [[unlikely]]
+    {
+        return std::unexpected(header.error());
+    }
 
-    constexpr uint16_t EXPECTED_MAGIC = 0x55AA;
-    if (header.magic != EXPECTED_MAGIC) [[unlikely]]
+    const auto wire = buffer.subspan(sizeof(FrameHeader), header->length);
+    if (!header->compressed())
     {
-        return std::unexpected(CodecError::InvalidMagic);
+        return DecodeResult{.cmd = header->cmd, .payload = wire};
     }
 
-    if (buffer.size() < sizeof(FrameHeader) + header.length) [[unlikely]]
+    const auto originalSize = compressedOriginalSize(wire);
+    if (!originalSize) [[unlikely]]
+    {
+        return std::unexpected(CodecError::CorruptPayload);
+    }
+    scratch.resize(*originalSize);
+    if (!decompressPayload(wire, scratch, dictionary)) [[unlikely]]
+    {
+        return std::unexpected(CodecError::CorruptPayload);
+    }
+    return DecodeResult{.cmd = header->cmd, .payload = scratch};
+}
+
+/**
+ * @brief 遍历一个缓冲区中首尾相接的多个帧（FrameBatcher 合并发送的 KCP 消息）
+ *
+ * 遇到格式错误时提前结束，可通过 error() 查询；完整遍历且无错误时 error() 为空。
+ * 压缩帧解压到 FrameRange 内部的缓冲区，其载荷在迭代器前进之前有效。
+ * @code
+ *   FrameRange frames(packet);
+ *   for (auto [cmd, payload] : frames) { ... }
+ *   if (frames.error()) { ... }
+ * @endcode
+ */
+class FrameRange
+{
+public:
+    class iterator
+    {
+    public:
+        using value_type = DecodeResult;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        const DecodeResult& operator*() const noexcept { return m_current; }
+        const DecodeResult* operator->() const noexcept { return &m_current; }
+
+        iterator& operator++()
+        {
+            advance();
+            return *this;
+        }
+
+        void operator++(int) { advance(); }
+
+        bool operator==(std::default_sentinel_t) const noexcept { return m_range == nullptr; }
+
+    private:
+        friend class FrameRange;
+
+        explicit iterator(FrameRange* range) : m_range(range), m_rest(range->m_buffer) { advance(); }
+
+        void advance()
+        {
+            if (m_rest.empty())
+            {
+                m_range = nullptr;
+                return;
+            }
+
+            auto result = decodeFrame(m_rest, m_range->m_scratch, m_range->m_dictionary);
+            if (!result) [[unlikely]]
+            {
+                m_range->m_error = result.error();
+                m_range = nullptr;
+                return;
+            }
+            m_current = *result;
+
+            // 按线上长度前进：压缩帧解出的载荷比线上长
+            const auto& header = *reinterpret_cast<const FrameHeader*>(m_rest.data()); // NOLINT
+            m_rest = m_rest.subspan(FRAME_HEADER_SIZE + header.length);
+        }
+
+        FrameRange* m_range = nullptr;
+        std::span<const uint8_t> m_rest;
+        DecodeResult m_current{};
+    };
+
+    explicit FrameRange(std::span<const uint8_t> buffer, const FrameDictionary* dictionary = nullptr) noexcept
+        : m_buffer(buffer), m_dictionary(dictionary)
     {
-        return std::unexpected(CodecError::IncompletePayload);
     }
 
-    return DecodeResult{.cmd = header.cmd, .payload = buffer.subspan(sizeof(FrameHeader), header.length)};
-}
\ No newline at end of file
+    iterator begin()
+    {
+        m_error.reset();
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+    /**
+     * @brief 最近一次遍历是否因格式错误提前结束
+     */
+    [[nodiscard]] std::optional<CodecError> error() const noexcept { return m_error; }
+
+private:
+    std::span<const uint8_t> m_buffer;
+    const FrameDictionary* m_dictionary = nullptr;
+    std::vector<uint8_t> m_scratch; // 压缩帧的解压缓冲
+    std::optional<CodecError> m_error;
+};
+
+/**
+ * @brief 按帧遍历缓冲区，单帧缓冲区同样适用
+ * @param dictionary 对端压缩时使用的预置字典
+ */
+inline FrameRange decodeFrames(std::span<const uint8_t> buffer, const FrameDictionary* dictionary = nullptr) noexcept
+{
+    return FrameRange(buffer, dictionary);
+}
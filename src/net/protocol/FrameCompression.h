@@ -0,0 +1,396 @@
+/**
+ * ************************************************************************
+ *
+ * @file FrameCompression.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 帧载荷压缩：LZ4 块格式风格的 LZ77 编码，支持预置字典
+ *
+ * 压缩后的载荷布局：
+ *   [uint16 原始长度][序列 0][序列 1]...
+ * 每个序列：
+ *   [token：高 4 位字面量长度，低 4 位匹配长度 - 4][字面量长度扩展][字面量]
+ *   [uint16 匹配偏移][匹配长度扩展]
+ * 长度字段为 15 时后接若干扩展字节（每字节累加，遇到小于 255 的字节结束）。
+ * 最后一个序列只有字面量，没有偏移。
+ *
+ * 匹配偏移可以越过已解出的数据回指到预置字典（字典视为输出之前的历史数据），
+ * 因此几十字节的小消息也能借助字典里的公共片段缩小。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+
+constexpr size_t LZ_MIN_MATCH = 4;           // 最短匹配
+constexpr size_t LZ_MAX_OFFSET = UINT16_MAX; // 最远回指距离
+constexpr size_t LZ_HASH_BITS = 12;          // 匹配查找表 4096 项
+constexpr size_t LZ_HASH_SIZE = size_t{1} << LZ_HASH_BITS;
+constexpr size_t MAX_DICTIONARY_SIZE = 16 * 1'024; // 预置字典上限，超出部分只保留尾部
+constexpr size_t COMPRESSED_PREFIX_SIZE = sizeof(uint16_t); // 压缩载荷开头记录原始长度
+
+namespace detail
+{
+constexpr uint8_t LZ_LENGTH_MASK = 0x0F;
+
+inline uint32_t lzLoad32(const uint8_t* p) noexcept
+{
+    uint32_t v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t lzHash(uint32_t sequence, unsigned bits = LZ_HASH_BITS) noexcept
+{
+    return (sequence * 2'654'435'761U) >> (32 - bits);
+}
+
+// [a, aEnd) 与 [b, bEnd) 的公共前缀长度，按 8 字节一组比较
+inline size_t lzCommonLength(const uint8_t* a, const uint8_t* aEnd, const uint8_t* b, const uint8_t* bEnd) noexcept
+{
+    const auto limit = static_cast<size_t>(std::min(aEnd - a, bEnd - b));
+    size_t n = 0;
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        for (; n + sizeof(uint64_t) <= limit; n += sizeof(uint64_t))
+        {
+            uint64_t x = 0;
+            uint64_t y = 0;
+            std::memcpy(&x, a + n, sizeof(x));
+            std::memcpy(&y, b + n, sizeof(y));
+            if (x != y)
+            {
+                return n + (static_cast<size_t>(std::countr_zero(x ^ y)) / 8);
+            }
+        }
+    }
+    while (n < limit && a[n] == b[n])
+    {
+        ++n;
+    }
+    return n;
+}
+} // namespace detail
+
+/**
+ * @brief 预置字典：字典内容 + 预先建好的匹配查找表
+ *
+ * 查找表在构造时建立一次，压缩时只读，不必每次重新扫描字典。
+ * @note 只引用字典内容不做拷贝，内容必须比 FrameDictionary 活得久（通常是静态数据）
+ */
+class FrameDictionary
+{
+public:
+    using HashTable = std::array<uint16_t, LZ_HASH_SIZE>; // 位置 + 1，0 表示空
+
+    FrameDictionary() noexcept { m_table.fill(0); }
+
+    explicit FrameDictionary(std::span<const uint8_t> content) noexcept
+        : m_content(content.size() > MAX_DICTIONARY_SIZE ? content.last(MAX_DICTIONARY_SIZE) : content)
+    {
+        m_table.fill(0);
+        for (size_t pos = 0; pos + LZ_MIN_MATCH <= m_content.size(); ++pos)
+        {
+            m_table[detail::lzHash(detail::lzLoad32(m_content.data() + pos))] = static_cast<uint16_t>(pos + 1);
+        }
+    }
+
+    [[nodiscard]] std::span<const uint8_t> content() const noexcept { return m_content; }
+    [[nodiscard]] const HashTable& table() const noexcept { return m_table; }
+    [[nodiscard]] bool empty() const noexcept { return m_content.empty(); }
+
+private:
+    std::span<const uint8_t> m_content;
+    HashTable m_table;
+};
+
+namespace detail
+{
+// 写入长度扩展字节，空间不足返回 false
+inline bool lzWriteLength(uint8_t*& out, const uint8_t* outEnd, size_t length) noexcept
+{
+    while (length >= 0xFF)
+    {
+        if (out == outEnd)
+        {
+            return false;
+        }
+        *out++ = 0xFF;
+        length -= 0xFF;
+    }
+    if (out == outEnd)
+    {
+        return false;
+    }
+    *out++ = static_cast<uint8_t>(length);
+    return true;
+}
+
+// 读取长度扩展字节，越界返回 false
+inline bool lzReadLength(const uint8_t*& in, const uint8_t* inEnd, size_t& length) noexcept
+{
+    uint8_t byte = 0xFF;
+    while (byte == 0xFF)
+    {
+        if (in == inEnd)
+        {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    }
+    return true;
+}
+
+// 写出一个序列；matchLength 为 0 表示最后一个只有字面量的序列
+inline bool lzWriteSequence(uint8_t*& out,
+                            const uint8_t* outEnd,
+                            std::span<const uint8_t> literals,
+                            size_t offset,
+                            size_t matchLength) noexcept
+{
+    if (out == outEnd)
+    {
+        return false;
+    }
+    const size_t matchCode = matchLength == 0 ? 0 : matchLength - LZ_MIN_MATCH;
+    uint8_t* token = out++;
+    *token = static_cast<uint8_t>((std::min<size_t>(literals.size(), LZ_LENGTH_MASK) << 4) |
+                                  std::min<size_t>(matchCode, LZ_LENGTH_MASK));
+
+    if (literals.size() >= LZ_LENGTH_MASK && !lzWriteLength(out, outEnd, literals.size() - LZ_LENGTH_MASK))
+    {
+        return false;
+    }
+    if (static_cast<size_t>(outEnd - out) < literals.size())
+    {
+        return false;
+    }
+    std::memcpy(out, literals.data(), literals.size());
+    out += literals.size();
+
+    if (matchLength == 0)
+    {
+        return true;
+    }
+    if (outEnd - out < 2)
+    {
+        return false;
+    }
+    const auto offset16 = static_cast<uint16_t>(offset);
+    std::memcpy(out, &offset16, sizeof(offset16));
+    out += sizeof(offset16);
+    return matchCode < LZ_LENGTH_MASK || lzWriteLength(out, outEnd, matchCode - LZ_LENGTH_MASK);
+}
+} // namespace detail
+
+/**
+ * @brief 压缩载荷
+ * @param src 原始载荷（不超过 65535 字节）
+ * @param dst 输出缓冲区，不可与 src 重叠
+ * @param dictionary 预置字典，nullptr 表示不用字典
+ * @return 压缩后的字节数；dst 放不下（即压缩无收益）或 src 过长时返回 0
+ * @note 调用方把 dst 限制为 src.size() - 1 即可保证结果严格小于原载荷
+ */
+inline size_t compressPayload(std::span<const uint8_t> src,
+                              std::span<uint8_t> dst,
+                              const FrameDictionary* dictionary = nullptr) noexcept
+{
+    if (src.size() > UINT16_MAX || dst.size() < COMPRESSED_PREFIX_SIZE)
+    {
+        return 0;
+    }
+
+    // 载荷自己的查找表按载荷大小缩小，小消息只需清空表的一小段；字典的查找表只读
+    const auto bits = static_cast<unsigned>(std::clamp<size_t>(std::bit_width(src.size()), 6, LZ_HASH_BITS));
+    std::array<uint16_t, LZ_HASH_SIZE> table; // 载荷内位置 + 1，0 表示空
+    std::fill_n(table.begin(), size_t{1} << bits, uint16_t{0});
+    const std::span<const uint8_t> dict = dictionary != nullptr ? dictionary->content() : std::span<const uint8_t>{};
+
+    uint8_t* out = dst.data();
+    const uint8_t* outEnd = dst.data() + dst.size();
+    const auto originalSize = static_cast<uint16_t>(src.size());
+    std::memcpy(out, &originalSize, sizeof(originalSize));
+    out += sizeof(originalSize);
+
+    const uint8_t* const begin = src.data();
+    const uint8_t* const end = begin + src.size();
+    size_t anchor = 0; // 尚未输出的字面量起点
+    size_t pos = 0;
+    while (pos + LZ_MIN_MATCH <= src.size())
+    {
+        const uint32_t sequence = detail::lzLoad32(begin + pos);
+        uint16_t& slot = table[detail::lzHash(sequence, bits)];
+        size_t length = 0;
+        size_t offset = 0;
+        if (slot != 0)
+        {
+            const size_t candidate = slot - 1U;
+            length = detail::lzCommonLength(begin + candidate, end, begin + pos, end);
+            offset = pos - candidate;
+        }
+        slot = static_cast<uint16_t>(pos + 1);
+
+        // 字典中的候选：匹配可以从字典末尾延续到载荷开头
+        if (dictionary != nullptr)
+        {
+            const uint16_t dictSlot = dictionary->table()[detail::lzHash(sequence)];
+            const size_t candidate = dictSlot - 1U;
+            if (dictSlot != 0 && dict.size() - candidate + pos <= LZ_MAX_OFFSET)
+            {
+                size_t dictLength =
+                    detail::lzCommonLength(dict.data() + candidate, dict.data() + dict.size(), begin + pos, end);
+                if (candidate + dictLength == dict.size())
+                {
+                    dictLength += detail::lzCommonLength(begin, end, begin + pos + dictLength, end);
+                }
+                if (dictLength > length)
+                {
+                    length = dictLength;
+                    offset = dict.size() - candidate + pos;
+                }
+            }
+        }
+
+        if (length < LZ_MIN_MATCH) // 没有候选或哈希冲突
+        {
+            ++pos;
+            continue;
+        }
+
+        if (!detail::lzWriteSequence(out, outEnd, src.subspan(anchor, pos - anchor), offset, length))
+        {
+            return 0;
+        }
+
+        // 匹配区间内的位置也登记进查找表，后续数据可以引用它们
+        const size_t matchEnd = pos + length;
+        for (++pos; pos < matchEnd && pos + LZ_MIN_MATCH <= src.size(); ++pos)
+        {
+            table[detail::lzHash(detail::lzLoad32(begin + pos), bits)] = static_cast<uint16_t>(pos + 1);
+        }
+        pos = matchEnd;
+        anchor = pos;
+    }
+
+    if (!detail::lzWriteSequence(out, outEnd, src.subspan(anchor), 0, 0))
+    {
+        return 0;
+    }
+    return static_cast<size_t>(out - dst.data());
+}
+
+/**
+ * @brief 读取压缩载荷记录的原始长度
+ */
+inline std::optional<size_t> compressedOriginalSize(std::span<const uint8_t> src) noexcept
+{
+    if (src.size() < COMPRESSED_PREFIX_SIZE)
+    {
+        return std::nullopt;
+    }
+    uint16_t originalSize = 0;
+    std::memcpy(&originalSize, src.data(), sizeof(originalSize));
+    return originalSize;
+}
+
+/**
+ * @brief 解压载荷
+ * @param src compressPayload 的输出
+ * @param dst 输出缓冲区，大小必须等于 compressedOriginalSize(src)
+ * @param dictionary 压缩时使用的预置字典
+ * @return 数据完整且恰好填满 dst 时返回 true；任何越界（包括缺少字典时的回指）都返回 false
+ */
+inline bool decompressPayload(std::span<const uint8_t> src,
+                              std::span<uint8_t> dst,
+                              const FrameDictionary* dictionary = nullptr) noexcept
+{
+    if (compressedOriginalSize(src) != dst.size())
+    {
+        return false;
+    }
+
+    const std::span<const uint8_t> dict = dictionary != nullptr ? dictionary->content() : std::span<const uint8_t>{};
+    const uint8_t* in = src.data() + COMPRESSED_PREFIX_SIZE;
+    const uint8_t* inEnd = src.data() + src.size();
+    size_t written = 0;
+    while (in != inEnd)
+    {
+        const uint8_t token = *in++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == detail::LZ_LENGTH_MASK && !detail::lzReadLength(in, inEnd, literalLength))
+        {
+            return false;
+        }
+        if (static_cast<size_t>(inEnd - in) < literalLength || dst.size() - written < literalLength)
+        {
+            return false;
+        }
+        std::memcpy(dst.data() + written, in, literalLength);
+        in += literalLength;
+        written += literalLength;
+
+        if (in == inEnd) // 最后一个序列
+        {
+            break;
+        }
+
+        if (inEnd - in < 2)
+        {
+            return false;
+        }
+        uint16_t offset = 0;
+        std::memcpy(&offset, in, sizeof(offset));
+        in += sizeof(offset);
+        size_t matchLength = token & detail::LZ_LENGTH_MASK;
+        if (matchLength == detail::LZ_LENGTH_MASK && !detail::lzReadLength(in, inEnd, matchLength))
+        {
+            return false;
+        }
+        matchLength += LZ_MIN_MATCH;
+        if (offset == 0 || offset > written + dict.size() || dst.size() - written < matchLength)
+        {
+            return false;
+        }
+
+        // 先复制落在字典里的部分
+        if (offset > written)
+        {
+            const size_t dictPos = dict.size() - (offset - written);
+            const size_t fromDict = std::min(matchLength, dict.size() - dictPos);
+            std::memcpy(dst.data() + written, dict.data() + dictPos, fromDict);
+            written += fromDict;
+            matchLength -= fromDict;
+        }
+
+        // 再复制输出中的部分；偏移小于长度时源与目标重叠，必须逐字节复制
+        uint8_t* target = dst.data() + written;
+        const uint8_t* source = target - offset;
+        if (offset >= matchLength)
+        {
+            std::memcpy(target, source, matchLength);
+        }
+        else
+        {
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                target[i] = source[i];
+            }
+        }
+        written += matchLength;
+    }
+    return written == dst.size();
+}
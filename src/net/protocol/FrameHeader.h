@@ -20,11 +20,17 @@
 #pragma pack(push, 1)
 
 constexpr uint16_t FRAME_MAGIC = 0x55AA;
+// 载荷经 FrameCompression 压缩的帧换用该魔数，帧头仍为 6 字节，length 保留完整的 16 位
+constexpr uint16_t FRAME_MAGIC_COMPRESSED = 0x55AB;
 
 struct FrameHeader
 {
-    uint16_t magic = FRAME_MAGIC; // 语义更明确的命名
+    uint16_t magic = FRAME_MAGIC; // 语义更明确的命名；FRAME_MAGIC 或 FRAME_MAGIC_COMPRESSED
     uint16_t cmd = 0;             // 指令 ID
-    uint16_t length = 0;          // 载荷长度
+    uint16_t length = 0;          // 载荷长度（线上字节数，压缩帧为压缩后的长度）
+
+    [[nodiscard]] constexpr bool compressed() const noexcept { return magic == FRAME_MAGIC_COMPRESSED; }
 };
 #pragma pack(pop)
+
+static_assert(sizeof(FrameHeader) == 6, "帧头为线上格式，大小不可变");
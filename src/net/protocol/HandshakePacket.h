@@ -0,0 +1,79 @@
+/**
+ * ************************************************************************
+ *
+ * @file HandshakePacket.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 连接握手报文（conv 0 保留给握手，KCP 会话不会使用）
+ *
+ * 流程（SYN cookie 风格，服务端在握手完成前不保存任何状态）：
+ *   客户端 HELLO(nonce)                       -> 服务端
+ *   服务端 CHALLENGE(nonce, timestamp, cookie) -> 客户端   cookie = MAC(地址, 端口, nonce, timestamp)
+ *   客户端 CONNECT(nonce, timestamp, cookie)   -> 服务端   校验 cookie 与时效后才创建会话
+ *   服务端 ACCEPT(nonce, conv)                 -> 客户端   conv 由服务端分配
+ * 所有握手报文等长，服务端的应答不会大于请求，无法被用来放大流量。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+
+constexpr uint32_t HANDSHAKE_CONV = 0; // 握手报文的 conv 字段
+
+enum class HandshakeType : uint8_t
+{
+    Hello = 1,     // 客户端发起
+    Challenge = 2, // 服务端下发 cookie
+    Connect = 3,   // 客户端回送 cookie
+    Accept = 4     // 服务端分配 conv
+};
+
+#pragma pack(push, 1)
+struct HandshakePacket
+{
+    uint32_t conv = HANDSHAKE_CONV;
+    HandshakeType type = HandshakeType::Hello;
+    uint32_t nonce = 0;        // 客户端随机数，用于匹配请求与应答
+    uint32_t timestamp = 0;    // 服务端签发 cookie 的时间（秒，服务端时钟）
+    uint32_t assignedConv = 0; // ACCEPT：服务端分配的 conv
+    uint64_t cookie = 0;
+};
+#pragma pack(pop)
+
+constexpr size_t HANDSHAKE_PACKET_SIZE = sizeof(HandshakePacket);
+
+/**
+ * @brief 报文的线上字节视图
+ */
+inline std::span<const uint8_t> handshakeBytes(const HandshakePacket& packet) noexcept
+{
+    return {reinterpret_cast<const uint8_t*>(&packet), HANDSHAKE_PACKET_SIZE}; // NOLINT
+}
+
+/**
+ * @brief 解析握手报文：长度、conv 与类型都必须合法，否则返回 std::nullopt
+ */
+inline std::optional<HandshakePacket> parseHandshake(std::span<const uint8_t> data) noexcept
+{
+    if (data.size() != HANDSHAKE_PACKET_SIZE) [[unlikely]]
+    {
+        return std::nullopt;
+    }
+    HandshakePacket packet;
+    std::memcpy(&packet, data.data(), HANDSHAKE_PACKET_SIZE);
+    const auto type = static_cast<uint8_t>(packet.type);
+    if (packet.conv != HANDSHAKE_CONV || type < static_cast<uint8_t>(HandshakeType::Hello) ||
+        type > static_cast<uint8_t>(HandshakeType::Accept)) [[unlikely]]
+    {
+        return std::nullopt;
+    }
+    return packet;
+}
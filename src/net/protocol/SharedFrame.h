@@ -0,0 +1,99 @@
+/**
+ * ************************************************************************
+ *
+ * @file SharedFrame.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 引用计数的只读帧：编码一次，排入任意多个会话
+ *
+ * 广播时只在第一次编码（与压缩）时写入缓冲区，之后每个接收方只增加一次引用计数；
+ * 内容不可修改，因此可以跨线程共享，最后一个持有者释放时归还内存。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "FrameCodec.h"
+#include <algorithm>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+
+class SharedFrame
+{
+public:
+    SharedFrame() = default;
+
+    /**
+     * @brief 编码一帧（FrameHeader + 载荷）
+     * @return 载荷超过帧长度上限时返回 PayloadTooLarge
+     */
+    static std::expected<SharedFrame, CodecError> encode(uint16_t cmd, std::span<const uint8_t> payload)
+    {
+        if (payload.size() > MAX_FRAME_PAYLOAD) [[unlikely]]
+        {
+            return std::unexpected(CodecError::PayloadTooLarge);
+        }
+        auto data = std::make_shared_for_overwrite<uint8_t[]>(FRAME_HEADER_SIZE + payload.size());
+        auto encoded = encodeFrame({data.get(), FRAME_HEADER_SIZE + payload.size()}, cmd, payload);
+        if (!encoded) [[unlikely]]
+        {
+            return std::unexpected(encoded.error());
+        }
+        return SharedFrame(std::move(data), encoded->size());
+    }
+
+    /**
+     * @brief 编码一帧，载荷达到阈值且压缩有收益时写出压缩帧
+     */
+    static std::expected<SharedFrame, CodecError>
+        encode(uint16_t cmd, std::span<const uint8_t> payload, const FrameCompression& compression)
+    {
+        if (payload.size() > MAX_FRAME_PAYLOAD) [[unlikely]]
+        {
+            return std::unexpected(CodecError::PayloadTooLarge);
+        }
+        auto data = std::make_shared_for_overwrite<uint8_t[]>(FRAME_HEADER_SIZE + payload.size());
+        auto encoded = encodeFrame({data.get(), FRAME_HEADER_SIZE + payload.size()}, cmd, payload, compression);
+        if (!encoded) [[unlikely]]
+        {
+            return std::unexpected(encoded.error());
+        }
+        return SharedFrame(std::move(data), encoded->size());
+    }
+
+    /**
+     * @brief 包装一段已编码的帧（如 encodeMessage 的输出），拷贝一次
+     * @param frame 完整的一帧或多帧，调用方保证格式正确
+     */
+    static SharedFrame copyOf(std::span<const uint8_t> frame)
+    {
+        auto data = std::make_shared_for_overwrite<uint8_t[]>(frame.size());
+        std::ranges::copy(frame, data.get());
+        return SharedFrame(std::move(data), frame.size());
+    }
+
+    /**
+     * @brief 帧的线上字节
+     */
+    [[nodiscard]] std::span<const uint8_t> bytes() const noexcept { return {m_data.get(), m_size}; }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief 当前持有者数量（调试与测试用）
+     */
+    [[nodiscard]] long useCount() const noexcept { return m_data.use_count(); }
+
+private:
+    SharedFrame(std::shared_ptr<const uint8_t[]> data, size_t size) : m_data(std::move(data)), m_size(size) {}
+
+    std::shared_ptr<const uint8_t[]> m_data;
+    size_t m_size = 0;
+};
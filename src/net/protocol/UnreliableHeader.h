@@ -0,0 +1,78 @@
+/**
+ * ************************************************************************
+ *
+ * @file UnreliableHeader.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 不可靠有序通道的数据报头（与 KCP 共用 conv，不经过 KCP）
+ *
+ * 悬停光标、"正在选择"提示、心跳计时等只关心最新值的数据，走 KCP 的可靠流会被前面丢失的段阻塞。
+ * 这类数据直接作为一个 UDP 数据报发出：
+ *   [conv u32][marker u8][channel u8][sequence u32][帧 0][帧 1]...
+ * marker 位于 KCP 段头 cmd 字节的位置，KCP 只使用 81 ~ 84，握手报文在此处是 1 ~ 4，三者互不冲突，
+ * 接收端只看这一个字节就能分流。每个 channel 各自编号，接收端丢弃不比已收到的更新的数据报
+ * （乱序到达的旧值、重复包），不重传、不确认。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+
+constexpr uint8_t UNRELIABLE_MARKER = 0xF0;
+constexpr size_t UNRELIABLE_CHANNELS = 4; // 每个会话的不可靠通道数，各自独立编号
+
+#pragma pack(push, 1)
+struct UnreliableHeader
+{
+    uint32_t conv = 0;
+    uint8_t marker = UNRELIABLE_MARKER;
+    uint8_t channel = 0;
+    uint32_t sequence = 0; // 每个通道从 1 开始递增
+};
+#pragma pack(pop)
+
+constexpr size_t UNRELIABLE_HEADER_SIZE = sizeof(UnreliableHeader);
+constexpr size_t UNRELIABLE_MARKER_OFFSET = offsetof(UnreliableHeader, marker);
+
+/**
+ * @brief 是否为不可靠通道的数据报（只检查 marker，不校验其余字段）
+ */
+inline bool isUnreliableDatagram(std::span<const uint8_t> data) noexcept
+{
+    return data.size() > UNRELIABLE_MARKER_OFFSET && data[UNRELIABLE_MARKER_OFFSET] == UNRELIABLE_MARKER;
+}
+
+/**
+ * @brief 解析数据报头：长度、marker 与通道编号都必须合法，否则返回 std::nullopt
+ */
+inline std::optional<UnreliableHeader> parseUnreliableHeader(std::span<const uint8_t> data) noexcept
+{
+    if (data.size() < UNRELIABLE_HEADER_SIZE) [[unlikely]]
+    {
+        return std::nullopt;
+    }
+    UnreliableHeader header;
+    std::memcpy(&header, data.data(), UNRELIABLE_HEADER_SIZE);
+    if (header.marker != UNRELIABLE_MARKER || header.channel >= UNRELIABLE_CHANNELS) [[unlikely]]
+    {
+        return std::nullopt;
+    }
+    return header;
+}
+
+/**
+ * @brief 序号比较（允许回绕）：sequence 是否比 last 更新
+ */
+constexpr bool isNewerSequence(uint32_t sequence, uint32_t last) noexcept
+{
+    return static_cast<int32_t>(sequence - last) > 0;
+}
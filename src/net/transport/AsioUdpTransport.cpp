@@ -15,22 +15,118 @@
 
 #include "AsioUdpTransport.h"
 #include <asio.hpp>
+#include <algorithm>
 #include <array>
+#include <vector>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <linux/filter.h>
+#include <cerrno>
+#endif
+
+namespace
+{
+constexpr size_t MAX_DATAGRAM_SIZE = 2048;
+constexpr int MAX_DRAIN_ROUNDS = 8;              // 单次唤醒最多连续排空的轮数，避免独占执行器
+constexpr size_t MAX_QUEUED_BYTES = 1024 * 1024; // 发送队列积压上限，超出时提前 flush
+constexpr unsigned int MAX_MMSG_PER_CALL = 1024; // 单次 sendmmsg 的报文数上限（UIO_MAXIOV）
+constexpr size_t MAX_GSO_SEGMENTS = 64;          // 内核单个 GSO 报文的分段上限
+constexpr size_t MAX_GSO_BYTES = 65000;          // GSO 报文总长上限（需小于 64KB）
+} // namespace
 
 // Pimpl 实现
 struct AsioUdpTransport::Impl
 {
     asio::ip::udp::socket socket;
-    std::array<uint8_t, 2048> recv_buffer{};
+    std::array<uint8_t, MAX_DATAGRAM_SIZE> recv_buffer{};
 
-    Impl(const asio::any_io_executor& exec, uint16_t port)
-    
-        : socket(exec, asio::ip::udp::endpoint(asio::ip::udp::v4(), port))
+    /**
+     * @brief 发送队列条目：载荷按顺序拷贝进 sendBytes，条目只记录目标地址与区间
+     */
+    struct QueuedDatagram
     {
+        NetAddress to;
+        size_t offset;
+        size_t size;
+    };
+
+    bool batching{false};
+    std::vector<uint8_t> sendBytes;
+    std::vector<QueuedDatagram> sendQueue;
+    SendBatchStats stats;
+
+    Impl(const asio::any_io_executor& exec, uint16_t port, bool reusePort) : socket(exec)
+    {
+        socket.open(asio::ip::udp::v4());
+#if defined(SO_REUSEPORT)
+        if (reusePort)
+        {
+            socket.set_option(asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+        }
+#else
+        static_cast<void>(reusePort);
+#endif
+        socket.bind(asio::ip::udp::endpoint(asio::ip::udp::v4(), port));
+
+#if defined(__linux__) && defined(UDP_SEGMENT)
+        // 能读取 UDP_SEGMENT 选项说明内核支持 UDP GSO（Linux 4.18+）
+        int segment = 0;
+        socklen_t length = sizeof(segment);
+        gsoEnabled = ::getsockopt(socket.native_handle(), SOL_UDP, UDP_SEGMENT, &segment, &length) == 0;
+#endif
+    }
+
+    /**
+     * @return 发送失败时返回 false
+     */
+    bool sendImmediate(const NetAddress& address, std::span<const uint8_t> data)
+    {
+        asio::error_code ec;
+        socket.send_to(asio::buffer(data.data(), data.size()), address.toAsioEndpoint(), 0, ec);
+        return !ec;
+    }
+
+    void enqueue(const NetAddress& address, std::span<const uint8_t> data)
+    {
+        if (sendBytes.size() + data.size() > MAX_QUEUED_BYTES)
+        {
+            flushQueue();
+        }
+        sendQueue.push_back(QueuedDatagram{.to = address, .offset = sendBytes.size(), .size = data.size()});
+        sendBytes.insert(sendBytes.end(), data.begin(), data.end());
+    }
+
+    void flushQueue()
+    {
+        if (sendQueue.empty())
+        {
+            return;
+        }
+
+        stats.flushes++;
+        stats.datagrams += sendQueue.size();
+#if defined(__linux__)
+        stats.syscalls += sendQueuedMessages();
+#else
+        for (const auto& queued : sendQueue)
+        {
+            if (!sendImmediate(queued.to, std::span<const uint8_t>(sendBytes).subspan(queued.offset, queued.size)))
+            {
+                stats.dropped++;
+            }
+        }
+        stats.syscalls += sendQueue.size();
+#endif
+        sendQueue.clear();
+        sendBytes.clear();
     }
 
     // 内部协程：接收循环
-    asio::awaitable<void> recvLoop(std::function<void(const NetAddress&, std::span<const uint8_t>)> handler)
+    asio::awaitable<void> recvLoop(RecvHandler handler)
     {
         asio::ip::udp::endpoint from;
         for (;;)
@@ -47,10 +143,282 @@ struct AsioUdpTransport::Impl
             handler(addr, std::span<const uint8_t>(recv_buffer.data(), n));
         }
     }
+
+#if defined(__linux__)
+    /**
+     * @brief recvmmsg 使用的可复用接收槽，整个循环生命周期内只分配一次
+     */
+    struct RecvSlab
+    {
+        std::vector<uint8_t> storage;
+        std::vector<mmsghdr> headers;
+        std::vector<iovec> iovecs;
+        std::vector<sockaddr_storage> addrs;
+        std::vector<UdpDatagram> datagrams;
+
+        explicit RecvSlab(size_t batchSize)
+            : storage(batchSize * MAX_DATAGRAM_SIZE), headers(batchSize), iovecs(batchSize), addrs(batchSize)
+        {
+            datagrams.reserve(batchSize);
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                iovecs[i].iov_base = storage.data() + (i * MAX_DATAGRAM_SIZE);
+                iovecs[i].iov_len = MAX_DATAGRAM_SIZE;
+                headers[i].msg_hdr = msghdr{};
+                headers[i].msg_hdr.msg_iov = &iovecs[i];
+                headers[i].msg_hdr.msg_iovlen = 1;
+                headers[i].msg_hdr.msg_name = &addrs[i];
+            }
+        }
+
+        void reset()
+        {
+            for (auto& header : headers)
+            {
+                header.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+                header.msg_hdr.msg_flags = 0;
+                header.msg_len = 0;
+            }
+        }
+
+        std::span<const UdpDatagram> collect(size_t count)
+        {
+            datagrams.clear();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto& header = headers[i];
+                // 超过 MAX_DATAGRAM_SIZE 的数据报已被截断，直接丢弃
+                if ((header.msg_hdr.msg_flags & MSG_TRUNC) != 0)
+                {
+                    continue;
+                }
+
+                const auto* data = static_cast<const uint8_t*>(iovecs[i].iov_base);
+                datagrams.push_back(UdpDatagram{
+                    .from = NetAddress::fromSockaddr(&addrs[i], header.msg_hdr.msg_namelen),
+                    .payload = std::span<const uint8_t>(data, header.msg_len),
+                });
+            }
+            return datagrams;
+        }
+    };
+
+    // 内部协程：基于 recvmmsg 的批量接收循环
+    asio::awaitable<void> batchRecvLoop(BatchRecvHandler handler, size_t batchSize)
+    {
+        RecvSlab slab(batchSize);
+        asio::error_code ec;
+        socket.non_blocking(true, ec);
+        if (ec)
+        {
+            co_return;
+        }
+
+        for (;;)
+        {
+            co_await socket.async_wait(asio::ip::udp::socket::wait_read, asio::redirect_error(asio::use_awaitable, ec));
+            if (ec)
+            {
+                co_return;
+            }
+
+            // 一次唤醒内尽量排空内核队列，满批时继续收取
+            for (int round = 0; round < MAX_DRAIN_ROUNDS; ++round)
+            {
+                slab.reset();
+                int received = ::recvmmsg(socket.native_handle(),
+                                          slab.headers.data(),
+                                          static_cast<unsigned int>(batchSize),
+                                          MSG_DONTWAIT,
+                                          nullptr);
+                if (received < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    break; // EAGAIN 或其他错误：回到 async_wait，关闭的 socket 会在那里返回错误
+                }
+
+                auto batch = slab.collect(static_cast<size_t>(received));
+                if (!batch.empty())
+                {
+                    handler(batch);
+                }
+
+                if (static_cast<size_t>(received) < batchSize)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    bool gsoEnabled{false};
+
+    struct alignas(cmsghdr) GsoControl
+    {
+        uint8_t data[CMSG_SPACE(sizeof(uint16_t))];
+    };
+
+    /**
+     * @brief 一个 mmsghdr 覆盖的队列区间（GSO 合并时一个报文包含多个数据报）
+     */
+    struct MessageRun
+    {
+        size_t first;
+        size_t count;
+    };
+
+    std::vector<mmsghdr> sendHeaders;
+    std::vector<iovec> sendIovecs;
+    std::vector<GsoControl> sendControls;
+    std::vector<MessageRun> sendRuns;
+
+    /**
+     * @brief 计算从 first 开始可合并为一个 GSO 报文的数据报数量
+     * 要求目标地址相同，且除最后一个外长度都等于首个分段长度
+     */
+    [[nodiscard]] size_t gsoRunLength(size_t first) const
+    {
+        if (!gsoEnabled)
+        {
+            return 1;
+        }
+
+        const auto& head = sendQueue[first];
+        size_t total = head.size;
+        size_t next = first + 1;
+        while (next < sendQueue.size() && next - first < MAX_GSO_SEGMENTS)
+        {
+            const auto& candidate = sendQueue[next];
+            if (sendQueue[next - 1].size != head.size || candidate.size > head.size ||
+                total + candidate.size > MAX_GSO_BYTES || !(candidate.to == head.to))
+            {
+                break;
+            }
+            total += candidate.size;
+            ++next;
+        }
+        return next - first;
+    }
+
+    void buildMessages()
+    {
+        sendHeaders.clear();
+        sendIovecs.clear();
+        sendControls.clear();
+        sendRuns.clear();
+        // 预留容量保证 mmsghdr 中引用的 iovec / cmsg 地址稳定
+        sendIovecs.reserve(sendQueue.size());
+        sendControls.reserve(sendQueue.size());
+
+        for (size_t first = 0; first < sendQueue.size();)
+        {
+            const size_t count = gsoRunLength(first);
+            const auto& head = sendQueue[first];
+            const auto& last = sendQueue[first + count - 1];
+
+            auto& iov = sendIovecs.emplace_back();
+            iov.iov_base = sendBytes.data() + head.offset;
+            iov.iov_len = last.offset + last.size - head.offset;
+
+            mmsghdr header{};
+            header.msg_hdr.msg_name = const_cast<void*>(head.to.sockaddrData()); // NOLINT
+            header.msg_hdr.msg_namelen = static_cast<socklen_t>(head.to.sockaddrSize());
+            header.msg_hdr.msg_iov = &iov;
+            header.msg_hdr.msg_iovlen = 1;
+
+#if defined(UDP_SEGMENT)
+            if (count > 1)
+            {
+                auto& control = sendControls.emplace_back();
+                header.msg_hdr.msg_control = control.data;
+                header.msg_hdr.msg_controllen = sizeof(control.data);
+                cmsghdr* cmsg = CMSG_FIRSTHDR(&header.msg_hdr);
+                cmsg->cmsg_level = SOL_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                const auto segmentSize = static_cast<uint16_t>(head.size);
+                std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+            }
+#endif
+            sendHeaders.push_back(header);
+            sendRuns.push_back(MessageRun{.first = first, .count = count});
+            first += count;
+        }
+    }
+
+    /**
+     * @brief 用 sendmmsg 发出整个队列
+     * @return 实际发生的系统调用次数
+     */
+    size_t sendQueuedMessages()
+    {
+        buildMessages();
+
+        size_t syscalls = 0;
+        size_t sent = 0;
+        while (sent < sendHeaders.size())
+        {
+            const size_t remaining = sendHeaders.size() - sent;
+            const auto chunk = static_cast<unsigned int>(std::min<size_t>(remaining, MAX_MMSG_PER_CALL));
+            const int result = ::sendmmsg(socket.native_handle(), sendHeaders.data() + sent, chunk, 0);
+            ++syscalls;
+            if (result > 0)
+            {
+                sent += static_cast<size_t>(result);
+                continue;
+            }
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (gsoEnabled && result < 0 && (errno == EIO || errno == EINVAL))
+            {
+                // 网卡或路由不支持 GSO：关闭 GSO 并逐个补发剩余数据报
+                gsoEnabled = false;
+                for (size_t run = sent; run < sendRuns.size(); ++run)
+                {
+                    for (size_t i = 0; i < sendRuns[run].count; ++i)
+                    {
+                        const auto& queued = sendQueue[sendRuns[run].first + i];
+                        auto payload = std::span<const uint8_t>(sendBytes).subspan(queued.offset, queued.size);
+                        if (!sendImmediate(queued.to, payload))
+                        {
+                            stats.dropped++;
+                        }
+                        ++syscalls;
+                    }
+                }
+                break;
+            }
+            if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS))
+            {
+                // 发送缓冲区满：丢弃剩余数据报，由 KCP 负责重传
+                for (size_t run = sent; run < sendRuns.size(); ++run)
+                {
+                    stats.dropped += sendRuns[run].count;
+                }
+                break;
+            }
+            // sendmmsg 把单个目标的错误（不可达、被防火墙拒绝、超长等）报告在第一条未发出的消息上：
+            // 只跳过这一条，其后发往其他目标的数据报照常发送
+            stats.dropped += sendRuns[sent].count;
+            ++sent;
+        }
+        return syscalls;
+    }
+#endif
 };
 
 AsioUdpTransport::AsioUdpTransport(const asio::any_io_executor& exec, uint16_t port)
-    : m_impl(std::make_unique<Impl>(exec, port))
+    : m_impl(std::make_unique<Impl>(exec, port, false))
+{
+}
+
+AsioUdpTransport::AsioUdpTransport(const asio::any_io_executor& exec, uint16_t port, bool reusePort)
+    : m_impl(std::make_unique<Impl>(exec, port, reusePort))
 {
 }
 
@@ -58,8 +426,28 @@ AsioUdpTransport::~AsioUdpTransport() = default;
 
 void AsioUdpTransport::send(const NetAddress& address, std::span<const uint8_t> data)
 {
-    asio::error_code ec;
-    m_impl->socket.send_to(asio::buffer(data.data(), data.size()), address.toAsioEndpoint(), 0, ec);
+    if (m_impl->batching)
+    {
+        m_impl->enqueue(address, data);
+        return;
+    }
+    m_impl->sendImmediate(address, data);
+}
+
+void AsioUdpTransport::beginBatch()
+{
+    m_impl->batching = true;
+}
+
+void AsioUdpTransport::flush()
+{
+    m_impl->flushQueue();
+    m_impl->batching = false;
+}
+
+SendBatchStats AsioUdpTransport::sendStats() const
+{
+    return m_impl->stats;
 }
 
 uint16_t AsioUdpTransport::localPort() const
@@ -67,13 +455,70 @@ uint16_t AsioUdpTransport::localPort() const
     return m_impl->socket.local_endpoint().port();
 }
 
+bool AsioUdpTransport::steerByConv(uint32_t groupSize)
+{
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+    if (groupSize == 0)
+    {
+        return false;
+    }
+    // 过滤器运行时数据起点为 UDP 载荷，BPF_LEN 为载荷长度；KCP 的 conv 为小端序，从高字节起逐字节拼出后取模。
+    // 载荷不足 4 字节时先行返回越界下标，内核对越界下标回退到默认的四元组哈希：这类数据报（不是 KCP 报文）
+    // 按来源均匀分散到组内各 socket，不具有 conv 亲和性。若让越界加载终止程序，会返回 0，全部压到第 0 个 socket。
+    constexpr uint32_t FALLBACK_TO_HASH = 0xFFFFFFFF;
+    std::array<sock_filter, 18> program{{
+        {BPF_LD | BPF_W | BPF_LEN, 0, 0, 0},
+        {BPF_JMP | BPF_JGE | BPF_K, 1, 0, 4},
+        {BPF_RET | BPF_K, 0, 0, FALLBACK_TO_HASH},
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, 3},
+        {BPF_ALU | BPF_LSH | BPF_K, 0, 0, 8},
+        {BPF_MISC | BPF_TAX, 0, 0, 0},
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, 2},
+        {BPF_ALU | BPF_OR | BPF_X, 0, 0, 0},
+        {BPF_ALU | BPF_LSH | BPF_K, 0, 0, 8},
+        {BPF_MISC | BPF_TAX, 0, 0, 0},
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, 1},
+        {BPF_ALU | BPF_OR | BPF_X, 0, 0, 0},
+        {BPF_ALU | BPF_LSH | BPF_K, 0, 0, 8},
+        {BPF_MISC | BPF_TAX, 0, 0, 0},
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, 0},
+        {BPF_ALU | BPF_OR | BPF_X, 0, 0, 0},
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, groupSize},
+        {BPF_RET | BPF_A, 0, 0, 0},
+    }};
+    sock_fprog fprog{.len = static_cast<unsigned short>(program.size()), .filter = program.data()};
+    return ::setsockopt(
+               m_impl->socket.native_handle(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &fprog, sizeof(fprog)) == 0;
+#else
+    static_cast<void>(groupSize);
+    return false;
+#endif
+}
+
 void AsioUdpTransport::stop()
 {
     asio::error_code ec;
     m_impl->socket.close(ec);
 }
 
-void AsioUdpTransport::startRecvLoop(std::function<void(const NetAddress&, std::span<const uint8_t>)> handler)
+void AsioUdpTransport::startRecvLoop(RecvHandler handler)
 {
     asio::co_spawn(m_impl->socket.get_executor(), m_impl->recvLoop(std::move(handler)), asio::detached);
-}
\ No newline at end of file
+}
+
+void AsioUdpTransport::startBatchRecvLoop(BatchRecvHandler handler, size_t batchSize)
+{
+#if defined(__linux__)
+    asio::co_spawn(m_impl->socket.get_executor(),
+                   m_impl->batchRecvLoop(std::move(handler), std::max<size_t>(batchSize, 1)),
+                   asio::detached);
+#else
+    // 非 Linux 平台：逐包接收，每个数据报作为单元素批次交付
+    startRecvLoop(
+        [handler = std::move(handler)](const NetAddress& from, std::span<const uint8_t> payload)
+        {
+            const UdpDatagram datagram{.from = from, .payload = payload};
+            handler(std::span<const UdpDatagram>(&datagram, 1));
+        });
+#endif
+}
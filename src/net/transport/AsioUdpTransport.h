@@ -29,7 +29,20 @@ class any_io_executor;
 class AsioUdpTransport final : public IUdpTransport
 {
 public:
+    using RecvHandler = std::function<void(const NetAddress&, std::span<const uint8_t>)>;
+    using BatchRecvHandler = std::function<void(std::span<const UdpDatagram>)>;
+
+    static constexpr size_t DEFAULT_RECV_BATCH = 32;
+
     AsioUdpTransport(const asio::any_io_executor& exec, uint16_t port);
+
+    /**
+     * @brief 构造函数
+     * @param exec ASIO 执行器
+     * @param port 绑定端口（0 表示由系统分配）
+     * @param reusePort 是否开启 SO_REUSEPORT，允许多个 socket 绑定同一端口（平台不支持时忽略）
+     */
+    AsioUdpTransport(const asio::any_io_executor& exec, uint16_t port, bool reusePort);
     ~AsioUdpTransport();
 
     /**
@@ -39,11 +52,36 @@ public:
      */
     void send(const NetAddress& address, std::span<const uint8_t> data) override;
 
+    /**
+     * @brief 开启发送队列，之后的 send 只入队
+     */
+    void beginBatch() override;
+
+    /**
+     * @brief 发出队列中的数据报
+     * Linux 下使用 sendmmsg 一次系统调用发出整批，内核支持 UDP GSO 时
+     * 发往同一地址的等长分段会进一步合并为一个超大报文由内核切分
+     */
+    void flush() override;
+
+    /**
+     * @brief 获取发送队列统计
+     */
+    [[nodiscard]] SendBatchStats sendStats() const override;
+
     /**
      * @brief 获取本地绑定端口
      */
     [[nodiscard]] uint16_t localPort() const;
 
+    /**
+     * @brief 为本 socket 所在的 SO_REUSEPORT 组安装按 conv 分流的内核过滤器
+     * 内核按载荷前 4 字节（小端 conv）对 groupSize 取模选择组内第 i 个绑定的 socket，
+     * 使同一会话的数据报总是落到同一个 socket 上；不足 4 字节的数据报由内核按四元组哈希分配
+     * @return 仅 Linux 且安装成功时返回 true
+     */
+    bool steerByConv(uint32_t groupSize);
+
     /**
      * @brief 停止传输
      */
@@ -53,7 +91,16 @@ public:
      * @brief 启动接收循环（回调模式，隔离 ASIO 协程）
      * @param handler 处理函数：void(const NetAddress&, std::span<const uint8_t>)
      */
-    void startRecvLoop(std::function<void(const NetAddress&, std::span<const uint8_t>)> handler);
+    void startRecvLoop(RecvHandler handler);
+
+    /**
+     * @brief 启动批量接收循环
+     * Linux 下每次唤醒通过 recvmmsg 最多收取 batchSize 个数据报，整批交给 handler；
+     * 其他平台退化为逐包接收，每批仅含 1 个数据报
+     * @param handler 处理函数：void(std::span<const UdpDatagram>)
+     * @param batchSize 单次系统调用最多收取的数据报数量
+     */
+    void startBatchRecvLoop(BatchRecvHandler handler, size_t batchSize = DEFAULT_RECV_BATCH);
 
 private:
     // Pimpl 模式：隐藏 ASIO 实现
@@ -18,6 +18,34 @@
 #include <span>
 #include <cstdint>
 
+/**
+ * @brief 接收到的单个 UDP 数据报（来源地址 + 载荷视图）
+ * @note payload 指向传输层内部缓冲区，仅在回调期间有效
+ */
+struct UdpDatagram
+{
+    NetAddress from;
+    std::span<const uint8_t> payload;
+};
+
+/**
+ * @brief 批量发送统计
+ */
+struct SendBatchStats
+{
+    uint64_t flushes = 0;   // 非空批次的 flush 次数
+    uint64_t datagrams = 0; // 经发送队列发出的数据报数量
+    uint64_t syscalls = 0;  // 为发出这些数据报实际发生的系统调用次数
+    uint64_t dropped = 0;   // 其中因发送失败被丢弃的数据报数量
+
+    [[nodiscard]] double datagramsPerFlush() const noexcept
+    {
+        return flushes == 0 ? 0.0 : static_cast<double>(datagrams) / static_cast<double>(flushes);
+    }
+
+    [[nodiscard]] uint64_t syscallsSaved() const noexcept { return datagrams > syscalls ? datagrams - syscalls : 0; }
+};
+
 class IUdpTransport
 {
 public:
@@ -29,4 +57,20 @@ public:
     virtual ~IUdpTransport() = default;
 
     virtual void send(const NetAddress& address, std::span<const uint8_t> data) = 0;
+
+    /**
+     * @brief 开启发送队列：此后的 send 只拷贝入队，直到 flush 时统一发出
+     * @note 默认实现不排队，send 立即发送
+     */
+    virtual void beginBatch() {}
+
+    /**
+     * @brief 发出 beginBatch 以来排队的全部数据报并结束本批次
+     */
+    virtual void flush() {}
+
+    /**
+     * @brief 获取发送队列统计
+     */
+    [[nodiscard]] virtual SendBatchStats sendStats() const { return {}; }
 };
\ No newline at end of file
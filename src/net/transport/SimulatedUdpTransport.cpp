@@ -0,0 +1,234 @@
+/**
+ * ************************************************************************
+ *
+ * @file SimulatedUdpTransport.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 进程内网络模拟器实现
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include "SimulatedUdpTransport.h"
+#include "../common/PacketPool.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+constexpr uint16_t AUTO_ADDRESS_PORT = 7000;
+constexpr uint64_t US_PER_MS = 1'000;
+constexpr uint64_t US_PER_SEC = 1'000'000;
+
+/**
+ * @brief 在途数据报
+ */
+struct InFlight
+{
+    uint64_t deliverAtUs = 0;
+    uint64_t seq = 0; // 同一时刻到达的数据报按发送顺序投递
+    NetAddress from;
+    NetAddress to;
+    PacketBuffer payload;
+};
+
+// 小顶堆比较：到达时间早的在堆顶
+bool arrivesLater(const InFlight& lhs, const InFlight& rhs) noexcept
+{
+    return lhs.deliverAtUs != rhs.deliverAtUs ? lhs.deliverAtUs > rhs.deliverAtUs : lhs.seq > rhs.seq;
+}
+} // namespace
+
+// Pimpl 实现
+struct SimulatedNetwork::Impl
+{
+    LinkConditions defaults;
+    std::mt19937_64 rng;
+    uint64_t nowUs = 0;
+    uint64_t nextSeq = 0;
+    uint32_t nextHost = 0;
+    std::unordered_map<NetAddress, const SimulatedUdpTransport::BatchRecvHandler*> routes; // 地址 -> 接收回调
+    std::vector<InFlight> heap;
+    PacketPool pool;
+    SimulatedNetworkStats stats;
+
+    Impl(const LinkConditions& linkDefaults, uint64_t seed) : defaults(linkDefaults), rng(seed) {}
+
+    // 不使用 std 分布：其实现因标准库而异，手工换算保证不同平台上结果一致
+    double uniform() noexcept { return static_cast<double>(rng() >> 11) * 0x1.0p-53; }
+
+    uint64_t uniformUs(uint64_t maxUs) noexcept { return maxUs == 0 ? 0 : rng() % (maxUs + 1); }
+
+    void enqueue(const NetAddress& from,
+                 const LinkConditions& link,
+                 uint64_t& busyUntilUs,
+                 const NetAddress& to,
+                 std::span<const uint8_t> data)
+    {
+        ++stats.sent;
+
+        // 带宽：数据报排在发送队列之后串行发出
+        uint64_t departUs = nowUs;
+        if (link.bandwidthBytesPerSec != 0)
+        {
+            const uint64_t startUs = std::max(nowUs, busyUntilUs);
+            const uint64_t backlogBytes = (startUs - nowUs) * link.bandwidthBytesPerSec / US_PER_SEC;
+            if (link.queueLimitBytes != 0 && backlogBytes + data.size() > link.queueLimitBytes)
+            {
+                ++stats.queueDropped;
+                return;
+            }
+            const uint64_t serializeUs =
+                ((data.size() * US_PER_SEC) + link.bandwidthBytesPerSec - 1) / link.bandwidthBytesPerSec;
+            departUs = startUs + serializeUs;
+            busyUntilUs = departUs;
+        }
+
+        // 丢包发生在链路上，已占用的带宽不退回
+        if (link.lossRate > 0.0 && uniform() < link.lossRate)
+        {
+            ++stats.lost;
+            return;
+        }
+
+        uint64_t deliverAtUs = departUs + (link.latencyMs * US_PER_MS) + uniformUs(link.jitterMs * US_PER_MS);
+        if (link.reorderRate > 0.0 && uniform() < link.reorderRate)
+        {
+            ++stats.reordered;
+            deliverAtUs += link.reorderDelayMs * US_PER_MS;
+        }
+
+        PacketBuffer payload = pool.acquire(data.size());
+        std::copy(data.begin(), data.end(), payload.data());
+        heap.push_back(InFlight{deliverAtUs, nextSeq++, from, to, std::move(payload)});
+        std::push_heap(heap.begin(), heap.end(), arrivesLater);
+    }
+
+    void advanceTo(uint64_t targetUs)
+    {
+        while (!heap.empty() && heap.front().deliverAtUs <= targetUs)
+        {
+            std::pop_heap(heap.begin(), heap.end(), arrivesLater);
+            InFlight datagram = std::move(heap.back());
+            heap.pop_back();
+            nowUs = std::max(nowUs, datagram.deliverAtUs);
+
+            auto it = routes.find(datagram.to);
+            if (it == routes.end() || !*it->second)
+            {
+                ++stats.unroutable;
+                continue;
+            }
+            ++stats.delivered;
+            stats.bytesDelivered += datagram.payload.size();
+
+            // 先出堆再回调：回调中的 send 会入堆
+            const UdpDatagram view{datagram.from, datagram.payload.span()};
+            (*it->second)(std::span<const UdpDatagram>(&view, 1));
+        }
+        nowUs = std::max(nowUs, targetUs);
+    }
+};
+
+SimulatedNetwork::SimulatedNetwork(const LinkConditions& defaults, uint64_t seed)
+    : m_impl(std::make_unique<Impl>(defaults, seed))
+{
+}
+
+SimulatedNetwork::~SimulatedNetwork() = default;
+
+std::unique_ptr<SimulatedUdpTransport> SimulatedNetwork::createTransport()
+{
+    while (true)
+    {
+        const uint32_t host = ++m_impl->nextHost;
+        const std::string ip = "10." + std::to_string((host >> 16) & 0xFF) + "." +
+                               std::to_string((host >> 8) & 0xFF) + "." + std::to_string(host & 0xFF);
+        const NetAddress address(ip, AUTO_ADDRESS_PORT);
+        if (auto transport = createTransport(address))
+        {
+            return transport;
+        }
+    }
+}
+
+std::unique_ptr<SimulatedUdpTransport> SimulatedNetwork::createTransport(const NetAddress& address)
+{
+    auto [it, inserted] = m_impl->routes.try_emplace(address, nullptr);
+    if (!inserted)
+    {
+        return nullptr;
+    }
+    std::unique_ptr<SimulatedUdpTransport> transport(new SimulatedUdpTransport(*this, address, m_impl->defaults));
+    it->second = &transport->m_handler;
+    return transport;
+}
+
+void SimulatedNetwork::advanceTo(uint64_t nowUs)
+{
+    m_impl->advanceTo(nowUs);
+}
+
+uint64_t SimulatedNetwork::nowUs() const noexcept
+{
+    return m_impl->nowUs;
+}
+
+uint32_t SimulatedNetwork::nowMs() const noexcept
+{
+    return static_cast<uint32_t>(m_impl->nowUs / US_PER_MS);
+}
+
+size_t SimulatedNetwork::inFlight() const noexcept
+{
+    return m_impl->heap.size();
+}
+
+SimulatedNetworkStats SimulatedNetwork::stats() const noexcept
+{
+    return m_impl->stats;
+}
+
+SimulatedUdpTransport::SimulatedUdpTransport(SimulatedNetwork& network,
+                                             const NetAddress& address,
+                                             const LinkConditions& conditions)
+    : m_network(network), m_address(address), m_conditions(conditions)
+{
+}
+
+SimulatedUdpTransport::~SimulatedUdpTransport()
+{
+    m_network.m_impl->routes.erase(m_address);
+}
+
+void SimulatedUdpTransport::send(const NetAddress& address, std::span<const uint8_t> data)
+{
+    m_network.m_impl->enqueue(m_address, m_conditions, m_busyUntilUs, address, data);
+}
+
+void SimulatedUdpTransport::setRecvHandler(BatchRecvHandler handler)
+{
+    m_handler = std::move(handler);
+}
+
+void SimulatedUdpTransport::setConditions(const LinkConditions& conditions)
+{
+    m_conditions = conditions;
+}
+
+const LinkConditions& SimulatedUdpTransport::conditions() const noexcept
+{
+    return m_conditions;
+}
+
+const NetAddress& SimulatedUdpTransport::localAddress() const noexcept
+{
+    return m_address;
+}
@@ -0,0 +1,159 @@
+/**
+ * ************************************************************************
+ *
+ * @file SimulatedUdpTransport.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 进程内网络模拟器：虚拟时钟驱动的 UDP 传输层（压测、延迟测试用）
+ *
+ * SimulatedNetwork 持有虚拟时钟与所有在途数据报，按链路条件（时延、抖动、丢包、乱序、带宽）
+ * 计算每个数据报的到达时间；advanceTo 推进时钟时按到达顺序投递给目标传输层的接收回调。
+ * 不使用真实 socket，同一随机种子下整个模拟过程可完全复现。
+ *
+ * @note 单线程使用：send、advanceTo 与接收回调都应在驱动模拟的同一线程上执行
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "IUdpTransport.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+
+/**
+ * @brief 单向链路条件（作用于某个传输层发出的数据报）
+ */
+struct LinkConditions
+{
+    uint32_t latencyMs = 0;            // 固定单向时延
+    uint32_t jitterMs = 0;             // 附加时延，均匀分布于 [0, jitterMs]
+    double lossRate = 0.0;             // 丢包概率
+    double reorderRate = 0.0;          // 数据报被额外延迟（从而被后发的包超过）的概率
+    uint32_t reorderDelayMs = 0;       // 被乱序的数据报的额外时延
+    uint64_t bandwidthBytesPerSec = 0; // 发送带宽上限，0 表示不限
+    uint32_t queueLimitBytes = 0;      // 带宽受限时发送队列的容量，超出即丢弃（0 表示不限）
+};
+
+/**
+ * @brief 模拟网络统计
+ */
+struct SimulatedNetworkStats
+{
+    uint64_t sent = 0;           // send 调用次数
+    uint64_t delivered = 0;      // 已投递的数据报
+    uint64_t bytesDelivered = 0; // 已投递的载荷字节
+    uint64_t lost = 0;           // 按丢包率丢弃
+    uint64_t queueDropped = 0;   // 发送队列溢出丢弃
+    uint64_t reordered = 0;      // 被额外延迟的数据报
+    uint64_t unroutable = 0;     // 到达时目标地址无人监听
+};
+
+class SimulatedUdpTransport;
+
+/**
+ * @brief 虚拟网络：虚拟时钟 + 在途数据报队列 + 地址路由
+ */
+class SimulatedNetwork
+{
+public:
+    /**
+     * @param defaults 新建传输层的默认链路条件
+     * @param seed 随机种子（丢包、抖动、乱序）
+     */
+    explicit SimulatedNetwork(const LinkConditions& defaults = {}, uint64_t seed = 1);
+    ~SimulatedNetwork();
+
+    SimulatedNetwork(const SimulatedNetwork&) = delete;
+    SimulatedNetwork& operator=(const SimulatedNetwork&) = delete;
+    SimulatedNetwork(SimulatedNetwork&&) = delete;
+    SimulatedNetwork& operator=(SimulatedNetwork&&) = delete;
+
+    /**
+     * @brief 创建绑定到自动分配地址（10.x.y.z:7000）的传输层
+     * @note 传输层必须先于 SimulatedNetwork 销毁
+     */
+    [[nodiscard]] std::unique_ptr<SimulatedUdpTransport> createTransport();
+
+    /**
+     * @brief 创建绑定到指定地址的传输层（地址已被占用时返回 nullptr）
+     */
+    [[nodiscard]] std::unique_ptr<SimulatedUdpTransport> createTransport(const NetAddress& address);
+
+    /**
+     * @brief 推进虚拟时钟，按到达时间顺序投递此前到期的全部数据报
+     * @param nowUs 目标时间（微秒），早于当前时间时忽略
+     * @note 接收回调中发出的数据报若在 nowUs 之前到期，也会在本次调用中投递
+     */
+    void advanceTo(uint64_t nowUs);
+
+    /**
+     * @brief 当前虚拟时间（微秒 / 毫秒）
+     */
+    [[nodiscard]] uint64_t nowUs() const noexcept;
+    [[nodiscard]] uint32_t nowMs() const noexcept;
+
+    /**
+     * @brief 在途数据报数量
+     */
+    [[nodiscard]] size_t inFlight() const noexcept;
+
+    [[nodiscard]] SimulatedNetworkStats stats() const noexcept;
+
+private:
+    friend class SimulatedUdpTransport;
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief 模拟网络上的一个 UDP 端口
+ */
+class SimulatedUdpTransport final : public IUdpTransport
+{
+public:
+    using BatchRecvHandler = std::function<void(std::span<const UdpDatagram>)>;
+
+    ~SimulatedUdpTransport() override;
+
+    SimulatedUdpTransport(const SimulatedUdpTransport&) = delete;
+    SimulatedUdpTransport& operator=(const SimulatedUdpTransport&) = delete;
+    SimulatedUdpTransport(SimulatedUdpTransport&&) = delete;
+    SimulatedUdpTransport& operator=(SimulatedUdpTransport&&) = delete;
+
+    /**
+     * @brief 把数据报放入虚拟网络，按本端链路条件计算到达时间
+     */
+    void send(const NetAddress& address, std::span<const uint8_t> data) override;
+
+    /**
+     * @brief 设置接收回调（签名与 AsioUdpTransport::BatchRecvHandler 相同，可直接接 KcpEndpoint::input）
+     */
+    void setRecvHandler(BatchRecvHandler handler);
+
+    /**
+     * @brief 修改本端发出方向的链路条件（不影响已在途的数据报）
+     */
+    void setConditions(const LinkConditions& conditions);
+
+    [[nodiscard]] const LinkConditions& conditions() const noexcept;
+
+    [[nodiscard]] const NetAddress& localAddress() const noexcept;
+
+private:
+    friend class SimulatedNetwork;
+
+    SimulatedUdpTransport(SimulatedNetwork& network, const NetAddress& address, const LinkConditions& conditions);
+
+    SimulatedNetwork& m_network;
+    NetAddress m_address;
+    LinkConditions m_conditions;
+    BatchRecvHandler m_handler;
+    uint64_t m_busyUntilUs = 0; // 带宽受限时，发送队列清空的时间点
+};
@@ -14,19 +14,20 @@
  * For study and research only, no reprinting.
  * ************************************************************************
  */
+#pragma once
 #include <entt/entt.hpp>
 #include <entt/poly/poly.hpp>
-#include "src/context/GameContext.h"
+#include "src/server/context/GameContext.h"
 #include "absl/container/flat_hash_map.h"
 struct ISkill : entt::type_list<>
 {
     template <typename Base>
     struct type : Base
     {
-        void onUse() const { return this->template invoke<0>(*this); }
+        void onUse() const { entt::poly_call<0>(*this); }
         absl::flat_hash_map<entt::entity, bool> filterTargets(entt::entity pt1) const
         {
-            return this->template invoke<1>(*this, pt1);
+            return entt::poly_call<1>(*this, pt1);
         }
     };
 
@@ -20,6 +20,8 @@
 #include <entt/entt.hpp>
 #include <span> // 需要包含 span
 #include "src/shared/common/Common.h"
+#include "src/server/components/CardId.h"
+#include "src/server/data/CardDatabaseFormat.h"
 
 // --------------------------------------------------------------------------
 // 1. 卡牌组件定义 (Component: Data Only)
@@ -27,7 +29,7 @@
 
 struct MetaCardInfo
 {
-    std::string name;
+    CardId id;
     std::string description;
     CardType type = CardType::BASIC;
 };
@@ -54,6 +56,37 @@ struct CardPointAndSuit
     SuitType suit = SuitType::JOKER; // JOKER表示无花色
 };
 
+// 卡牌数据库（carddb）的编码与玩法枚举逐值一致，两边之间直接 static_cast
+static_assert(static_cast<uint8_t>(SuitType::SPADE) == static_cast<uint8_t>(carddb::Suit::SPADE) &&
+              static_cast<uint8_t>(SuitType::HEART) == static_cast<uint8_t>(carddb::Suit::HEART) &&
+              static_cast<uint8_t>(SuitType::CLUB) == static_cast<uint8_t>(carddb::Suit::CLUB) &&
+              static_cast<uint8_t>(SuitType::DIAMOND) == static_cast<uint8_t>(carddb::Suit::DIAMOND) &&
+              static_cast<uint8_t>(SuitType::JOKER) == static_cast<uint8_t>(carddb::Suit::JOKER));
+static_assert(static_cast<uint8_t>(CardType::BASIC) == static_cast<uint8_t>(carddb::Type::BASIC) &&
+              static_cast<uint8_t>(CardType::STRATEGY) == static_cast<uint8_t>(carddb::Type::STRATEGY));
+static_assert(static_cast<uint8_t>(BasicCardType::STRIKE) == static_cast<uint8_t>(carddb::BasicType::STRIKE) &&
+              static_cast<uint8_t>(BasicCardType::DODGE) == static_cast<uint8_t>(carddb::BasicType::DODGE) &&
+              static_cast<uint8_t>(BasicCardType::PEACH) == static_cast<uint8_t>(carddb::BasicType::PEACH) &&
+              static_cast<uint8_t>(BasicCardType::ALCOHOL) == static_cast<uint8_t>(carddb::BasicType::ALCOHOL));
+static_assert(
+    static_cast<uint8_t>(StrategyCardType::FIRE_ATTACK) == static_cast<uint8_t>(carddb::StrategyType::FIRE_ATTACK) &&
+    static_cast<uint8_t>(StrategyCardType::DUEL) == static_cast<uint8_t>(carddb::StrategyType::DUEL));
+
+constexpr SuitType toSuitType(carddb::Suit suit) noexcept
+{
+    return static_cast<SuitType>(suit);
+}
+
+constexpr carddb::Suit toDatabaseSuit(SuitType suit) noexcept
+{
+    return static_cast<carddb::Suit>(suit);
+}
+
+constexpr CardType toCardType(carddb::Type type) noexcept
+{
+    return static_cast<CardType>(type);
+}
+
 // **已删除 CardEffect 结构体，逻辑将由 EffectSystem 处理**
 
 // --------------------------------------------------------------------------
@@ -129,142 +162,3 @@ inline entt::entity CreateEquipCard(entt::registry& reg,
     reg.emplace<EquipCardTypeTag>(ent, EquipCardTypeTag{equipType});
     return ent;
 }
-
-// --------------------------------------------------------------------------
-// 4. 具体卡牌创建函数 (Factory: Specific Cards)
-// --------------------------------------------------------------------------
-
-/**
- * @brief 创建杀卡牌实体
- * @param reg 注册表
- * @param pointAndSuit 点数和花色
- * @return entt::entity 实体ID
- */
-inline entt::entity CreateStrickCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
-{
-    CardTarget target{
-        .needTarget = true,
-        .maxTargets = 1,
-        .minTargets = 1,
-        .range = 1,
-    };
-    CardCost cost{};
-
-    // **Effect 逻辑已移除**
-
-    return CreateBasicCard(reg,
-                           {.name = "杀", .description = "需要使用一张闪否则造成一点伤害", .type = CardType::BASIC},
-                           cost,
-                           target,
-                           pointAndSuit,
-                           BasicCardType::STRIKE);
-}
-
-/**
- * @brief 创建闪卡牌实体
- * @param reg 注册表
- * @param pointAndSuit 点数和花色
- * @return entt::entity 实体ID
- */
-inline entt::entity CreateDodgeCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
-{
-    CardTarget target{.needTarget = false, .maxTargets = 0, .minTargets = 0, .range = 0};
-    MetaCardInfo metaInfo{.name = "闪", .description = "用于抵消一张杀的伤害", .type = CardType::BASIC};
-    CardCost cost{};
-
-    // **Effect 逻辑已移除**
-
-    return CreateBasicCard(reg, metaInfo, cost, target, pointAndSuit, BasicCardType::DODGE);
-}
-
-inline entt::entity CreatePeachCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
-{
-    MetaCardInfo metaInfo{.name = "桃", .description = "回复一点体力", .type = CardType::BASIC};
-    CardTarget target{};
-    target.needTarget = true;
-    target.minTargets = 1;
-    target.maxTargets = 1;
-    target.range = 0; // 无距离限制
-    CardCost cost{};
-
-    // **Effect 逻辑已移除**
-
-    return CreateBasicCard(reg, metaInfo, cost, target, pointAndSuit, BasicCardType::PEACH);
-}
-
-/**
- * @brief 创建酒卡牌实体
- * @param reg 注册表
- * @param pointAndSuit 点数和花色
- * @return entt::entity 实体ID
- */
-inline entt::entity CreateAlcoholCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
-{
-    CardTarget target{};
-    target.needTarget = true;
-    target.minTargets = 1;
-    target.maxTargets = 1;
-    target.range = 0; // 无距离限制
-
-    // **修复：MetaInfo -> MetaCardInfo**
-    MetaCardInfo metaInfo{.name = "酒",
-                          .description = "回合内使用后，下一次受到的伤害-1（至少为1）,濒死状态下使用可回复1点体力",
-                          .type = CardType::BASIC};
-    CardCost cost{};
-
-    // **Effect 逻辑已移除**
-
-    return CreateBasicCard(reg, metaInfo, cost, target, pointAndSuit, BasicCardType::ALCOHOL);
-}
-
-/**
- * @brief 创建火攻卡牌实体
- * @param reg 注册表
- * @param pointAndSuit 点数和花色
- * @return entt::entity 实体ID
- */
-inline entt::entity CreateFireAttackCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
-{
-    CardTarget target{};
-    target.needTarget = true;
-    target.minTargets = 1;
-    target.maxTargets = 1;
-    target.range = 0;
-
-    // **修复：MetaInfo -> MetaCardInfo**
-    MetaCardInfo metaInfo{.name = "火攻",
-                          .description = "对目标角色造成一点火焰伤害，目标角色可以使用一张闪避来抵消伤害",
-                          .type = CardType::STRATEGY};
-    CardCost cost{};
-
-    // **Effect 逻辑已移除**
-
-    return CreateStrategyCard(reg, metaInfo, cost, target, pointAndSuit, StrategyCardType::FIRE_ATTACK);
-}
-
-/**
- * @brief 创建决斗卡牌实体
- * @param reg 注册表
- * @param pointAndSuit 点数和花色
- * @return entt::entity 实体ID
- */
-inline entt::entity CreateDuelCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
-{
-    CardTarget target{
-        .needTarget = true,
-        .maxTargets = 1,
-        .minTargets = 1,
-
-        .range = 0xFF, // 无距离限制
-    };
-
-    // **修复：MetaInfo -> MetaCardInfo**
-    MetaCardInfo metaInfo{.name = "决斗",
-                          .description = "与你指定的角色进行决斗，双方轮流出杀，未能出杀的一方受到一点伤害",
-                          .type = CardType::STRATEGY};
-    CardCost cost{};
-
-    // **Effect 逻辑已移除**
-
-    return CreateStrategyCard(reg, metaInfo, cost, target, pointAndSuit, StrategyCardType::DUEL);
-}
\ No newline at end of file
@@ -0,0 +1,37 @@
+/**
+ * ************************************************************************
+ *
+ * @file CardId.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 卡牌标识与牌堆中卡牌实体携带的数据库下标，卡牌数据库只依赖本文件
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+#include "src/utils/Intern.h"
+
+// 卡牌标识：牌名的 32 位哈希，热路径上只比较标识，牌名文本经 utils::text() 取回用于日志与界面
+using CardId = utils::Interned<struct CardIdTag>;
+
+namespace cards
+{
+inline const CardId STRIKE = utils::intern<CardId>("杀");
+inline const CardId DODGE = utils::intern<CardId>("闪");
+inline const CardId PEACH = utils::intern<CardId>("桃");
+inline const CardId ALCOHOL = utils::intern<CardId>("酒");
+inline const CardId FIRE_ATTACK = utils::intern<CardId>("火攻");
+inline const CardId DUEL = utils::intern<CardId>("决斗");
+} // namespace cards
+
+// 牌堆中的牌只携带它在 CardDatabase 整副牌中的下标，牌名、花色、点数与目标规则都从数据库读取
+struct CardEntry
+{
+    uint16_t index = 0;
+};
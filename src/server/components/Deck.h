@@ -15,11 +15,37 @@
 
 #pragma once
 #include <entt/entt.hpp>
+#include <cstdint>
 #include <vector>
 
+/**
+ * @brief 公共牌区；抽牌堆的 back() 是牌顶，摸牌从尾部弹出
+ */
 struct Deck
 {
     std::vector<entt::entity> drawPile;       // 抽牌堆
     std::vector<entt::entity> discardPile;    // 弃牌堆
     std::vector<entt::entity> processingArea; // 处理区
 };
+
+enum class CardZone : uint8_t
+{
+    NONE,
+    DRAW_PILE,
+    DISCARD_PILE,
+    PROCESSING_AREA,
+    HAND,
+    EQUIPMENT,
+};
+
+/**
+ * @brief 卡牌当前所在的位置，由 DeckSystem 维护
+ *
+ * slot 是卡牌在所在容器中的下标（装备区为 Equipments 的第几个栏位），移动卡牌时据此 O(1) 摘除，无需查找。
+ */
+struct CardLocation
+{
+    CardZone zone = CardZone::NONE;
+    entt::entity owner = entt::null; // 手牌、装备区的持有者；公共牌区为 entt::null
+    uint32_t slot = 0;
+};
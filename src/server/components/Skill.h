@@ -21,11 +21,15 @@
 #include <entt/entt.hpp>
 #include <array>
 #include "src/shared/common/Common.h"
+#include "src/utils/Intern.h"
+
+// 技能标识：技能名的 32 位哈希，技能名文本经 utils::text() 取回用于日志与界面
+using SkillId = utils::Interned<struct SkillIdTag>;
 
 struct MetaSkillInfo
 {
-    absl::string name;
-    absl::string description; // 新增描述字段
+    SkillId id;
+    std::string description; // 新增描述字段
     bool needTarget = true;
     uint8_t maxTargets = 1;
     uint8_t minTargets = 1;
@@ -16,11 +16,26 @@
 
 #include <entt/entt.hpp>
 #include "CreateLogger.h"
-#include <asio/thread_pool.hpp>
+#include <asio/any_io_executor.hpp>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief 一局游戏（一个房间）的上下文
+ *
+ * 不持有线程：executor 由宿主提供（RoomHost 中为该房间的 strand），房间内的异步任务都投递到这里，
+ * 因此 registry 与 dispatcher 只会被串行访问。日志器通常由所有房间共享。
+ */
 struct GameContext
 {
+    explicit GameContext(asio::any_io_executor executor,
+                         std::shared_ptr<spdlog::logger> logger = CreateRollingLogger())
+        : logger(std::move(logger)), executor(std::move(executor))
+    {
+    }
+
     entt::registry registry;     // 实体组件系统注册表
     entt::dispatcher dispatcher; // 事件分发器
-    std::shared_ptr<spdlog::logger> logger = CreateRollingLogger();
-    asio::thread_pool threadPool{static_cast<std::size_t>(std::thread::hardware_concurrency()) * 2}; // 线程池
-};
\ No newline at end of file
+    std::shared_ptr<spdlog::logger> logger;
+    asio::any_io_executor executor; // 房间的执行器
+};
@@ -0,0 +1,173 @@
+/**
+ * ************************************************************************
+ *
+ * @file RoomHost.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间宿主：大量相互隔离的 GameContext 复用同一个线程池，每个房间一个 strand
+ *
+ * 每个房间有自己的 registry 与 dispatcher，但不再各自持有线程池：所有房间共享宿主的线程池（默认每核一个线程），
+ * 房间的执行器是线程池上的一个 strand。投递到同一房间的任务按顺序串行执行，不同房间的任务由空闲的工作线程
+ * 并行取走，线程数与房间数无关，一个进程可以同时承载上千桌。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "GameContext.h"
+#include <asio/post.hpp>
+#include <asio/strand.hpp>
+#include <asio/thread_pool.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief 房间宿主
+ *
+ * createRoom / closeRoom / post 可以在任意线程调用。任务以 GameContext& 为参数，在房间的 strand 上执行，
+ * 因此任务内可以直接访问 registry 与 dispatcher；任务抛出的异常被记录后丢弃，不影响其他房间。
+ * @code
+ *   RoomHost host;
+ *   auto room = host.createRoom([](GameContext& ctx) { ctx.registry.ctx().emplace<DamageSystem>(ctx); });
+ *   host.post(room, [](GameContext& ctx) { ctx.dispatcher.trigger(events::GameStart{}); });
+ * @endcode
+ */
+class RoomHost
+{
+public:
+    using RoomId = uint32_t;
+    using Setup = std::function<void(GameContext&)>;
+
+    /**
+     * @param threads 工作线程数
+     * @param logger 所有房间共享的日志器
+     */
+    explicit RoomHost(size_t threads = defaultThreadCount(),
+                      std::shared_ptr<spdlog::logger> logger = CreateRollingLogger())
+        : m_logger(std::move(logger)), m_threads(threads), m_pool(threads)
+    {
+    }
+
+    RoomHost(const RoomHost&) = delete;
+    RoomHost& operator=(const RoomHost&) = delete;
+
+    ~RoomHost() { join(); }
+
+    /**
+     * @brief 创建房间
+     * @param setup 在房间的 strand 上执行的初始化（注册系统、创建实体等），先于之后投递的任务
+     */
+    RoomId createRoom(Setup setup = {})
+    {
+        auto room = std::make_shared<GameContext>(asio::make_strand(m_pool.get_executor()), m_logger);
+        RoomId id = 0;
+        {
+            std::unique_lock lock(m_mutex);
+            id = ++m_nextId;
+            m_rooms.emplace(id, room);
+        }
+        if (setup)
+        {
+            run(id, std::move(room), std::move(setup));
+        }
+        return id;
+    }
+
+    /**
+     * @brief 关闭房间：不再接受新任务，已投递的任务执行完后房间随最后一个任务一起销毁
+     * @return 房间存在时返回 true
+     */
+    bool closeRoom(RoomId id)
+    {
+        std::unique_lock lock(m_mutex);
+        return m_rooms.erase(id) > 0;
+    }
+
+    /**
+     * @brief 把任务投递到房间的 strand
+     * @param task 可以以 GameContext& 调用的对象
+     * @return 房间不存在时返回 false
+     */
+    template <typename Task>
+    bool post(RoomId id, Task&& task)
+    {
+        auto room = find(id);
+        if (!room)
+        {
+            return false;
+        }
+        run(id, std::move(room), std::forward<Task>(task));
+        return true;
+    }
+
+    /**
+     * @brief 取得房间上下文，调用方只应在该房间的 strand 上访问 registry 与 dispatcher
+     */
+    [[nodiscard]] std::shared_ptr<GameContext> find(RoomId id) const
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_rooms.find(id);
+        return it == m_rooms.end() ? nullptr : it->second;
+    }
+
+    [[nodiscard]] size_t roomCount() const
+    {
+        std::shared_lock lock(m_mutex);
+        return m_rooms.size();
+    }
+
+    [[nodiscard]] size_t threadCount() const noexcept { return m_threads; }
+
+    /**
+     * @brief 等待已投递的任务全部执行完并结束工作线程，之后投递的任务不会再执行
+     */
+    void join() { m_pool.join(); }
+
+    static size_t defaultThreadCount() noexcept
+    {
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+private:
+    template <typename Task>
+    void run(RoomId id, std::shared_ptr<GameContext> room, Task&& task)
+    {
+        auto executor = room->executor;
+        asio::post(executor,
+                   [id, room = std::move(room), task = std::forward<Task>(task)]() mutable
+                   {
+                       try
+                       {
+                           task(*room);
+                       }
+                       catch (const std::exception& e)
+                       {
+                           room->logger->error("房间 {} 的任务抛出异常: {}", id, e.what());
+                       }
+                       catch (...)
+                       {
+                           room->logger->error("房间 {} 的任务抛出未知异常", id);
+                       }
+                   });
+    }
+
+    std::shared_ptr<spdlog::logger> m_logger;
+    size_t m_threads;
+    asio::thread_pool m_pool;
+
+    mutable std::shared_mutex m_mutex; // 保护 m_rooms 与 m_nextId
+    std::unordered_map<RoomId, std::shared_ptr<GameContext>> m_rooms;
+    RoomId m_nextId = 0;
+};
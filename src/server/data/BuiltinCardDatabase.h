@@ -0,0 +1,45 @@
+/**
+ * ************************************************************************
+ *
+ * @file BuiltinCardDatabase.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 嵌入可执行文件的内置卡牌数据库（cmrc 资源 card_data 中的 cards.bin）
+ *
+ * 使用该头文件的目标需要链接 card::data。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <cmrc/cmrc.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "CardDatabase.h"
+
+CMRC_DECLARE(card_data);
+
+/**
+ * @brief 内置卡牌数据库，首次调用时加载，之后所有房间共享
+ * @throw std::runtime_error 内置数据缺失或损坏
+ */
+inline const CardDatabase& BuiltinCardDatabase()
+{
+    static const CardDatabase database = []
+    {
+        const auto file = cmrc::card_data::get_filesystem().open("cards.bin");
+        auto loaded = CardDatabase::load({file.begin(), file.end()});
+        if (!loaded)
+        {
+            throw std::runtime_error("内置卡牌数据库损坏，错误码 " +
+                                     std::to_string(static_cast<int>(loaded.error())));
+        }
+        return std::move(*loaded);
+    }();
+    return database;
+}
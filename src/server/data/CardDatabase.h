@@ -0,0 +1,222 @@
+/**
+ * ************************************************************************
+ *
+ * @file CardDatabase.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 卡牌数据库：原地读取编译好的二进制卡牌表，卡牌实体只需携带表中的下标
+ *
+ * 数据由 resource/Card/cards.json 经 CardDbCompiler 编译为 cards.bin，再由 cmrc 嵌入可执行文件，
+ * 随可执行文件一起被映射进内存。load() 只校验头部与引用、建立检索索引，不拷贝记录与字符串；
+ * 所有房间共享同一份只读数据库。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/inlined_vector.h>
+#include <entt/core/hashed_string.hpp>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include "CardDatabaseFormat.h"
+#include "src/server/components/CardId.h"
+
+static_assert(std::endian::native == std::endian::little, "卡牌数据库按小端存储");
+
+/**
+ * @brief 卡牌检索键：牌 + 花色 + 点数，均为整数，检索不比较字符串
+ */
+struct CardKey
+{
+    CardId card;
+    carddb::Suit suit = carddb::Suit::JOKER;
+    uint8_t rank = 0;
+
+    bool operator==(const CardKey&) const = default;
+
+    template <typename H>
+    friend H AbslHashValue(H state, const CardKey& key)
+    {
+        return H::combine(std::move(state), key.card, key.suit, key.rank);
+    }
+};
+
+enum class CardDatabaseError : uint8_t
+{
+    TooSmall = 1,       // 不足一个头部
+    BadMagic,           // 不是卡牌数据库
+    UnsupportedVersion, // 格式版本不符
+    Truncated,          // 记录或字符串区超出数据长度
+    BadReference,       // 记录引用了不存在的种类或字符串，枚举值越界，或牌名与 id 不符
+};
+
+class CardDatabase
+{
+public:
+    using Indices = absl::InlinedVector<uint16_t, 4>;
+
+    /**
+     * @brief 在 blob 上建立数据库，blob 必须在数据库的生命周期内保持有效
+     * @note blob 未按 4 字节对齐时会复制一份到对齐的内部缓冲
+     */
+    static std::expected<CardDatabase, CardDatabaseError> load(std::span<const char> blob)
+    {
+        if (blob.size() < sizeof(carddb::Header))
+        {
+            return std::unexpected(CardDatabaseError::TooSmall);
+        }
+        CardDatabase database;
+        const char* data = blob.data();
+        if (reinterpret_cast<uintptr_t>(data) % alignof(carddb::KindRecord) != 0)
+        {
+            database.m_aligned = std::make_unique<uint32_t[]>((blob.size() + 3) / 4);
+            std::memcpy(database.m_aligned.get(), blob.data(), blob.size());
+            data = reinterpret_cast<const char*>(database.m_aligned.get());
+        }
+
+        const auto* header = reinterpret_cast<const carddb::Header*>(data);
+        if (header->magic != carddb::MAGIC)
+        {
+            return std::unexpected(CardDatabaseError::BadMagic);
+        }
+        if (header->version != carddb::VERSION)
+        {
+            return std::unexpected(CardDatabaseError::UnsupportedVersion);
+        }
+        if (carddb::stringsOffset(*header) + header->stringBytes > blob.size())
+        {
+            return std::unexpected(CardDatabaseError::Truncated);
+        }
+
+        database.m_kinds = {reinterpret_cast<const carddb::KindRecord*>(data + carddb::kindsOffset()),
+                            header->kindCount};
+        database.m_cards = {reinterpret_cast<const carddb::CardRecord*>(data + carddb::cardsOffset(*header)),
+                            header->cardCount};
+        database.m_strings = {data + carddb::stringsOffset(*header), header->stringBytes};
+        if (!database.buildIndex())
+        {
+            return std::unexpected(CardDatabaseError::BadReference);
+        }
+        return database;
+    }
+
+    CardDatabase(CardDatabase&&) noexcept = default;
+    CardDatabase& operator=(CardDatabase&&) noexcept = default;
+
+    /**
+     * @brief 整副牌的张数
+     */
+    [[nodiscard]] size_t deckSize() const noexcept { return m_cards.size(); }
+    [[nodiscard]] std::span<const carddb::KindRecord> kinds() const noexcept { return m_kinds; }
+    [[nodiscard]] std::span<const carddb::CardRecord> cards() const noexcept { return m_cards; }
+
+    [[nodiscard]] const carddb::KindRecord& kindOf(uint16_t card) const { return m_kinds[m_cards[card].kind]; }
+    [[nodiscard]] CardId id(uint16_t card) const { return CardId::fromValue(kindOf(card).id); }
+    [[nodiscard]] carddb::Type type(uint16_t card) const { return static_cast<carddb::Type>(kindOf(card).type); }
+    [[nodiscard]] carddb::Suit suit(uint16_t card) const { return static_cast<carddb::Suit>(m_cards[card].suit); }
+    [[nodiscard]] uint8_t point(uint16_t card) const { return m_cards[card].point; }
+
+    [[nodiscard]] std::string_view text(carddb::StringRef ref) const noexcept
+    {
+        return m_strings.substr(ref.offset, ref.size);
+    }
+
+    /**
+     * @brief 该种牌在整副牌中的所有下标
+     */
+    [[nodiscard]] std::span<const uint16_t> find(CardId id) const
+    {
+        auto it = m_byId.find(id);
+        return it == m_byId.end() ? std::span<const uint16_t>{} : std::span<const uint16_t>{it->second};
+    }
+
+    /**
+     * @brief 指定牌、花色、点数的牌在整副牌中的所有下标
+     */
+    [[nodiscard]] std::span<const uint16_t> find(const CardKey& key) const
+    {
+        auto it = m_byKey.find(key);
+        return it == m_byKey.end() ? std::span<const uint16_t>{} : std::span<const uint16_t>{it->second};
+    }
+
+private:
+    CardDatabase() = default;
+
+    /**
+     * @brief 校验引用与枚举值，全部通过后才登记牌名供日志与界面取回，再建立 (牌, 花色, 点数) 与牌两级索引
+     */
+    bool buildIndex()
+    {
+        for (const auto& kind : m_kinds)
+        {
+            if (!validKind(kind))
+            {
+                return false;
+            }
+        }
+        for (const auto& card : m_cards)
+        {
+            if (card.kind >= m_kinds.size() || card.suit >= static_cast<uint8_t>(carddb::Suit::JOKER))
+            {
+                return false;
+            }
+        }
+
+        for (const auto& kind : m_kinds)
+        {
+            utils::intern<CardId>(text(kind.name));
+        }
+        for (uint16_t i = 0; i < m_cards.size(); ++i)
+        {
+            m_byId[id(i)].push_back(i);
+            m_byKey[CardKey{.card = id(i), .suit = suit(i), .rank = point(i)}].push_back(i);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 字符串不越界、类型与子类型在枚举范围内、牌名哈希等于 id 且不与已登记的其他文本冲突
+     */
+    [[nodiscard]] bool validKind(const carddb::KindRecord& kind) const
+    {
+        if (size_t{kind.name.offset} + kind.name.size > m_strings.size() ||
+            size_t{kind.description.offset} + kind.description.size > m_strings.size())
+        {
+            return false;
+        }
+
+        const auto maxSubtype = kind.type == static_cast<uint8_t>(carddb::Type::BASIC)
+                                    ? static_cast<uint8_t>(carddb::BasicType::ALCOHOL)
+                                    : static_cast<uint8_t>(carddb::StrategyType::DUEL);
+        if (kind.type > static_cast<uint8_t>(carddb::Type::STRATEGY) || kind.subtype > maxSubtype)
+        {
+            return false;
+        }
+
+        const auto name = text(kind.name);
+        if (entt::hashed_string::value(name.data(), name.size()) != kind.id)
+        {
+            return false;
+        }
+        const auto interned = utils::text(CardId::fromValue(kind.id));
+        return interned.empty() || interned == name;
+    }
+
+    std::unique_ptr<uint32_t[]> m_aligned; // 仅在 blob 未对齐时使用
+    std::span<const carddb::KindRecord> m_kinds;
+    std::span<const carddb::CardRecord> m_cards;
+    std::string_view m_strings;
+    absl::flat_hash_map<CardId, Indices> m_byId;
+    absl::flat_hash_map<CardKey, Indices> m_byKey;
+};
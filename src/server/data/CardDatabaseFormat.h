@@ -0,0 +1,122 @@
+/**
+ * ************************************************************************
+ *
+ * @file CardDatabaseFormat.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 卡牌数据库二进制格式，CardDbCompiler 写出、CardDatabase 原地读取
+ *
+ * 布局（小端，所有段 4 字节对齐）：
+ *   Header | KindRecord[kindCount] | CardRecord[cardCount] | 字符串区（UTF-8，不以 0 结尾）
+ * KindRecord 是一种牌（杀、闪……）的定义，CardRecord 是整副牌中的一张（种类 + 花色 + 点数）。
+ * 记录都是定长 POD，读取时直接把数据段看作数组，不做解析与拷贝。
+ * 花色、牌类型与子类型按下面的枚举编码，编译器只依赖本文件；取值与 Common.h 中玩法代码使用的
+ * SuitType / CardType / BasicCardType / StrategyCardType 一致，由 components/Card.h 静态断言保证；数据库一侧只使用这里的枚举，不依赖玩法头文件。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace carddb
+{
+inline constexpr std::array<char, 4> MAGIC{'P', 'M', 'C', 'D'};
+inline constexpr uint16_t VERSION = 1;
+
+// 花色；JOKER 表示无花色，不会出现在牌表中
+enum class Suit : uint8_t
+{
+    SPADE,
+    HEART,
+    CLUB,
+    DIAMOND,
+    JOKER,
+};
+
+enum class Type : uint8_t
+{
+    BASIC,
+    STRATEGY,
+};
+
+// Type::BASIC 的子类型
+enum class BasicType : uint8_t
+{
+    STRIKE,
+    DODGE,
+    PEACH,
+    ALCOHOL,
+};
+
+// Type::STRATEGY 的子类型
+enum class StrategyType : uint8_t
+{
+    FIRE_ATTACK,
+    DUEL,
+};
+
+struct Header
+{
+    std::array<char, 4> magic;
+    uint16_t version;
+    uint16_t kindCount;
+    uint16_t cardCount;
+    uint16_t reserved;
+    uint32_t stringBytes;
+};
+
+// 字符串区中的一段
+struct StringRef
+{
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct KindRecord
+{
+    uint32_t id;         // CardId 的值，即牌名的 entt::hashed_string
+    StringRef name;
+    StringRef description;
+    uint8_t type;        // Type
+    uint8_t subtype;     // BasicType / StrategyType，取决于 type
+    uint8_t needTarget;
+    uint8_t minTargets;
+    uint8_t maxTargets;
+    uint8_t range;       // 0 表示无距离限制
+    uint16_t reserved;
+};
+
+struct CardRecord
+{
+    uint16_t kind; // KindRecord 下标
+    uint8_t point;
+    uint8_t suit;  // Suit
+};
+
+static_assert(sizeof(Header) == 16 && std::is_trivially_copyable_v<Header>);
+static_assert(sizeof(KindRecord) == 28 && std::is_trivially_copyable_v<KindRecord>);
+static_assert(sizeof(CardRecord) == 4 && std::is_trivially_copyable_v<CardRecord>);
+
+constexpr size_t kindsOffset() noexcept
+{
+    return sizeof(Header);
+}
+
+constexpr size_t cardsOffset(const Header& header) noexcept
+{
+    return kindsOffset() + header.kindCount * sizeof(KindRecord);
+}
+
+constexpr size_t stringsOffset(const Header& header) noexcept
+{
+    return cardsOffset(header) + header.cardCount * sizeof(CardRecord);
+}
+} // namespace carddb
@@ -0,0 +1,68 @@
+/**
+ * ************************************************************************
+ *
+ * @file CardDbCompiler.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 构建期工具：把 JSON 卡牌定义编译为 CardDatabaseFormat.h 描述的二进制卡牌表
+ *
+ * 用法：CardDbCompiler <cards.json> <cards.bin>
+ * JSON 格式与解析见 CardDbCompiler.h。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "CardDbCompiler.h"
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: %s <cards.json> <cards.bin>\n", argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        std::ifstream input(argv[1]);
+        if (!input)
+        {
+            throw std::runtime_error(std::string("无法打开 ") + argv[1]);
+        }
+        const auto json = nlohmann::json::parse(input);
+
+        carddb::Compiler compiler;
+        for (const auto& card : json.at("cards"))
+        {
+            compiler.addKind(card);
+        }
+        const auto blob = compiler.build();
+
+        std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+        output.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        if (!output)
+        {
+            throw std::runtime_error(std::string("无法写入 ") + argv[2]);
+        }
+        std::printf("%s: %zu kinds, %zu cards, %zu bytes\n",
+                    argv[2],
+                    compiler.kindCount(),
+                    compiler.cardCount(),
+                    blob.size());
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[1], e.what());
+        return 1;
+    }
+    return 0;
+}
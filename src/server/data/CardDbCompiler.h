@@ -0,0 +1,158 @@
+/**
+ * ************************************************************************
+ *
+ * @file CardDbCompiler.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 把 JSON 卡牌定义编译为 CardDatabaseFormat.h 描述的二进制卡牌表，供构建期工具与单元测试使用
+ *
+ * JSON 格式：
+ * @code
+ *   { "cards": [ { "name": "杀", "type": "BASIC", "subtype": "STRIKE", "description": "……",
+ *                  "target": { "need": true, "min": 1, "max": 1, "range": 1 },
+ *                  "deck": ["♠7", "♣10", "♦K"] } ] }
+ * @endcode
+ * deck 中每一项是整副牌中的一张：花色（♠ ♥ ♣ ♦）+ 点数（A、2~10、J、Q、K）。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <entt/core/hashed_string.hpp>
+#include <nlohmann/json.hpp>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "CardDatabaseFormat.h"
+
+namespace carddb
+{
+template <typename Enum>
+using NameTable = std::vector<std::pair<std::string_view, Enum>>;
+
+inline const NameTable<Type> CARD_TYPES{{"BASIC", Type::BASIC}, {"STRATEGY", Type::STRATEGY}};
+inline const NameTable<BasicType> BASIC_TYPES{{"STRIKE", BasicType::STRIKE},
+                                              {"DODGE", BasicType::DODGE},
+                                              {"PEACH", BasicType::PEACH},
+                                              {"ALCOHOL", BasicType::ALCOHOL}};
+inline const NameTable<StrategyType> STRATEGY_TYPES{{"FIRE_ATTACK", StrategyType::FIRE_ATTACK},
+                                                    {"DUEL", StrategyType::DUEL}};
+inline const NameTable<Suit> SUITS{{"♠", Suit::SPADE}, {"♥", Suit::HEART}, {"♣", Suit::CLUB}, {"♦", Suit::DIAMOND}};
+inline const NameTable<uint8_t> POINTS{{"A", 1}, {"2", 2}, {"3", 3}, {"4", 4}, {"5", 5}, {"6", 6}, {"7", 7},
+                                       {"8", 8}, {"9", 9}, {"10", 10}, {"J", 11}, {"Q", 12}, {"K", 13}};
+
+template <typename Enum>
+uint8_t lookup(const NameTable<Enum>& table, std::string_view name, std::string_view what)
+{
+    for (const auto& [key, value] : table)
+    {
+        if (key == name)
+        {
+            return static_cast<uint8_t>(value);
+        }
+    }
+    throw std::runtime_error("未知的" + std::string(what) + ": " + std::string(name));
+}
+
+class Compiler
+{
+public:
+    /**
+     * @brief 加入一种牌及其在整副牌中的各张
+     * @throw std::runtime_error 未知的类型、花色、点数，或牌名重复
+     * @throw nlohmann::json::exception 缺少必需字段或字段类型不符
+     */
+    void addKind(const nlohmann::json& card)
+    {
+        const auto name = card.at("name").get<std::string>();
+        const auto type = card.at("type").get<std::string>();
+        const auto subtype = card.at("subtype").get<std::string>();
+        const auto& target = card.at("target");
+
+        KindRecord kind{};
+        kind.id = entt::hashed_string::value(name.data(), name.size());
+        kind.name = addString(name);
+        kind.description = addString(card.value("description", std::string{}));
+        kind.type = lookup(CARD_TYPES, type, "牌类型");
+        kind.subtype = kind.type == static_cast<uint8_t>(Type::BASIC) ? lookup(BASIC_TYPES, subtype, "基本牌类型")
+                                                                       : lookup(STRATEGY_TYPES, subtype, "锦囊牌类型");
+        kind.needTarget = target.value("need", true) ? 1 : 0;
+        kind.minTargets = static_cast<uint8_t>(target.value("min", 1));
+        kind.maxTargets = static_cast<uint8_t>(target.value("max", 1));
+        kind.range = static_cast<uint8_t>(target.value("range", 0));
+        for (const auto& existing : m_kinds)
+        {
+            if (existing.id == kind.id)
+            {
+                throw std::runtime_error("重复或哈希冲突的牌名: " + name);
+            }
+        }
+
+        const auto kindIndex = static_cast<uint16_t>(m_kinds.size());
+        m_kinds.push_back(kind);
+        for (const auto& entry : card.at("deck"))
+        {
+            addCard(kindIndex, entry.get<std::string>());
+        }
+    }
+
+    [[nodiscard]] std::vector<char> build() const
+    {
+        if (m_kinds.size() > std::numeric_limits<uint16_t>::max() ||
+            m_cards.size() > std::numeric_limits<uint16_t>::max())
+        {
+            throw std::runtime_error("牌的种类或张数超过 65535");
+        }
+        Header header{};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.kindCount = static_cast<uint16_t>(m_kinds.size());
+        header.cardCount = static_cast<uint16_t>(m_cards.size());
+        header.stringBytes = static_cast<uint32_t>(m_strings.size());
+
+        std::vector<char> blob(stringsOffset(header) + m_strings.size());
+        std::memcpy(blob.data(), &header, sizeof(header));
+        std::memcpy(blob.data() + kindsOffset(), m_kinds.data(), m_kinds.size() * sizeof(KindRecord));
+        std::memcpy(blob.data() + cardsOffset(header), m_cards.data(), m_cards.size() * sizeof(CardRecord));
+        std::memcpy(blob.data() + stringsOffset(header), m_strings.data(), m_strings.size());
+        return blob;
+    }
+
+    [[nodiscard]] size_t kindCount() const noexcept { return m_kinds.size(); }
+    [[nodiscard]] size_t cardCount() const noexcept { return m_cards.size(); }
+
+private:
+    StringRef addString(std::string_view text)
+    {
+        const StringRef ref{.offset = static_cast<uint32_t>(m_strings.size()),
+                            .size = static_cast<uint32_t>(text.size())};
+        m_strings.append(text);
+        return ref;
+    }
+
+    // "♠7"：花色是一个 3 字节的 UTF-8 字符，其余是点数
+    void addCard(uint16_t kind, std::string_view entry)
+    {
+        constexpr size_t SUIT_BYTES = 3;
+        if (entry.size() <= SUIT_BYTES)
+        {
+            throw std::runtime_error("无法解析的牌: " + std::string(entry));
+        }
+        m_cards.push_back({.kind = kind,
+                           .point = lookup(POINTS, entry.substr(SUIT_BYTES), "点数"),
+                           .suit = lookup(SUITS, entry.substr(0, SUIT_BYTES), "花色")});
+    }
+
+    std::vector<KindRecord> m_kinds;
+    std::vector<CardRecord> m_cards;
+    std::string m_strings;
+};
+} // namespace carddb
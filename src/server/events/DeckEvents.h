@@ -2,6 +2,7 @@
 #pragma once
 #include <entt/entt.hpp>
 #include "src/shared/common/Common.h"
+#include "src/server/components/Card.h"
 
 namespace events
 {
@@ -13,43 +14,43 @@ struct DealCards // 发牌事件
 
 struct FindCardInDrawPile
 {
-    std::string cardName; // 需要查找的牌名
-    SuitType suitType;    // 需要查找的花色
-    uint8_t rank;         // 需要查找的点数
+    CardId card;       // 需要查找的牌
+    SuitType suitType; // 需要查找的花色
+    uint8_t rank;      // 需要查找的点数，0 表示任意
 };
 
 struct FindCardInHandCardsArea
 {
-    std::string cardName; // 需要查找的牌名
-    SuitType suitType;    // 需要查找的花色
-    uint8_t rank;         // 需要查找的点数
+    CardId card;       // 需要查找的牌
+    SuitType suitType; // 需要查找的花色
+    uint8_t rank;      // 需要查找的点数，0 表示任意
 };
 
 struct FindCardInEquipmentArea
 {
-    std::string cardName; // 需要查找的牌名
-    SuitType suitType;    // 需要查找的花色
-    uint8_t rank;         // 需要查找的点数
+    CardId card;       // 需要查找的牌
+    SuitType suitType; // 需要查找的花色
+    uint8_t rank;      // 需要查找的点数，0 表示任意
 };
 
 struct FindCardInDiscardPile
 {
-    std::string cardName; // 需要查找的牌名
-    SuitType suitType;    // 需要查找的花色
-    uint8_t rank;         // 需要查找的点数
+    CardId card;       // 需要查找的牌
+    SuitType suitType; // 需要查找的花色
+    uint8_t rank;      // 需要查找的点数，0 表示任意
 };
 
 struct FindCardinAllAreas
 {
-    std::string cardName; // 需要查找的牌名
-    SuitType suitType;    // 需要查找的花色
-    uint8_t rank;         // 需要查找的点数
+    CardId card;       // 需要查找的牌
+    SuitType suitType; // 需要查找的花色
+    uint8_t rank;      // 需要查找的点数，0 表示任意
 };
 
 struct PickRandomCardFromSomeone
 {
     entt::entity fromPlayer; // 被抽牌的角色
-    std::string cardName;    // 需要查找的牌名
+    CardId card;             // 需要查找的牌
     SuitType suitType;       // 需要查找的花色
     uint8_t rank;            // 需要查找的点数
 };
@@ -57,7 +58,7 @@ struct PickRandomCardFromSomeone
 struct PickRandomCardFromSomeonesHand
 {
     entt::entity fromPlayer; // 被抽牌的角色
-    std::string cardName;    // 需要查找的牌名
+    CardId card;             // 需要查找的牌
     SuitType suitType;       // 需要查找的花色
     uint8_t rank;            // 需要查找的点数
 };
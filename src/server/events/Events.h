@@ -15,6 +15,7 @@
 #pragma once
 
 #include "src/shared/common/Common.h"
+#include "src/server/components/Card.h"
 #include <cstddef>
 #include <cstdint>
 #include <entt/entity/entity.hpp>
@@ -137,9 +138,9 @@ struct NearDeath
 
 struct CheckCardToResponse
 {
-    entt::entity player;  // 需要响应的角色
-    std::string cardName; // 需要响应的牌名
-    bool canRespond;      // 是否可以响应
+    entt::entity player; // 需要响应的角色
+    CardId card;         // 需要响应的牌
+    bool canRespond;     // 是否可以响应
 };
 
 struct TurnStartEvent
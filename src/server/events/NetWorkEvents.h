@@ -17,6 +17,7 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include "src/shared/rpc/RpcProtocol.h"
 
 namespace events
 {
@@ -25,6 +26,7 @@ struct NetworkMessageReceived
     // std::string message; // Deprecated
     std::vector<uint8_t> payload;
     uint32_t connectionId; // 标识发送者
+    RpcReply reply;        // 回复发送者（通常为 replyTo(session)），为空时 RPC 请求不回复
 };
 
 struct Login
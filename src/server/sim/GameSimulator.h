@@ -0,0 +1,320 @@
+/**
+ * ************************************************************************
+ *
+ * @file GameSimulator.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 无界面对局模拟：机器人经现有事件驱动 DeckSystem、DamageSystem、UseCardSystem 打完整局
+ *
+ * 每局对局在 RoomHost 的一个独立房间中运行：CreatePlayer 创建玩家，GameStart 后每人发 4 张，
+ * 之后轮流 TurnStartEvent → DealCards(2) → 机器人出牌（CardUsed + Damage）→ 超出体力的手牌 CardDiscarded → NextTurn，
+ * 直到只剩一名存活玩家、牌堆耗尽（DeckSystem 触发 GameEnd）或达到回合上限。
+ * 出牌阶段的卡牌效果由模拟器按"造成 1 点伤害"结算（卡牌效果系统尚未接入）。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <latch>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "SimBots.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/context/RoomHost.h"
+#include "src/server/events/DeckEvents.h"
+#include "src/server/events/Events.h"
+#include "src/server/events/GameFlowEvents.h"
+#include "src/server/systems/DamageSystem.h"
+#include "src/server/systems/DeckSystem.h"
+#include "src/server/systems/UseCardSystem.h"
+
+namespace sim
+{
+struct SimConfig
+{
+    uint32_t games = 1'000;
+    uint32_t players = 4;
+    uint32_t initialCards = 4;
+    uint32_t cardsPerTurn = 2;
+    uint32_t maxTurns = 200;
+    BotPolicy policy = BotPolicy::Random;
+    uint64_t seed = 2026;
+};
+
+struct SimStats
+{
+    uint64_t games = 0;
+    uint64_t turns = 0;
+    uint64_t events = 0;   // 所有经 dispatcher 分发的事件，含系统派生的（CardDrawn、NearDeath……）
+    uint64_t kills = 0;
+    uint64_t deckOuts = 0; // 因牌堆耗尽结束的对局
+    uint64_t failed = 0;   // 抛出异常的对局
+
+    SimStats& operator+=(const SimStats& other) noexcept
+    {
+        games += other.games;
+        turns += other.turns;
+        events += other.events;
+        kills += other.kills;
+        deckOuts += other.deckOuts;
+        failed += other.failed;
+        return *this;
+    }
+};
+
+/**
+ * @brief 一局对局，构造时把系统挂到 context 上，析构时摘下
+ * @note 只能在该 context 所属房间的 strand 上使用
+ */
+class SimulatedGame
+{
+public:
+    SimulatedGame(GameContext& context, const SimConfig& config, uint64_t seed)
+        : m_context(&context),
+          m_config(config),
+          m_rng(seed),
+          m_deck(context, BuiltinCardDatabase(), BuiltinCardDatabase().deckSize(), seed),
+          m_damage(context),
+          m_useCard(context)
+    {
+        m_deck.registerEvents();
+        m_damage.registerEvents();
+        m_useCard.registerEvents();
+
+        auto& dispatcher = m_context->dispatcher;
+        dispatcher.sink<events::NearDeath>().connect<&SimulatedGame::onNearDeath>(this);
+        dispatcher.sink<events::GameEnd>().connect<&SimulatedGame::onGameEnd>(this);
+        countEvents<events::GameStart,
+                    events::GameEnd,
+                    events::TurnStartEvent,
+                    events::DealCards,
+                    events::CardDrawn,
+                    events::ShuffleDeck,
+                    events::CardUsed,
+                    events::Damage,
+                    events::NearDeath,
+                    events::CardDiscarded,
+                    events::NextTurn>();
+    }
+
+    SimulatedGame(const SimulatedGame&) = delete;
+    SimulatedGame& operator=(const SimulatedGame&) = delete;
+
+    ~SimulatedGame()
+    {
+        m_useCard.unregisterEvents();
+        m_damage.unregisterEvents();
+        m_deck.unregisterEvents();
+        m_context->dispatcher.disconnect(this);
+    }
+
+    /**
+     * @brief 打完整局
+     */
+    SimStats play()
+    {
+        createPlayers();
+        trigger(events::GameStart{.players = {m_players.begin(), m_players.end()}});
+        for (auto player : m_players)
+        {
+            trigger(events::DealCards{.player = player, .count = static_cast<uint8_t>(m_config.initialCards)});
+        }
+
+        for (size_t seat = 0; !finished(); seat = (seat + 1) % m_players.size())
+        {
+            const auto player = m_players[seat];
+            if (isAlive(player))
+            {
+                playTurn(player);
+            }
+        }
+
+        if (!m_over)
+        {
+            events::GameEnd end{.reason = m_alive <= 1 ? "只剩一名存活玩家" : "达到回合上限", .winner = {}};
+            std::ranges::copy_if(m_players, std::back_inserter(end.winner), [this](auto p) { return isAlive(p); });
+            trigger(std::move(end));
+        }
+        m_stats.games = 1;
+        return m_stats;
+    }
+
+private:
+    template <typename... Events>
+    void countEvents()
+    {
+        (m_context->dispatcher.sink<Events>().template connect<&SimulatedGame::countEvent<Events>>(this), ...);
+    }
+
+    template <typename Event>
+    void countEvent(const Event&) noexcept
+    {
+        ++m_stats.events;
+    }
+
+    template <typename Event>
+    void trigger(Event&& event)
+    {
+        m_context->dispatcher.trigger(std::forward<Event>(event));
+    }
+
+    void createPlayers()
+    {
+        auto& registry = m_context->registry;
+        for (uint32_t i = 0; i < m_config.players; ++i)
+        {
+            MetaPlayerInfo meta{.playerName = "bot" + std::to_string(i), .playerID = i};
+            CharacterInfo character{};
+            HandCards hand{};
+            Equipments equipments{};
+            LiveStatus live{};
+            const auto player = CreatePlayer(registry, meta, character, hand, equipments, live);
+            registry.emplace<Attributes>(player);
+            m_players.push_back(player);
+        }
+        m_alive = m_config.players;
+    }
+
+    void playTurn(entt::entity player)
+    {
+        trigger(events::TurnStartEvent{.player = player});
+        trigger(events::DealCards{.player = player, .count = static_cast<uint8_t>(m_config.cardsPerTurn)});
+
+        // 出牌阶段
+        collectOpponents(player);
+        for (uint32_t played = 0; !finished(); ++played)
+        {
+            const auto action =
+                chooseAction(m_config.policy, m_context->registry, player, m_opponents, played, m_rng);
+            if (action.card == entt::null)
+            {
+                break;
+            }
+            entt::entity target = action.target;
+            trigger(events::CardUsed{.user = player, .target = std::span(&target, 1), .card = action.card});
+            trigger(events::Damage{.from = player, .to = target, .amount = 1});
+            if (!isAlive(target))
+            {
+                std::erase(m_opponents, target);
+            }
+        }
+
+        // 弃牌阶段：手牌数不超过当前体力
+        const auto& hand = m_context->registry.get<HandCards>(player).handCards;
+        const auto limit = static_cast<size_t>(std::max(0, m_context->registry.get<Attributes>(player).currentHealth));
+        if (!m_over && hand.size() > limit)
+        {
+            std::vector<entt::entity> excess(hand.begin() + static_cast<std::ptrdiff_t>(limit), hand.end());
+            const auto count = static_cast<uint8_t>(excess.size());
+            trigger(events::CardDiscarded{.player = player, .card = std::move(excess), .count = count});
+        }
+
+        trigger(events::NextTurn{});
+        ++m_stats.turns;
+    }
+
+    void collectOpponents(entt::entity player)
+    {
+        m_opponents.clear();
+        std::ranges::copy_if(m_players,
+                             std::back_inserter(m_opponents),
+                             [this, player](auto other) { return other != player && isAlive(other); });
+    }
+
+    [[nodiscard]] bool isAlive(entt::entity player) const
+    {
+        return m_context->registry.get<LiveStatus>(player).isAlive;
+    }
+
+    [[nodiscard]] bool finished() const noexcept
+    {
+        return m_over || m_alive <= 1 || m_stats.turns >= m_config.maxTurns;
+    }
+
+    void onNearDeath(const events::NearDeath& event)
+    {
+        // 没有求桃结算：濒死即阵亡
+        auto& live = m_context->registry.get<LiveStatus>(event.character);
+        if (live.isAlive)
+        {
+            live.isAlive = false;
+            m_context->registry.get<Attributes>(event.character).isAlive = false;
+            --m_alive;
+            ++m_stats.kills;
+        }
+    }
+
+    void onGameEnd(const events::GameEnd&)
+    {
+        if (!finished())
+        {
+            ++m_stats.deckOuts; // 对局进行中由 DeckSystem 宣告结束：牌堆耗尽
+        }
+        m_over = true;
+    }
+
+    GameContext* m_context;
+    SimConfig m_config;
+    std::mt19937_64 m_rng;
+    DeckSystem m_deck;
+    DamageSystem m_damage;
+    UseCardSystem m_useCard;
+
+    std::vector<entt::entity> m_players;
+    std::vector<entt::entity> m_opponents;
+    uint32_t m_alive = 0;
+    bool m_over = false;
+    SimStats m_stats;
+};
+
+/**
+ * @brief 在 host 上并行打 config.games 局，每局一个房间，返回汇总
+ *
+ * 第 i 局的机器人与 DeckSystem 洗牌都使用种子 config.seed + i，汇总结果只取决于 config，与线程数无关。
+ */
+inline SimStats runGames(RoomHost& host, const SimConfig& config)
+{
+    std::mutex mutex;
+    SimStats total;
+    std::latch done(config.games);
+    for (uint32_t i = 0; i < config.games; ++i)
+    {
+        const auto room = host.createRoom();
+        host.post(room,
+                  [&host, &config, &mutex, &total, &done, room, seed = config.seed + i](GameContext& context)
+                  {
+                      SimStats stats;
+                      try
+                      {
+                          SimulatedGame game(context, config, seed);
+                          stats = game.play();
+                      }
+                      catch (const std::exception& e)
+                      {
+                          context.logger->error("对局 {} 异常: {}", seed, e.what());
+                          stats.failed = 1;
+                      }
+                      {
+                          std::lock_guard lock(mutex);
+                          total += stats;
+                      }
+                      host.closeRoom(room);
+                      done.count_down();
+                  });
+    }
+    done.wait();
+    return total;
+}
+} // namespace sim
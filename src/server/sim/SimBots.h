@@ -0,0 +1,102 @@
+/**
+ * ************************************************************************
+ *
+ * @file SimBots.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 模拟器中的机器人策略：出哪张牌、打谁
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string_view>
+#include "src/server/components/Character.h"
+#include "src/server/components/Player.h"
+
+namespace sim
+{
+enum class BotPolicy : uint8_t
+{
+    Random,     // 随机出牌、随机选目标，随机停手
+    Aggressive, // 每回合出一张牌，打体力最低的对手
+};
+
+constexpr std::string_view toString(BotPolicy policy) noexcept
+{
+    switch (policy)
+    {
+    case BotPolicy::Random:
+        return "random";
+    case BotPolicy::Aggressive:
+        return "aggressive";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief 一次出牌；card 为 entt::null 表示结束出牌阶段
+ */
+struct BotAction
+{
+    entt::entity card = entt::null;
+    entt::entity target = entt::null;
+};
+
+/**
+ * @brief 出牌阶段的第 playedThisTurn + 1 次决策
+ * @param opponents 存活的对手
+ */
+inline BotAction chooseAction(BotPolicy policy,
+                              const entt::registry& registry,
+                              entt::entity self,
+                              std::span<const entt::entity> opponents,
+                              uint32_t playedThisTurn,
+                              std::mt19937_64& rng)
+{
+    const auto& hand = registry.get<HandCards>(self).handCards;
+    if (hand.empty() || opponents.empty())
+    {
+        return {};
+    }
+
+    switch (policy)
+    {
+    case BotPolicy::Random:
+    {
+        if (playedThisTurn > 0 && std::bernoulli_distribution(0.5)(rng))
+        {
+            return {};
+        }
+        std::uniform_int_distribution<size_t> pickCard(0, hand.size() - 1);
+        std::uniform_int_distribution<size_t> pickTarget(0, opponents.size() - 1);
+        return {.card = hand[pickCard(rng)], .target = opponents[pickTarget(rng)]};
+    }
+    case BotPolicy::Aggressive:
+    {
+        if (playedThisTurn > 0)
+        {
+            return {};
+        }
+        entt::entity weakest = opponents.front();
+        for (auto opponent : opponents)
+        {
+            if (registry.get<Attributes>(opponent).currentHealth < registry.get<Attributes>(weakest).currentHealth)
+            {
+                weakest = opponent;
+            }
+        }
+        return {.card = hand.front(), .target = weakest};
+    }
+    }
+    return {};
+}
+} // namespace sim
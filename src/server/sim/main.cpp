@@ -0,0 +1,166 @@
+/**
+ * ************************************************************************
+ *
+ * @file main.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 无界面对局模拟器入口：并行打大量机器人对局，输出 games/s、events/s 与内存分配次数
+ *
+ * 用法：PestManSim [--games N] [--players N] [--threads N] [--max-turns N] [--policy random|aggressive] [--seed N]
+ * 作为玩法改动的回归基准：改动前后用同一组参数各跑一次，比较吞吐与每局分配次数。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+#include <spdlog/sinks/null_sink.h>
+#include "GameSimulator.h"
+
+// ==================== 分配计数 ====================
+// 替换全局 operator new，统计整个进程的堆分配次数（该目标不链接 mimalloc）
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // 内联后 GCC 看不出 new / delete 都基于 malloc / free
+#endif
+
+namespace
+{
+std::atomic<uint64_t> g_allocations{0};
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    operator delete[](ptr);
+}
+
+namespace
+{
+struct Options
+{
+    sim::SimConfig config;
+    size_t threads = RoomHost::defaultThreadCount();
+};
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string_view key = argv[i];
+        const std::string_view value = argv[i + 1];
+        const auto number = std::strtoull(argv[i + 1], nullptr, 10);
+        if (key == "--games")
+        {
+            options.config.games = static_cast<uint32_t>(number);
+        }
+        else if (key == "--players")
+        {
+            options.config.players = static_cast<uint32_t>(number);
+        }
+        else if (key == "--threads")
+        {
+            options.threads = std::max<size_t>(1, number);
+        }
+        else if (key == "--max-turns")
+        {
+            options.config.maxTurns = static_cast<uint32_t>(number);
+        }
+        else if (key == "--seed")
+        {
+            options.config.seed = number;
+        }
+        else if (key == "--policy" && (value == "random" || value == "aggressive"))
+        {
+            options.config.policy = value == "random" ? sim::BotPolicy::Random : sim::BotPolicy::Aggressive;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return argc % 2 == 1 && options.config.games > 0 && options.config.players >= 2 &&
+           options.config.players <= events::MAX_PLAYERS;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr,
+                     "usage: %s [--games N] [--players 2-8] [--threads N] [--max-turns N] "
+                     "[--policy random|aggressive] [--seed N]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    const auto& config = options.config;
+    auto logger = std::make_shared<spdlog::logger>("sim", std::make_shared<spdlog::sinks::null_sink_mt>());
+    RoomHost host(options.threads, logger);
+
+    const uint64_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+    const auto begin = std::chrono::steady_clock::now();
+    const auto stats = sim::runGames(host, config);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    const uint64_t allocations = g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+    std::printf("games %u, players %u, policy %.*s, threads %zu, seed %llu\n",
+                config.games,
+                config.players,
+                static_cast<int>(sim::toString(config.policy).size()),
+                sim::toString(config.policy).data(),
+                options.threads,
+                static_cast<unsigned long long>(config.seed));
+    std::printf("  %10.0f games/s   %10.0f turns/s   %12.0f events/s\n",
+                static_cast<double>(stats.games) / seconds,
+                static_cast<double>(stats.turns) / seconds,
+                static_cast<double>(stats.events) / seconds);
+    std::printf("  %10.1f turns/game %8.1f events/turn %8.1f allocations/game\n",
+                static_cast<double>(stats.turns) / static_cast<double>(stats.games),
+                static_cast<double>(stats.events) / static_cast<double>(std::max<uint64_t>(1, stats.turns)),
+                static_cast<double>(allocations) / static_cast<double>(stats.games));
+    std::printf("  kills %llu, deck-outs %llu, failed %llu\n",
+                static_cast<unsigned long long>(stats.kills),
+                static_cast<unsigned long long>(stats.deckOuts),
+                static_cast<unsigned long long>(stats.failed));
+    return stats.failed == 0 ? 0 : 1;
+}
@@ -27,12 +27,13 @@ public:
     void init() { registerEvents(); };
     void destroy() { unregisterEvents(); };
 
-private:
     void registerEvents() { m_context->dispatcher.sink<events::Damage>().connect<&DamageSystem::onDamageEvent>(this); };
     void unregisterEvents()
     {
         m_context->dispatcher.sink<events::Damage>().disconnect<&DamageSystem::onDamageEvent>(this);
     };
+
+private:
     void onDamageEvent(const events::Damage& damageEvent) const
     {
         auto [source, target, amount] = damageEvent;
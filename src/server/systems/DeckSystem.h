@@ -7,6 +7,12 @@
  * @version 0.1
  * @brief 牌堆管理系统，负责管理发牌/洗牌/检索
  *
+ * 每张牌带 CardLocation 组件记录所在区域与下标，移牌时按下标交换删除，摸牌从抽牌堆尾部弹出，均为 O(1)。
+ * 牌的定义来自共享的只读 CardDatabase，卡牌实体只带 CardEntry（数据库下标）；牌堆第 i 张是数据库第 i % N 张。
+ * 每个牌区另按 (牌, 花色, 点数) 与按牌分桶记录其中的牌，随牌进出牌区一起维护，检索只取桶尾，不遍历牌区、不比较字符串。
+ * 交换删除会打乱手牌顺序，手牌顺序不具有玩法含义。
+ * 使用、弃置的牌先进入处理区，结算完成（DetailFinish）或回合结束（NextTurn）时进入弃牌堆。
+ *
  * ************************************************************************
  * @copyright Copyright (c) 2025 AnakinLiu
  * For study and research only, no reprinting.
@@ -16,6 +22,11 @@
 #include <entt/entt.hpp>
 #include <absl/random/random.h>
 #include <algorithm>
+#include <array>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <vector>
 #include "src/server/context/GameContext.h"
 #include "src/server/components/Deck.h"
 #include "src/server/events/Events.h"
@@ -24,12 +35,36 @@
 #include "src/server/events/DeckEvents.h"
 #include "src/server/events/GameFlowEvents.h"
 #include "src/server/Interface/ISystem.h"
-#include "absl/container/flat_hash_set.h"
+#include "src/server/data/BuiltinCardDatabase.h"
 
 class DeckSystem : public EnableRegister<DeckSystem>
 {
 public:
-    explicit DeckSystem(GameContext& context) : m_context(&context) { m_context->logger->info("DeckSystem 初始化"); }
+    /**
+     * @param database 卡牌定义，须比 DeckSystem 活得久；默认为嵌入可执行文件的内置数据库
+     */
+    explicit DeckSystem(GameContext& context, const CardDatabase& database = BuiltinCardDatabase())
+        : DeckSystem(context, database, database.deckSize())
+    {
+    }
+
+    /**
+     * @param deckSize 牌堆张数，超过一副时按数据库顺序循环多副
+     * @param seed 洗牌种子；给定时同一程序内洗牌顺序可复现（模拟器、回归基准），缺省时使用系统随机源
+     */
+    DeckSystem(GameContext& context,
+               const CardDatabase& database,
+               size_t deckSize,
+               std::optional<uint64_t> seed = std::nullopt)
+        : m_context(&context),
+          m_database(&database),
+          m_locations(&context.registry.storage<CardLocation>()),
+          m_hands(&context.registry.storage<HandCards>()),
+          m_deckSize(deckSize),
+          m_gen(makeGenerator(seed))
+    {
+        m_context->logger->info("DeckSystem 初始化");
+    }
 
     // Disable copy and move operations due to reference member
     DeckSystem(const DeckSystem&) = default;
@@ -38,12 +73,217 @@ public:
     DeckSystem& operator=(DeckSystem&& other) = delete;
     ~DeckSystem() = default;
 
+    void registerEventsImpl()
+    {
+        initDeck();
+        m_context->dispatcher.sink<events::DealCards>().connect<&DeckSystem::onDealCards>(this);
+        m_context->dispatcher.sink<events::ShuffleDeck>().connect<&DeckSystem::onShuffleDeck>(this);
+        m_context->dispatcher.sink<events::CardUsed>().connect<&DeckSystem::onCardUsed>(this);
+        m_context->dispatcher.sink<events::CardDiscarded>().connect<&DeckSystem::onCardDiscarded>(this);
+        m_context->dispatcher.sink<events::DetailFinish>().connect<&DeckSystem::onDetailFinish>(this);
+        m_context->dispatcher.sink<events::NextTurn>().connect<&DeckSystem::onProcessFinished>(this);
+        m_context->dispatcher.sink<events::FindCardInDrawPile>().connect<&DeckSystem::onFindCardInDrawPile>(this);
+        m_context->dispatcher.sink<events::FindCardInHandCardsArea>().connect<&DeckSystem::onFindCardInHandCards>(
+            this);
+    };
+    void unregisterEventsImpl() { m_context->dispatcher.disconnect(this); };
+
+    /**
+     * @brief 在指定区域查找一张牌：一次数据库查表得到桶号，再取该牌区对应桶的末尾
+     * @param rank 为 0 时只按牌查找，忽略花色
+     * @return 找不到时返回 entt::null
+     */
+    [[nodiscard]] entt::entity findCard(CardZone zone, CardId id, SuitType suit, uint8_t rank) const
+    {
+        const auto indices = rank == 0
+                                 ? m_database->find(id)
+                                 : m_database->find(CardKey{.card = id, .suit = toDatabaseSuit(suit), .rank = rank});
+        if (indices.empty() || m_cards.empty())
+        {
+            return entt::null;
+        }
+        const auto& zoneIndex = m_zoneIndex[static_cast<size_t>(zone)];
+        const auto& bucket = rank == 0 ? zoneIndex.byId[indices.front()] : zoneIndex.byKey[indices.front()];
+        return bucket.empty() ? entt::null : bucket.back();
+    }
+
+    /**
+     * @brief 最近一次 FindCardIn* 事件的结果
+     */
+    [[nodiscard]] entt::entity foundCard() const noexcept { return m_findCard; }
+
+    /**
+     * @brief 把牌移到指定区域的末尾（抽牌堆即牌顶）
+     * @param owner 目标为手牌或装备区时的持有者
+     * @param slot 目标为装备区时的栏位，依次为武器、防具、进攻马、防御马
+     */
+    void moveCard(entt::entity card, CardZone zone, entt::entity owner = entt::null, uint32_t slot = 0)
+    {
+        detach(card);
+        attach(card, zone, owner, slot);
+    }
+
+    [[nodiscard]] const Deck& deck() const noexcept { return m_deck; }
+    [[nodiscard]] const CardDatabase& database() const noexcept { return *m_database; }
+
 private:
-    void registerEventsImpl() { initDeck(); };
-    void unregisterEventsImpl() {
+    static constexpr size_t ZONE_COUNT = static_cast<size_t>(CardZone::EQUIPMENT) + 1;
 
+    /**
+     * @brief 一个牌区的检索桶，桶号为数据库中同键的第一个下标（find(key).front()），同键的牌落在同一个桶
+     */
+    struct ZoneIndex
+    {
+        std::vector<std::vector<entt::entity>> byKey; // 按 (牌, 花色, 点数)
+        std::vector<std::vector<entt::entity>> byId;  // 按牌
+    };
+
+    /**
+     * @brief 一张牌的桶号（initDeck 时算好）及其在所在牌区两个桶中的位置，供交换删除
+     */
+    struct IndexEntry
+    {
+        uint16_t keyBucket = 0;
+        uint16_t idBucket = 0;
+        uint32_t keySlot = 0;
+        uint32_t idSlot = 0;
     };
 
+    static absl::BitGen makeGenerator(std::optional<uint64_t> seed)
+    {
+        if (!seed)
+        {
+            return {};
+        }
+        std::seed_seq sequence{static_cast<uint32_t>(*seed), static_cast<uint32_t>(*seed >> 32)};
+        return absl::BitGen(sequence);
+    }
+
+    static std::array<entt::entity*, 4> equipmentSlots(Equipments& equipments) noexcept
+    {
+        return {&equipments.weapon, &equipments.armor, &equipments.attackhorse, &equipments.defensehorse};
+    }
+
+    std::vector<entt::entity>* container(CardZone zone, entt::entity owner)
+    {
+        switch (zone)
+        {
+        case CardZone::DRAW_PILE:
+            return &m_deck.drawPile;
+        case CardZone::DISCARD_PILE:
+            return &m_deck.discardPile;
+        case CardZone::PROCESSING_AREA:
+            return &m_deck.processingArea;
+        case CardZone::HAND:
+            return &m_hands->get(owner).handCards;
+        default:
+            return nullptr;
+        }
+    }
+
+    IndexEntry& indexEntry(entt::entity card) { return m_indexEntries[entt::to_entity(card)]; }
+
+    /**
+     * @brief 写入牌的新位置；换了牌区时同时把它从旧牌区的检索桶移到新牌区的检索桶
+     */
+    void place(entt::entity card, const CardLocation& to)
+    {
+        auto& location = m_locations->get(card);
+        if (location.zone != to.zone)
+        {
+            unindex(card, location.zone);
+            index(card, to.zone);
+        }
+        location = to;
+    }
+
+    void index(entt::entity card, CardZone zone)
+    {
+        if (zone == CardZone::NONE)
+        {
+            return;
+        }
+        auto& zoneIndex = m_zoneIndex[static_cast<size_t>(zone)];
+        auto& entry = indexEntry(card);
+        auto& byKey = zoneIndex.byKey[entry.keyBucket];
+        entry.keySlot = static_cast<uint32_t>(byKey.size());
+        byKey.push_back(card);
+        auto& byId = zoneIndex.byId[entry.idBucket];
+        entry.idSlot = static_cast<uint32_t>(byId.size());
+        byId.push_back(card);
+    }
+
+    void unindex(entt::entity card, CardZone zone)
+    {
+        if (zone == CardZone::NONE)
+        {
+            return;
+        }
+        auto& zoneIndex = m_zoneIndex[static_cast<size_t>(zone)];
+        const auto entry = indexEntry(card);
+        removeFromBucket(zoneIndex.byKey[entry.keyBucket], entry.keySlot, &IndexEntry::keySlot);
+        removeFromBucket(zoneIndex.byId[entry.idBucket], entry.idSlot, &IndexEntry::idSlot);
+    }
+
+    void removeFromBucket(std::vector<entt::entity>& bucket, uint32_t slot, uint32_t IndexEntry::* member)
+    {
+        const auto last = bucket.back();
+        bucket[slot] = last;
+        indexEntry(last).*member = slot;
+        bucket.pop_back();
+    }
+
+    /**
+     * @brief 把牌从所在区域摘下：与末尾交换后弹出，并修正被换过来的那张牌的下标
+     */
+    void detach(entt::entity card)
+    {
+        auto& location = m_locations->get(card);
+        if (location.zone == CardZone::EQUIPMENT)
+        {
+            *equipmentSlots(m_context->registry.get<Equipments>(location.owner))[location.slot] = entt::null;
+        }
+        else if (auto* cards = container(location.zone, location.owner))
+        {
+            const auto last = cards->back();
+            (*cards)[location.slot] = last;
+            m_locations->get(last).slot = location.slot;
+            cards->pop_back();
+        }
+        place(card, {});
+    }
+
+    void attach(entt::entity card, CardZone zone, entt::entity owner, uint32_t slot)
+    {
+        if (zone == CardZone::EQUIPMENT)
+        {
+            auto* equipped = equipmentSlots(m_context->registry.get<Equipments>(owner))[slot];
+            if (*equipped != entt::null)
+            {
+                moveCard(*equipped, CardZone::DISCARD_PILE); // 替换下来的装备进入弃牌堆
+            }
+            *equipped = card;
+            place(card, {.zone = zone, .owner = owner, .slot = slot});
+        }
+        else if (auto* cards = container(zone, owner))
+        {
+            place(card, {.zone = zone, .owner = owner, .slot = static_cast<uint32_t>(cards->size())});
+            cards->push_back(card);
+        }
+    }
+
+    /**
+     * @brief 重排区域内所有牌的下标，用于整体改写容器之后
+     */
+    void relocateAll(CardZone zone)
+    {
+        const auto& cards = *container(zone, entt::null);
+        for (uint32_t i = 0; i < cards.size(); ++i)
+        {
+            place(cards[i], {.zone = zone, .owner = entt::null, .slot = i});
+        }
+    }
+
     /**
      * @brief 初始化牌堆
      */
@@ -52,56 +292,77 @@ private:
         initDeck();
         onShuffleDeck({});
     }
+
+    /**
+     * @brief 使用的牌从手牌进入处理区
+     */
+    void onCardUsed(const events::CardUsed& event)
+    {
+        const auto& location = m_locations->get(event.card);
+        if (location.zone == CardZone::HAND && location.owner == event.user)
+        {
+            moveCard(event.card, CardZone::PROCESSING_AREA);
+        }
+    }
+
     /**
-     * @brief 处理卡牌弃置事件
+     * @brief 处理卡牌弃置事件：手牌或装备区中属于该角色的牌进入处理区
      */
     void onCardDiscarded(events::CardDiscarded event)
     {
         auto& [player, cards, count] = event;
-
-        auto& handCards = m_context->registry.try_get<HandCards>(player)->handCards;
-        auto* equipments = m_context->registry.try_get<Equipments>(player);
-        auto& [weapon, armor, attackhorse, defensehorse] = *equipments;
-        // 用 unordered_set 提升查找效率
-        absl::flat_hash_set<entt::entity> cardSet(cards.begin(), cards.end());
-
-        // 移除手牌
-        auto newEnd = std::ranges::remove_if(handCards, [&](entt::entity card) { return cardSet.contains(card); });
-        handCards.erase(newEnd.begin(), newEnd.end());
-
-        auto checkDiscarded = [](entt::entity& equipments, absl::flat_hash_set<entt::entity>& cardSet)
+        for (auto card : cards)
         {
-            if (equipments != entt::null && cardSet.contains(equipments))
+            const auto& location = m_locations->get(card);
+            if ((location.zone == CardZone::HAND || location.zone == CardZone::EQUIPMENT) && location.owner == player)
             {
-                equipments = entt::null;
+                moveCard(card, CardZone::PROCESSING_AREA);
             }
-        };
-        checkDiscarded(weapon, cardSet);
-        checkDiscarded(armor, cardSet);
-        checkDiscarded(attackhorse, cardSet);
-        checkDiscarded(defensehorse, cardSet);
+        }
+    }
 
-        m_deck.processingArea.insert(m_deck.processingArea.end(), cards.begin(), cards.end());
+    /**
+     * @brief 一次结算完成：结算的牌中仍在处理区的进入弃牌堆
+     */
+    void onDetailFinish(const events::DetailFinish& event)
+    {
+        for (auto card : event.cards)
+        {
+            if (m_locations->get(card).zone == CardZone::PROCESSING_AREA)
+            {
+                moveCard(card, CardZone::DISCARD_PILE);
+            }
+        }
     }
 
-    void onProcessFinished()
+    /**
+     * @brief 回合结束：处理区剩余的牌全部进入弃牌堆
+     */
+    void onProcessFinished([[maybe_unused]] const events::NextTurn& event)
     {
-        m_deck.discardPile.insert(m_deck.discardPile.end(), m_deck.processingArea.begin(), m_deck.processingArea.end());
+        for (auto card : m_deck.processingArea)
+        {
+            place(card,
+                  {.zone = CardZone::DISCARD_PILE,
+                   .owner = entt::null,
+                   .slot = static_cast<uint32_t>(m_deck.discardPile.size())});
+            m_deck.discardPile.push_back(card);
+        }
         m_deck.processingArea.clear();
     }
 
     void onShuffleDeck(events::ShuffleDeck event)
     {
-        absl::BitGen gen; // 自动使用系统随机源初始化
-
         // 打乱弃牌堆
-        std::shuffle(m_deck.discardPile.begin(), m_deck.discardPile.end(), gen);
+        std::shuffle(m_deck.discardPile.begin(), m_deck.discardPile.end(), m_gen);
 
-        // 将弃牌堆放入抽牌堆
-        m_deck.drawPile.insert(m_deck.drawPile.end(), m_deck.discardPile.begin(), m_deck.discardPile.end());
+        // 弃牌堆垫在抽牌堆下面：牌顶在尾部，剩余的牌仍先被摸到
+        m_deck.discardPile.insert(m_deck.discardPile.end(), m_deck.drawPile.begin(), m_deck.drawPile.end());
+        m_deck.drawPile.swap(m_deck.discardPile);
 
         // 清空弃牌堆
         m_deck.discardPile.clear();
+        relocateAll(CardZone::DRAW_PILE);
     }
 
     /**
@@ -111,7 +372,7 @@ private:
     void onDealCards(events::DealCards event)
     {
         auto& [player, count] = event;
-        auto& handCards = m_context->registry.get<HandCards>(player).handCards;
+        auto& handCards = m_hands->get(player).handCards;
 
         if (m_deck.drawPile.empty() or m_deck.drawPile.size() < count)
         {
@@ -120,8 +381,15 @@ private:
         }
         if (!m_deck.drawPile.empty())
         {
-            handCards.insert(handCards.end(), m_deck.drawPile.begin(), m_deck.drawPile.begin() + count);
-            m_deck.drawPile.erase(m_deck.drawPile.begin(), m_deck.drawPile.begin() + count);
+            // 洗牌后仍不足时能发几张发几张
+            count = static_cast<uint8_t>(std::min<size_t>(count, m_deck.drawPile.size()));
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                const auto card = m_deck.drawPile.back();
+                m_deck.drawPile.pop_back();
+                place(card, {.zone = CardZone::HAND, .owner = player, .slot = static_cast<uint32_t>(handCards.size())});
+                handCards.push_back(card);
+            }
             m_context->dispatcher.trigger<events::CardDrawn>(
                 {.player = player,
                  .cards = std::span<entt::entity>(handCards.end() - count, handCards.end()),
@@ -137,69 +405,84 @@ private:
      * @brief 在摸牌堆中查找指定卡牌
      * @param event 查找卡牌事件，包含卡牌名称、花色和点数
      */
-    void onFindCardInDrawPile(events::FindCardInDrawPile event)
+    void onFindCardInDrawPile(const events::FindCardInDrawPile& event)
     {
-        m_findCard = entt::null;
-        auto& [cardName, suitType, rank] = event;
-        {
-            auto it1 = std::ranges::find_if(m_deck.drawPile.begin(),
-                                            m_deck.drawPile.end(),
-                                            [&](entt::entity card)
-                                            {
-                                                auto& meta = m_context->registry.get<MetaCardInfo>(card);
-                                                return meta.name == cardName;
-                                            });
-            if (it1 != m_deck.drawPile.end())
-            {
-                m_findCard = *it1;
-                return;
-            }
-        }
+        m_findCard = findCard(CardZone::DRAW_PILE, event.card, event.suitType, event.rank);
     }
 
-    void onFindCardInHandCards(events::FindCardInHandCardsArea event)
+    void onFindCardInHandCards(const events::FindCardInHandCardsArea& event)
     {
-        m_findCard = entt::null;
-        auto& [cardName, suitType, rank] = event;
-        // 遍历所有玩家手牌区域
-        for (auto player : m_context->registry.view<HandCards>())
-        {
-            auto& handCards = m_context->registry.get<HandCards>(player).handCards;
-            {
-                auto it1 = std::ranges::find_if(handCards.begin(),
-                                                handCards.end(),
-                                                [&](entt::entity card)
-                                                {
-                                                    auto& meta = m_context->registry.get<MetaCardInfo>(card);
-                                                    return meta.name == cardName;
-                                                });
-                if (it1 != handCards.end())
-                {
-                    m_findCard = *it1;
-                    return;
-                }
-            }
-        }
+        m_findCard = findCard(CardZone::HAND, event.card, event.suitType, event.rank);
     }
 
+    /**
+     * @brief 创建整副牌：批量创建实体并一次性写入 CardEntry 与 CardLocation，算好每张牌的检索桶号，洗好后放入抽牌堆
+     */
     void initDeck()
     {
-        // 初始化牌堆，创建所有卡牌实体并加入摸牌堆
-        // 这里简化为只创建少量示例卡牌
         auto& registry = m_context->registry;
+        registry.destroy(m_cards.begin(), m_cards.end());
         m_deck.drawPile.clear();
         m_deck.discardPile.clear();
         m_deck.processingArea.clear();
-        // NOLINTNEXTLINE
-        for (int i = 0; i < 52; ++i)
+
+        m_cards.resize(m_deckSize);
+        registry.create(m_cards.begin(), m_cards.end());
+        const auto perDeck = static_cast<uint32_t>(m_database->deckSize());
+        auto entries = std::views::iota(uint32_t{0}, static_cast<uint32_t>(m_deckSize)) |
+                       std::views::transform([perDeck](uint32_t position)
+                                             { return CardEntry{.index = static_cast<uint16_t>(position % perDeck)}; });
+        registry.insert<CardEntry>(m_cards.begin(), m_cards.end(), entries.begin());
+        registry.insert<CardLocation>(m_cards.begin(), m_cards.end());
+        buildZoneIndex();
+
+        m_deck.drawPile = m_cards;
+        std::shuffle(m_deck.drawPile.begin(), m_deck.drawPile.end(), m_gen);
+        relocateAll(CardZone::DRAW_PILE);
+        m_context->logger->info("牌堆初始化完成，包含 {} 张卡牌", m_deck.drawPile.size());
+    }
+
+    /**
+     * @brief 清空各牌区的检索桶，按数据库为每张牌算好桶号；此时所有牌都在 CardZone::NONE，随后由 relocateAll 入桶
+     */
+    void buildZoneIndex()
+    {
+        const size_t perDeck = m_database->deckSize();
+        for (auto& zoneIndex : m_zoneIndex)
         {
-            entt::entity card = registry.create();
-            registry.emplace<MetaCardInfo>(card, MetaCardInfo{.name = "Card" + std::to_string(i + 1)});
-            m_deck.drawPile.push_back(card);
+            zoneIndex.byKey.assign(perDeck, {});
+            zoneIndex.byId.assign(perDeck, {});
+        }
+
+        std::vector<IndexEntry> buckets(perDeck);
+        for (uint16_t index = 0; index < perDeck; ++index)
+        {
+            const CardId id = m_database->id(index);
+            const CardKey key{.card = id, .suit = m_database->suit(index), .rank = m_database->point(index)};
+            buckets[index] = {.keyBucket = m_database->find(key).front(), .idBucket = m_database->find(id).front()};
+        }
+
+        uint32_t maxEntity = 0;
+        for (auto card : m_cards)
+        {
+            maxEntity = std::max<uint32_t>(maxEntity, entt::to_entity(card));
+        }
+        m_indexEntries.assign(m_cards.empty() ? 0 : maxEntity + 1, {});
+        for (size_t position = 0; position < m_cards.size(); ++position)
+        {
+            indexEntry(m_cards[position]) = buckets[position % perDeck];
         }
-        m_context->logger->info("牌堆初始化完成，包含 {} 张卡牌", m_deck.drawPile.size());
     }
+
     GameContext* m_context;
+    const CardDatabase* m_database;
+    entt::storage_for_t<CardLocation>* m_locations; // 缓存组件存储，移牌时免去按类型查找存储
+    entt::storage_for_t<HandCards>* m_hands;
+    size_t m_deckSize;
+    std::vector<entt::entity> m_cards; // 牌堆第 i 张对应的实体，即数据库第 i % N 张
     Deck m_deck;
+    std::array<ZoneIndex, ZONE_COUNT> m_zoneIndex;
+    std::vector<IndexEntry> m_indexEntries; // 按实体编号（entt::to_entity）索引
+    absl::BitGen m_gen; // 未给定种子时使用系统随机源初始化
     entt::entity m_findCard{entt::null};
 };
\ No newline at end of file
@@ -20,14 +20,17 @@
 #include "src/server/context/GameContext.h"
 #include "src/server/events/NetWorkEvents.h"
 #include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/StaticMessageDispatcher.h"
+#include "src/shared/messages/MessageDictionary.h"
 #include "src/shared/messages/request/SendMessageRequest.h"
 #include "src/shared/messages/response/SendMessageToChatResponse.h"
+#include "src/shared/rpc/RpcServer.h"
 #include "src/net/protocol/FrameCodec.h"
 
 class NetworkMessageSystem
 {
 public:
-    explicit NetworkMessageSystem(GameContext& context) : m_context(&context) { registerMessageHandlers(); };
+    explicit NetworkMessageSystem(GameContext& context) : m_rpcServer(context.executor), m_context(&context) {}
 
     void registerEvents()
     {
@@ -43,50 +46,67 @@ public:
     };
 
 private:
-    MessageDispatcher m_messageDispatcher;
-
-    void registerMessageHandlers()
+    // 编译期分发表：Messages 中的每个消息类型对应 handle 的一个重载
+    struct Handlers
     {
-        // 注册聊天消息处理器
-        m_messageDispatcher.registerHandler<SendMessageRequest>(
-            [this](const SendMessageRequest& req) -> std::expected<std::vector<uint8_t>, MessageError>
-            {
-                m_context->logger->info("收到聊天消息 [频道{}]: {}", req.channelId, req.content);
+        NetworkMessageSystem* system;
+
+        template <typename Message>
+        auto operator()(const Message& message, shared::PacketWriter& out)
+        {
+            return system->handle(message, out);
+        }
+    };
+    using Messages = MessageList<SendMessageRequest>;
+
+    StaticMessageDispatcher<Messages, Handlers> m_messageDispatcher{Handlers{this}};
+    shared::PacketWriter m_responseWriter; // 响应直接编码到这里，跨消息复用
+    RpcServer m_rpcServer; // 请求 / 响应式消息：协程处理器在房间的执行器上执行，响应带 requestId 经 event.reply 发回
 
-                // 构造响应 (回显)
-                SendMessageToChatResponse resp;
-                resp.sender = 0; // System or User ID
-                resp.chatMessage = "Server Echo: " + req.content;
+    // 聊天消息：回显
+    std::expected<std::span<const uint8_t>, MessageError> handle(const SendMessageRequest& req,
+                                                                 shared::PacketWriter& out)
+    {
+        m_context->logger->info("收到聊天消息 [频道{}]: {}", req.channelId, req.content);
 
-                return resp.serialize();
-            });
+        SendMessageToChatResponse resp;
+        resp.sender = 0; // System or User ID
+        resp.chatMessage = "Server Echo: " + req.content;
+        return encodeMessage(resp, out);
     }
 
     void onNetworkMessageReceived(const events::NetworkMessageReceived& event)
     {
-        // 使用 FrameCodec 解码帧
-        auto decodeResult = decodeFrame(event.payload);
+        // 一条 KCP 消息可能携带多帧（发送方 queueFrame 合并），逐帧分发；压缩帧按预置字典解压
+        auto frames = decodeFrames(event.payload, &messageDictionary());
+        for (const auto& [cmdId, payload] : frames)
+        {
+            if (!m_rpcServer.onFrame(cmdId, payload, event.reply))
+            {
+                dispatchFrame(event.connectionId, cmdId, payload);
+            }
+        }
 
-        if (!decodeResult)
+        if (frames.error())
         {
             m_context->logger->warn("数据包解码失败 (来自连接 {})", event.connectionId);
-            return;
         }
+    }
 
-        auto [cmdId, payload] = *decodeResult;
-
+    void dispatchFrame([[maybe_unused]] uint32_t connectionId, uint16_t cmdId, std::span<const uint8_t> payload)
+    {
         // 分发消息
-        auto result = m_messageDispatcher.dispatch(cmdId, payload);
+        auto result = m_messageDispatcher.dispatch(cmdId, payload, m_responseWriter);
 
         if (result)
         {
-            // 这里的 result 是 Handler 返回的响应数据 (std::vector<uint8_t>)
+            // 这里的 result 是 Handler 编码在 m_responseWriter 中的响应帧
             // 实际应用中，我们需要通过 NetworkManager/Server 发送回客户端
             // 由于 NetworkMessageSystem 目前没有直接持有 Server 实例，我们这里仅做逻辑处理
             // 或者触发一个 "SendNetworkPacket" 事件
             m_context->logger->info("消息处理成功，生成响应 {} 字节", result->size());
 
-            // TODO: m_context->dispatcher.trigger<events::SendNetworkPacket>({event.connectionId, *result});
+            // 需要回复的请求改为注册到 m_rpcServer，响应按 requestId 经 event.reply 发回发送者
         }
         else
         {
@@ -16,6 +16,7 @@
 #include <entt/entt.hpp>
 #include <absl/container/flat_hash_map.h>
 #include "src/server/Interface/ISkill.h"
+#include "src/server/components/Skill.h"
 class SkillSystem
 {
 public:
@@ -24,7 +25,21 @@ public:
     void registerEvents() {}
     void unregisterEvents() {}
 
+    /**
+     * @brief 登记技能实现，同一技能重复登记时覆盖
+     */
+    void addSkill(SkillId id, entt::poly<ISkill> skill) { m_skillMap.insert_or_assign(id, std::move(skill)); }
+
+    /**
+     * @brief 按技能标识取实现，找不到时返回 nullptr
+     */
+    [[nodiscard]] const entt::poly<ISkill>* findSkill(SkillId id) const
+    {
+        auto it = m_skillMap.find(id);
+        return it == m_skillMap.end() ? nullptr : &it->second;
+    }
+
 private:
     GameContext* m_context;
-    absl::flat_hash_map<std::string, entt::poly<ISkill>> m_skillMap;
+    absl::flat_hash_map<SkillId, entt::poly<ISkill>> m_skillMap;
 };
\ No newline at end of file
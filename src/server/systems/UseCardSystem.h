@@ -35,14 +35,8 @@ private:
     {
         auto [user, target, card] = event;
 
-        if (m_context->registry.all_of<CardEffect>(card))
-        {
-            auto& cet = m_context->registry.get<CardEffect>(card);
-
-            cet.apply(user, target, m_context->registry); // 执行 delegate
-        }
-        auto& handCards = m_context->registry.get<HandCards>(user).handCards;
-        std::erase(handCards, card);
+        // 卡牌效果由 EffectSystem 结算（CardEffect 组件已删除），牌从手牌进入处理区由 DeckSystem 处理
+        m_context->logger->debug("角色 {} 使用了卡牌 {}", static_cast<int>(user), static_cast<int>(card));
     }
 
     void onCardShown(const events::CardShown& event)
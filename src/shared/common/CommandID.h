@@ -26,6 +26,8 @@ namespace CommandID
 constexpr uint16_t CONNECTED = 0x1001;  // 客户端连接请求
 constexpr uint16_t HEARTBEAT = 0x1002;  // 心跳
 constexpr uint16_t DISCONNECT = 0x1003; // 断开连接
+constexpr uint16_t RPC_REQUEST = 0x1004;  // RPC 请求信封（RpcHeader + 请求消息）
+constexpr uint16_t RPC_RESPONSE = 0x2004; // RPC 响应信封（RpcHeader + 响应消息）
 
 // ==================== 房间管理 (0x1100-0x11FF) ====================
 constexpr uint16_t CREATE_ROOM_REQ = 0x1100;  // 创建房间请求
@@ -33,6 +33,30 @@ public:
 
     PacketWriter() { buffer.reserve(128); }
 
+    /**
+     * @brief 预先分配 capacity 字节（已知编码长度时一次分配到位）
+     */
+    explicit PacketWriter(size_t capacity) { buffer.reserve(capacity); }
+
+    /**
+     * @brief 清空已写入的数据，保留容量以便复用
+     */
+    void clear() noexcept { buffer.clear(); }
+
+    /**
+     * @brief 预留 n 个字节（填 0），供之后回填（如帧头）
+     * @return 预留区域在 buffer 中的起始偏移
+     */
+    size_t reserveBytes(size_t n)
+    {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + n);
+        return offset;
+    }
+
+    [[nodiscard]] std::span<uint8_t> view() noexcept { return buffer; }
+    [[nodiscard]] std::span<const uint8_t> view() const noexcept { return buffer; }
+
     void writeUint8(uint8_t v) { buffer.push_back(v); }
 
     void writeUint16(uint16_t v)
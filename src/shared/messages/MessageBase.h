@@ -20,27 +20,41 @@
 #include <span>
 #include <nlohmann/json.hpp>
 #include "src/shared/common/PacketStream.h"
+#include "MessageSchema.h"
 
 enum class MessageError
 {
     BufferTooSmall,
     InvalidFormat,
-    DeserializeFailed
+    DeserializeFailed,
+    SerializeFailed
 };
 
 /**
  * @brief 消息基类，提供统一的序列化接口
  * @tparam Derived 派生类类型
+ *
+ * 派生类用 static constexpr auto fields() 列出字段（见 MessageSchema.h）时，writeTo / readFrom / toJsonImpl、
+ * fromJson、serializedSize 与增量编码都由字段表生成；也可以自行提供 writeTo / readFrom / toJsonImpl。
  */
 template <typename Derived>
 struct MessageBase
 {
-    // 序列化
+    // 序列化：字段表给出精确长度，一次分配
     std::vector<uint8_t> serialize() const
     {
-        shared::PacketWriter writer;
-        static_cast<const Derived*>(this)->writeTo(writer);
-        return writer.buffer;
+        if constexpr (schema::HasSchema<Derived>)
+        {
+            shared::PacketWriter writer(serializedSize());
+            derived().writeTo(writer);
+            return std::move(writer.buffer);
+        }
+        else
+        {
+            shared::PacketWriter writer;
+            derived().writeTo(writer);
+            return std::move(writer.buffer);
+        }
     }
 
     // 反序列化
@@ -60,5 +74,73 @@ struct MessageBase
     }
 
     // Json 接口用于调试
-    [[nodiscard]] nlohmann::json toJson() const { return static_cast<const Derived*>(this)->toJsonImpl(); }
+    [[nodiscard]] nlohmann::json toJson() const { return derived().toJsonImpl(); }
+
+    void writeTo(shared::PacketWriter& writer) const
+        requires schema::HasSchema<Derived>
+    {
+        schema::writeFields(derived(), writer);
+    }
+
+    void readFrom(shared::PacketReader& reader)
+        requires schema::HasSchema<Derived>
+    {
+        schema::readFields(static_cast<Derived&>(*this), reader);
+    }
+
+    [[nodiscard]] nlohmann::json toJsonImpl() const
+        requires schema::HasSchema<Derived>
+    {
+        return schema::toJson(derived());
+    }
+
+    static std::expected<Derived, MessageError> fromJson(const nlohmann::json& json)
+        requires schema::HasSchema<Derived>
+    {
+        Derived msg;
+        try
+        {
+            schema::fromJson(msg, json);
+        }
+        catch (...)
+        {
+            return std::unexpected(MessageError::DeserializeFailed);
+        }
+        return msg;
+    }
+
+    // 编码后的字节数（不含帧头）
+    [[nodiscard]] size_t serializedSize() const noexcept
+        requires schema::HasSchema<Derived>
+    {
+        return schema::serializedSize(derived());
+    }
+
+    // 相对上一条消息的增量编码：只写出变化的字段
+    void writeDeltaTo(const Derived& previous, shared::PacketWriter& writer) const
+        requires schema::HasSchema<Derived>
+    {
+        schema::writeDelta(derived(), previous, writer);
+    }
+
+    // 在上一条消息上应用增量；失败时消息保持不变
+    std::expected<void, MessageError> applyDelta(std::span<const uint8_t> data)
+        requires schema::HasSchema<Derived>
+    {
+        shared::PacketReader reader(data);
+        Derived next = derived();
+        try
+        {
+            schema::readDelta(next, reader);
+        }
+        catch (...)
+        {
+            return std::unexpected(MessageError::InvalidFormat);
+        }
+        static_cast<Derived&>(*this) = std::move(next);
+        return {};
+    }
+
+private:
+    const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
 };
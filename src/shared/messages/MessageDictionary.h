@@ -0,0 +1,62 @@
+/**
+ * ************************************************************************
+ *
+ * @file MessageDictionary.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 帧压缩的预置字典（客户端与服务端共用）
+ *
+ * 字典内容取自消息载荷里反复出现的片段：小整数 ID 的小端编码、bool + 字符串长度前缀、
+ * 结算 / 出牌 / 聊天描述中的固定用语与卡牌名。匹配偏移可以回指到字典，
+ * 所以几十字节的结算消息也能压缩。越常见的片段放得越靠后（离载荷越近，查找表中后写入的位置优先）。
+ *
+ * @note 字典是协议的一部分：修改内容后新旧版本的压缩帧不再互通，需同时升级客户端与服务端
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "src/net/protocol/FrameCompression.h"
+#include <cstdint>
+#include <span>
+
+namespace detail
+{
+// 字符串字面量中相邻的 \x 转义分开书写，避免与后续十六进制字符连读
+constexpr char MESSAGE_DICTIONARY_CONTENT[] =
+    // 房间、聊天
+    "房间已创建房间已满房间不存在加入房间离开房间"
+    "Server Echo: "
+    // 出牌与结算用语
+    "不在攻击范围内目标无效结算失败：已被抵消"
+    "使用了【决斗】双方轮流出杀，未能出杀的一方受到一点伤害"
+    "使用了【火攻】造成1点火焰伤害"
+    "使用了【酒】，下一次【杀】伤害+1进入濒死状态"
+    "使用了【桃】，回复1点体力"
+    "打出了【闪】，抵消了【杀】"
+    // ID 的小端编码：前后两个 ID 相连的形式（高位 0 + 下一个 ID）
+    "\x00\x00\x00" "\x01\x00\x00\x00" "\x02\x00\x00\x00" "\x03\x00\x00\x00" "\x04\x00\x00\x00"
+    "\x05\x00\x00\x00" "\x06\x00\x00\x00" "\x07\x00\x00\x00" "\x08\x00\x00\x00"
+    // 最常见：结算成功的描述
+    "结算成功：玩家1对玩家2使用了【杀】，造成1点伤害";
+} // namespace detail
+
+/**
+ * @brief 消息帧压缩的预置字典
+ * @code
+ *   session->setFrameCompression(FrameCompression{.dictionary = &messageDictionary()});
+ *   for (auto [cmd, payload] : decodeFrames(packet, &messageDictionary())) { ... }
+ * @endcode
+ */
+inline const FrameDictionary& messageDictionary()
+{
+    // 去掉字面量结尾的 '\0'
+    static const FrameDictionary dictionary(
+        std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(detail::MESSAGE_DICTIONARY_CONTENT),
+                                 sizeof(detail::MESSAGE_DICTIONARY_CONTENT) - 1));
+    return dictionary;
+}
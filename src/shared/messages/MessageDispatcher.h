@@ -21,6 +21,7 @@
 #include <span>
 #include <expected>
 #include <memory>
+#include <cstring>
 
 /**
  * @brief 消息处理器基类
@@ -144,45 +145,127 @@ private:
 };
 
 /**
- * @brief 消息编码辅助函数
+ * @brief 消息编码到可复用的 writer：预留帧头，消息就地序列化，最后回填帧头
+ *
+ * 使用示例（writer 在多次发送间复用，稳定后不再分配内存）：
+ * auto frame = encodeMessage(resp, m_writer);
+ * if (frame) session->send(*frame);
+ *
  * @tparam MessageType 消息类型
  * @param message 消息对象
- * @return 成功返回完整的帧数据（包含 FrameHeader），失败返回错误
+ * @param writer 输出缓冲，编码前会被清空
+ * @return 成功返回 writer 内完整帧（包含 FrameHeader）的视图，下次写入 writer 前有效
  */
 template <typename MessageType>
-std::expected<std::vector<uint8_t>, MessageError> encodeMessage(const MessageType& message)
+std::expected<std::span<const uint8_t>, MessageError> encodeMessage(const MessageType& message,
+                                                                    shared::PacketWriter& writer)
 {
-    std::vector<uint8_t> payloadBuffer(1024);
+    writer.clear();
+    writer.reserveBytes(FRAME_HEADER_SIZE);
+    try
+    {
+        message.writeTo(writer);
+    }
+    catch (...)
+    {
+        return std::unexpected(MessageError::SerializeFailed);
+    }
 
-    // 序列化消息
-    auto payloadResult = message.serialize(payloadBuffer);
-    if (!payloadResult)
+    auto frameResult = patchFrameHeader(writer.view(), MessageType::CMD_ID);
+    if (!frameResult)
     {
-        return std::unexpected(payloadResult.error());
+        return std::unexpected(MessageError::SerializeFailed);
     }
+    return *frameResult;
+}
 
-    // 编码为帧
-    std::vector<uint8_t> frameBuffer(2048);
-    auto frameResult = encodeFrame(frameBuffer, MessageType::CMD_ID, *payloadResult);
+/**
+ * @brief 消息编码到可复用的 writer，载荷达到阈值且压缩有收益时写出压缩帧
+ *
+ * 消息先就地序列化，再压缩到 writer 尾部的临时区域并移回帧头之后，writer 稳定后同样不分配内存。
+ * @param compression 压缩选项（通常使用 messageDictionary() 作为字典）
+ * @return 成功返回 writer 内完整帧的视图，下次写入 writer 前有效
+ */
+template <typename MessageType>
+std::expected<std::span<const uint8_t>, MessageError>
+    encodeMessage(const MessageType& message, shared::PacketWriter& writer, const FrameCompression& compression)
+{
+    auto frameResult = encodeMessage(message, writer);
     if (!frameResult)
+    {
+        return frameResult;
+    }
+
+    const size_t payloadSize = writer.buffer.size() - FRAME_HEADER_SIZE;
+    if (payloadSize < compression.threshold)
+    {
+        return frameResult;
+    }
+
+    // 临时区域只要 payloadSize - 1 字节：放不下说明压缩没有收益
+    const size_t scratchOffset = writer.reserveBytes(payloadSize - 1);
+    const auto frame = writer.view();
+    const size_t packed = compressPayload(
+        frame.subspan(FRAME_HEADER_SIZE, payloadSize), frame.subspan(scratchOffset), compression.dictionary);
+    if (packed == 0)
+    {
+        writer.buffer.resize(scratchOffset);
+        return std::span<const uint8_t>(writer.buffer);
+    }
+
+    std::memmove(frame.data() + FRAME_HEADER_SIZE, frame.data() + scratchOffset, packed);
+    writer.buffer.resize(FRAME_HEADER_SIZE + packed);
+    auto patched = patchFrameHeader(writer.view(), MessageType::CMD_ID, FRAME_MAGIC_COMPRESSED);
+    if (!patched)
     {
         return std::unexpected(MessageError::SerializeFailed);
     }
+    return *patched;
+}
 
-    return std::vector<uint8_t>(frameResult->begin(), frameResult->end());
+/**
+ * @brief 消息编码辅助函数
+ * @tparam MessageType 消息类型
+ * @param message 消息对象
+ * @return 成功返回完整的帧数据（包含 FrameHeader），失败返回错误
+ */
+template <typename MessageType>
+std::expected<std::vector<uint8_t>, MessageError> encodeMessage(const MessageType& message)
+{
+    // 有字段表时帧长度已知，一次分配到位
+    auto writer = [&message]
+    {
+        if constexpr (schema::HasSchema<MessageType>)
+        {
+            return shared::PacketWriter(FRAME_HEADER_SIZE + message.serializedSize());
+        }
+        else
+        {
+            return shared::PacketWriter();
+        }
+    }();
+    auto frameResult = encodeMessage(message, writer);
+    if (!frameResult)
+    {
+        return std::unexpected(frameResult.error());
+    }
+    return std::move(writer.buffer);
 }
 
 /**
  * @brief 消息解码辅助函数
  * @tparam MessageType 消息类型
  * @param frameData 完整的帧数据（包含 FrameHeader）
+ * @param dictionary 对端压缩时使用的预置字典；未压缩的帧忽略该参数
  * @return 成功返回消息对象，失败返回错误
  */
 template <typename MessageType>
-std::expected<MessageType, MessageError> decodeMessage(std::span<const uint8_t> frameData)
+std::expected<MessageType, MessageError> decodeMessage(std::span<const uint8_t> frameData,
+                                                       const FrameDictionary* dictionary = nullptr)
 {
-    // 解码帧
-    auto frameResult = decodeFrame(frameData);
+    // 解码帧（压缩帧解压到临时缓冲）
+    std::vector<uint8_t> scratch;
+    auto frameResult = decodeFrame(frameData, scratch, dictionary);
     if (!frameResult)
     {
         return std::unexpected(MessageError::InvalidFormat);
@@ -0,0 +1,278 @@
+/**
+ * ************************************************************************
+ *
+ * @file MessageSchema.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 消息字段表：由编译期字段描述生成二进制读写、JSON 转换、精确长度与增量编码
+ *
+ * 消息只需列出字段（名称 + 成员指针），其余代码由模板生成：
+ * @code
+ *   struct CreateRoomRequest : MessageBase<CreateRoomRequest>
+ *   {
+ *       std::string roomName;
+ *       uint8_t maxPlayers = 4;
+ *
+ *       static constexpr auto fields()
+ *       {
+ *           return std::tuple{schema::field("roomName", &CreateRoomRequest::roomName),
+ *                             schema::field("maxPlayers", &CreateRoomRequest::maxPlayers)};
+ *       }
+ *   };
+ * @endcode
+ * 线上格式与手写的 writeTo / readFrom 相同：字段按列出的顺序排列，整数小端，bool 一个字节，
+ * 字符串与数组以 u16 长度开头。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "src/shared/common/PacketStream.h"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace schema
+{
+/**
+ * @brief 一个字段：JSON 中的名称与成员指针
+ */
+template <typename Owner, typename T>
+struct Field
+{
+    using Type = T;
+
+    std::string_view name;
+    T Owner::*member;
+};
+
+template <typename Owner, typename T>
+constexpr Field<Owner, T> field(std::string_view name, T Owner::*member) noexcept
+{
+    return {name, member};
+}
+
+/**
+ * @brief 字段类型的线上编码：size 给出编码后的字节数，write / read 与 PacketWriter / PacketReader 对应
+ */
+template <typename T>
+struct FieldCodec;
+
+template <>
+struct FieldCodec<uint8_t>
+{
+    static constexpr size_t size(uint8_t) noexcept { return 1; }
+    static void write(shared::PacketWriter& writer, uint8_t value) { writer.writeUint8(value); }
+    static uint8_t read(shared::PacketReader& reader) { return reader.readUint8(); }
+};
+
+template <>
+struct FieldCodec<uint16_t>
+{
+    static constexpr size_t size(uint16_t) noexcept { return 2; }
+    static void write(shared::PacketWriter& writer, uint16_t value) { writer.writeUint16(value); }
+    static uint16_t read(shared::PacketReader& reader) { return reader.readUint16(); }
+};
+
+template <>
+struct FieldCodec<uint32_t>
+{
+    static constexpr size_t size(uint32_t) noexcept { return 4; }
+    static void write(shared::PacketWriter& writer, uint32_t value) { writer.writeUint32(value); }
+    static uint32_t read(shared::PacketReader& reader) { return reader.readUint32(); }
+};
+
+template <>
+struct FieldCodec<bool>
+{
+    static constexpr size_t size(bool) noexcept { return 1; }
+    static void write(shared::PacketWriter& writer, bool value) { writer.writeBool(value); }
+    static bool read(shared::PacketReader& reader) { return reader.readBool(); }
+};
+
+template <>
+struct FieldCodec<std::string>
+{
+    static size_t size(const std::string& value) noexcept { return 2 + value.size(); }
+    static void write(shared::PacketWriter& writer, const std::string& value) { writer.writeString(value); }
+    static std::string read(shared::PacketReader& reader) { return reader.readString(); }
+};
+
+// 数组：u16 元素个数 + 逐个元素
+template <typename T>
+struct FieldCodec<std::vector<T>>
+{
+    static size_t size(const std::vector<T>& values) noexcept
+    {
+        size_t total = 2;
+        for (const auto& value : values)
+        {
+            total += FieldCodec<T>::size(value);
+        }
+        return total;
+    }
+
+    static void write(shared::PacketWriter& writer, const std::vector<T>& values)
+    {
+        if (values.size() > UINT16_MAX)
+        {
+            throw std::length_error("Array too long for packet");
+        }
+        writer.writeUint16(static_cast<uint16_t>(values.size()));
+        for (const auto& value : values)
+        {
+            FieldCodec<T>::write(writer, value);
+        }
+    }
+
+    static std::vector<T> read(shared::PacketReader& reader)
+    {
+        const uint16_t count = reader.readUint16();
+        std::vector<T> values;
+        values.reserve(count);
+        for (uint16_t i = 0; i < count; ++i)
+        {
+            values.push_back(FieldCodec<T>::read(reader));
+        }
+        return values;
+    }
+};
+
+/**
+ * @brief 通过静态成员函数 fields() 描述了字段的消息
+ */
+template <typename Message>
+concept HasSchema = requires { Message::fields(); };
+
+template <HasSchema Message>
+constexpr size_t fieldCount() noexcept
+{
+    return std::tuple_size_v<decltype(Message::fields())>;
+}
+
+/**
+ * @brief 依次对每个字段调用 visit(field)
+ */
+template <HasSchema Message, typename Visitor>
+constexpr void forEachField(Visitor&& visit)
+{
+    std::apply([&visit](const auto&... fields) { (visit(fields), ...); }, Message::fields());
+}
+
+/**
+ * @brief 编码后的精确字节数
+ */
+template <HasSchema Message>
+size_t serializedSize(const Message& message) noexcept
+{
+    size_t total = 0;
+    forEachField<Message>(
+        [&](const auto& field)
+        { total += FieldCodec<typename std::decay_t<decltype(field)>::Type>::size(message.*field.member); });
+    return total;
+}
+
+template <HasSchema Message>
+void writeFields(const Message& message, shared::PacketWriter& writer)
+{
+    forEachField<Message>(
+        [&](const auto& field)
+        { FieldCodec<typename std::decay_t<decltype(field)>::Type>::write(writer, message.*field.member); });
+}
+
+template <HasSchema Message>
+void readFields(Message& message, shared::PacketReader& reader)
+{
+    forEachField<Message>(
+        [&](const auto& field)
+        { message.*field.member = FieldCodec<typename std::decay_t<decltype(field)>::Type>::read(reader); });
+}
+
+template <HasSchema Message>
+nlohmann::json toJson(const Message& message)
+{
+    nlohmann::json json = nlohmann::json::object();
+    forEachField<Message>([&](const auto& field) { json[std::string(field.name)] = message.*field.member; });
+    return json;
+}
+
+/**
+ * @note 缺少字段或类型不符时抛出 nlohmann::json::exception
+ */
+template <HasSchema Message>
+void fromJson(Message& message, const nlohmann::json& json)
+{
+    forEachField<Message>(
+        [&](const auto& field)
+        {
+            using Type = typename std::decay_t<decltype(field)>::Type;
+            message.*field.member = json.at(std::string(field.name)).template get<Type>();
+        });
+}
+
+/**
+ * @brief 增量编码的字段掩码：字段数不超过 8 / 16 / 32 时分别用 1 / 2 / 4 字节
+ */
+template <HasSchema Message>
+using DeltaMask = std::conditional_t<fieldCount<Message>() <= 8,
+                                     uint8_t,
+                                     std::conditional_t<fieldCount<Message>() <= 16, uint16_t, uint32_t>>;
+
+/**
+ * @brief 相对上一条消息的增量编码：[掩码][变化的字段...]，第 i 位表示第 i 个字段有变化
+ *
+ * 适合周期性同步、大部分字段不变的状态消息；两端各自保存上一条消息，接收端用 readDelta 在其上就地更新。
+ */
+template <HasSchema Message>
+void writeDelta(const Message& current, const Message& previous, shared::PacketWriter& writer)
+{
+    static_assert(fieldCount<Message>() <= 32, "增量编码最多支持 32 个字段");
+    using Mask = DeltaMask<Message>;
+
+    const size_t maskOffset = writer.reserveBytes(sizeof(Mask));
+    Mask mask = 0;
+    size_t index = 0;
+    forEachField<Message>(
+        [&](const auto& field)
+        {
+            if (!(current.*field.member == previous.*field.member))
+            {
+                mask |= static_cast<Mask>(Mask{1} << index);
+                FieldCodec<typename std::decay_t<decltype(field)>::Type>::write(writer, current.*field.member);
+            }
+            ++index;
+        });
+    std::memcpy(writer.buffer.data() + maskOffset, &mask, sizeof(Mask));
+}
+
+/**
+ * @brief 读取增量编码，把变化的字段写入 message（调用前 message 为上一条消息）
+ */
+template <HasSchema Message>
+void readDelta(Message& message, shared::PacketReader& reader)
+{
+    using Mask = DeltaMask<Message>;
+    const auto mask = reader.readPOD<Mask>();
+    size_t index = 0;
+    forEachField<Message>(
+        [&](const auto& field)
+        {
+            if ((mask >> index) & 1U)
+            {
+                message.*field.member = FieldCodec<typename std::decay_t<decltype(field)>::Type>::read(reader);
+            }
+            ++index;
+        });
+}
+} // namespace schema
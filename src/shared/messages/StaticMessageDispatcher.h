@@ -0,0 +1,232 @@
+/**
+ * ************************************************************************
+ *
+ * @file StaticMessageDispatcher.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 编译期生成的消息分发表：由消息类型列表生成按命令段索引的跳转表，处理器经模板内联
+ *
+ * MessageDispatcher 每次分发要做一次哈希查找和一次虚调用，再把消息反序列化到 expected 里返回。
+ * 消息类型在编译期已知时使用本分发器：CommandID 按 0x100 分段（连接、房间、游戏逻辑、聊天……），
+ * 表的第一级以命令 ID 的高字节选出段，第二级以低字节取出该消息类型的入口函数，两次数组下标即可定位；
+ * 入口函数就地读取消息并直接调用处理器的对应重载，处理器可以被完整内联。
+ * 只有列表中实际出现的段才占用一页（256 个函数指针）。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "MessageBase.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 消息类型列表
+ */
+template <typename... Messages>
+struct MessageList
+{
+    static constexpr size_t size = sizeof...(Messages);
+};
+
+namespace detail
+{
+constexpr size_t MESSAGE_PAGE_SIZE = 256; // 每段命令数（CommandID 的低字节）
+constexpr size_t MESSAGE_PAGE_COUNT = 256;
+
+// 高字节 -> 页号（从 1 开始，0 表示该段没有消息）
+template <typename... Messages>
+constexpr std::array<uint8_t, MESSAGE_PAGE_COUNT> messagePageSlots()
+{
+    std::array<uint8_t, MESSAGE_PAGE_COUNT> slots{};
+    uint8_t next = 0;
+    for (uint16_t cmd : {Messages::CMD_ID...})
+    {
+        auto& slot = slots[cmd >> 8];
+        if (slot == 0)
+        {
+            slot = ++next;
+        }
+    }
+    return slots;
+}
+
+template <typename... Messages>
+constexpr bool uniqueCommandIds()
+{
+    std::array<uint16_t, sizeof...(Messages)> ids{Messages::CMD_ID...};
+    std::ranges::sort(ids);
+    return std::ranges::adjacent_find(ids) == ids.end();
+}
+} // namespace detail
+
+template <typename List, typename Handler>
+class StaticMessageDispatcher;
+
+/**
+ * @brief 静态消息分发器
+ * @tparam Messages 消息类型（各有唯一的 CMD_ID 与 readFrom）
+ * @tparam Handler 处理器，对每个消息类型提供一个重载（可以是重载的 operator() 或泛型 lambda）
+ *
+ * 两种分发方式，按处理器提供的重载选用：
+ *  - dispatch(cmd, payload)：调用 handler(const M&)，所有重载返回同一个 std::expected<T, MessageError>
+ *  - dispatch(cmd, payload, writer)：调用 handler(const M&, shared::PacketWriter&)，处理器把响应直接写入调用方的
+ *    writer（通常 return encodeMessage(resp, writer);），返回 writer 内的视图，不分配内存
+ * 未知命令返回 MessageError::InvalidFormat，消息解析失败同样返回 InvalidFormat，与 MessageDispatcher 一致。
+ * @code
+ *   struct Handlers
+ *   {
+ *       auto operator()(const CreateRoomRequest& req, shared::PacketWriter& out)
+ *       {
+ *           return encodeMessage(CreateRoomResponse::createSuccess(1), out);
+ *       }
+ *       ...
+ *   };
+ *   StaticMessageDispatcher<MessageList<CreateRoomRequest, SendMessageRequest>, Handlers> dispatcher;
+ *   auto response = dispatcher.dispatch(cmd, payload, m_writer);
+ * @endcode
+ */
+template <typename... Messages, typename Handler>
+class StaticMessageDispatcher<MessageList<Messages...>, Handler>
+{
+    static_assert(sizeof...(Messages) > 0, "消息列表不能为空");
+    static_assert(detail::uniqueCommandIds<Messages...>(), "消息列表中有重复的 CMD_ID");
+
+    static constexpr auto PAGE_SLOTS = detail::messagePageSlots<Messages...>();
+    static constexpr size_t PAGE_COUNT = *std::ranges::max_element(PAGE_SLOTS);
+
+public:
+    using WriterResult = std::expected<std::span<const uint8_t>, MessageError>;
+
+    explicit StaticMessageDispatcher(Handler handler = Handler{}) : m_handler(std::move(handler)) {}
+
+    /**
+     * @brief 分发一条消息，处理器返回的结果原样返回
+     */
+    auto dispatch(uint16_t cmdId, std::span<const uint8_t> payload)
+        requires(std::invocable<Handler&, const Messages&> && ...)
+    {
+        using Result = std::invoke_result_t<Handler&, const FirstMessage&>;
+        static_assert((std::same_as<Result, std::invoke_result_t<Handler&, const Messages&>> && ...),
+                      "所有处理器重载必须返回同一类型");
+        static_assert(std::same_as<typename Result::error_type, MessageError>,
+                      "处理器返回 std::expected<T, MessageError>");
+
+        using Entry = Result (*)(Handler&, std::span<const uint8_t>);
+        static constexpr auto TABLE = buildTable<Entry>([]<typename M>() { return &invokeValue<Result, M>; });
+
+        const Entry entry = lookup(TABLE, cmdId);
+        if (entry == nullptr) [[unlikely]]
+        {
+            return Result(std::unexpected(MessageError::InvalidFormat)); // 未注册的命令
+        }
+        return entry(m_handler, payload);
+    }
+
+    /**
+     * @brief 分发一条消息，处理器把响应写入调用方提供的 writer
+     * @return 成功返回处理器给出的 writer 内视图，下次写入 writer 前有效
+     */
+    WriterResult dispatch(uint16_t cmdId, std::span<const uint8_t> payload, shared::PacketWriter& writer)
+        requires(std::invocable<Handler&, const Messages&, shared::PacketWriter&> && ...)
+    {
+        using Entry = WriterResult (*)(Handler&, std::span<const uint8_t>, shared::PacketWriter&);
+        static constexpr auto TABLE = buildTable<Entry>([]<typename M>() { return &invokeWriter<M>; });
+
+        const Entry entry = lookup(TABLE, cmdId);
+        if (entry == nullptr) [[unlikely]]
+        {
+            return std::unexpected(MessageError::InvalidFormat);
+        }
+        return entry(m_handler, payload, writer);
+    }
+
+    /**
+     * @brief 列表中是否有该命令
+     */
+    static constexpr bool hasHandler(uint16_t cmdId) noexcept { return ((cmdId == Messages::CMD_ID) || ...); }
+
+    /**
+     * @brief 跳转表占用的页数（列表中出现的命令段数）
+     */
+    static constexpr size_t pageCount() noexcept { return PAGE_COUNT; }
+
+    Handler& handler() noexcept { return m_handler; }
+
+private:
+    using FirstMessage = std::tuple_element_t<0, std::tuple<Messages...>>;
+
+    template <typename Entry, typename MakeEntry>
+    static constexpr std::array<Entry, PAGE_COUNT * detail::MESSAGE_PAGE_SIZE> buildTable(MakeEntry makeEntry)
+    {
+        std::array<Entry, PAGE_COUNT * detail::MESSAGE_PAGE_SIZE> table{};
+        ((table[indexOf(Messages::CMD_ID)] = makeEntry.template operator()<Messages>()), ...);
+        return table;
+    }
+
+    static constexpr size_t indexOf(uint16_t cmdId) noexcept
+    {
+        return (PAGE_SLOTS[cmdId >> 8] - 1) * detail::MESSAGE_PAGE_SIZE + (cmdId & 0xFF);
+    }
+
+    template <typename Entry, size_t N>
+    static Entry lookup(const std::array<Entry, N>& table, uint16_t cmdId) noexcept
+    {
+        if (PAGE_SLOTS[cmdId >> 8] == 0)
+        {
+            return nullptr;
+        }
+        return table[indexOf(cmdId)];
+    }
+
+    // 就地读取消息（不经过 deserialize 的 expected 包装），失败时返回 InvalidFormat
+    template <typename Message>
+    static bool readMessage(Message& message, std::span<const uint8_t> payload)
+    {
+        shared::PacketReader reader(payload);
+        try
+        {
+            message.readFrom(reader);
+        }
+        catch (...)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    template <typename Result, typename Message>
+    static Result invokeValue(Handler& handler, std::span<const uint8_t> payload)
+    {
+        Message message;
+        if (!readMessage(message, payload))
+        {
+            return Result(std::unexpected(MessageError::InvalidFormat));
+        }
+        return handler(std::as_const(message));
+    }
+
+    template <typename Message>
+    static WriterResult invokeWriter(Handler& handler, std::span<const uint8_t> payload, shared::PacketWriter& writer)
+    {
+        Message message;
+        if (!readMessage(message, payload))
+        {
+            return std::unexpected(MessageError::InvalidFormat);
+        }
+        return handler(std::as_const(message), writer);
+    }
+
+    Handler m_handler;
+};
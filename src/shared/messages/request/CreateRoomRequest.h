@@ -15,32 +15,22 @@
 
 #pragma once
 #include "../MessageBase.h"
+#include "../response/CreateRoomResponse.h"
 #include "src/shared/common/CommandID.h"
 
 struct CreateRoomRequest : public MessageBase<CreateRoomRequest>
 {
     static constexpr uint16_t CMD_ID = CommandID::CREATE_ROOM_REQ;
+    using Response = CreateRoomResponse; // RpcClient::call 的返回类型
 
     std::string roomName;
     uint8_t maxPlayers = 4;
     std::string password; // 可为空
 
-    void writeTo(shared::PacketWriter& writer) const
+    static constexpr auto fields()
     {
-        writer.writeString(roomName);
-        writer.writeUint8(maxPlayers);
-        writer.writeString(password);
-    }
-
-    void readFrom(shared::PacketReader& reader)
-    {
-        roomName = reader.readString();
-        maxPlayers = reader.readUint8();
-        password = reader.readString();
-    }
-
-    [[nodiscard]] nlohmann::json toJsonImpl() const
-    {
-        return {{"roomName", roomName}, {"maxPlayers", maxPlayers}, {"password", password}};
+        return std::tuple{schema::field("roomName", &CreateRoomRequest::roomName),
+                          schema::field("maxPlayers", &CreateRoomRequest::maxPlayers),
+                          schema::field("password", &CreateRoomRequest::password)};
     }
 };
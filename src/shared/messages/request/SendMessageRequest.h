@@ -15,27 +15,21 @@
 
 #pragma once
 #include "../MessageBase.h"
+#include "../response/SendMessageToChatResponse.h"
 #include "src/shared/common/CommandID.h"
 #include <string>
 
 struct SendMessageRequest : public MessageBase<SendMessageRequest>
 {
     static constexpr uint16_t CMD_ID = CommandID::SEND_MESSAGE_REQ;
+    using Response = SendMessageToChatResponse; // RpcClient::call 的返回类型
 
     uint32_t channelId = 0; // 0: Global, 1: Room, etc.
     std::string content;
 
-    void writeTo(shared::PacketWriter& writer) const
+    static constexpr auto fields()
     {
-        writer.writeUint32(channelId);
-        writer.writeString(content);
+        return std::tuple{schema::field("channelId", &SendMessageRequest::channelId),
+                          schema::field("content", &SendMessageRequest::content)};
     }
-
-    void readFrom(shared::PacketReader& reader)
-    {
-        channelId = reader.readUint32();
-        content = reader.readString();
-    }
-
-    [[nodiscard]] nlohmann::json toJsonImpl() const { return {{"channelId", channelId}, {"content", content}}; }
 };
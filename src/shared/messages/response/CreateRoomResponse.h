@@ -43,22 +43,10 @@ struct CreateRoomResponse : public MessageBase<CreateRoomResponse>
         return resp;
     }
 
-    void writeTo(shared::PacketWriter& writer) const
+    static constexpr auto fields()
     {
-        writer.writeUint32(roomId);
-        writer.writeBool(success);
-        writer.writeUint8(errorCode);
-    }
-
-    void readFrom(shared::PacketReader& reader)
-    {
-        roomId = reader.readUint32();
-        success = reader.readBool();
-        errorCode = reader.readUint8();
-    }
-
-    [[nodiscard]] nlohmann::json toJsonImpl() const
-    {
-        return {{"roomId", roomId}, {"success", success}, {"errorCode", errorCode}};
+        return std::tuple{schema::field("roomId", &CreateRoomResponse::roomId),
+                          schema::field("success", &CreateRoomResponse::success),
+                          schema::field("errorCode", &CreateRoomResponse::errorCode)};
     }
 };
\ No newline at end of file
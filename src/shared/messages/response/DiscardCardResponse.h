@@ -23,33 +23,12 @@ struct DiscardCardResponse : public MessageBase<DiscardCardResponse>
 {
     static constexpr uint16_t CMD_ID = CommandID::DISCARD_CARD_RESP;
 
-    uint32_t player;
+    uint32_t player = 0;
     std::vector<uint32_t> cardIndexs;
 
-    [[nodiscard]] nlohmann::json toJsonImpl() const { return {{"player", player}, {"cardIndexs", cardIndexs}}; }
-
-    static std::expected<DiscardCardResponse, MessageError> fromJsonImpl(const nlohmann::json& json)
-    {
-        try
-        {
-            DiscardCardResponse resp;
-            resp.player = json.at("player").get<uint32_t>();
-            resp.cardIndexs = json.at("cardIndexs").get<std::vector<uint32_t>>();
-            return resp;
-        }
-        catch (...)
-        {
-            return std::unexpected(MessageError::DeserializeFailed);
-        }
-    }
-
-    std::expected<std::span<uint8_t>, MessageError> serializeImpl(std::span<uint8_t>) const
-    {
-        return std::unexpected(MessageError::SerializeFailed);
-    }
-
-    static std::expected<DiscardCardResponse, MessageError> deserializeImpl(std::span<const uint8_t>)
+    static constexpr auto fields()
     {
-        return std::unexpected(MessageError::DeserializeFailed);
+        return std::tuple{schema::field("player", &DiscardCardResponse::player),
+                          schema::field("cardIndexs", &DiscardCardResponse::cardIndexs)};
     }
 };
\ No newline at end of file
@@ -26,17 +26,9 @@ struct SendMessageToChatResponse : public MessageBase<SendMessageToChatResponse>
     uint32_t sender = 0;
     std::string chatMessage;
 
-    void writeTo(shared::PacketWriter& writer) const
+    static constexpr auto fields()
     {
-        writer.writeUint32(sender);
-        writer.writeString(chatMessage);
+        return std::tuple{schema::field("sender", &SendMessageToChatResponse::sender),
+                          schema::field("chatMessage", &SendMessageToChatResponse::chatMessage)};
     }
-
-    void readFrom(shared::PacketReader& reader)
-    {
-        sender = reader.readUint32();
-        chatMessage = reader.readString();
-    }
-
-    [[nodiscard]] nlohmann::json toJsonImpl() const { return {{"sender", sender}, {"chatMessage", chatMessage}}; }
 };
\ No newline at end of file
@@ -23,42 +23,18 @@ struct SettlementResponse : public MessageBase<SettlementResponse>
 {
     static constexpr uint16_t CMD_ID = CommandID::SETTLEMENT_RESP;
 
-    uint32_t player;     // 发起结算的玩家
-    uint32_t card;       // 结算的卡牌
-    uint32_t target;     // 结算目标
-    bool success;        // 结算是否成功
-    std::string message; // 结算结果描述
+    uint32_t player = 0;  // 发起结算的玩家
+    uint32_t card = 0;    // 结算的卡牌
+    uint32_t target = 0;  // 结算目标
+    bool success = false; // 结算是否成功
+    std::string message;  // 结算结果描述
 
-    [[nodiscard]] nlohmann::json toJsonImpl() const
+    static constexpr auto fields()
     {
-        return {{"player", player}, {"card", card}, {"target", target}, {"success", success}, {"message", message}};
-    }
-
-    static std::expected<SettlementResponse, MessageError> fromJsonImpl(const nlohmann::json& json)
-    {
-        try
-        {
-            SettlementResponse resp;
-            resp.player = json.at("player").get<uint32_t>();
-            resp.card = json.at("card").get<uint32_t>();
-            resp.target = json.at("target").get<uint32_t>();
-            resp.success = json.at("success").get<bool>();
-            resp.message = json.at("message").get<std::string>();
-            return resp;
-        }
-        catch (...)
-        {
-            return std::unexpected(MessageError::DeserializeFailed);
-        }
-    }
-
-    std::expected<std::span<uint8_t>, MessageError> serializeImpl(std::span<uint8_t>) const
-    {
-        return std::unexpected(MessageError::SerializeFailed);
-    }
-
-    static std::expected<SettlementResponse, MessageError> deserializeImpl(std::span<const uint8_t>)
-    {
-        return std::unexpected(MessageError::DeserializeFailed);
+        return std::tuple{schema::field("player", &SettlementResponse::player),
+                          schema::field("card", &SettlementResponse::card),
+                          schema::field("target", &SettlementResponse::target),
+                          schema::field("success", &SettlementResponse::success),
+                          schema::field("message", &SettlementResponse::message)};
     }
 };
@@ -0,0 +1,218 @@
+/**
+ * ************************************************************************
+ *
+ * @file RpcClient.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 协程式 RPC 客户端：按 requestId 把响应对应到发起的调用
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "RpcProtocol.h"
+#include "src/net/Session/KcpSession.h"
+#include <asio/redirect_error.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/this_coro.hpp>
+#include <asio/use_awaitable.hpp>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 在一个会话上发起 RPC 调用
+ *
+ * 请求经 KcpSession::queueFrame 排入批量缓冲，同一 tick 内发起的调用合并发送；每个调用挂起等待自己的响应，
+ * 多个调用可同时在途（流水线），响应按 requestId 对应，可以乱序完成。
+ * 收到的帧需先交给 onFrame，返回 false 的帧再按普通消息处理。
+ * @code
+ *   RpcClient rpc(session);
+ *   // 接收协程：for (auto [cmd, payload] : decodeFrames(*packet)) { if (!rpc.onFrame(cmd, payload)) { ... } }
+ *   auto resp = co_await rpc.call(CreateRoomRequest{.roomName = "room"});
+ *   if (resp && resp->success) { ... }
+ * @endcode
+ * @note call、onFrame、cancelAll 都在驱动会话的网络线程（会话的 executor）上调用
+ */
+class RpcClient
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{5'000};
+
+    explicit RpcClient(std::shared_ptr<KcpSession> session) : m_session(std::move(session)) {}
+
+    // 析构时取消所有在途调用，挂起的协程随后以 RpcError::Cancelled 恢复
+    ~RpcClient() { cancelAll(); }
+
+    RpcClient(const RpcClient&) = delete;
+    RpcClient& operator=(const RpcClient&) = delete;
+
+    /**
+     * @brief 发起一次调用并等待类型化的响应
+     * @param request 请求消息（按值传入，co_spawn 时不必担心临时对象的生命周期）
+     * @param timeout 超时时间，到期未收到响应返回 RpcError::Timeout，迟到的响应被丢弃
+     * @return 成功返回 Request::Response；服务端拒绝、超时或被取消时返回对应的 RpcError，会话已关闭时立即返回 Cancelled
+     *
+     * 支持 asio 的按操作取消：通过 bind_cancellation_slot 或 awaitable_operators 的 || 取消时返回 Cancelled。
+     */
+    template <RpcRequest Request>
+    asio::awaitable<std::expected<typename Request::Response, RpcError>>
+        call(Request request, std::chrono::milliseconds timeout = DEFAULT_TIMEOUT)
+    {
+        using Response = typename Request::Response;
+
+        const RpcHeader header{.requestId = nextRequestId(), .cmd = Request::CMD_ID};
+        auto payload = encodeRpcEnvelope(header, request, m_writer);
+        if (!payload)
+        {
+            co_return std::unexpected(payload.error());
+        }
+        if (auto queued = m_session->queueFrame(CommandID::RPC_REQUEST, *payload); !queued)
+        {
+            // 会话已关闭时请求不会发出，也不会有响应：立即返回，不等到超时
+            co_return std::unexpected(queued.error() == CodecError::SessionClosed ? RpcError::Cancelled
+                                                                                   : RpcError::SerializeFailed);
+        }
+
+        // 挂起期间的状态放在协程帧里：响应或 cancelAll 写入结果后把它移出表并唤醒定时器
+        PendingCall pending(co_await asio::this_coro::executor, m_pending, header.requestId);
+        pending.timer.expires_after(timeout);
+
+        std::error_code ec;
+        co_await pending.timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        if (!pending.finished)
+        {
+            co_return std::unexpected(ec ? RpcError::Cancelled : RpcError::Timeout); // 析构时移出表
+        }
+
+        if (pending.error)
+        {
+            co_return std::unexpected(*pending.error);
+        }
+        if (pending.cmd != Response::CMD_ID)
+        {
+            co_return std::unexpected(RpcError::BadResponse);
+        }
+        auto response = Response::deserialize(pending.body);
+        if (!response)
+        {
+            co_return std::unexpected(RpcError::BadResponse);
+        }
+        co_return std::move(*response);
+    }
+
+    /**
+     * @brief 交付一帧收到的消息
+     * @return 是 RPC 响应则返回 true（包括已超时调用的迟到响应和格式错误的信封，均被丢弃）；否则返回 false
+     */
+    bool onFrame(uint16_t cmd, std::span<const uint8_t> payload)
+    {
+        if (cmd != CommandID::RPC_RESPONSE)
+        {
+            return false;
+        }
+        auto envelope = parseRpcEnvelope(payload);
+        if (!envelope) [[unlikely]]
+        {
+            return true;
+        }
+        auto it = m_pending.find(envelope->header.requestId);
+        if (it == m_pending.end())
+        {
+            return true;
+        }
+
+        PendingCall& pending = *it->second;
+        m_pending.erase(it);
+        const uint8_t status = envelope->header.status;
+        if (status == RPC_STATUS_OK)
+        {
+            pending.cmd = envelope->header.cmd;
+            pending.body.assign(envelope->body.begin(), envelope->body.end());
+        }
+        else
+        {
+            const bool known = status <= static_cast<uint8_t>(RpcError::SerializeFailed);
+            pending.error = known ? static_cast<RpcError>(status) : RpcError::BadResponse;
+        }
+        complete(pending);
+        return true;
+    }
+
+    /**
+     * @brief 取消所有在途调用（如断线时），它们以 RpcError::Cancelled 返回
+     */
+    void cancelAll()
+    {
+        for (auto& [requestId, pending] : m_pending)
+        {
+            pending->error = RpcError::Cancelled;
+            complete(*pending);
+        }
+        m_pending.clear();
+    }
+
+    /**
+     * @brief 在途（已发出、尚未完成）的调用数
+     */
+    [[nodiscard]] size_t pendingCalls() const noexcept { return m_pending.size(); }
+
+private:
+    struct PendingCall;
+    using PendingTable = std::unordered_map<uint32_t, PendingCall*>;
+
+    // 未完成就销毁（超时、被取消、协程帧随 io_context 销毁）时自行移出表；
+    // 已完成时表项已被移除，不再访问表（RpcClient 可能已经析构）
+    struct PendingCall
+    {
+        PendingCall(const asio::any_io_executor& executor, PendingTable& table, uint32_t requestId)
+            : timer(executor), table(table), requestId(requestId)
+        {
+            table.emplace(requestId, this);
+        }
+
+        ~PendingCall()
+        {
+            if (!finished)
+            {
+                table.erase(requestId);
+            }
+        }
+
+        PendingCall(const PendingCall&) = delete;
+        PendingCall& operator=(const PendingCall&) = delete;
+
+        asio::steady_timer timer; // 同时用作超时与完成通知
+        bool finished = false;
+        std::optional<RpcError> error;
+        uint16_t cmd = 0;
+        std::vector<uint8_t> body; // 响应消息体，调用方恢复后解码
+        PendingTable& table;
+        uint32_t requestId;
+    };
+
+    static void complete(PendingCall& pending)
+    {
+        pending.finished = true;
+        pending.timer.cancel();
+    }
+
+    uint32_t nextRequestId() noexcept
+    {
+        if (++m_nextRequestId == 0) [[unlikely]]
+        {
+            ++m_nextRequestId; // 0 保留
+        }
+        return m_nextRequestId;
+    }
+
+    std::shared_ptr<KcpSession> m_session;
+    PendingTable m_pending;         // requestId -> 挂起中的调用
+    shared::PacketWriter m_writer; // 请求编码缓冲，跨调用复用
+    uint32_t m_nextRequestId = 0;
+};
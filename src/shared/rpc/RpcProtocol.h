@@ -0,0 +1,124 @@
+/**
+ * ************************************************************************
+ *
+ * @file RpcProtocol.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 请求 / 响应 RPC 的线上信封
+ *
+ * RPC 请求与响应各用一个命令 ID（CommandID::RPC_REQUEST / RPC_RESPONSE），载荷为：
+ *   [requestId u32][cmd u16][status u8][消息体]
+ * requestId 由调用方分配，响应原样带回，调用方据此把响应对应到发起的调用，同一会话上的调用可以流水线并发、
+ * 乱序完成。cmd 是消息体的类型（请求为 Request::CMD_ID，成功的响应为 Response::CMD_ID），
+ * status 非 0 时表示服务端拒绝或处理失败，此时没有消息体。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "src/shared/common/CommandID.h"
+#include "src/shared/messages/MessageBase.h"
+#include "src/net/protocol/SharedFrame.h"
+#include <concepts>
+#include <cstring>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <span>
+
+/**
+ * @brief RPC 调用失败的原因；前几项同时作为响应信封的 status 在线上传输
+ */
+enum class RpcError : uint8_t
+{
+    UnknownCommand = 1, // 服务端没有注册该请求的处理器
+    BadRequest,         // 服务端无法解析请求消息
+    HandlerFailed,      // 处理器返回错误或抛出异常
+    Timeout,            // 超时前没有收到响应
+    Cancelled,          // 调用被取消（cancellation slot、RpcClient::cancelAll 或 RpcClient 析构）
+    BadResponse,        // 响应的类型或格式不符
+    SerializeFailed     // 本端消息编码失败或超过帧长度上限
+};
+
+constexpr uint8_t RPC_STATUS_OK = 0;
+
+#pragma pack(push, 1)
+struct RpcHeader
+{
+    uint32_t requestId = 0;
+    uint16_t cmd = 0;
+    uint8_t status = RPC_STATUS_OK;
+};
+#pragma pack(pop)
+
+constexpr size_t RPC_HEADER_SIZE = sizeof(RpcHeader);
+
+/**
+ * @brief 把响应帧发回发起请求的会话（通常转发到其 KcpSession::queueSharedFrame，可在任意线程调用）
+ */
+using RpcReply = std::function<void(SharedFrame)>;
+
+/**
+ * @brief 可以发起 RPC 的请求消息：声明了对应的响应类型 Request::Response
+ */
+template <typename Request>
+concept RpcRequest = requires {
+    { Request::CMD_ID } -> std::convertible_to<uint16_t>;
+    { Request::Response::CMD_ID } -> std::convertible_to<uint16_t>;
+};
+
+struct RpcEnvelope
+{
+    RpcHeader header;
+    std::span<const uint8_t> body; // 信封头之后的消息体
+};
+
+/**
+ * @brief 解析信封，载荷短于信封头时返回 std::nullopt
+ */
+inline std::optional<RpcEnvelope> parseRpcEnvelope(std::span<const uint8_t> payload) noexcept
+{
+    if (payload.size() < RPC_HEADER_SIZE) [[unlikely]]
+    {
+        return std::nullopt;
+    }
+    RpcEnvelope envelope;
+    std::memcpy(&envelope.header, payload.data(), RPC_HEADER_SIZE);
+    envelope.body = payload.subspan(RPC_HEADER_SIZE);
+    return envelope;
+}
+
+/**
+ * @brief 只编码信封头（失败的响应没有消息体）
+ */
+inline std::span<const uint8_t> encodeRpcEnvelope(const RpcHeader& header, shared::PacketWriter& writer)
+{
+    writer.clear();
+    const size_t offset = writer.reserveBytes(RPC_HEADER_SIZE);
+    std::memcpy(writer.buffer.data() + offset, &header, RPC_HEADER_SIZE);
+    return writer.view();
+}
+
+/**
+ * @brief 把信封头与消息编码到可复用的 writer（只有载荷，帧头由发送方添加）
+ * @return 成功返回 writer 内载荷的视图，下次写入 writer 前有效
+ */
+template <typename MessageType>
+std::expected<std::span<const uint8_t>, RpcError>
+    encodeRpcEnvelope(const RpcHeader& header, const MessageType& message, shared::PacketWriter& writer)
+{
+    encodeRpcEnvelope(header, writer);
+    try
+    {
+        message.writeTo(writer);
+    }
+    catch (...)
+    {
+        return std::unexpected(RpcError::SerializeFailed);
+    }
+    return std::span<const uint8_t>(writer.buffer);
+}
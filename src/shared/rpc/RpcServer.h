@@ -0,0 +1,226 @@
+/**
+ * ************************************************************************
+ *
+ * @file RpcServer.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief RPC 服务端：按请求类型分发，处理器可以是普通函数或协程，响应带回 requestId
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "RpcProtocol.h"
+#include "src/net/Session/KcpSession.h"
+#include <asio/any_io_executor.hpp>
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+
+/**
+ * @brief 回复到指定会话：响应帧经 KcpSession::queueSharedFrame 排入，可在任意线程调用；会话已释放时丢弃
+ */
+inline RpcReply replyTo(const std::shared_ptr<KcpSession>& session)
+{
+    return [weak = std::weak_ptr<KcpSession>(session)](SharedFrame frame)
+    {
+        if (auto target = weak.lock())
+        {
+            target->queueSharedFrame(std::move(frame));
+        }
+    };
+}
+
+/**
+ * @brief RPC 请求分发器
+ *
+ * 处理器签名为 R(const Request&)，R 可以是：
+ *  - Request::Response 或 std::expected<Request::Response, RpcError>：在 onFrame 的调用线程上同步执行并立即回复
+ *  - asio::awaitable<...> 包装上述两者之一：在构造时给定的 executor 上 co_spawn，挂起期间不占用调用线程，
+ *    完成后再回复；同一会话的多个请求并发执行，响应按完成顺序发出
+ * 处理器返回错误或抛出异常时回复对应的 RpcError（异常为 HandlerFailed），未注册的请求回复 UnknownCommand。
+ * @code
+ *   RpcServer rpc(pool.get_executor());
+ *   rpc.registerHandler<CreateRoomRequest>(
+ *       [](const CreateRoomRequest& req) -> asio::awaitable<CreateRoomResponse> { co_return ...; });
+ *   // 接收协程：if (!rpc.onFrame(cmd, payload, replyTo(session))) { ... }
+ * @endcode
+ * @note registerHandler 在开始分发前完成；onFrame 在同一线程调用；RpcServer 需比仍在执行的协程处理器活得久
+ */
+class RpcServer
+{
+public:
+    explicit RpcServer(asio::any_io_executor executor) : m_executor(std::move(executor)) {}
+
+    RpcServer(const RpcServer&) = delete;
+    RpcServer& operator=(const RpcServer&) = delete;
+
+    /**
+     * @brief 注册请求处理器，同一请求类型重复注册时替换
+     */
+    template <RpcRequest Request, typename Handler>
+    void registerHandler(Handler&& handler)
+    {
+        using Response = typename Request::Response;
+        using Result = std::invoke_result_t<std::decay_t<Handler>&, const Request&>;
+
+        // 协程处理器持有 shared_ptr，处理器被替换或注销时仍在执行的调用不受影响
+        auto stored = std::make_shared<std::decay_t<Handler>>(std::forward<Handler>(handler));
+        m_handlers[Request::CMD_ID] =
+            [this, stored = std::move(stored)](uint32_t requestId, std::span<const uint8_t> body, const RpcReply& reply)
+        {
+            auto request = Request::deserialize(body);
+            if (!request)
+            {
+                sendStatus(requestId, RpcError::BadRequest, reply, m_writer);
+                return;
+            }
+
+            if constexpr (IsAwaitable<Result>::value)
+            {
+                m_inFlight.fetch_add(1, std::memory_order_relaxed);
+                asio::co_spawn(
+                    m_executor,
+                    [this, handler = stored, request = std::move(*request), requestId, reply]() -> asio::awaitable<void>
+                    {
+                        std::expected<Response, RpcError> result = std::unexpected(RpcError::HandlerFailed);
+                        try
+                        {
+                            result = co_await (*handler)(request);
+                        }
+                        catch (...)
+                        {
+                            // 处理器抛出异常：回复 HandlerFailed
+                        }
+                        shared::PacketWriter writer; // 协程可能在线程池的任意线程上完成，不共用 m_writer
+                        sendResult(requestId, result, reply, writer);
+                        m_inFlight.fetch_sub(1, std::memory_order_relaxed);
+                    },
+                    asio::detached);
+            }
+            else
+            {
+                std::expected<Response, RpcError> result = std::unexpected(RpcError::HandlerFailed);
+                try
+                {
+                    result = (*stored)(*request);
+                }
+                catch (...)
+                {
+                    // 同上
+                }
+                sendResult(requestId, result, reply, m_writer);
+            }
+        };
+    }
+
+    /**
+     * @brief 交付一帧收到的消息
+     * @param reply 回复到发起请求的会话（见 replyTo），为空时只执行处理器、不回复
+     * @return 是 RPC 请求则返回 true（格式错误、无法回复的信封被丢弃）；否则返回 false，交给其他分发器
+     */
+    bool onFrame(uint16_t cmd, std::span<const uint8_t> payload, const RpcReply& reply)
+    {
+        if (cmd != CommandID::RPC_REQUEST)
+        {
+            return false;
+        }
+        auto envelope = parseRpcEnvelope(payload);
+        if (!envelope) [[unlikely]]
+        {
+            return true;
+        }
+
+        const auto& header = envelope->header;
+        auto it = m_handlers.find(header.cmd);
+        if (it == m_handlers.end())
+        {
+            sendStatus(header.requestId, RpcError::UnknownCommand, reply, m_writer);
+            return true;
+        }
+        it->second(header.requestId, envelope->body, reply);
+        return true;
+    }
+
+    bool hasHandler(uint16_t cmdId) const { return m_handlers.contains(cmdId); }
+
+    void unregisterHandler(uint16_t cmdId) { m_handlers.erase(cmdId); }
+
+    /**
+     * @brief 设置响应帧的压缩选项，std::nullopt 关闭压缩（默认）
+     * @note 在开始分发前设置；字典与对端 decodeFrames 使用的一致
+     */
+    void setFrameCompression(std::optional<FrameCompression> compression) { m_compression = compression; }
+
+    /**
+     * @brief 正在执行（已 co_spawn、尚未回复）的协程处理器数量，可在任意线程读取
+     */
+    [[nodiscard]] size_t inFlight() const noexcept { return m_inFlight.load(std::memory_order_relaxed); }
+
+private:
+    using Dispatch = std::function<void(uint32_t requestId, std::span<const uint8_t> body, const RpcReply& reply)>;
+
+    template <typename T>
+    struct IsAwaitable : std::false_type
+    {
+    };
+
+    template <typename T, typename Executor>
+    struct IsAwaitable<asio::awaitable<T, Executor>> : std::true_type
+    {
+    };
+
+    template <typename Response>
+    void sendResult(uint32_t requestId,
+                    const std::expected<Response, RpcError>& result,
+                    const RpcReply& reply,
+                    shared::PacketWriter& writer) const
+    {
+        if (!result)
+        {
+            sendStatus(requestId, result.error(), reply, writer);
+            return;
+        }
+        const RpcHeader header{.requestId = requestId, .cmd = Response::CMD_ID};
+        auto payload = encodeRpcEnvelope(header, *result, writer);
+        if (!payload || !send(*payload, reply))
+        {
+            sendStatus(requestId, RpcError::HandlerFailed, reply, writer); // 响应无法编码或超过帧长度上限
+        }
+    }
+
+    void sendStatus(uint32_t requestId, RpcError error, const RpcReply& reply, shared::PacketWriter& writer) const
+    {
+        const RpcHeader header{.requestId = requestId, .status = static_cast<uint8_t>(error)};
+        send(encodeRpcEnvelope(header, writer), reply);
+    }
+
+    bool send(std::span<const uint8_t> payload, const RpcReply& reply) const
+    {
+        if (!reply)
+        {
+            return true;
+        }
+        auto frame = m_compression ? SharedFrame::encode(CommandID::RPC_RESPONSE, payload, *m_compression)
+                                   : SharedFrame::encode(CommandID::RPC_RESPONSE, payload);
+        if (!frame) [[unlikely]]
+        {
+            return false;
+        }
+        reply(std::move(*frame));
+        return true;
+    }
+
+    asio::any_io_executor m_executor; // 协程处理器运行的执行器
+    std::unordered_map<uint16_t, Dispatch> m_handlers;
+    std::optional<FrameCompression> m_compression;
+    shared::PacketWriter m_writer; // 同步处理器与错误回复的编码缓冲（onFrame 线程）
+    std::atomic<size_t> m_inFlight{0};
+};
@@ -0,0 +1,161 @@
+/**
+ * ************************************************************************
+ *
+ * @file Intern.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 字符串驻留：卡牌、技能等以 32 位哈希标识，文本只用于日志与界面
+ *
+ * Interned<Tag> 的值是文本的 entt::hashed_string（FNV-1a），构造为 constexpr，比较与哈希都是整数运算。
+ * intern() 在启动期把文本登记到全局表，之后可由标识取回文本；不同文本哈希相同时登记失败并抛出异常，
+ * 因此所有登记过的标识都是无冲突的。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <entt/core/hashed_string.hpp>
+#include <compare>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace utils
+{
+using InternId = entt::id_type;
+
+/**
+ * @brief 强类型的驻留标识，Tag 区分卡牌、技能等，不同种类的标识不能互相比较
+ */
+template <typename Tag>
+struct Interned
+{
+    InternId value = 0;
+
+    constexpr Interned() noexcept = default;
+    constexpr explicit Interned(std::string_view text) noexcept
+        : value(entt::hashed_string::value(text.data(), text.size()))
+    {
+    }
+
+    /**
+     * @brief 由已有的哈希值构造，用于从数据文件、网络消息中还原标识
+     */
+    static constexpr Interned fromValue(InternId value) noexcept
+    {
+        Interned id;
+        id.value = value;
+        return id;
+    }
+
+    constexpr bool operator==(const Interned&) const noexcept = default;
+    constexpr auto operator<=>(const Interned&) const noexcept = default;
+
+    template <typename H>
+    friend H AbslHashValue(H state, Interned id)
+    {
+        return H::combine(std::move(state), id.value);
+    }
+};
+
+/**
+ * @brief 标识到文本的全局表，线程安全；登记通常只发生在启动期，之后只有读
+ */
+class InternTable
+{
+public:
+    static InternTable& getInstance()
+    {
+        static InternTable instance;
+        return instance;
+    }
+
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+    InternTable(InternTable&&) = delete;
+    InternTable& operator=(InternTable&&) = delete;
+
+    /**
+     * @brief 登记文本，重复登记同一文本无副作用
+     * @throw std::logic_error 与已登记的另一文本哈希冲突
+     */
+    InternId intern(std::string_view text)
+    {
+        const auto id = entt::hashed_string::value(text.data(), text.size());
+        {
+            std::shared_lock lock(m_mutex);
+            if (auto it = m_texts.find(id); it != m_texts.end())
+            {
+                return checked(it->second, text, id);
+            }
+        }
+        std::unique_lock lock(m_mutex);
+        auto [it, inserted] = m_texts.try_emplace(id, text);
+        return inserted ? id : checked(it->second, text, id);
+    }
+
+    /**
+     * @brief 取回文本；未登记的标识返回空串
+     * @note 返回的视图在进程生命周期内有效（节点容器，扩容不移动文本）
+     */
+    [[nodiscard]] std::string_view text(InternId id) const
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_texts.find(id);
+        return it == m_texts.end() ? std::string_view{} : std::string_view{it->second};
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        std::shared_lock lock(m_mutex);
+        return m_texts.size();
+    }
+
+private:
+    InternTable() = default;
+    ~InternTable() = default;
+
+    static InternId checked(const std::string& existing, std::string_view text, InternId id)
+    {
+        if (existing != text)
+        {
+            throw std::logic_error("驻留字符串哈希冲突: \"" + existing + "\" 与 \"" + std::string(text) + "\"");
+        }
+        return id;
+    }
+
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<InternId, std::string> m_texts;
+};
+
+/**
+ * @brief 登记文本并返回标识，用于初始化全局常量：
+ * @code
+ *   inline const CardId STRIKE = utils::intern<CardId>("杀");
+ * @endcode
+ */
+template <typename Id>
+Id intern(std::string_view text)
+{
+    InternTable::getInstance().intern(text);
+    return Id{text};
+}
+
+/**
+ * @brief 标识对应的文本，只应在日志与界面中使用
+ */
+template <typename Tag>
+std::string_view text(Interned<Tag> id)
+{
+    return InternTable::getInstance().text(id.value);
+}
+} // namespace utils
@@ -0,0 +1,45 @@
+/**
+ * ************************************************************************
+ *
+ * @file BenchUtils.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 基准测试公共工具（计时、结果输出）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+namespace bench
+{
+using Clock = std::chrono::steady_clock;
+
+inline double secondsBetween(Clock::time_point begin, Clock::time_point end)
+{
+    return std::chrono::duration<double>(end - begin).count();
+}
+
+inline void printTitle(const char* title)
+{
+    std::printf("\n==== %s ====\n", title);
+}
+
+/**
+ * @brief 阻止编译器优化掉基准结果
+ */
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+} // namespace bench
@@ -0,0 +1,158 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_card_database.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 卡牌数据库基准：新房间初始化 160 张牌的牌堆，按数据库下标批量写入对比逐张调用卡牌工厂
+ *
+ * 每个房间新建 GameContext，创建整副牌并洗入抽牌堆后销毁，统计每房间耗时与堆分配次数。
+ * 修改前的实现按原具体卡牌工厂（CreateStrickCard 等）内联在本文件中：逐张创建实体，
+ * 挂载 MetaCardInfo（复制描述字符串）、CardCost、CardTarget、CardPointAndSuit 与类型标签。
+ * empty room 为只创建 GameContext 的开销，两种实现都包含这部分。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/server/systems/DeckSystem.h"
+#include <asio/system_executor.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+namespace
+{
+bool g_countAllocations = false;
+size_t g_allocations = 0;
+} // namespace
+
+void* operator new(size_t size)
+{
+    if (g_countAllocations)
+    {
+        ++g_allocations;
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+constexpr size_t DECK_SIZE = 160;
+constexpr int ROOMS = 20'000;
+
+struct Result
+{
+    double ns;
+    double allocations;
+};
+
+// ==================== 修改前的实现 ====================
+
+entt::entity createLegacyCard(entt::registry& registry, const CardDatabase& database, uint16_t index)
+{
+    const auto& kind = database.kindOf(index);
+    const MetaCardInfo meta{.id = database.id(index),
+                            .description = std::string(database.text(kind.description)),
+                            .type = toCardType(database.type(index))};
+    const CardTarget target{.needTarget = kind.needTarget != 0,
+                            .maxTargets = kind.maxTargets,
+                            .minTargets = kind.minTargets,
+                            .range = kind.range};
+    const CardPointAndSuit pointAndSuit{.point = database.point(index), .suit = toSuitType(database.suit(index))};
+    if (meta.type == CardType::BASIC)
+    {
+        return CreateBasicCard(registry, meta, {}, target, pointAndSuit, static_cast<BasicCardType>(kind.subtype));
+    }
+    return CreateStrategyCard(registry, meta, {}, target, pointAndSuit, static_cast<StrategyCardType>(kind.subtype));
+}
+
+void initLegacyDeck(GameContext& context, const CardDatabase& database, Deck& deck, std::mt19937& gen)
+{
+    for (size_t i = 0; i < DECK_SIZE; ++i)
+    {
+        deck.drawPile.push_back(
+            createLegacyCard(context.registry, database, static_cast<uint16_t>(i % database.deckSize())));
+    }
+    std::shuffle(deck.drawPile.begin(), deck.drawPile.end(), gen);
+}
+
+// ==================== 计时 ====================
+
+template <typename Room>
+Result measureRooms(Room&& room)
+{
+    g_allocations = 0;
+    g_countAllocations = true;
+    const auto begin = bench::Clock::now();
+    for (int i = 0; i < ROOMS; ++i)
+    {
+        GameContext context(asio::system_executor(),
+                            std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::null_sink_st>()));
+        room(context);
+        bench::doNotOptimize(context.registry.storage<entt::entity>().size());
+    }
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+    g_countAllocations = false;
+    return {.ns = seconds * 1e9 / ROOMS, .allocations = static_cast<double>(g_allocations) / ROOMS};
+}
+
+void report(const char* name, const Result& result)
+{
+    std::printf("%-16s %10.1f ns/room  %8.1f allocs/room\n", name, result.ns, result.allocations);
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("Room deck initialization, 160 cards");
+    const auto& database = BuiltinCardDatabase();
+    std::printf("card database: %zu kinds, %zu cards\n", database.kinds().size(), database.deckSize());
+
+    std::mt19937 gen(2026);
+    const auto empty = measureRooms([](GameContext&) {});
+    const auto legacy = measureRooms(
+        [&](GameContext& context)
+        {
+            Deck deck;
+            initLegacyDeck(context, database, deck, gen);
+            bench::doNotOptimize(deck.drawPile.back());
+        });
+    const auto indexed = measureRooms(
+        [&](GameContext& context)
+        {
+            DeckSystem deck(context, database, DECK_SIZE);
+            deck.registerEvents();
+            bench::doNotOptimize(deck.deck().drawPile.back());
+            deck.unregisterEvents();
+        });
+
+    report("empty room", empty);
+    report("legacy factory", legacy);
+    report("card database", indexed);
+    std::printf("deck init only: legacy %.1f ns / %.1f allocs, database %.1f ns / %.1f allocs (%.2fx)\n",
+                legacy.ns - empty.ns,
+                legacy.allocations - empty.allocations,
+                indexed.ns - empty.ns,
+                indexed.allocations - empty.allocations,
+                (legacy.ns - empty.ns) / (indexed.ns - empty.ns));
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_channels.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 可靠 / 不可靠通道的尾延迟：200 个客户端以 60 Hz 上报光标位置，链路 5% 丢包
+ *
+ * 全程运行在 SimulatedNetwork 的虚拟时钟上（1 ms 一个 tick），两个通道使用同一随机种子。
+ *  - reliable：queueFrame 经 KCP 可靠有序流发送，丢失的段重传，后续消息被队头阻塞
+ *  - unreliable：sendUnreliable 直接作为数据报发送，丢了就丢了，旧值被接收端丢弃
+ * 输出交付率与交付消息的单向延迟分位数。只关心最新值的数据，丢一个可以由下一个（16 ms 后）补上，
+ * 而被阻塞的可靠消息到达时已经过时。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/Client.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/transport/SimulatedUdpTransport.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t CLIENT_COUNT = 200;
+constexpr uint32_t SEND_INTERVAL_MS = 16; // 约 60 Hz
+constexpr uint32_t SEND_DURATION_MS = 10'000;
+constexpr uint32_t DRAIN_MS = 3'000;
+constexpr uint16_t CMD_CURSOR = 0x3001;
+
+// 服务端：业务协程逐帧记录单向延迟
+class SinkEndpoint : public KcpEndpoint
+{
+public:
+    SinkEndpoint(IUdpTransport& transport, asio::io_context& ioc, const SimulatedNetwork& network)
+        : KcpEndpoint(transport), m_ioc(ioc), m_network(network)
+    {
+    }
+
+    std::vector<uint32_t> latenciesUs;
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+    void onSession(uint32_t, std::shared_ptr<KcpSession> session) override
+    {
+        asio::co_spawn(
+            m_ioc,
+            [this, session]() -> asio::awaitable<void>
+            {
+                while (auto packet = co_await session->recv())
+                {
+                    for (const auto& [cmd, payload] : decodeFrames(*packet))
+                    {
+                        uint64_t sentUs = 0;
+                        std::memcpy(&sentUs, payload.data(), sizeof(sentUs));
+                        latenciesUs.push_back(static_cast<uint32_t>(m_network.nowUs() - sentUs));
+                    }
+                }
+            },
+            asio::detached);
+    }
+
+private:
+    asio::io_context& m_ioc;
+    const SimulatedNetwork& m_network;
+};
+
+struct Peer
+{
+    std::unique_ptr<SimulatedUdpTransport> wire;
+    std::unique_ptr<Client> client;
+    std::shared_ptr<KcpSession> session;
+};
+
+void runScenario(const char* name, bool unreliable, const LinkConditions& link)
+{
+    asio::io_context ioc;
+    auto work = asio::make_work_guard(ioc);
+    SimulatedNetwork network(link, 2026);
+    auto serverWire = network.createTransport();
+    SinkEndpoint server(*serverWire, ioc, network);
+    serverWire->setRecvHandler([&server](std::span<const UdpDatagram> batch) { server.input(batch); });
+
+    std::vector<Peer> peers(CLIENT_COUNT);
+    for (uint32_t i = 0; i < CLIENT_COUNT; ++i)
+    {
+        auto& peer = peers[i];
+        peer.wire = network.createTransport();
+        peer.client = std::make_unique<Client>(*peer.wire, ioc.get_executor());
+        peer.wire->setRecvHandler([client = peer.client.get()](std::span<const UdpDatagram> batch)
+                                  { client->input(batch); });
+        peer.session = peer.client->connect(i + 1, serverWire->localAddress());
+    }
+
+    uint64_t messagesSent = 0;
+    std::array<uint8_t, 16> cursor{}; // 发送时刻 + 坐标
+    for (uint32_t nowMs = 0; nowMs < SEND_DURATION_MS + DRAIN_MS; ++nowMs)
+    {
+        const uint64_t nowUs = uint64_t{nowMs} * 1'000;
+        network.advanceTo(nowUs);
+        for (uint32_t i = 0; i < CLIENT_COUNT; ++i)
+        {
+            auto& peer = peers[i];
+            if (nowMs < SEND_DURATION_MS && (nowMs + i) % SEND_INTERVAL_MS == 0)
+            {
+                std::memcpy(cursor.data(), &nowUs, sizeof(nowUs));
+                auto sent = unreliable ? peer.session->sendUnreliable(CMD_CURSOR, cursor)
+                                       : peer.session->queueFrame(CMD_CURSOR, cursor);
+                bench::doNotOptimize(sent);
+                ++messagesSent;
+            }
+            peer.client->update(nowMs);
+        }
+        server.update(nowMs);
+        ioc.poll();
+    }
+
+    auto& latencies = server.latenciesUs;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentileMs = [&latencies](double p)
+    {
+        if (latencies.empty())
+        {
+            return 0.0;
+        }
+        const auto rank = static_cast<size_t>(p * static_cast<double>(latencies.size()));
+        return latencies[std::min(latencies.size() - 1, rank)] / 1'000.0;
+    };
+
+    std::printf("%-11s %7.3f %8.1f %7.1f %7.1f %7.1f %7.1f\n",
+                name,
+                messagesSent == 0 ? 0.0 : static_cast<double>(latencies.size()) / static_cast<double>(messagesSent),
+                percentileMs(0.50),
+                percentileMs(0.99),
+                percentileMs(0.999),
+                percentileMs(0.9999),
+                latencies.empty() ? 0.0 : latencies.back() / 1'000.0);
+
+    for (auto& peer : peers)
+    {
+        peer.session->close();
+    }
+    ioc.poll();
+}
+} // namespace
+
+int main()
+{
+    constexpr LinkConditions LOSSY{.latencyMs = 30, .jitterMs = 5, .lossRate = 0.05};
+
+    bench::printTitle("Cursor updates, 200 clients x 60 Hz x 16 B, 30 ms +- 5 ms, 5% loss");
+    std::printf(
+        "%-11s %7s %8s %7s %7s %7s %7s\n", "channel", "deliv", "p50(ms)", "p99", "p999", "p9999", "max");
+    runScenario("reliable", false, LOSSY);
+    runScenario("unreliable", true, LOSSY);
+    return 0;
+}
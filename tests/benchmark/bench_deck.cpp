@@ -0,0 +1,261 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_deck.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 牌堆基准：160 张牌、8 名玩家，下标式牌区对比修改前的 vector 头部删除与按牌名线性查找
+ *
+ * 牌取自内置卡牌数据库，一副 64 张循环 2.5 副。
+ * - find：开局每人 4 张后，随机 (牌名, 花色, 点数) 在抽牌堆中检索一张牌，以及在所有玩家的手牌中检索
+ * - turn：每名玩家经 DealCards 事件摸 2 张再弃 2 张，轮流进行，牌堆摸空时由弃牌堆洗回
+ * 修改前的实现按原 DeckSystem 逻辑内联在本文件中：摸牌 erase(begin, begin + n)，弃牌用哈希集合 remove_if，
+ * 检索逐张读取牌名组件比较字符串。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/server/systems/DeckSystem.h"
+#include "absl/container/flat_hash_set.h"
+#include <asio/system_executor.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr size_t DECK_SIZE = 160;
+constexpr uint32_t PLAYERS = 8;
+constexpr uint8_t CARDS_PER_TURN = 2;
+constexpr int TURNS = 1'000'000;
+constexpr int LOOKUPS = 1'000'000;
+
+struct Query
+{
+    std::string name;
+    CardId id;
+    SuitType suit;
+    uint8_t rank;
+};
+
+// 修改前 MetaCardInfo 以字符串保存牌名
+struct LegacyCardName
+{
+    std::string name;
+};
+
+std::shared_ptr<spdlog::logger> nullLogger()
+{
+    return std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::null_sink_mt>());
+}
+
+std::vector<entt::entity> createPlayers(entt::registry& registry)
+{
+    std::vector<entt::entity> players;
+    for (uint32_t i = 0; i < PLAYERS; ++i)
+    {
+        MetaPlayerInfo meta{.playerName = "player" + std::to_string(i), .playerID = i};
+        CharacterInfo character{};
+        HandCards hand{};
+        Equipments equipments{};
+        LiveStatus live{};
+        players.push_back(CreatePlayer(registry, meta, character, hand, equipments, live));
+    }
+    return players;
+}
+
+std::vector<Query> makeQueries(const CardDatabase& database)
+{
+    std::mt19937 rng(2026);
+    std::uniform_int_distribution<size_t> pick(0, database.deckSize() - 1);
+    std::vector<Query> queries(1024);
+    for (auto& query : queries)
+    {
+        const auto card = static_cast<uint16_t>(pick(rng));
+        query.name = std::string(database.text(database.kindOf(card).name));
+        query.id = database.id(card);
+        query.suit = toSuitType(database.suit(card));
+        query.rank = database.point(card);
+    }
+    return queries;
+}
+
+// ==================== 修改前的实现 ====================
+
+class LegacyDeck
+{
+public:
+    LegacyDeck(GameContext& context, const CardDatabase& database)
+        : m_context(&context), m_registry(&context.registry)
+    {
+        for (size_t i = 0; i < DECK_SIZE; ++i)
+        {
+            const auto card = m_registry->create();
+            const auto& kind = database.kindOf(static_cast<uint16_t>(i % database.deckSize()));
+            m_registry->emplace<LegacyCardName>(card, LegacyCardName{std::string(database.text(kind.name))});
+            m_deck.drawPile.push_back(card);
+        }
+        m_context->dispatcher.sink<events::DealCards>().connect<&LegacyDeck::onDealCards>(this);
+    }
+
+    ~LegacyDeck() { m_context->dispatcher.disconnect(this); }
+
+    void onDealCards(events::DealCards event)
+    {
+        auto& [player, count] = event;
+        auto& handCards = m_registry->get<HandCards>(player).handCards;
+        if (m_deck.drawPile.size() < count)
+        {
+            std::shuffle(m_deck.discardPile.begin(), m_deck.discardPile.end(), m_gen);
+            m_deck.drawPile.insert(m_deck.drawPile.end(), m_deck.discardPile.begin(), m_deck.discardPile.end());
+            m_deck.discardPile.clear();
+        }
+        handCards.insert(handCards.end(), m_deck.drawPile.begin(), m_deck.drawPile.begin() + count);
+        m_deck.drawPile.erase(m_deck.drawPile.begin(), m_deck.drawPile.begin() + count);
+        m_context->dispatcher.trigger<events::CardDrawn>(
+            {.player = player,
+             .cards = std::span<entt::entity>(handCards.end() - count, handCards.end()),
+             .count = count});
+    }
+
+    void discard(entt::entity player, const std::vector<entt::entity>& cards)
+    {
+        auto& handCards = m_registry->get<HandCards>(player).handCards;
+        absl::flat_hash_set<entt::entity> cardSet(cards.begin(), cards.end());
+        auto newEnd = std::ranges::remove_if(handCards, [&](entt::entity card) { return cardSet.contains(card); });
+        handCards.erase(newEnd.begin(), newEnd.end());
+        m_deck.discardPile.insert(m_deck.discardPile.end(), cards.begin(), cards.end());
+    }
+
+    entt::entity findInDrawPile(const std::string& cardName) const
+    {
+        auto it = std::ranges::find_if(m_deck.drawPile,
+                                       [&](entt::entity card)
+                                       { return m_registry->get<LegacyCardName>(card).name == cardName; });
+        return it == m_deck.drawPile.end() ? entt::null : *it;
+    }
+
+    entt::entity findInHandCards(const std::string& cardName) const
+    {
+        for (auto player : m_registry->view<HandCards>())
+        {
+            const auto& handCards = m_registry->get<HandCards>(player).handCards;
+            auto it = std::ranges::find_if(handCards,
+                                           [&](entt::entity card)
+                                           { return m_registry->get<LegacyCardName>(card).name == cardName; });
+            if (it != handCards.end())
+            {
+                return *it;
+            }
+        }
+        return entt::null;
+    }
+
+private:
+    GameContext* m_context;
+    entt::registry* m_registry;
+    Deck m_deck;
+    std::mt19937 m_gen{2026};
+};
+
+// ==================== 计时 ====================
+
+template <typename Turn>
+double measureTurns(const std::vector<entt::entity>& players, Turn&& turn)
+{
+    const auto begin = bench::Clock::now();
+    for (int i = 0; i < TURNS; ++i)
+    {
+        turn(players[static_cast<size_t>(i) % players.size()]);
+    }
+    return bench::secondsBetween(begin, bench::Clock::now()) * 1e9 / TURNS;
+}
+
+template <typename Find>
+double measureLookups(const std::vector<Query>& queries, Find&& find)
+{
+    size_t found = 0;
+    const auto begin = bench::Clock::now();
+    for (int i = 0; i < LOOKUPS; ++i)
+    {
+        found += find(queries[static_cast<size_t>(i) % queries.size()]) != entt::null ? 1 : 0;
+    }
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+    bench::doNotOptimize(found);
+    return seconds * 1e9 / LOOKUPS;
+}
+
+void report(const char* name, double legacyNs, double indexedNs)
+{
+    std::printf("%-24s legacy %8.1f ns  indexed %8.1f ns  (%.2fx)\n",
+                name,
+                legacyNs,
+                indexedNs,
+                legacyNs / indexedNs);
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("Deck, 160 cards x 8 players: card lookup and draw/discard turn");
+    const auto& database = BuiltinCardDatabase();
+    const auto queries = makeQueries(database);
+
+    GameContext legacyContext(asio::system_executor(), nullLogger());
+    const auto legacyPlayers = createPlayers(legacyContext.registry);
+    LegacyDeck legacy(legacyContext, database);
+
+    GameContext context(asio::system_executor(), nullLogger());
+    const auto players = createPlayers(context.registry);
+    DeckSystem deck(context, database, DECK_SIZE);
+    deck.registerEvents();
+
+    // 开局每人 4 张：抽牌堆剩 128 张，手牌共 32 张
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        legacyContext.dispatcher.trigger(events::DealCards{.player = legacyPlayers[i], .count = 4});
+        context.dispatcher.trigger(events::DealCards{.player = players[i], .count = 4});
+    }
+
+    report("find in draw pile",
+           measureLookups(queries, [&](const Query& query) { return legacy.findInDrawPile(query.name); }),
+           measureLookups(queries,
+                          [&](const Query& query)
+                          { return deck.findCard(CardZone::DRAW_PILE, query.id, query.suit, query.rank); }));
+    report("find in hand cards",
+           measureLookups(queries, [&](const Query& query) { return legacy.findInHandCards(query.name); }),
+           measureLookups(queries,
+                          [&](const Query& query)
+                          { return deck.findCard(CardZone::HAND, query.id, query.suit, query.rank); }));
+
+    std::vector<entt::entity> discarded(CARDS_PER_TURN);
+    const double legacyTurn = measureTurns(
+        legacyPlayers,
+        [&](entt::entity player)
+        {
+            legacyContext.dispatcher.trigger(events::DealCards{.player = player, .count = CARDS_PER_TURN});
+            const auto& hand = legacyContext.registry.get<HandCards>(player).handCards;
+            discarded.assign(hand.end() - CARDS_PER_TURN, hand.end());
+            legacy.discard(player, discarded);
+        });
+    const double indexedTurn = measureTurns(
+        players,
+        [&](entt::entity player)
+        {
+            context.dispatcher.trigger(events::DealCards{.player = player, .count = CARDS_PER_TURN});
+            const auto& hand = context.registry.get<HandCards>(player).handCards;
+            discarded.assign(hand.end() - CARDS_PER_TURN, hand.end());
+            for (auto card : discarded)
+            {
+                deck.moveCard(card, CardZone::DISCARD_PILE);
+            }
+        });
+    report("draw + discard turn", legacyTurn, indexedTurn);
+
+    deck.unregisterEvents();
+    return 0;
+}
@@ -0,0 +1,210 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_echo_latency.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 回环回显延迟直方图：轮询式接收 vs KcpSession::recv 协程接收
+ *
+ * 轮询式：recvAsync 之后固定睡 10 ms 再检查结果（旧版 playerRoutine 的写法）
+ * 协程式：co_await session->recv()，数据到达即恢复
+ * 两端在同一线程上经回环 UDP 往返，输出两种写法的往返延迟分布。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/Client.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/transport/AsioUdpTransport.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdio>
+#include <optional>
+
+namespace
+{
+using bench::Clock;
+
+/**
+ * @brief 以 2 的幂微秒为桶的延迟直方图
+ */
+class LatencyHistogram
+{
+public:
+    void record(Clock::duration latency)
+    {
+        const auto us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+        const size_t bucket = std::min<size_t>(std::bit_width(us), BUCKETS - 1);
+        ++m_buckets[bucket];
+        ++m_count;
+    }
+
+    // 返回百分位所在桶的上界（微秒）
+    [[nodiscard]] uint64_t percentileUs(double percentile) const
+    {
+        const auto target = static_cast<uint64_t>(percentile * static_cast<double>(m_count));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i)
+        {
+            seen += m_buckets[i];
+            if (seen > target)
+            {
+                return (uint64_t{1} << i) - 1;
+            }
+        }
+        return UINT64_MAX;
+    }
+
+    void print(const char* title) const
+    {
+        std::printf("%s (n=%llu, p50<=%lluus, p99<=%lluus)\n",
+                    title,
+                    static_cast<unsigned long long>(m_count),
+                    static_cast<unsigned long long>(percentileUs(0.50)),
+                    static_cast<unsigned long long>(percentileUs(0.99)));
+        for (size_t i = 0; i < BUCKETS; ++i)
+        {
+            if (m_buckets[i] != 0)
+            {
+                std::printf("  < %8lluus : %llu\n",
+                            static_cast<unsigned long long>(uint64_t{1} << i),
+                            static_cast<unsigned long long>(m_buckets[i]));
+            }
+        }
+    }
+
+private:
+    static constexpr size_t BUCKETS = 32;
+    std::array<uint64_t, BUCKETS> m_buckets{};
+    uint64_t m_count = 0;
+};
+
+enum class RecvMode
+{
+    Polling,
+    Awaitable,
+};
+
+// 旧版写法：recvAsync 后固定等待 10 ms 再检查
+asio::awaitable<void> pollingEcho(std::shared_ptr<KcpSession> session)
+{
+    while (true)
+    {
+        auto result = std::make_shared<std::optional<std::expected<KcpSession::Packet, std::error_code>>>();
+        session->recvAsync([result](auto res) { *result = std::move(res); });
+        co_await asio::steady_timer(co_await asio::this_coro::executor, std::chrono::milliseconds(10))
+            .async_wait(asio::use_awaitable);
+        const auto& slot = *result;
+        if (!slot || !slot->has_value())
+        {
+            co_return;
+        }
+        session->send(**slot);
+    }
+}
+
+asio::awaitable<void> awaitableEcho(std::shared_ptr<KcpSession> session)
+{
+    while (auto result = co_await session->recv())
+    {
+        session->send(*result);
+    }
+}
+
+class EchoEndpoint : public KcpEndpoint
+{
+public:
+    EchoEndpoint(IUdpTransport& transport, asio::io_context& ioc, RecvMode mode)
+        : KcpEndpoint(transport), m_ioc(ioc), m_mode(mode)
+    {
+    }
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+    void onSession(uint32_t, std::shared_ptr<KcpSession> session) override
+    {
+        auto routine =
+            m_mode == RecvMode::Polling ? pollingEcho(std::move(session)) : awaitableEcho(std::move(session));
+        asio::co_spawn(m_ioc, std::move(routine), asio::detached);
+    }
+
+private:
+    asio::io_context& m_ioc;
+    RecvMode m_mode;
+};
+
+uint32_t nowMs()
+{
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch()).count());
+}
+
+LatencyHistogram measureEchoLatency(RecvMode mode, int roundTrips)
+{
+    asio::io_context ioc;
+    AsioUdpTransport serverTransport(ioc.get_executor(), 0);
+    AsioUdpTransport clientTransport(ioc.get_executor(), 0);
+    EchoEndpoint server(serverTransport, ioc, mode);
+    Client client(clientTransport, ioc.get_executor());
+    serverTransport.startBatchRecvLoop([&](std::span<const UdpDatagram> batch) { server.input(batch); });
+    clientTransport.startBatchRecvLoop([&](std::span<const UdpDatagram> batch) { client.input(batch); });
+
+    LatencyHistogram histogram;
+    bool done = false;
+    auto session = client.connect(1, NetAddress("127.0.0.1", serverTransport.localPort()));
+    asio::co_spawn(
+        ioc,
+        [&]() -> asio::awaitable<void>
+        {
+            const std::vector<uint8_t> message(64, 0x7E);
+            for (int i = 0; i < roundTrips; ++i)
+            {
+                const auto begin = Clock::now();
+                session->send(message);
+                auto reply = co_await session->recv();
+                if (!reply)
+                {
+                    break;
+                }
+                histogram.record(Clock::now() - begin);
+            }
+            done = true;
+        },
+        asio::detached);
+
+    // 单线程驱动：处理完就绪的 I/O 与协程后立即 update 两端
+    const auto deadline = Clock::now() + std::chrono::seconds(10);
+    while (!done && Clock::now() < deadline)
+    {
+        ioc.run_one_for(std::chrono::microseconds(200));
+        ioc.poll();
+        const uint32_t now = nowMs();
+        client.update(now);
+        server.update(now);
+    }
+    serverTransport.stop();
+    clientTransport.stop();
+    return histogram;
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("loopback echo latency: polling vs co_await recv");
+    measureEchoLatency(RecvMode::Polling, 100).print("polling recvAsync + 10ms timer");
+    measureEchoLatency(RecvMode::Awaitable, 5'000).print("co_await KcpSession::recv");
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_endpoint_update.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief KcpEndpoint::update 基准：10k 会话、每个 tick 1% 活跃
+ *
+ * 对比两种驱动方式的单 tick 耗时：
+ *  - 全量扫描：逐个会话 ikcp_update + 活跃时间查找（时间轮之前的做法）
+ *  - 时间轮：只处理到期的会话，静默会话挂起到空闲超时
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include <asio.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t SESSION_COUNT = 10'000;
+constexpr uint32_t ACTIVE_PER_TICK = SESSION_COUNT / 100;
+constexpr uint32_t TICK_MS = 10;
+constexpr int TICKS = 500;
+
+// 记录发出的数据报，计时结束后再回送给对端
+class CaptureTransport : public IUdpTransport
+{
+public:
+    void send(const NetAddress& address, std::span<const uint8_t> data) override
+    {
+        datagrams.push_back({address, std::vector<uint8_t>(data.begin(), data.end())});
+    }
+
+    struct Datagram
+    {
+        NetAddress to;
+        std::vector<uint8_t> data;
+    };
+    std::vector<Datagram> datagrams;
+};
+
+class BenchEndpoint : public KcpEndpoint
+{
+public:
+    BenchEndpoint(IUdpTransport& transport, asio::io_context& ioc) : KcpEndpoint(transport), m_ioc(ioc) {}
+
+    // 时间轮之前的驱动方式：每个 tick 更新全部会话并查一次活跃时间
+    void updateFullScan(uint32_t nowMs)
+    {
+        m_transport.beginBatch();
+        for (auto& entry : m_sessions)
+        {
+            entry.session->update(nowMs);
+            bench::doNotOptimize(m_lastActive[entry.conv]);
+        }
+        m_transport.flush();
+    }
+
+    [[nodiscard]] size_t sessionCount() const { return m_sessions.size(); }
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        m_lastActive[conv] = 0;
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+private:
+    asio::io_context& m_ioc;
+    std::unordered_map<uint32_t, uint32_t> m_lastActive;
+};
+
+double runScenario(bool fullScan)
+{
+    asio::io_context ioc;
+    CaptureTransport serverWire;
+    CaptureTransport clientWire;
+    BenchEndpoint endpoint(serverWire, ioc);
+    const NetAddress address("127.0.0.1", 9000);
+
+    std::vector<std::unique_ptr<KcpSession>> peers;
+    peers.reserve(SESSION_COUNT);
+    for (uint32_t conv = 1; conv <= SESSION_COUNT; ++conv)
+    {
+        peers.push_back(std::make_unique<KcpSession>(conv, clientWire, address, ioc.get_executor()));
+    }
+
+    const std::vector<uint8_t> message(64, 0x42);
+    auto deliver = [](CaptureTransport& from, auto&& sink)
+    {
+        for (auto& datagram : from.datagrams)
+        {
+            sink(datagram);
+        }
+        from.datagrams.clear();
+    };
+
+    uint32_t now = 1'000;
+    // 预热：所有会话各发一条消息并完成握手
+    for (auto& peer : peers)
+    {
+        peer->send(message);
+        peer->update(now);
+    }
+    deliver(clientWire, [&](auto& datagram) { endpoint.input(datagram.to, datagram.data); });
+    endpoint.update(now);
+    deliver(serverWire, [&](auto& datagram) { peers[peekConv(datagram.data) - 1]->input(datagram.data); });
+
+    double updateSeconds = 0.0;
+    uint32_t cursor = 0;
+    for (int tick = 0; tick < TICKS; ++tick)
+    {
+        now += TICK_MS;
+
+        // 1% 的会话在本 tick 收到数据
+        for (uint32_t i = 0; i < ACTIVE_PER_TICK; ++i)
+        {
+            auto& peer = peers[cursor];
+            cursor = (cursor + 1) % SESSION_COUNT;
+            peer->send(message);
+            peer->update(now);
+        }
+        deliver(clientWire, [&](auto& datagram) { endpoint.input(datagram.to, datagram.data); });
+
+        const auto begin = bench::Clock::now();
+        if (fullScan)
+        {
+            endpoint.updateFullScan(now);
+        }
+        else
+        {
+            endpoint.update(now);
+        }
+        updateSeconds += bench::secondsBetween(begin, bench::Clock::now());
+
+        deliver(serverWire, [&](auto& datagram) { peers[peekConv(datagram.data) - 1]->input(datagram.data); });
+    }
+
+    if (endpoint.sessionCount() != SESSION_COUNT)
+    {
+        std::printf("unexpected session count %zu\n", endpoint.sessionCount());
+    }
+    return updateSeconds / TICKS;
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("KcpEndpoint::update, 10k sessions, 1% active");
+    const double scan = runScenario(true);
+    const double wheel = runScenario(false);
+    std::printf("%-12s %10.1f us/tick\n", "full scan", scan * 1e6);
+    std::printf("%-12s %10.1f us/tick\n", "timer wheel", wheel * 1e6);
+    std::printf("speedup      %10.1fx\n", wheel > 0.0 ? scan / wheel : 0.0);
+    return 0;
+}
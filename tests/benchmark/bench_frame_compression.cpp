@@ -0,0 +1,197 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_frame_compression.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 帧压缩基准：线上字节数与编解码 CPU 开销的取舍
+ *
+ * 消息流：
+ *  - settlement：逐帧发送的 SettlementResponse（约 70 字节，描述文本随卡牌与结果变化）
+ *  - create-room：逐帧发送的 CreateRoomResponse（6 字节，低于阈值，衡量压缩路径的额外开销）
+ *  - room-list：500 条 CreateRoomResponse 记录拼成的一个大载荷（房间列表快照）
+ * 每种消息流分别以 plain / lz / lz+dict 三种方式编码，输出线上字节、压缩率与每帧编解码耗时。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/protocol/FrameCodec.h"
+#include "src/shared/messages/MessageDictionary.h"
+#include "src/shared/messages/response/CreateRoomResponse.h"
+#include "src/shared/messages/response/SettlementResponse.h"
+#include <array>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr size_t ROUNDS = 20;
+constexpr uint32_t ROOM_LIST_SIZE = 500;
+
+struct Stream
+{
+    const char* name;
+    uint16_t cmd;
+    std::vector<std::vector<uint8_t>> payloads;
+};
+
+struct Mode
+{
+    const char* name;
+    std::optional<FrameCompression> compression;
+};
+
+Stream makeSettlementStream(size_t count)
+{
+    static constexpr std::array<const char*, 5> CARDS{"杀", "闪", "桃", "火攻", "决斗"};
+    std::mt19937 rng(2026);
+    Stream stream{"settlement", SettlementResponse::CMD_ID, {}};
+    for (size_t i = 0; i < count; ++i)
+    {
+        SettlementResponse resp;
+        resp.player = 1 + (rng() % 8);
+        resp.target = 1 + (rng() % 8);
+        resp.card = 1 + (rng() % 120);
+        resp.success = rng() % 10 != 0;
+        const char* card = CARDS[rng() % CARDS.size()];
+        resp.message = resp.success ? "结算成功：玩家" + std::to_string(resp.player) + "对玩家" +
+                                          std::to_string(resp.target) + "使用了【" + card + "】，造成1点伤害"
+                                    : std::string("结算失败：【") + card + "】已被抵消";
+        stream.payloads.push_back(resp.serialize());
+    }
+    return stream;
+}
+
+Stream makeCreateRoomStream(size_t count)
+{
+    Stream stream{"create-room", CreateRoomResponse::CMD_ID, {}};
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto resp = i % 16 == 0 ? CreateRoomResponse::createFailed(3)
+                                       : CreateRoomResponse::createSuccess(static_cast<uint32_t>(1'000 + i));
+        stream.payloads.push_back(resp.serialize());
+    }
+    return stream;
+}
+
+Stream makeRoomListStream(size_t count)
+{
+    Stream stream{"room-list", CommandID::ROOM_LIST, {}};
+    for (size_t i = 0; i < count; ++i)
+    {
+        shared::PacketWriter writer;
+        for (uint32_t room = 0; room < ROOM_LIST_SIZE; ++room)
+        {
+            CreateRoomResponse::createSuccess(static_cast<uint32_t>((i * ROOM_LIST_SIZE) + room + 1)).writeTo(writer);
+        }
+        stream.payloads.push_back(std::move(writer.buffer));
+    }
+    return stream;
+}
+
+void runStream(const Stream& stream, const Mode& mode)
+{
+    size_t plainBytes = 0;
+    size_t capacity = 0;
+    for (const auto& payload : stream.payloads)
+    {
+        plainBytes += FRAME_HEADER_SIZE + payload.size();
+        capacity = std::max(capacity, FRAME_HEADER_SIZE + payload.size());
+    }
+
+    // 编码：每帧写入同一块缓冲，记录编码结果供解码阶段使用
+    std::vector<uint8_t> buffer(capacity);
+    std::vector<std::vector<uint8_t>> frames;
+    frames.reserve(stream.payloads.size());
+    size_t wireBytes = 0;
+    size_t compressedFrames = 0;
+    const auto encodeBegin = bench::Clock::now();
+    for (size_t round = 0; round < ROUNDS; ++round)
+    {
+        for (const auto& payload : stream.payloads)
+        {
+            auto frame = mode.compression ? encodeFrame(buffer, stream.cmd, payload, *mode.compression)
+                                          : encodeFrame(buffer, stream.cmd, payload);
+            bench::doNotOptimize(frame);
+            if (round == 0)
+            {
+                wireBytes += frame->size();
+                compressedFrames += reinterpret_cast<const FrameHeader*>(frame->data())->compressed() ? 1 : 0;
+                frames.emplace_back(frame->begin(), frame->end());
+            }
+        }
+    }
+    const double encodeSeconds = bench::secondsBetween(encodeBegin, bench::Clock::now());
+
+    const FrameDictionary* dictionary = mode.compression ? mode.compression->dictionary : nullptr;
+    std::vector<uint8_t> scratch;
+    size_t decodedBytes = 0;
+    const auto decodeBegin = bench::Clock::now();
+    for (size_t round = 0; round < ROUNDS; ++round)
+    {
+        for (const auto& frame : frames)
+        {
+            auto decoded = decodeFrame(frame, scratch, dictionary);
+            decodedBytes += decoded->payload.size();
+            bench::doNotOptimize(decoded);
+        }
+    }
+    const double decodeSeconds = bench::secondsBetween(decodeBegin, bench::Clock::now());
+
+    const double operations = static_cast<double>(ROUNDS * stream.payloads.size());
+    std::printf("%-12s %-8s %8zu %10zu %10zu %7.3f %10.1f %10.1f %s\n",
+                stream.name,
+                mode.name,
+                stream.payloads.size(),
+                plainBytes,
+                wireBytes,
+                static_cast<double>(wireBytes) / static_cast<double>(plainBytes),
+                encodeSeconds * 1e9 / operations,
+                decodeSeconds * 1e9 / operations,
+                compressedFrames == stream.payloads.size() ? "all"
+                : compressedFrames == 0                    ? "none"
+                                                           : "some");
+    bench::doNotOptimize(decodedBytes);
+}
+} // namespace
+
+int main()
+{
+    const std::array<Stream, 3> streams{
+        makeSettlementStream(10'000),
+        makeCreateRoomStream(10'000),
+        makeRoomListStream(50),
+    };
+    const std::array<Mode, 3> modes{{
+        {"plain", std::nullopt},
+        {"lz", FrameCompression{}},
+        {"lz+dict", FrameCompression{.dictionary = &messageDictionary()}},
+    }};
+
+    bench::printTitle("Frame compression: bytes on wire vs CPU (threshold 64 B)");
+    std::printf("%-12s %-8s %8s %10s %10s %7s %10s %10s %s\n",
+                "stream",
+                "mode",
+                "frames",
+                "plain(B)",
+                "wire(B)",
+                "ratio",
+                "enc(ns)",
+                "dec(ns)",
+                "compressed");
+    for (const auto& stream : streams)
+    {
+        for (const auto& mode : modes)
+        {
+            runStream(stream, mode);
+        }
+    }
+    return 0;
+}
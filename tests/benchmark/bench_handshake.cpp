@@ -0,0 +1,150 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_handshake.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 握手与垃圾包丢弃基准：服务端处理每个未握手数据报的耗时
+ *
+ *  - random conv：随机 conv 的数据报（洪泛攻击），直接丢弃
+ *  - forged CONNECT：携带伪造 cookie 的 CONNECT，需要计算一次 SipHash
+ *  - HELLO：合法的 HELLO，计算 cookie 并回复 CHALLENGE
+ *  - auto-accept：对照组，未知 conv 直接建立会话（握手之前的做法）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/App/Server.h"
+#include "src/net/protocol/HandshakePacket.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr size_t PACKET_COUNT = 1'000'000;
+constexpr size_t AUTO_ACCEPT_COUNT = 20'000; // 对照组每个包都建会话，数量不宜过大
+constexpr size_t JUNK_SIZE = 24;             // 与一个 KCP 段头等长
+
+// 只计数、不发送
+class NullTransport : public IUdpTransport
+{
+public:
+    void send([[maybe_unused]] const NetAddress& address, [[maybe_unused]] std::span<const uint8_t> data) override
+    {
+        ++sent;
+    }
+
+    size_t sent = 0;
+};
+
+// 握手之前的行为：任何未知 conv 都建立会话
+class AutoAcceptEndpoint : public KcpEndpoint
+{
+public:
+    AutoAcceptEndpoint(IUdpTransport& transport, asio::io_context& ioc) : KcpEndpoint(transport), m_ioc(ioc) {}
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+private:
+    asio::io_context& m_ioc;
+};
+
+std::vector<std::vector<uint8_t>> randomConvPackets(size_t count)
+{
+    std::mt19937 rng(1);
+    std::vector<std::vector<uint8_t>> packets(count, std::vector<uint8_t>(JUNK_SIZE));
+    for (auto& packet : packets)
+    {
+        for (auto& byte : packet)
+        {
+            byte = static_cast<uint8_t>(rng());
+        }
+        if (std::all_of(packet.begin(), packet.begin() + 4, [](uint8_t b) { return b == 0; }))
+        {
+            packet[0] = 1;
+        }
+    }
+    return packets;
+}
+
+std::vector<std::vector<uint8_t>> handshakePackets(size_t count, HandshakeType type)
+{
+    std::mt19937_64 rng(2);
+    std::vector<std::vector<uint8_t>> packets;
+    packets.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const HandshakePacket packet{.type = type,
+                                     .nonce = static_cast<uint32_t>(rng()),
+                                     .timestamp = 0,
+                                     .cookie = type == HandshakeType::Connect ? rng() : 0};
+        const auto bytes = handshakeBytes(packet);
+        packets.emplace_back(bytes.begin(), bytes.end());
+    }
+    return packets;
+}
+
+void run(const char* name, KcpEndpoint& endpoint, const std::vector<std::vector<uint8_t>>& packets,
+         const NullTransport& transport)
+{
+    const NetAddress from("10.1.2.3", 40000);
+    const auto begin = bench::Clock::now();
+    for (const auto& packet : packets)
+    {
+        endpoint.input(from, packet);
+    }
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+    const auto metrics = endpoint.metrics();
+    std::printf("%-16s packets=%-8zu %8.1f ns/packet  sessions=%-6zu rejected=%-8llu replies=%zu\n",
+                name,
+                packets.size(),
+                seconds * 1e9 / static_cast<double>(packets.size()),
+                static_cast<size_t>(metrics.activeSessions),
+                static_cast<unsigned long long>(metrics.packetsRejected),
+                transport.sent);
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("Unknown-conv datagrams on the server receive path");
+
+    {
+        NullTransport transport;
+        Server server(transport, 1);
+        run("random conv", server, randomConvPackets(PACKET_COUNT), transport);
+    }
+    {
+        NullTransport transport;
+        Server server(transport, 1);
+        run("forged CONNECT", server, handshakePackets(PACKET_COUNT, HandshakeType::Connect), transport);
+    }
+    {
+        NullTransport transport;
+        Server server(transport, 1);
+        run("HELLO", server, handshakePackets(PACKET_COUNT, HandshakeType::Hello), transport);
+    }
+    {
+        asio::io_context ioc;
+        NullTransport transport;
+        AutoAcceptEndpoint endpoint(transport, ioc);
+        run("auto-accept", endpoint, randomConvPackets(AUTO_ACCEPT_COUNT), transport);
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_intern.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 驻留标识基准：卡牌与技能以 32 位标识识别，对比以 std::string 牌名、技能名识别
+ *
+ * - card match：160 张牌中统计某种牌的张数，逐张比较牌名字符串 / 比较 CardId
+ * - card table：按牌取卡牌定义，以字符串为键的哈希表 / 以 CardId 为键的哈希表
+ * - skill resolve：按技能取实现，修改前的 flat_hash_map<std::string, poly<ISkill>> / SkillSystem::findSkill
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/server/components/Card.h"
+#include "src/server/components/Skill.h"
+#include "src/server/systems/SkillSystem.h"
+#include "absl/container/flat_hash_map.h"
+#include <asio/system_executor.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr size_t DECK_SIZE = 160;
+constexpr int ITERATIONS = 1'000'000;
+
+constexpr std::array<const char*, 6> CARD_NAMES{"杀", "闪", "桃", "酒", "火攻", "决斗"};
+constexpr std::array<const char*, 36> SKILL_NAMES{
+    "制衡", "奸雄", "护驾", "仁德", "激将", "武圣", "咆哮", "观星", "空城", "龙胆", "马术", "铁骑",
+    "集智", "奇才", "反馈", "鬼才", "刚烈", "突袭", "裸衣", "天妒", "遗计", "倾国", "洛神", "苦肉",
+    "英姿", "反间", "国色", "流离", "谦逊", "结姻", "枭姬", "青囊", "急救", "无双", "离间", "闭月",
+};
+
+// 修改前 MetaCardInfo 以字符串保存牌名
+struct LegacyCardName
+{
+    std::string name;
+};
+
+struct CardDefinition
+{
+    uint8_t maxTargets = 1;
+    uint8_t range = 1;
+};
+
+struct NoopSkill
+{
+    void onUse() const {}
+    absl::flat_hash_map<entt::entity, bool> filterTargets(entt::entity) const { return {}; }
+};
+
+template <typename Body>
+double measure(Body&& body)
+{
+    size_t sink = 0;
+    const auto begin = bench::Clock::now();
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        sink += body(static_cast<size_t>(i));
+    }
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+    bench::doNotOptimize(sink);
+    return seconds * 1e9 / ITERATIONS;
+}
+
+void report(const char* name, double stringNs, double internedNs)
+{
+    std::printf("%-16s string %8.1f ns  interned %8.1f ns  (%.2fx)\n",
+                name,
+                stringNs,
+                internedNs,
+                stringNs / internedNs);
+}
+
+void runCards()
+{
+    entt::registry registry;
+    std::vector<CardId> ids;
+    for (const char* name : CARD_NAMES)
+    {
+        ids.push_back(utils::intern<CardId>(name));
+    }
+
+    std::mt19937 rng(2026);
+    std::uniform_int_distribution<size_t> pick(0, CARD_NAMES.size() - 1);
+    for (size_t i = 0; i < DECK_SIZE; ++i)
+    {
+        const size_t kind = pick(rng);
+        const auto card = registry.create();
+        registry.emplace<LegacyCardName>(card, LegacyCardName{CARD_NAMES[kind]});
+        registry.emplace<MetaCardInfo>(card, MetaCardInfo{.id = ids[kind]});
+    }
+
+    // 调用方手里的牌名：修改前是 std::string，修改后是 CardId
+    std::vector<std::string> names(CARD_NAMES.begin(), CARD_NAMES.end());
+
+    report("card match",
+           measure(
+               [&](size_t i)
+               {
+                   const auto& name = names[i % names.size()];
+                   size_t count = 0;
+                   for (auto [card, legacy] : registry.view<LegacyCardName>().each())
+                   {
+                       count += legacy.name == name ? 1 : 0;
+                   }
+                   return count;
+               }),
+           measure(
+               [&](size_t i)
+               {
+                   const auto id = ids[i % ids.size()];
+                   size_t count = 0;
+                   for (auto [card, meta] : registry.view<MetaCardInfo>().each())
+                   {
+                       count += meta.id == id ? 1 : 0;
+                   }
+                   return count;
+               }));
+
+    absl::flat_hash_map<std::string, CardDefinition> byName;
+    absl::flat_hash_map<CardId, CardDefinition> byId;
+    for (size_t i = 0; i < CARD_NAMES.size(); ++i)
+    {
+        byName.emplace(CARD_NAMES[i], CardDefinition{});
+        byId.emplace(ids[i], CardDefinition{});
+    }
+    report("card table",
+           measure([&](size_t i) { return size_t{byName.find(names[i % names.size()])->second.range}; }),
+           measure([&](size_t i) { return size_t{byId.find(ids[i % ids.size()])->second.range}; }));
+}
+
+void runSkills()
+{
+    GameContext context(asio::system_executor(),
+                        std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::null_sink_mt>()));
+    SkillSystem skills(context);
+    absl::flat_hash_map<std::string, entt::poly<ISkill>> legacy;
+    std::vector<std::string> names;
+    std::vector<SkillId> ids;
+    for (const char* name : SKILL_NAMES)
+    {
+        names.emplace_back(name);
+        ids.push_back(utils::intern<SkillId>(name));
+        legacy.emplace(name, NoopSkill{});
+        skills.addSkill(ids.back(), NoopSkill{});
+    }
+
+    report("skill resolve",
+           measure([&](size_t i) { return size_t{legacy.find(names[i % names.size()]) != legacy.end()}; }),
+           measure([&](size_t i) { return size_t{skills.findSkill(ids[i % ids.size()]) != nullptr}; }));
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("Interned ids: 160-card match, card table and skill resolution");
+    runCards();
+    runSkills();
+    std::printf("interned texts: %zu, e.g. %.*s\n",
+                utils::InternTable::getInstance().size(),
+                static_cast<int>(utils::text(cards::STRIKE).size()),
+                utils::text(cards::STRIKE).data());
+    return 0;
+}
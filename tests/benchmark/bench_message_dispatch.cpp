@@ -0,0 +1,171 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_message_dispatch.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 消息分发基准：MessageDispatcher（哈希表 + 虚调用）对比 StaticMessageDispatcher（编译期跳转表）
+ *
+ * 5 种消息（分布在 4 个命令段）随机排成 4096 条的流，逐条分发。两种处理器：
+ *  - noop：只读取消息、返回空结果，差别全部来自查找、虚调用与消息的 expected 包装
+ *  - echo：把消息重新编码作为响应。MessageDispatcher 只能返回 std::vector（每条消息一次堆分配），
+ *    StaticMessageDispatcher 的写入模式直接编码到调用方复用的 writer 中
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/StaticMessageDispatcher.h"
+#include "src/shared/messages/request/CreateRoomRequest.h"
+#include "src/shared/messages/request/SendMessageRequest.h"
+#include "src/shared/messages/response/SettlementResponse.h"
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr size_t STREAM_LENGTH = 4'096;
+constexpr int ROUNDS = 500;
+
+using BenchMessages = MessageList<CreateRoomRequest,
+                                  SendMessageRequest,
+                                  CreateRoomResponse,
+                                  SendMessageToChatResponse,
+                                  SettlementResponse>;
+
+struct Frame
+{
+    uint16_t cmd;
+    std::vector<uint8_t> payload;
+};
+
+std::vector<Frame> makeStream()
+{
+    CreateRoomRequest create;
+    create.roomName = "friday-night";
+    SendMessageRequest chat;
+    chat.content = "good game, well played";
+    SendMessageToChatResponse chatResponse;
+    chatResponse.chatMessage = "[room] good game, well played";
+    SettlementResponse settlement{};
+    settlement.message = "Strike deals 6 damage";
+
+    const std::vector<Frame> kinds = {
+        {CreateRoomRequest::CMD_ID, create.serialize()},
+        {SendMessageRequest::CMD_ID, chat.serialize()},
+        {CreateRoomResponse::CMD_ID, CreateRoomResponse::createSuccess(42).serialize()},
+        {SendMessageToChatResponse::CMD_ID, chatResponse.serialize()},
+        {SettlementResponse::CMD_ID, settlement.serialize()},
+    };
+
+    std::mt19937 rng(2026);
+    std::uniform_int_distribution<size_t> pick(0, kinds.size() - 1);
+    std::vector<Frame> stream;
+    stream.reserve(STREAM_LENGTH);
+    for (size_t i = 0; i < STREAM_LENGTH; ++i)
+    {
+        stream.push_back(kinds[pick(rng)]);
+    }
+    return stream;
+}
+
+using VectorResult = std::expected<std::vector<uint8_t>, MessageError>;
+
+// 同一组处理器分别注册到两种分发器
+struct NoopHandlers
+{
+    template <typename Message>
+    VectorResult operator()(const Message& message) const
+    {
+        bench::doNotOptimize(message);
+        return std::vector<uint8_t>{};
+    }
+};
+
+struct EchoHandlers
+{
+    template <typename Message>
+    VectorResult operator()(const Message& message) const
+    {
+        return message.serialize();
+    }
+
+    template <typename Message>
+    std::expected<std::span<const uint8_t>, MessageError> operator()(const Message& message,
+                                                                      shared::PacketWriter& out) const
+    {
+        return encodeMessage(message, out);
+    }
+};
+
+template <typename Handlers, typename... Messages>
+void registerAll(MessageDispatcher& dispatcher, MessageList<Messages...>)
+{
+    (dispatcher.registerHandler<Messages>(Handlers{}), ...);
+}
+
+template <typename Dispatch>
+double measure(const std::vector<Frame>& stream, Dispatch&& dispatch)
+{
+    size_t bytes = 0;
+    const auto begin = bench::Clock::now();
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        for (const auto& frame : stream)
+        {
+            bytes += dispatch(frame);
+        }
+    }
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+    bench::doNotOptimize(bytes);
+    return seconds * 1e9 / (static_cast<double>(ROUNDS) * stream.size());
+}
+
+template <typename Handlers>
+void runValueMode(const char* name, const std::vector<Frame>& stream)
+{
+    MessageDispatcher dynamic;
+    registerAll<Handlers>(dynamic, BenchMessages{});
+    StaticMessageDispatcher<BenchMessages, Handlers> table;
+
+    const double dynamicNs = measure(stream,
+                                     [&dynamic](const Frame& frame)
+                                     {
+                                         auto result = dynamic.dispatch(frame.cmd, frame.payload);
+                                         return result ? result->size() : 0;
+                                     });
+    const double tableNs = measure(stream,
+                                   [&table](const Frame& frame)
+                                   {
+                                       auto result = table.dispatch(frame.cmd, frame.payload);
+                                       return result ? result->size() : 0;
+                                   });
+    std::printf("%-6s %-28s %8.1f ns\n", name, "MessageDispatcher", dynamicNs);
+    std::printf("%-6s %-28s %8.1f ns  (%.2fx)\n", name, "StaticMessageDispatcher", tableNs, dynamicNs / tableNs);
+}
+} // namespace
+
+int main()
+{
+    const auto stream = makeStream();
+
+    bench::printTitle("Message dispatch, 5 message types over 4 command ranges, per message");
+    runValueMode<NoopHandlers>("noop", stream);
+    runValueMode<EchoHandlers>("echo", stream);
+
+    StaticMessageDispatcher<BenchMessages, EchoHandlers> table;
+    shared::PacketWriter writer;
+    const double writerNs = measure(stream,
+                                    [&table, &writer](const Frame& frame)
+                                    {
+                                        auto result = table.dispatch(frame.cmd, frame.payload, writer);
+                                        return result ? result->size() : 0;
+                                    });
+    std::printf("%-6s %-28s %8.1f ns\n", "echo", "Static + caller writer", writerNs);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_message_schema.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 字段表生成的编码基准：精确长度一次分配对比默认 128 字节预留，增量编码对比完整编码
+ *
+ * - serialize：小消息（CreateRoomRequest）与超过 128 字节的消息（UseCardResponse，48 个目标），
+ *   默认预留在后者上要多次扩容
+ * - delta：同一条 UseCardResponse 连续同步，每次只有 card 变化，比较每条消息的字节数与耗时
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/shared/messages/request/CreateRoomRequest.h"
+#include "src/shared/messages/response/UseCardResponse.h"
+#include <numeric>
+#include <vector>
+
+namespace
+{
+constexpr int ITERATIONS = 1'000'000;
+
+// 修改前的 serialize：默认预留 128 字节，按需扩容
+template <typename Message>
+std::vector<uint8_t> serializeDefaultReserve(const Message& message)
+{
+    shared::PacketWriter writer;
+    message.writeTo(writer);
+    return std::move(writer.buffer);
+}
+
+template <typename Encode>
+double measure(Encode&& encode)
+{
+    size_t bytes = 0;
+    const auto begin = bench::Clock::now();
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        bytes += encode(i);
+    }
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+    bench::doNotOptimize(bytes);
+    return seconds * 1e9 / ITERATIONS;
+}
+
+template <typename Message>
+void runSerialize(const char* name, const Message& message)
+{
+    const double defaultNs = measure([&message](int) { return serializeDefaultReserve(message).size(); });
+    const double exactNs = measure([&message](int) { return message.serialize().size(); });
+    std::printf("%-16s %4zu B  default reserve %7.1f ns  exact size %7.1f ns  (%.2fx)\n",
+                name,
+                message.serializedSize(),
+                defaultNs,
+                exactNs,
+                defaultNs / exactNs);
+}
+
+void runDelta()
+{
+    UseCardResponse previous;
+    previous.player = 3;
+    previous.targets.resize(48);
+    std::iota(previous.targets.begin(), previous.targets.end(), 100U);
+    previous.success = true;
+    previous.message = "Volley hits every enemy";
+
+    shared::PacketWriter writer;
+    size_t fullBytes = 0;
+    const double fullNs = measure(
+        [&](int i)
+        {
+            UseCardResponse current = previous;
+            current.card = static_cast<uint32_t>(i);
+            writer.clear();
+            current.writeTo(writer);
+            fullBytes = writer.buffer.size();
+            return fullBytes;
+        });
+
+    size_t deltaBytes = 0;
+    UseCardResponse receiver = previous;
+    const double deltaNs = measure(
+        [&](int i)
+        {
+            UseCardResponse current = previous;
+            current.card = static_cast<uint32_t>(i);
+            writer.clear();
+            current.writeDeltaTo(previous, writer);
+            deltaBytes = writer.buffer.size();
+            static_cast<void>(receiver.applyDelta(writer.buffer));
+            return deltaBytes;
+        });
+    std::printf("%-16s full %4zu B %7.1f ns  delta %4zu B %7.1f ns (encode + apply)\n",
+                "UseCardResponse",
+                fullBytes,
+                fullNs,
+                deltaBytes,
+                deltaNs);
+}
+} // namespace
+
+int main()
+{
+    CreateRoomRequest create;
+    create.roomName = "friday-night";
+    UseCardResponse volley;
+    volley.targets.resize(48);
+    volley.message = "Volley hits every enemy";
+
+    bench::printTitle("Schema serialize, per message");
+    runSerialize("CreateRoomReq", create);
+    runSerialize("UseCardResponse", volley);
+
+    bench::printTitle("Schema delta, one changed field per update");
+    runDelta();
+    return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_room_broadcast.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间广播扇出基准：1000 个房间 × 8 名玩家，每轮每个房间广播一个事件
+ *
+ * 对比三种发给全房间的方式（同一份约 120 字节的 JSON 事件）：
+ *  - send：逐个玩家编码一帧再 KcpSession::send（以往唯一的发送原语）
+ *  - queueFrame：逐个玩家 queueFrame（每人编码 / 压缩一次）
+ *  - broadcast：RoomBroadcaster 编码一次，各会话只持有 SharedFrame 引用
+ * 分别统计调用方的扇出耗时与随后一次 KcpEndpoint::update 的耗时，
+ * 以及是否开启帧压缩两种配置。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/App/RoomBroadcaster.h"
+#include <asio.hpp>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t ROOM_COUNT = 1'000;
+constexpr uint32_t PLAYERS_PER_ROOM = 8;
+constexpr int ROUNDS = 30; // 每轮 1 ms：不超过发送窗口（32 段），总时长小于初始 RTO，不会积压或重传
+constexpr uint16_t CMD_CARD_PLAYED = 0x2101;
+constexpr std::string_view EVENT =
+    R"({"event":"cardPlayed","player":3,"card":{"id":"Strike","cost":1,"damage":6},"target":{"id":7,"hp":42},"turn":12})";
+
+enum class Mode
+{
+    Send,
+    QueueFrame,
+    Broadcast
+};
+
+// 只计数、不发送
+class NullTransport : public IUdpTransport
+{
+public:
+    void send([[maybe_unused]] const NetAddress& address, [[maybe_unused]] std::span<const uint8_t> data) override
+    {
+        ++datagrams;
+    }
+
+    size_t datagrams = 0;
+};
+
+class RoomEndpoint : public KcpEndpoint
+{
+public:
+    RoomEndpoint(IUdpTransport& transport, asio::io_context& ioc) : KcpEndpoint(transport), m_ioc(ioc) {}
+
+    std::shared_ptr<KcpSession> open(uint32_t conv, const NetAddress& peer) { return openSession(conv, peer); }
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+private:
+    asio::io_context& m_ioc;
+};
+
+struct Result
+{
+    double fanoutNs = 0.0; // 每个房间事件的调用方耗时
+    double updateUs = 0.0; // 每轮 update 耗时
+    size_t datagrams = 0;
+};
+
+Result run(Mode mode, const std::optional<FrameCompression>& compression)
+{
+    asio::io_context ioc;
+    NullTransport transport;
+    RoomEndpoint endpoint(transport, ioc);
+    RoomBroadcaster broadcaster;
+    broadcaster.setFrameCompression(compression);
+
+    std::vector<std::vector<std::shared_ptr<KcpSession>>> rooms(ROOM_COUNT);
+    uint32_t conv = 1;
+    for (uint32_t room = 0; room < ROOM_COUNT; ++room)
+    {
+        for (uint32_t player = 0; player < PLAYERS_PER_ROOM; ++player, ++conv)
+        {
+            const NetAddress peer("10.0.0.1", static_cast<uint16_t>(10'000 + conv));
+            auto session = endpoint.open(conv, peer);
+            session->setFrameCompression(compression);
+            broadcaster.join(room, session);
+            rooms[room].push_back(std::move(session));
+        }
+    }
+
+    uint32_t now = 1'000;
+    endpoint.update(now);
+    transport.datagrams = 0;
+
+    const std::span<const uint8_t> payload(reinterpret_cast<const uint8_t*>(EVENT.data()), EVENT.size());
+    std::vector<uint8_t> frame(FRAME_HEADER_SIZE + EVENT.size());
+    double fanoutSeconds = 0.0;
+    double updateSeconds = 0.0;
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        const auto begin = bench::Clock::now();
+        for (uint32_t room = 0; room < ROOM_COUNT; ++room)
+        {
+            switch (mode)
+            {
+            case Mode::Send:
+                for (const auto& session : rooms[room])
+                {
+                    auto encoded = compression ? encodeFrame(frame, CMD_CARD_PLAYED, payload, *compression)
+                                               : encodeFrame(frame, CMD_CARD_PLAYED, payload);
+                    session->send(*encoded);
+                }
+                break;
+            case Mode::QueueFrame:
+                for (const auto& session : rooms[room])
+                {
+                    bench::doNotOptimize(session->queueFrame(CMD_CARD_PLAYED, payload));
+                }
+                break;
+            case Mode::Broadcast:
+                bench::doNotOptimize(broadcaster.broadcast(room, CMD_CARD_PLAYED, payload));
+                break;
+            }
+        }
+        const auto middle = bench::Clock::now();
+        endpoint.update(++now);
+        const auto end = bench::Clock::now();
+        fanoutSeconds += bench::secondsBetween(begin, middle);
+        updateSeconds += bench::secondsBetween(middle, end);
+    }
+
+    return Result{.fanoutNs = fanoutSeconds * 1e9 / (ROUNDS * ROOM_COUNT),
+                  .updateUs = updateSeconds * 1e6 / ROUNDS,
+                  .datagrams = transport.datagrams};
+}
+
+void report(const char* name, Mode mode, const std::optional<FrameCompression>& compression)
+{
+    const Result result = run(mode, compression);
+    const double perDeliveryNs =
+        (result.fanoutNs * ROOM_COUNT + result.updateUs * 1e3) / (ROOM_COUNT * PLAYERS_PER_ROOM);
+    std::printf("%-12s fan-out %8.1f ns/room  update %8.1f us/round  total %6.1f ns/delivery  datagrams=%zu\n",
+                name,
+                result.fanoutNs,
+                result.updateUs,
+                perDeliveryNs,
+                result.datagrams);
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("Room fan-out, 1000 rooms x 8 players, uncompressed");
+    report("send", Mode::Send, std::nullopt);
+    report("queueFrame", Mode::QueueFrame, std::nullopt);
+    report("broadcast", Mode::Broadcast, std::nullopt);
+
+    bench::printTitle("Room fan-out, 1000 rooms x 8 players, compressed");
+    report("send", Mode::Send, FrameCompression{});
+    report("queueFrame", Mode::QueueFrame, FrameCompression{});
+    report("broadcast", Mode::Broadcast, FrameCompression{});
+    return 0;
+}
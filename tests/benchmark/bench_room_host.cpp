@@ -0,0 +1,150 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_room_host.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间宿主基准：1000 个房间共享线程池，合成的出牌负载，测每核可承载的房间数
+ *
+ * 每个房间 8 名玩家（实体 + Health 组件），一个伤害系统挂在房间的 dispatcher 上。
+ * 一次"动作"在房间的 strand 上执行：触发一次伤害事件、遍历房间内的玩家统计存活数，然后投递本房间的下一个动作，
+ * 所以任意时刻每个房间有一个动作在排队，与真实牌局中每桌串行处理玩家操作一致。
+ * 以 1、2、4……直到全部核数的工作线程分别运行，换算成每秒动作数与每核房间数（按每桌每秒 10 个动作计）。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/server/context/RoomHost.h"
+#include <spdlog/sinks/null_sink.h>
+#include <latch>
+#include <vector>
+
+namespace
+{
+constexpr size_t ROOMS = 1'000;
+constexpr int PLAYERS = 8;
+constexpr int ACTIONS_PER_ROOM = 500;
+constexpr double ACTIONS_PER_ROOM_PER_SECOND = 10.0; // 一桌牌局的目标负载
+
+struct Health
+{
+    int value = 4;
+};
+
+struct DamageEvent
+{
+    entt::entity target;
+    int amount;
+};
+
+// 房间内的伤害系统：由 registry.ctx() 持有，随房间销毁
+class DamageSystem
+{
+public:
+    explicit DamageSystem(GameContext& context) : m_context(&context)
+    {
+        m_context->dispatcher.sink<DamageEvent>().connect<&DamageSystem::onDamage>(this);
+    }
+
+private:
+    void onDamage(const DamageEvent& event)
+    {
+        auto& health = m_context->registry.get<Health>(event.target);
+        health.value -= event.amount;
+        if (health.value <= 0)
+        {
+            health.value = 4; // 复活，保持负载稳定
+        }
+    }
+
+    GameContext* m_context;
+};
+
+struct RoomState
+{
+    std::vector<entt::entity> players;
+    int remaining = ACTIONS_PER_ROOM;
+    uint64_t alive = 0;
+};
+
+void action(RoomHost& host, RoomHost::RoomId id, GameContext& ctx, std::latch& done)
+{
+    auto& state = ctx.registry.ctx().get<RoomState>();
+    const auto target = state.players[static_cast<size_t>(state.remaining) % state.players.size()];
+    ctx.dispatcher.trigger(DamageEvent{target, 1});
+    for (auto [entity, health] : ctx.registry.view<Health>().each())
+    {
+        state.alive += health.value > 0 ? 1 : 0;
+    }
+
+    if (--state.remaining > 0)
+    {
+        host.post(id, [&host, id, &done](GameContext& next) { action(host, id, next, done); });
+    }
+    else
+    {
+        done.count_down();
+    }
+}
+
+void run(size_t threads)
+{
+    auto logger = std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::null_sink_mt>());
+    RoomHost host(threads, logger);
+    std::latch ready(ROOMS);
+    std::vector<RoomHost::RoomId> rooms;
+    rooms.reserve(ROOMS);
+    for (size_t i = 0; i < ROOMS; ++i)
+    {
+        rooms.push_back(host.createRoom(
+            [&ready](GameContext& ctx)
+            {
+                ctx.registry.ctx().emplace<DamageSystem>(ctx);
+                auto& state = ctx.registry.ctx().emplace<RoomState>();
+                for (int p = 0; p < PLAYERS; ++p)
+                {
+                    const auto player = ctx.registry.create();
+                    ctx.registry.emplace<Health>(player);
+                    state.players.push_back(player);
+                }
+                ready.count_down();
+            }));
+    }
+    ready.wait();
+
+    std::latch done(ROOMS);
+    const auto begin = bench::Clock::now();
+    for (auto id : rooms)
+    {
+        host.post(id, [&host, id, &done](GameContext& ctx) { action(host, id, ctx, done); });
+    }
+    done.wait();
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+
+    const double actionsPerSecond = static_cast<double>(ROOMS) * ACTIONS_PER_ROOM / seconds;
+    const double roomsPerCore = actionsPerSecond / static_cast<double>(threads) / ACTIONS_PER_ROOM_PER_SECOND;
+    std::printf("%2zu threads  %7.2f M actions/s  %6.0f ns/action/thread  %8.0f rooms/core\n",
+                threads,
+                actionsPerSecond / 1e6,
+                1e9 * static_cast<double>(threads) / actionsPerSecond,
+                roomsPerCore);
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("RoomHost, 1000 rooms x 8 players, one queued action per room");
+    std::printf("threads: shared pool = worker count; one thread_pool per GameContext would be %zu\n",
+                ROOMS * 2 * RoomHost::defaultThreadCount());
+    const size_t cores = RoomHost::defaultThreadCount();
+    for (size_t threads = 1; threads < cores; threads *= 2)
+    {
+        run(threads);
+    }
+    run(cores);
+    return 0;
+}
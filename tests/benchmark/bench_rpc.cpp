@@ -0,0 +1,175 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_rpc.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief RPC 吞吐基准：单个会话上保持 1 ~ 4096 个在途调用，完成至多 16384 次 CreateRoom 调用
+ *
+ * 全程运行在 SimulatedNetwork 的虚拟时钟上（1 ms 一个 tick，单向 30 ms），服务端处理器是协程。
+ * 每个 worker 协程循环 co_await call，worker 数即在途调用数（每个 worker 至多 1024 次调用）。输出：
+ *  - vtime / calls/vs：全部完成所用的虚拟时间与按虚拟时间计的吞吐（一次只有一个在途调用时每次要等一个 RTT）
+ *  - cpu(us)：两端协程、编解码与 KCP 的实际耗时（墙钟时间 / 调用数）
+ *  - peak：观察到的最大在途调用数
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/Client.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/transport/SimulatedUdpTransport.h"
+#include "src/shared/messages/request/CreateRoomRequest.h"
+#include "src/shared/rpc/RpcClient.h"
+#include "src/shared/rpc/RpcServer.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+constexpr uint32_t MAX_CALLS = 16'384;
+constexpr uint32_t CALLS_PER_WORKER = 1'024;
+constexpr uint32_t MAX_VIRTUAL_MS = 600'000;
+
+// 服务端：每个会话一个接收协程，RPC 请求交给 RpcServer，响应经 queueSharedFrame 发回
+class RpcEndpoint : public KcpEndpoint
+{
+public:
+    RpcEndpoint(IUdpTransport& transport, asio::io_context& ioc)
+        : KcpEndpoint(transport), rpc(ioc.get_executor()), m_ioc(ioc)
+    {
+        rpc.registerHandler<CreateRoomRequest>(
+            [this](const CreateRoomRequest& req) -> asio::awaitable<CreateRoomResponse>
+            { co_return CreateRoomResponse::createSuccess(++m_nextRoomId + req.maxPlayers); });
+    }
+
+    ~RpcEndpoint() override { closeAllSessions(); }
+
+    RpcServer rpc;
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+    void onSession(uint32_t, std::shared_ptr<KcpSession> session) override
+    {
+        asio::co_spawn(
+            m_ioc,
+            [this, session]() -> asio::awaitable<void>
+            {
+                const auto reply = replyTo(session);
+                while (auto packet = co_await session->recv())
+                {
+                    for (const auto& [cmd, payload] : decodeFrames(*packet))
+                    {
+                        rpc.onFrame(cmd, payload, reply);
+                    }
+                }
+            },
+            asio::detached);
+    }
+
+private:
+    asio::io_context& m_ioc;
+    uint32_t m_nextRoomId = 0;
+};
+
+void runScenario(uint32_t depth)
+{
+    asio::io_context ioc;
+    SimulatedNetwork network(LinkConditions{.latencyMs = 30}, 2026);
+    auto serverWire = network.createTransport();
+    RpcEndpoint server(*serverWire, ioc);
+    serverWire->setRecvHandler([&server](std::span<const UdpDatagram> batch) { server.input(batch); });
+
+    auto clientWire = network.createTransport();
+    Client client(*clientWire, ioc.get_executor());
+    clientWire->setRecvHandler([&client](std::span<const UdpDatagram> batch) { client.input(batch); });
+    auto session = client.connect(1, serverWire->localAddress());
+    RpcClient rpc(session);
+
+    asio::co_spawn(
+        ioc,
+        [session, &rpc]() -> asio::awaitable<void>
+        {
+            while (auto packet = co_await session->recv())
+            {
+                for (const auto& [cmd, payload] : decodeFrames(*packet))
+                {
+                    rpc.onFrame(cmd, payload);
+                }
+            }
+        },
+        asio::detached);
+
+    const uint32_t total = std::min(MAX_CALLS, depth * CALLS_PER_WORKER);
+    uint32_t issued = 0;
+    uint32_t completed = 0;
+    uint32_t failed = 0;
+    for (uint32_t worker = 0; worker < depth; ++worker)
+    {
+        asio::co_spawn(
+            ioc,
+            [&]() -> asio::awaitable<void>
+            {
+                CreateRoomRequest request;
+                request.roomName = "bench-room";
+                while (issued < total)
+                {
+                    ++issued;
+                    auto response = co_await rpc.call(request);
+                    failed += response.has_value() ? 0 : 1;
+                    ++completed;
+                }
+            },
+            asio::detached);
+    }
+
+    size_t peak = 0;
+    uint32_t nowMs = 0;
+    const auto begin = bench::Clock::now();
+    for (; completed < total && nowMs < MAX_VIRTUAL_MS; ++nowMs)
+    {
+        network.advanceTo(uint64_t{nowMs} * 1'000);
+        ioc.poll();
+        peak = std::max(peak, rpc.pendingCalls());
+        client.update(nowMs);
+        server.update(nowMs);
+        ioc.poll();
+    }
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+
+    std::printf("%6u %6u %9u %12.0f %10.2f %7zu %6u\n",
+                depth,
+                total,
+                nowMs,
+                nowMs == 0 ? 0.0 : completed * 1e3 / nowMs,
+                seconds * 1e6 / std::max(completed, 1U),
+                peak,
+                failed + (total - completed));
+
+    session->close();
+    ioc.poll();
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("RPC throughput, 1 session, 30 ms one-way, async handler");
+    std::printf(
+        "%6s %6s %9s %12s %10s %7s %6s\n", "depth", "calls", "vtime(ms)", "calls/vs", "cpu(us)", "peak", "failed");
+    for (uint32_t depth : {1U, 16U, 256U, 1'024U, 4'096U})
+    {
+        runScenario(depth);
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_session_table.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief KcpEndpoint::input 会话分发基准：1k / 10k / 100k 会话
+ *
+ * 对比每个数据报的查表开销（不含 KCP 协议处理）：
+ *  - 双哈希表：sessions.try_emplace + schedules[conv]（SessionTable 之前的做法）
+ *  - SessionTable：一次探测取得会话指针与调度状态
+ * 数据报按随机顺序落到各会话上，模拟大量会话交错收包时的缓存行为。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/SessionTable.h"
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+constexpr size_t PACKETS = 4'000'000;
+
+struct SessionSchedule
+{
+    uint32_t lastActiveMs = 0;
+    TimerWheel<uint32_t>::Handle timer = TimerWheel<uint32_t>::INVALID_HANDLE;
+    bool woken = false;
+};
+
+std::vector<uint32_t> makeConvs(size_t sessions)
+{
+    std::mt19937 rng(static_cast<uint32_t>(sessions));
+    std::vector<uint32_t> convs(sessions);
+    for (auto& conv : convs)
+    {
+        conv = rng();
+    }
+    return convs;
+}
+
+std::vector<uint32_t> makeTraffic(const std::vector<uint32_t>& convs)
+{
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> pick(0, convs.size() - 1);
+    std::vector<uint32_t> traffic(PACKETS);
+    for (auto& conv : traffic)
+    {
+        conv = convs[pick(rng)];
+    }
+    return traffic;
+}
+
+double runTwoMaps(const std::vector<uint32_t>& convs, const std::vector<uint32_t>& traffic)
+{
+    std::unordered_map<uint32_t, std::shared_ptr<KcpSession>> sessions;
+    std::unordered_map<uint32_t, SessionSchedule> schedules;
+    for (uint32_t conv : convs)
+    {
+        sessions.try_emplace(conv);
+        schedules.try_emplace(conv);
+    }
+
+    uint32_t now = 0;
+    const auto begin = bench::Clock::now();
+    for (uint32_t conv : traffic)
+    {
+        auto [iter, inserted] = sessions.try_emplace(conv);
+        bench::doNotOptimize(iter->second);
+        auto& schedule = schedules[conv];
+        schedule.lastActiveMs = ++now;
+        schedule.woken = true;
+    }
+    return bench::secondsBetween(begin, bench::Clock::now());
+}
+
+double runSessionTable(const std::vector<uint32_t>& convs, const std::vector<uint32_t>& traffic)
+{
+    SessionTable table;
+    for (uint32_t conv : convs)
+    {
+        table.tryEmplace(conv);
+    }
+
+    uint32_t now = 0;
+    const auto begin = bench::Clock::now();
+    for (uint32_t conv : traffic)
+    {
+        auto [entry, inserted] = table.tryEmplace(conv);
+        bench::doNotOptimize(entry->session);
+        entry->lastActiveMs = ++now;
+        entry->woken = true;
+    }
+    return bench::secondsBetween(begin, bench::Clock::now());
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("KcpEndpoint::input session dispatch");
+    std::printf("%-10s %14s %14s %9s\n", "sessions", "two maps", "SessionTable", "speedup");
+    for (size_t sessions : {1'000, 10'000, 100'000})
+    {
+        const auto convs = makeConvs(sessions);
+        const auto traffic = makeTraffic(convs);
+        const double maps = runTwoMaps(convs, traffic);
+        const double table = runSessionTable(convs, traffic);
+        std::printf("%-10zu %11.1f ns %11.1f ns %8.1fx\n",
+                    sessions,
+                    maps * 1e9 / PACKETS,
+                    table * 1e9 / PACKETS,
+                    table > 0.0 ? maps / table : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_sharded_server.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief ShardedServer 回环压测：多客户端线程回显，观察吞吐随分片数的扩展
+ *
+ * 每个客户端线程拥有独立的 io_context / socket / Client，握手建立若干会话，
+ * 每个会话保持固定数量的消息在途，收到回显后立即补发。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/Client.h"
+#include "src/net/App/ShardedServer.h"
+#include "src/net/transport/AsioUdpTransport.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr size_t CLIENT_THREADS = 4;
+constexpr uint32_t SESSIONS_PER_CLIENT = 256;
+constexpr int IN_FLIGHT_PER_SESSION = 8;
+constexpr size_t MESSAGE_SIZE = 64;
+constexpr auto WARMUP = std::chrono::milliseconds(500);
+constexpr auto MEASURE = std::chrono::seconds(2);
+constexpr auto TICK = std::chrono::milliseconds(1);
+
+uint32_t nowMs()
+{
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(bench::Clock::now().time_since_epoch()).count());
+}
+
+void serverEcho(const std::shared_ptr<KcpSession>& session)
+{
+    session->recvAsync(
+        [session](std::expected<KcpSession::Packet, std::error_code> result)
+        {
+            if (!result)
+            {
+                return;
+            }
+            session->send(*result);
+            serverEcho(session);
+        });
+}
+
+void clientLoop(const std::shared_ptr<KcpSession>& session, std::atomic<uint64_t>& echoes)
+{
+    session->recvAsync(
+        [session, &echoes](std::expected<KcpSession::Packet, std::error_code> result)
+        {
+            if (!result)
+            {
+                return;
+            }
+            echoes.fetch_add(1, std::memory_order_relaxed);
+            session->send(*result);
+            clientLoop(session, echoes);
+        });
+}
+
+void runClient(uint16_t port, std::atomic<uint64_t>& echoes, std::atomic<bool>& running)
+{
+    asio::io_context ioc(1);
+    AsioUdpTransport transport(ioc.get_executor(), 0);
+    Client client(transport, ioc.get_executor());
+    transport.startBatchRecvLoop([&](std::span<const UdpDatagram> batch) { client.input(batch); });
+
+    const NetAddress server("127.0.0.1", port);
+    const std::vector<uint8_t> message(MESSAGE_SIZE, 0x5A);
+    for (uint32_t i = 0; i < SESSIONS_PER_CLIENT; ++i)
+    {
+        // conv 由服务器在握手中分配，握手在预热阶段内完成
+        client.handshake(server,
+                         [&message, &echoes](std::expected<std::shared_ptr<KcpSession>, std::error_code> result)
+                         {
+                             if (!result)
+                             {
+                                 return;
+                             }
+                             for (int k = 0; k < IN_FLIGHT_PER_SESSION; ++k)
+                             {
+                                 (*result)->send(message);
+                             }
+                             clientLoop(*result, echoes);
+                         });
+    }
+
+    asio::steady_timer ticker(ioc);
+    std::function<void()> arm = [&]
+    {
+        ticker.expires_after(TICK);
+        ticker.async_wait(
+            [&](const asio::error_code& ec)
+            {
+                if (ec || !running.load(std::memory_order_relaxed))
+                {
+                    // 会话上挂起的接收协程会一直占住 io_context，直接停止
+                    transport.stop();
+                    ioc.stop();
+                    return;
+                }
+                client.update(nowMs());
+                arm();
+            });
+    };
+    arm();
+    ioc.run();
+}
+
+double runScenario(size_t shards)
+{
+    ShardedServer::Options options;
+    options.shardCount = shards;
+    options.tickInterval = TICK;
+    ShardedServer server(options, [](uint32_t, const std::shared_ptr<KcpSession>& session) { serverEcho(session); });
+    server.start();
+
+    std::atomic<uint64_t> echoes{0};
+    std::atomic<bool> running{true};
+    std::vector<std::thread> clients;
+    for (size_t i = 0; i < CLIENT_THREADS; ++i)
+    {
+        clients.emplace_back([&] { runClient(server.localPort(), echoes, running); });
+    }
+
+    std::this_thread::sleep_for(WARMUP);
+    const uint64_t startCount = echoes.load();
+    const auto begin = bench::Clock::now();
+    std::this_thread::sleep_for(MEASURE);
+    const uint64_t endCount = echoes.load();
+    const double seconds = bench::secondsBetween(begin, bench::Clock::now());
+
+    running.store(false);
+    for (auto& thread : clients)
+    {
+        thread.join();
+    }
+    server.stop();
+
+    std::printf("shards=%-3zu steering=%-3s forwarded=%-9llu %10.0f echoes/s\n",
+                shards,
+                server.kernelSteering() ? "yes" : "no",
+                static_cast<unsigned long long>(server.forwardedPackets()),
+                static_cast<double>(endCount - startCount) / seconds);
+    return static_cast<double>(endCount - startCount) / seconds;
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("ShardedServer loopback echo");
+    const size_t maxShards = std::max<size_t>(std::thread::hardware_concurrency() / 2, 1);
+    double baseline = 0.0;
+    for (size_t shards = 1; shards <= maxShards; shards *= 2)
+    {
+        const double rate = runScenario(shards);
+        if (shards == 1)
+        {
+            baseline = rate;
+        }
+        else if (baseline > 0.0)
+        {
+            std::printf("           scaling vs 1 shard: %.2fx\n", rate / baseline);
+        }
+    }
+    return 0;
+}
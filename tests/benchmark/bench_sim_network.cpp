@@ -0,0 +1,244 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_sim_network.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 模拟网络上的 KCP 负载测试：2000 个 Client 以 20 Hz 向同一服务端发送消息
+ *
+ * 全程运行在 SimulatedNetwork 的虚拟时钟上（1 ms 一个 tick），结果与机器负载无关、可复现。
+ * 每种链路条件 × KCP 参数预设输出：
+ *  - goodput：服务端业务层收到的载荷速率
+ *  - p50 / p99 / p999：消息从 send 到服务端业务协程取出的单向延迟
+ *  - retransmit：重传段数 / 发送消息数
+ *  - serviced：所有端点每秒在 update 中处理的会话数（CPU 开销的近似）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/App/Client.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/transport/SimulatedUdpTransport.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t CLIENT_COUNT = 2'000;
+constexpr uint32_t SEND_INTERVAL_MS = 50; // 20 Hz
+constexpr uint32_t SEND_DURATION_MS = 5'000;
+constexpr uint32_t DRAIN_MS = 2'000;
+constexpr size_t MESSAGE_SIZE = 64;
+
+struct Scenario
+{
+    const char* name;
+    LinkConditions clientLink; // 客户端上行
+    LinkConditions serverLink; // 服务端下行
+    const char* profileName;
+    KcpProfile profile;
+};
+
+// 服务端：会话运行在 io_context 上，业务协程记录每条消息的单向延迟
+class SinkEndpoint : public KcpEndpoint
+{
+public:
+    SinkEndpoint(IUdpTransport& transport, asio::io_context& ioc, const SimulatedNetwork& network)
+        : KcpEndpoint(transport), m_ioc(ioc), m_network(network)
+    {
+    }
+
+    std::vector<uint32_t> latenciesUs;
+    uint64_t payloadBytes = 0;
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+    void onSession(uint32_t, std::shared_ptr<KcpSession> session) override
+    {
+        asio::co_spawn(
+            m_ioc,
+            [this, session]() -> asio::awaitable<void>
+            {
+                while (auto packet = co_await session->recv())
+                {
+                    uint64_t sentUs = 0;
+                    std::memcpy(&sentUs, packet->data(), sizeof(sentUs));
+                    latenciesUs.push_back(static_cast<uint32_t>(m_network.nowUs() - sentUs));
+                    payloadBytes += packet->size();
+                }
+            },
+            asio::detached);
+    }
+
+private:
+    asio::io_context& m_ioc;
+    const SimulatedNetwork& m_network;
+};
+
+struct Peer
+{
+    std::unique_ptr<SimulatedUdpTransport> wire;
+    std::unique_ptr<Client> client;
+    std::shared_ptr<KcpSession> session;
+};
+
+void runScenario(const Scenario& scenario)
+{
+    asio::io_context ioc;
+    auto work = asio::make_work_guard(ioc); // 首批会话建立之前 poll 也不会让 io_context 停止
+    SimulatedNetwork network(scenario.clientLink, 2026);
+    auto serverWire = network.createTransport();
+    serverWire->setConditions(scenario.serverLink);
+    SinkEndpoint server(*serverWire, ioc, network);
+    server.setSessionProfile(scenario.profile);
+    serverWire->setRecvHandler([&server](std::span<const UdpDatagram> batch) { server.input(batch); });
+    server.latenciesUs.reserve(size_t{CLIENT_COUNT} * (SEND_DURATION_MS / SEND_INTERVAL_MS));
+
+    std::vector<Peer> peers(CLIENT_COUNT);
+    for (uint32_t i = 0; i < CLIENT_COUNT; ++i)
+    {
+        auto& peer = peers[i];
+        peer.wire = network.createTransport();
+        peer.client = std::make_unique<Client>(*peer.wire, ioc.get_executor());
+        peer.client->setSessionProfile(scenario.profile);
+        peer.wire->setRecvHandler([client = peer.client.get()](std::span<const UdpDatagram> batch)
+                                  { client->input(batch); });
+        peer.session = peer.client->connect(i + 1, serverWire->localAddress());
+    }
+
+    uint64_t messagesSent = 0;
+    std::array<uint8_t, MESSAGE_SIZE> message{};
+    const auto begin = bench::Clock::now();
+    for (uint32_t nowMs = 0; nowMs < SEND_DURATION_MS + DRAIN_MS; ++nowMs)
+    {
+        const uint64_t nowUs = uint64_t{nowMs} * 1'000;
+        network.advanceTo(nowUs);
+        for (uint32_t i = 0; i < CLIENT_COUNT; ++i)
+        {
+            auto& peer = peers[i];
+            // 各客户端错开发送时刻
+            if (nowMs < SEND_DURATION_MS && (nowMs + i) % SEND_INTERVAL_MS == 0)
+            {
+                std::memcpy(message.data(), &nowUs, sizeof(nowUs));
+                peer.session->send(message);
+                ++messagesSent;
+            }
+            peer.client->update(nowMs);
+        }
+        server.update(nowMs);
+        ioc.poll();
+    }
+    const double wallSeconds = bench::secondsBetween(begin, bench::Clock::now());
+
+    uint64_t retransmits = 0;
+    uint64_t packetsOut = 0;
+    uint64_t serviced = server.metrics().sessionsServiced;
+    for (const auto& peer : peers)
+    {
+        const auto metrics = peer.session->metrics();
+        retransmits += metrics.retransmits;
+        packetsOut += metrics.packetsOut;
+        serviced += peer.client->metrics().sessionsServiced;
+    }
+    for (const auto& metrics : server.sessionMetrics())
+    {
+        retransmits += metrics.retransmits;
+        packetsOut += metrics.packetsOut;
+    }
+
+    auto& latencies = server.latenciesUs;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentileMs = [&latencies](double p)
+    {
+        if (latencies.empty())
+        {
+            return 0.0;
+        }
+        const auto rank = static_cast<size_t>(p * static_cast<double>(latencies.size()));
+        return latencies[std::min(latencies.size() - 1, rank)] / 1'000.0;
+    };
+
+    const auto stats = network.stats();
+    const uint64_t dropped = stats.lost + stats.queueDropped;
+    const double simSeconds = (SEND_DURATION_MS + DRAIN_MS) / 1'000.0;
+    std::printf("%-8s %-7s %8.1f KB/s %6.3f %8.1f %7.1f %7.1f %9.4f %9.4f %9.0f %7.2fs\n",
+                scenario.name,
+                scenario.profileName,
+                static_cast<double>(server.payloadBytes) / 1'024.0 / (SEND_DURATION_MS / 1'000.0),
+                messagesSent == 0 ? 0.0 : static_cast<double>(latencies.size()) / static_cast<double>(messagesSent),
+                percentileMs(0.50),
+                percentileMs(0.99),
+                percentileMs(0.999),
+                messagesSent == 0 ? 0.0 : static_cast<double>(retransmits) / static_cast<double>(messagesSent),
+                packetsOut == 0 ? 0.0 : static_cast<double>(dropped) / static_cast<double>(packetsOut),
+                static_cast<double>(serviced) / simSeconds,
+                wallSeconds);
+
+    for (auto& peer : peers)
+    {
+        peer.session->close();
+    }
+    ioc.poll();
+}
+} // namespace
+
+int main()
+{
+    constexpr LinkConditions LAN{.latencyMs = 1};
+    constexpr LinkConditions WAN{.latencyMs = 30, .jitterMs = 5, .lossRate = 0.01};
+    constexpr LinkConditions LOSSY{
+        .latencyMs = 50, .jitterMs = 15, .lossRate = 0.05, .reorderRate = 0.02, .reorderDelayMs = 20};
+    // 客户端上行 4 KB/s，发送队列 2 KB：发出一个 88 字节的数据报约需 21 ms
+    constexpr LinkConditions CAPPED{
+        .latencyMs = 30, .jitterMs = 5, .bandwidthBytesPerSec = 4'096, .queueLimitBytes = 2'048};
+
+    constexpr LinkConditions CAPPED_DOWN{.latencyMs = 30, .jitterMs = 5};
+    auto turboAdaptive = KcpProfile::turbo();
+    turboAdaptive.adaptiveInterval = true;
+
+    const std::array<Scenario, 9> scenarios{{
+        {"lan", LAN, LAN, "turbo", KcpProfile::turbo()},
+        {"wan", WAN, WAN, "turbo", KcpProfile::turbo()},
+        {"lossy", LOSSY, LOSSY, "turbo", KcpProfile::turbo()},
+        {"capped", CAPPED, CAPPED_DOWN, "turbo", KcpProfile::turbo()},
+        {"wan", WAN, WAN, "turbo-a", turboAdaptive},
+        {"wan", WAN, WAN, "normal", KcpProfile::normal()},
+        {"lossy", LOSSY, LOSSY, "normal", KcpProfile::normal()},
+        {"wan", WAN, WAN, "bulk", KcpProfile::bulk()},
+        {"lossy", LOSSY, LOSSY, "bulk", KcpProfile::bulk()},
+    }};
+
+    bench::printTitle("KCP over SimulatedNetwork, 2000 clients x 20 Hz x 64 B (turbo = nodelay(1, 10, 2, 1))");
+    std::printf("%-8s %-7s %13s %6s %8s %7s %7s %9s %9s %9s %8s\n",
+                "link",
+                "profile",
+                "goodput",
+                "deliv",
+                "p50(ms)",
+                "p99",
+                "p999",
+                "retx/msg",
+                "drop/pkt",
+                "svc/s",
+                "wall");
+    for (const auto& scenario : scenarios)
+    {
+        runScenario(scenario);
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_udp_recv.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 回环 UDP 接收吞吐基准：逐包 async_receive_from 对比 recvmmsg 批量接收
+ *
+ * 发送线程向回环地址灌入固定数量的小包，接收端单线程运行 io_context，
+ * 统计实际收到的包数与首包到末包的耗时，得到单核每秒处理的包数，
+ * 并统计接收期间接收线程上的堆分配次数（稳态应为 0）。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "BenchUtils.h"
+#include "src/net/transport/AsioUdpTransport.h"
+#include <asio.hpp>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <thread>
+
+namespace
+{
+// 只统计接收线程（运行 io_context 的主线程）在计时窗口内的分配
+thread_local bool g_countAllocations = false;
+std::atomic<size_t> g_allocations{0};
+} // namespace
+
+void* operator new(size_t size)
+{
+    if (g_countAllocations)
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+constexpr size_t PACKET_COUNT = 1'000'000;
+constexpr size_t PAYLOAD_SIZE = 96; // 典型 KCP 小包：24 字节头 + 少量载荷
+constexpr auto IDLE_TIMEOUT = std::chrono::milliseconds(100);
+
+struct RecvResult
+{
+    size_t received = 0;
+    double seconds = 0.0;
+    size_t allocations = 0;
+};
+
+RecvResult runOnce(bool batched, size_t batchSize)
+{
+    asio::io_context ioc;
+    AsioUdpTransport receiver(ioc.get_executor(), 0);
+    const uint16_t port = receiver.localPort();
+
+    size_t received = 0;
+    bench::Clock::time_point first;
+    bench::Clock::time_point last;
+    auto onPackets = [&](size_t count)
+    {
+        if (received == 0)
+        {
+            first = bench::Clock::now();
+            g_allocations.store(0, std::memory_order_relaxed);
+            g_countAllocations = true;
+        }
+        received += count;
+        last = bench::Clock::now();
+    };
+
+    if (batched)
+    {
+        receiver.startBatchRecvLoop([&](std::span<const UdpDatagram> batch) { onPackets(batch.size()); }, batchSize);
+    }
+    else
+    {
+        receiver.startRecvLoop([&](const NetAddress&, std::span<const uint8_t>) { onPackets(1); });
+    }
+
+    std::atomic<bool> senderDone{false};
+    std::thread sender(
+        [&]
+        {
+            asio::io_context senderIoc;
+            asio::ip::udp::socket socket(senderIoc, asio::ip::udp::v4());
+            const asio::ip::udp::endpoint target(asio::ip::address_v4::loopback(), port);
+            std::array<uint8_t, PAYLOAD_SIZE> payload{};
+            asio::error_code ec;
+            for (size_t i = 0; i < PACKET_COUNT; ++i)
+            {
+                socket.send_to(asio::buffer(payload), target, 0, ec);
+            }
+            senderDone.store(true, std::memory_order_release);
+        });
+
+    // 发送结束且一个空闲周期内没有新包到达时停止接收
+    asio::steady_timer watchdog(ioc);
+    size_t lastSeen = SIZE_MAX;
+    std::function<void()> arm = [&]
+    {
+        watchdog.expires_after(IDLE_TIMEOUT);
+        watchdog.async_wait(
+            [&](const asio::error_code& ec)
+            {
+                if (ec)
+                {
+                    return;
+                }
+                if (senderDone.load(std::memory_order_acquire) && received == lastSeen)
+                {
+                    receiver.stop();
+                    return;
+                }
+                lastSeen = received;
+                arm();
+            });
+    };
+    arm();
+
+    ioc.run();
+    g_countAllocations = false;
+    sender.join();
+    return {.received = received,
+            .seconds = bench::secondsBetween(first, last),
+            .allocations = g_allocations.load(std::memory_order_relaxed)};
+}
+
+void report(const char* mode, const RecvResult& result)
+{
+    const double pps = result.seconds > 0.0 ? static_cast<double>(result.received) / result.seconds : 0.0;
+    const double loss = 100.0 * (1.0 - (static_cast<double>(result.received) / PACKET_COUNT));
+    const double allocsPerPacket =
+        result.received > 0 ? static_cast<double>(result.allocations) / static_cast<double>(result.received) : 0.0;
+    std::printf("%-22s received=%9zu  loss=%5.1f%%  %8.3f Mpps/core  allocs/pkt=%.4f\n",
+                mode,
+                result.received,
+                loss,
+                pps / 1e6,
+                allocsPerPacket);
+}
+} // namespace
+
+int main()
+{
+    bench::printTitle("UDP loopback receive");
+    report("async_receive_from", runOnce(false, 1));
+    for (size_t batch : {8, 32, 64})
+    {
+        char label[32];
+        std::snprintf(label, sizeof(label), "recvmmsg batch=%zu", batch);
+        report(label, runOnce(true, batch));
+    }
+    return 0;
+}
@@ -16,6 +16,7 @@
 #include "src/net/transport/IUdpTransport.h"
 #include <vector>
 #include <mutex>
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -27,11 +28,11 @@ class MockUdpTransport : public IUdpTransport
 public:
     struct Packet
     {
-        asio::ip::udp::endpoint to;
+        NetAddress to;
         std::vector<uint8_t> data;
     };
 
-    void send(const asio::ip::udp::endpoint& to, std::span<const uint8_t> data) override
+    void send(const NetAddress& to, std::span<const uint8_t> data) override
     {
         std::lock_guard lock(m_mutex);
         m_packets.push_back({to, std::vector<uint8_t>(data.begin(), data.end())});
@@ -58,7 +59,7 @@ public:
         m_sendCount = 0;
     }
 
-    [[nodiscard]] bool hasPacketTo(const asio::ip::udp::endpoint& ep) const
+    [[nodiscard]] bool hasPacketTo(const NetAddress& ep) const
     {
         std::lock_guard lock(m_mutex);
         return std::ranges::any_of(m_packets, [&](const Packet& p) { return p.to == ep; });
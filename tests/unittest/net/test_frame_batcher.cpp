@@ -0,0 +1,291 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_frame_batcher.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 多帧合并单元测试（FrameRange 遍历、KcpSession::queueFrame 合并发送）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/net/protocol/FrameCodec.h"
+#include "src/net/Session/KcpSession.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int FRAMES_PER_TICK = 20;
+constexpr size_t FRAME_PAYLOAD = 24;
+
+struct WireStats
+{
+    size_t bytes = 0;
+    std::vector<std::vector<uint8_t>> messages; // 接收方收到的 KCP 消息
+};
+
+// 发送方一个 tick 内产生 FRAMES_PER_TICK 帧，统计线上开销与接收方收到的消息
+WireStats runTick(bool batched)
+{
+    asio::io_context ioc;
+    MockUdpTransport senderWire;
+    MockUdpTransport receiverWire;
+    const NetAddress address("127.0.0.1", 9000);
+    auto sender = std::make_shared<KcpSession>(1, senderWire, address, ioc.get_executor());
+    auto receiver = std::make_shared<KcpSession>(1, receiverWire, address, ioc.get_executor());
+
+    WireStats stats;
+    std::vector<uint8_t> frame(FRAME_HEADER_SIZE + FRAME_PAYLOAD);
+    const std::vector<uint8_t> payload(FRAME_PAYLOAD, 0x33);
+    for (int i = 0; i < FRAMES_PER_TICK; ++i)
+    {
+        const auto cmd = static_cast<uint16_t>(0x1200 + i);
+        if (batched)
+        {
+            EXPECT_TRUE(sender->queueFrame(cmd, payload).has_value());
+        }
+        else
+        {
+            sender->send(*encodeFrame(frame, cmd, payload));
+        }
+    }
+    sender->update(1'000);
+
+    for (const auto& packet : senderWire.getPackets())
+    {
+        stats.bytes += packet.data.size();
+        receiver->input(packet.data);
+    }
+
+    // 接收方把所有消息取出来
+    for (int i = 0; i < FRAMES_PER_TICK; ++i)
+    {
+        receiver->recvAsync(
+            [&stats](std::expected<KcpSession::Packet, std::error_code> result)
+            {
+                if (result)
+                {
+                    stats.messages.emplace_back(result->begin(), result->end());
+                }
+            });
+    }
+    ioc.poll();
+    receiver->close(); // 结束多余的接收等待
+    ioc.run();
+    return stats;
+}
+} // namespace
+
+// 测试 1: FrameRange 依次遍历首尾相接的多帧
+TEST(FrameBatcherTest, FrameRangeWalksConcatenatedFrames)
+{
+    std::vector<uint8_t> buffer;
+    for (uint16_t cmd = 1; cmd <= 3; ++cmd)
+    {
+        std::vector<uint8_t> payload(cmd, static_cast<uint8_t>(cmd));
+        std::vector<uint8_t> frame(FRAME_HEADER_SIZE + payload.size());
+        ASSERT_TRUE(encodeFrame(frame, cmd, payload).has_value());
+        buffer.insert(buffer.end(), frame.begin(), frame.end());
+    }
+
+    auto frames = decodeFrames(buffer);
+    uint16_t expected = 1;
+    for (const auto& [cmd, payload] : frames)
+    {
+        EXPECT_EQ(cmd, expected);
+        EXPECT_EQ(payload.size(), expected);
+        EXPECT_TRUE(std::ranges::all_of(payload, [&](uint8_t b) { return b == expected; }));
+        ++expected;
+    }
+    EXPECT_EQ(expected, 4);
+    EXPECT_FALSE(frames.error().has_value());
+}
+
+// 测试 2: 末尾残缺的帧结束遍历并报告错误
+TEST(FrameBatcherTest, FrameRangeStopsOnTruncatedFrame)
+{
+    std::vector<uint8_t> buffer(FRAME_HEADER_SIZE + 4);
+    ASSERT_TRUE(encodeFrame(buffer, 7, std::vector<uint8_t>(4, 1)).has_value());
+    buffer.push_back(0xAA); // 半个帧头
+
+    auto frames = decodeFrames(buffer);
+    size_t count = 0;
+    for ([[maybe_unused]] const auto& frame : frames)
+    {
+        ++count;
+    }
+    EXPECT_EQ(count, 1U);
+    EXPECT_EQ(frames.error(), CodecError::BufferTooSmall);
+}
+
+// 测试 3: 同一 tick 的帧合并为一条 KCP 消息，线上字节数减少
+TEST(FrameBatcherTest, QueuedFramesShareOneKcpMessage)
+{
+    const auto separate = runTick(false);
+    const auto batched = runTick(true);
+
+    ASSERT_EQ(separate.messages.size(), static_cast<size_t>(FRAMES_PER_TICK));
+    ASSERT_EQ(batched.messages.size(), 1U);
+
+    auto frames = decodeFrames(batched.messages.front());
+    uint16_t expected = 0x1200;
+    for (const auto& [cmd, payload] : frames)
+    {
+        EXPECT_EQ(cmd, expected++);
+        EXPECT_EQ(payload.size(), FRAME_PAYLOAD);
+    }
+    EXPECT_EQ(expected, 0x1200 + FRAMES_PER_TICK);
+    EXPECT_FALSE(frames.error().has_value());
+
+    // 每帧省去一个 24 字节的 KCP 段头
+    EXPECT_LE(batched.bytes + ((FRAMES_PER_TICK - 1) * 24), separate.bytes);
+}
+
+// 测试 4: 批量缓冲超过段数上限时提前提交；send 只排入收件箱，提交时先提交已排入的帧以保持顺序
+TEST(FrameBatcherTest, OversizedBatchCommitsEarlyAndSendPreservesOrder)
+{
+    asio::io_context ioc;
+    MockUdpTransport wire;
+    auto session = std::make_shared<KcpSession>(1, wire, NetAddress("127.0.0.1", 9000), ioc.get_executor());
+    int wakeups = 0;
+    session->setWakeCallback([&wakeups] { ++wakeups; });
+
+    const std::vector<uint8_t> payload(1000, 0x11);
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(session->queueFrame(1, payload).has_value());
+    }
+    EXPECT_LT(session->queuedFrameBytes(), 40 * (FRAME_HEADER_SIZE + payload.size()));
+    EXPECT_GT(wakeups, 1);
+    EXPECT_TRUE(session->hasPendingOutput());
+
+    const size_t queued = session->queuedFrameBytes();
+    session->send(payload);
+    EXPECT_EQ(session->queuedFrameBytes(), queued); // 调用线程不触碰批量缓冲
+    session->commitFrames();
+    EXPECT_EQ(session->queuedFrameBytes(), 0U);
+
+    std::vector<uint8_t> tooLarge(MAX_FRAME_PAYLOAD + 1);
+    EXPECT_EQ(session->queueFrame(2, tooLarge).error(), CodecError::PayloadTooLarge);
+    EXPECT_EQ(session->queuedFrameBytes(), 0U);
+}
+
+// 测试 5: 设置帧压缩后，达到阈值的帧压缩后排入，批量缓冲只占压缩后的字节
+TEST(FrameBatcherTest, QueueFrameCompressesLargeFrames)
+{
+    asio::io_context ioc;
+    MockUdpTransport wire;
+    auto session = std::make_shared<KcpSession>(1, wire, NetAddress("127.0.0.1", 9000), ioc.get_executor());
+    session->setFrameCompression(FrameCompression{.threshold = 64});
+
+    const std::vector<uint8_t> large(1000, 0x11);
+    const std::vector<uint8_t> small(32, 0x22);
+    ASSERT_TRUE(session->queueFrame(1, large).has_value());
+    ASSERT_TRUE(session->queueFrame(2, small).has_value());
+    EXPECT_LT(session->queuedFrameBytes(), (2 * FRAME_HEADER_SIZE) + small.size() + 100);
+
+    session->setFrameCompression(std::nullopt);
+    ASSERT_TRUE(session->queueFrame(3, large).has_value());
+    EXPECT_GT(session->queuedFrameBytes(), FRAME_HEADER_SIZE + large.size());
+}
+
+// 测试 6: 多个业务线程并发 send，网络线程同时 update：每条消息完整送达，同一线程的消息保持顺序
+TEST(FrameBatcherTest, ConcurrentSendsArriveIntactAndInOrder)
+{
+    constexpr uint8_t THREADS = 4;
+    constexpr uint32_t MESSAGES = 200;
+
+    asio::io_context ioc;
+    MockUdpTransport senderWire;
+    MockUdpTransport receiverWire;
+    const NetAddress address("127.0.0.1", 9000);
+    auto sender = std::make_shared<KcpSession>(1, senderWire, address, ioc.get_executor());
+    auto receiver = std::make_shared<KcpSession>(1, receiverWire, address, ioc.get_executor());
+
+    std::vector<std::vector<uint8_t>> messages;
+    asio::co_spawn(
+        ioc,
+        [&]() -> asio::awaitable<void>
+        {
+            while (auto packet = co_await receiver->recv())
+            {
+                messages.emplace_back(packet->begin(), packet->end());
+            }
+        },
+        asio::detached);
+
+    std::atomic<uint8_t> finished{0};
+    std::vector<std::thread> threads;
+    for (uint8_t t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(
+            [&, t]
+            {
+                for (uint32_t i = 0; i < MESSAGES; ++i)
+                {
+                    // 线程号 + 序号 + 填充，长度随序号变化，拼接或覆盖都会被检出
+                    std::vector<uint8_t> message(8 + (i % 32), t);
+                    std::memcpy(message.data() + 1, &i, sizeof(i));
+                    sender->send(message);
+                }
+                finished.fetch_add(1);
+            });
+    }
+
+    // 网络线程：轮流驱动两端并交换数据报，直到所有消息送达；
+    // 轮数上限只在业务线程全部发完后才开始计，业务线程迟迟未被调度时不会提前退出
+    uint32_t now = 0;
+    const size_t expected = static_cast<size_t>(THREADS) * MESSAGES;
+    for (int round = 0; round < 20'000 && messages.size() < expected;)
+    {
+        if (finished.load() == THREADS)
+        {
+            ++round;
+        }
+        now += 10;
+        sender->update(now);
+        for (const auto& packet : senderWire.getPackets())
+        {
+            receiver->input(packet.data);
+        }
+        senderWire.clearPackets();
+        receiver->update(now);
+        for (const auto& packet : receiverWire.getPackets())
+        {
+            sender->input(packet.data);
+        }
+        receiverWire.clearPackets();
+        ioc.poll();
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(messages.size(), expected);
+    std::array<uint32_t, THREADS> next{};
+    for (const auto& message : messages)
+    {
+        ASSERT_GE(message.size(), 8U);
+        const uint8_t t = message[0];
+        ASSERT_LT(t, THREADS);
+        uint32_t i = 0;
+        std::memcpy(&i, message.data() + 1, sizeof(i));
+        EXPECT_EQ(i, next[t]++);
+        EXPECT_EQ(message.size(), 8 + (i % 32));
+        EXPECT_TRUE(std::all_of(message.begin() + 5, message.end(), [t](uint8_t b) { return b == t; }));
+    }
+    receiver->close();
+    ioc.run();
+}
@@ -196,3 +196,35 @@ TEST_F(FrameCodecTest, MaxPayloadSize)
     ASSERT_TRUE(decodeResult.has_value());
     EXPECT_EQ(decodeResult->payload.size(), maxSize);
 }
+
+// 测试 11: 预留帧头后就地写入载荷，回填帧头即可解码
+TEST_F(FrameCodecTest, PatchHeaderInPlace)
+{
+    std::vector<uint8_t> frame(FRAME_HEADER_SIZE);
+    const std::array<uint8_t, 5> payload = {9, 8, 7, 6, 5};
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    const uint8_t* storage = frame.data();
+
+    auto patched = patchFrameHeader(frame, 0x4321);
+    ASSERT_TRUE(patched.has_value());
+    EXPECT_EQ(patched->data(), storage);
+    EXPECT_EQ(patched->size(), frame.size());
+
+    auto decodeResult = decodeFrame(*patched);
+    ASSERT_TRUE(decodeResult.has_value());
+    EXPECT_EQ(decodeResult->cmd, 0x4321);
+    EXPECT_TRUE(std::ranges::equal(decodeResult->payload, payload));
+}
+
+// 测试 12: 载荷超过 uint16_t 或缺少帧头空间时报错
+TEST_F(FrameCodecTest, PatchHeaderRejectsInvalidFrames)
+{
+    std::array<uint8_t, FRAME_HEADER_SIZE - 1> tooShort{};
+    EXPECT_EQ(patchFrameHeader(tooShort, 1).error(), CodecError::BufferTooSmall);
+
+    m_buffer.resize(FRAME_HEADER_SIZE + MAX_FRAME_PAYLOAD + 1);
+    EXPECT_EQ(patchFrameHeader(m_buffer, 1).error(), CodecError::PayloadTooLarge);
+
+    std::vector<uint8_t> oversized(MAX_FRAME_PAYLOAD + 1);
+    EXPECT_EQ(encodeFrame(m_buffer, 1, oversized).error(), CodecError::PayloadTooLarge);
+}
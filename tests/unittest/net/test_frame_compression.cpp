@@ -0,0 +1,213 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_frame_compression.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 帧压缩单元测试（往返、预置字典、阈值与无收益回退、批量遍历、损坏数据）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/net/protocol/FrameCodec.h"
+#include "src/shared/messages/MessageDictionary.h"
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/response/SettlementResponse.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<uint8_t> bytesOf(std::string_view text)
+{
+    return {text.begin(), text.end()};
+}
+
+// 重复度较高的载荷：房间列表式的记录
+std::vector<uint8_t> makeRoomList(uint32_t rooms)
+{
+    std::vector<uint8_t> payload;
+    for (uint32_t roomId = 1; roomId <= rooms; ++roomId)
+    {
+        const std::string record = "room=" + std::to_string(roomId) + ";players=4/8;mode=standard;";
+        payload.insert(payload.end(), record.begin(), record.end());
+    }
+    return payload;
+}
+
+SettlementResponse makeSettlement(uint32_t player, uint32_t target)
+{
+    SettlementResponse resp;
+    resp.player = player;
+    resp.card = 1;
+    resp.target = target;
+    resp.success = true;
+    resp.message = "结算成功：玩家" + std::to_string(player) + "对玩家" + std::to_string(target) +
+                   "使用了【杀】，造成1点伤害";
+    return resp;
+}
+} // namespace
+
+// 测试 1: 大载荷压缩后往返一致，帧头为压缩魔数且 length 为线上长度
+TEST(FrameCompressionTest, RoundTripsLargePayload)
+{
+    const auto payload = makeRoomList(200);
+    std::vector<uint8_t> buffer(FRAME_HEADER_SIZE + payload.size());
+
+    auto encoded = encodeFrame(buffer, 0x2103, payload, FrameCompression{});
+    ASSERT_TRUE(encoded.has_value());
+    EXPECT_LT(encoded->size(), (FRAME_HEADER_SIZE + payload.size()) / 3);
+
+    const auto* header = reinterpret_cast<const FrameHeader*>(encoded->data());
+    EXPECT_EQ(header->magic, FRAME_MAGIC_COMPRESSED);
+    EXPECT_TRUE(header->compressed());
+    EXPECT_EQ(header->length, encoded->size() - FRAME_HEADER_SIZE);
+
+    std::vector<uint8_t> scratch;
+    auto decoded = decodeFrame(*encoded, scratch);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->cmd, 0x2103);
+    EXPECT_TRUE(std::ranges::equal(decoded->payload, payload));
+
+    // 不带解压缓冲的 decodeFrame 明确拒绝压缩帧
+    EXPECT_EQ(decodeFrame(*encoded).error(), CodecError::CompressedPayload);
+}
+
+// 测试 2: 低于阈值或压缩无收益时按原样编码
+TEST(FrameCompressionTest, FallsBackToPlainFrame)
+{
+    std::vector<uint8_t> buffer(4'096);
+    const auto small = bytesOf("aaaaaaaaaaaaaaaaaaaaaaaa");
+    auto encoded = encodeFrame(buffer, 1, small, FrameCompression{.threshold = 64});
+    ASSERT_TRUE(encoded.has_value());
+    EXPECT_EQ(encoded->size(), FRAME_HEADER_SIZE + small.size());
+    EXPECT_FALSE(reinterpret_cast<const FrameHeader*>(encoded->data())->compressed());
+
+    std::mt19937 rng(7);
+    std::vector<uint8_t> noise(1'024);
+    std::ranges::generate(noise, [&rng] { return static_cast<uint8_t>(rng()); });
+    encoded = encodeFrame(buffer, 2, noise, FrameCompression{});
+    ASSERT_TRUE(encoded.has_value());
+    EXPECT_EQ(encoded->size(), FRAME_HEADER_SIZE + noise.size());
+    EXPECT_FALSE(reinterpret_cast<const FrameHeader*>(encoded->data())->compressed());
+
+    auto decoded = decodeFrame(*encoded);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(std::ranges::equal(decoded->payload, noise));
+}
+
+// 测试 3: 预置字典让几十字节的结算消息也能缩小，且解码必须提供同一字典
+TEST(FrameCompressionTest, DictionaryShrinksSmallMessages)
+{
+    const auto payload = makeSettlement(3, 5).serialize();
+    ASSERT_LT(payload.size(), 100U);
+    std::vector<uint8_t> plainBuffer(FRAME_HEADER_SIZE + payload.size());
+    std::vector<uint8_t> dictBuffer(FRAME_HEADER_SIZE + payload.size());
+
+    const FrameCompression withoutDictionary{.threshold = 16};
+    const FrameCompression withDictionary{.threshold = 16, .dictionary = &messageDictionary()};
+    auto plain = encodeFrame(plainBuffer, SettlementResponse::CMD_ID, payload, withoutDictionary);
+    auto packed = encodeFrame(dictBuffer, SettlementResponse::CMD_ID, payload, withDictionary);
+    ASSERT_TRUE(plain.has_value());
+    ASSERT_TRUE(packed.has_value());
+    EXPECT_EQ(plain->size(), FRAME_HEADER_SIZE + payload.size()); // 没有字典时无可匹配
+    EXPECT_LT(packed->size(), FRAME_HEADER_SIZE + (payload.size() / 2));
+
+    std::vector<uint8_t> scratch;
+    auto decoded = decodeFrame(*packed, scratch, &messageDictionary());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(std::ranges::equal(decoded->payload, payload));
+    EXPECT_EQ(decodeFrame(*packed, scratch).error(), CodecError::CorruptPayload);
+}
+
+// 测试 4: decodeFrames 遍历压缩帧与普通帧混合的批量消息
+TEST(FrameCompressionTest, FrameRangeHandlesMixedBatch)
+{
+    const auto large = makeRoomList(50);
+    const auto small = bytesOf("ping");
+    const FrameCompression compression{.dictionary = &messageDictionary()};
+
+    std::vector<uint8_t> batch(3 * (FRAME_HEADER_SIZE + large.size()));
+    size_t used = 0;
+    for (const auto& [cmd, payload] : {std::pair{1, large}, std::pair{2, small}, std::pair{3, large}})
+    {
+        auto encoded = encodeFrame(std::span(batch).subspan(used), static_cast<uint16_t>(cmd), payload, compression);
+        ASSERT_TRUE(encoded.has_value());
+        used += encoded->size();
+    }
+    batch.resize(used);
+
+    std::vector<std::pair<uint16_t, size_t>> seen;
+    auto frames = decodeFrames(batch, &messageDictionary());
+    for (auto [cmd, payload] : frames)
+    {
+        EXPECT_TRUE(std::ranges::equal(payload, cmd == 2 ? small : large));
+        seen.emplace_back(cmd, payload.size());
+    }
+    EXPECT_FALSE(frames.error().has_value());
+    EXPECT_EQ(seen, (std::vector<std::pair<uint16_t, size_t>>{{1, large.size()}, {2, 4}, {3, large.size()}}));
+}
+
+// 测试 5: 损坏的压缩载荷被拒绝，不越界读写
+TEST(FrameCompressionTest, RejectsCorruptPayload)
+{
+    const auto payload = makeRoomList(20);
+    std::vector<uint8_t> buffer(FRAME_HEADER_SIZE + payload.size());
+    auto encoded = encodeFrame(buffer, 1, payload, FrameCompression{});
+    ASSERT_TRUE(encoded.has_value());
+    std::vector<uint8_t> frame(encoded->begin(), encoded->end());
+
+    std::vector<uint8_t> scratch;
+    std::mt19937 rng(11);
+    for (int round = 0; round < 500; ++round)
+    {
+        auto corrupt = frame;
+        const size_t pos = FRAME_HEADER_SIZE + (rng() % (corrupt.size() - FRAME_HEADER_SIZE));
+        corrupt[pos] = static_cast<uint8_t>(rng());
+        auto decoded = decodeFrame(corrupt, scratch);
+        if (decoded.has_value())
+        {
+            EXPECT_EQ(decoded->payload.size(), scratch.size());
+        }
+        else
+        {
+            EXPECT_EQ(decoded.error(), CodecError::CorruptPayload);
+        }
+    }
+
+    // 截断：帧头声明的原始长度与实际解出的不符
+    auto* header = reinterpret_cast<FrameHeader*>(frame.data());
+    header->length = static_cast<uint16_t>(header->length - 3);
+    frame.resize(frame.size() - 3);
+    EXPECT_EQ(decodeFrame(frame, scratch).error(), CodecError::CorruptPayload);
+}
+
+// 测试 6: encodeMessage 就地压缩，decodeMessage 解压还原
+TEST(FrameCompressionTest, EncodeMessageCompressesInPlace)
+{
+    const FrameCompression compression{.threshold = 16, .dictionary = &messageDictionary()};
+    shared::PacketWriter writer;
+    auto frame = encodeMessage(makeSettlement(2, 7), writer, compression);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->data(), writer.buffer.data());
+    EXPECT_TRUE(reinterpret_cast<const FrameHeader*>(frame->data())->compressed());
+    EXPECT_LT(frame->size(), FRAME_HEADER_SIZE + makeSettlement(2, 7).serialize().size());
+
+    auto decoded = decodeMessage<SettlementResponse>(*frame, &messageDictionary());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->player, 2U);
+    EXPECT_EQ(decoded->target, 7U);
+    EXPECT_EQ(decoded->message, makeSettlement(2, 7).message);
+
+    // 低于阈值的消息保持原样
+    frame = encodeMessage(makeSettlement(2, 7), writer, FrameCompression{.threshold = 1'000});
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_FALSE(reinterpret_cast<const FrameHeader*>(frame->data())->compressed());
+    EXPECT_TRUE(decodeMessage<SettlementResponse>(*frame).has_value());
+}
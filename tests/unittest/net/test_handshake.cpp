@@ -0,0 +1,273 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_handshake.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 连接握手单元测试（SipHash、cookie 校验、未知 conv 丢弃、服务端分配 conv、重发与超时）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/net/App/Client.h"
+#include "src/net/App/HandshakeCookies.h"
+#include "src/net/App/Server.h"
+#include "src/net/protocol/HandshakePacket.h"
+#include "src/net/transport/SimulatedUdpTransport.h"
+#include <asio.hpp>
+#include <array>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr SipHashKey TEST_KEY{0x0706050403020100ULL, 0x0F0E0D0C0B0A0908ULL};
+
+// 收集服务端发来的握手报文
+struct RawPeer
+{
+    std::unique_ptr<SimulatedUdpTransport> wire;
+    std::vector<HandshakePacket> replies;
+
+    explicit RawPeer(SimulatedNetwork& network) : wire(network.createTransport())
+    {
+        wire->setRecvHandler(
+            [this](std::span<const UdpDatagram> batch)
+            {
+                for (const auto& datagram : batch)
+                {
+                    if (auto packet = parseHandshake(datagram.payload))
+                    {
+                        replies.push_back(*packet);
+                    }
+                }
+            });
+    }
+
+    void send(Server& server, const HandshakePacket& packet)
+    {
+        server.input(wire->localAddress(), handshakeBytes(packet));
+    }
+};
+} // namespace
+
+// 测试 1: SipHash-2-4 与参考实现的测试向量一致
+TEST(HandshakeTest, SipHashMatchesReferenceVectors)
+{
+    std::array<uint8_t, 15> message{};
+    std::iota(message.begin(), message.end(), uint8_t{0});
+    EXPECT_EQ(sipHash24(TEST_KEY, {}), 0x726FDB47DD0E0E31ULL);
+    EXPECT_EQ(sipHash24(TEST_KEY, message), 0xA129CA6149BE45E5ULL);
+}
+
+// 测试 2: cookie 绑定地址、端口、nonce 与时间，过期或来自未来的 cookie 无效
+TEST(HandshakeTest, CookieBindsPeerNonceAndTime)
+{
+    const HandshakeCookies cookies(TEST_KEY, 10);
+    const NetAddress peer("10.0.0.1", 5000);
+    const uint64_t cookie = cookies.issue(peer, 42, 100);
+
+    EXPECT_TRUE(cookies.verify(peer, 42, 100, cookie, 100));
+    EXPECT_TRUE(cookies.verify(peer, 42, 100, cookie, 110));
+    EXPECT_FALSE(cookies.verify(peer, 42, 100, cookie, 111));                     // 过期
+    EXPECT_FALSE(cookies.verify(peer, 42, 100, cookie, 99));                      // 签发时间晚于当前
+    EXPECT_FALSE(cookies.verify(NetAddress("10.0.0.1", 5001), 42, 100, cookie, 100)); // 端口不同
+    EXPECT_FALSE(cookies.verify(NetAddress("10.0.0.2", 5000), 42, 100, cookie, 100)); // 地址不同
+    EXPECT_FALSE(cookies.verify(peer, 43, 100, cookie, 100));
+    EXPECT_FALSE(cookies.verify(peer, 42, 101, cookie, 101));
+    EXPECT_FALSE(cookies.verify(peer, 42, 100, cookie ^ 1, 100));
+
+    // 另一把密钥签发的 cookie 无效；conv 由 cookie 确定且非 0
+    const HandshakeCookies other(SipHashKey{1, 2}, 10);
+    EXPECT_FALSE(other.verify(peer, 42, 100, cookie, 100));
+    EXPECT_EQ(cookies.convFor(cookie), cookies.convFor(cookie));
+    EXPECT_NE(cookies.convFor(cookie), HANDSHAKE_CONV);
+}
+
+// 测试 3: 未握手的 conv 与格式错误的握手报文被丢弃，不分配任何会话、不产生应答
+TEST(HandshakeTest, ServerDropsUnknownConvWithoutState)
+{
+    SimulatedNetwork network;
+    auto serverWire = network.createTransport();
+    Server server(*serverWire, 1);
+    const NetAddress attacker("10.9.9.9", 4000);
+
+    std::mt19937 rng(5);
+    std::array<uint8_t, 24> junk{};
+    for (int i = 0; i < 1'000; ++i)
+    {
+        std::ranges::generate(junk, [&rng] { return static_cast<uint8_t>(rng()); });
+        server.input(attacker, junk);
+    }
+    HandshakePacket challenge{.type = HandshakeType::Challenge};
+    server.input(attacker, handshakeBytes(challenge));
+    server.input(attacker, handshakeBytes(challenge).first(HANDSHAKE_PACKET_SIZE - 1));
+
+    const auto metrics = server.metrics();
+    EXPECT_EQ(metrics.sessionsOpened, 0U);
+    EXPECT_EQ(metrics.activeSessions, 0U);
+    EXPECT_EQ(metrics.packetsRejected, 1'002U);
+    EXPECT_EQ(network.stats().sent, 0U);
+}
+
+// 测试 4: CONNECT 必须携带本服务器为该地址签发的未过期 cookie；重发的 CONNECT 得到同一个 conv
+TEST(HandshakeTest, ConnectRequiresValidCookieAndIsIdempotent)
+{
+    SimulatedNetwork network;
+    auto serverWire = network.createTransport();
+    Server server(*serverWire, 1, HandshakeCookies(TEST_KEY, 5));
+    server.update(1'000);
+    RawPeer client(network);
+    RawPeer attacker(network);
+
+    client.send(server, HandshakePacket{.type = HandshakeType::Hello, .nonce = 7});
+    network.advanceTo(1);
+    ASSERT_EQ(client.replies.size(), 1U);
+    const auto challenge = client.replies.back();
+    EXPECT_EQ(challenge.type, HandshakeType::Challenge);
+    EXPECT_EQ(challenge.nonce, 7U);
+    EXPECT_EQ(server.metrics().activeSessions, 0U); // HELLO 不分配状态
+
+    HandshakePacket connect = challenge;
+    connect.type = HandshakeType::Connect;
+
+    // 伪造 cookie、冒用他人的 cookie 都被拒绝
+    HandshakePacket forged = connect;
+    forged.cookie ^= 1;
+    client.send(server, forged);
+    attacker.send(server, connect);
+    network.advanceTo(2);
+    EXPECT_EQ(client.replies.size(), 1U);
+    EXPECT_TRUE(attacker.replies.empty());
+    EXPECT_EQ(server.metrics().packetsRejected, 2U);
+
+    client.send(server, connect);
+    client.send(server, connect);
+    network.advanceTo(3);
+    ASSERT_EQ(client.replies.size(), 3U);
+    EXPECT_EQ(client.replies[1].type, HandshakeType::Accept);
+    EXPECT_NE(client.replies[1].assignedConv, HANDSHAKE_CONV);
+    EXPECT_EQ(client.replies[1].assignedConv, client.replies[2].assignedConv);
+    EXPECT_EQ(server.metrics().sessionsOpened, 1U);
+
+    // cookie 过期后不再接受
+    server.update(7'000);
+    HandshakePacket late = connect;
+    late.nonce = 8;
+    client.send(server, HandshakePacket{.type = HandshakeType::Hello, .nonce = 8});
+    network.advanceTo(4);
+    ASSERT_EQ(client.replies.size(), 4U);
+    late.timestamp = client.replies.back().timestamp;
+    late.cookie = client.replies.back().cookie;
+    server.update(13'000);
+    client.send(server, late);
+    network.advanceTo(5);
+    EXPECT_EQ(client.replies.size(), 4U);
+    EXPECT_EQ(server.metrics().sessionsOpened, 1U);
+}
+
+// 测试 5: Client 在丢包链路上通过重发完成握手，双方会话使用服务端分配的 conv
+TEST(HandshakeTest, ClientHandshakeOverLossyLink)
+{
+    asio::io_context ioc;
+    SimulatedNetwork network({.latencyMs = 20, .jitterMs = 5, .lossRate = 0.3}, 3);
+    auto serverWire = network.createTransport();
+    auto clientWire = network.createTransport();
+    Server server(*serverWire, 1);
+    Client client(*clientWire, ioc.get_executor());
+    serverWire->setRecvHandler([&server](std::span<const UdpDatagram> batch) { server.input(batch); });
+    clientWire->setRecvHandler([&client](std::span<const UdpDatagram> batch) { client.input(batch); });
+
+    std::shared_ptr<KcpSession> session;
+    int callbacks = 0;
+    client.handshake(serverWire->localAddress(),
+                     [&](std::expected<std::shared_ptr<KcpSession>, std::error_code> result)
+                     {
+                         ++callbacks;
+                         ASSERT_TRUE(result.has_value());
+                         session = *result;
+                     });
+    EXPECT_EQ(client.pendingHandshakes(), 1U);
+
+    for (uint32_t nowMs = 0; nowMs < 5'000 && session == nullptr; ++nowMs)
+    {
+        network.advanceTo(uint64_t{nowMs} * 1'000);
+        server.update(nowMs);
+        client.update(nowMs);
+        ioc.poll();
+    }
+
+    ASSERT_NE(session, nullptr);
+    EXPECT_EQ(callbacks, 1);
+    EXPECT_EQ(client.pendingHandshakes(), 0U);
+    const auto serverSessions = server.sessionMetrics();
+    ASSERT_EQ(serverSessions.size(), 1U);
+    EXPECT_EQ(serverSessions.front().conv, session->metrics().conv);
+    EXPECT_EQ(session->peer(), serverWire->localAddress());
+
+    session->close();
+    ioc.poll();
+}
+
+// 测试 6: 服务器无应答时，重发次数用尽后以 timed_out 回调
+TEST(HandshakeTest, ClientHandshakeTimesOut)
+{
+    SimulatedNetwork network;
+    auto clientWire = network.createTransport();
+    Client client(*clientWire);
+
+    std::error_code error;
+    client.handshake(NetAddress("10.200.0.1", 7000),
+                     [&](std::expected<std::shared_ptr<KcpSession>, std::error_code> result)
+                     {
+                         ASSERT_FALSE(result.has_value());
+                         error = result.error();
+                     });
+
+    for (uint32_t nowMs = 0; nowMs <= Client::HANDSHAKE_RETRY_MS * Client::HANDSHAKE_MAX_ATTEMPTS; nowMs += 10)
+    {
+        client.update(nowMs);
+    }
+    EXPECT_EQ(error, std::errc::timed_out);
+    EXPECT_EQ(client.pendingHandshakes(), 0U);
+    EXPECT_EQ(network.stats().sent, Client::HANDSHAKE_MAX_ATTEMPTS);
+}
+
+// 测试 7: 32 位毫秒时钟回绕时 cookie 的时效按实际经过的时间计算
+TEST(HandshakeTest, CookieAgeSurvivesMillisecondClockWrap)
+{
+    SimulatedNetwork network;
+    auto serverWire = network.createTransport();
+    Server server(*serverWire, 1, HandshakeCookies(TEST_KEY, 5));
+    RawPeer client(network);
+
+    // 签发后 3 秒，毫秒时钟已回绕：cookie 仍有效
+    server.update(UINT32_MAX - 1'000);
+    client.send(server, HandshakePacket{.type = HandshakeType::Hello, .nonce = 1});
+    network.advanceTo(1);
+    ASSERT_EQ(client.replies.size(), 1U);
+    HandshakePacket connect = client.replies.back();
+    connect.type = HandshakeType::Connect;
+    server.update(2'000);
+    client.send(server, connect);
+    network.advanceTo(2);
+    ASSERT_EQ(client.replies.size(), 2U);
+    EXPECT_EQ(client.replies.back().type, HandshakeType::Accept);
+
+    // 回绕后签发的 cookie 照常在有效期后失效
+    client.send(server, HandshakePacket{.type = HandshakeType::Hello, .nonce = 2});
+    network.advanceTo(3);
+    ASSERT_EQ(client.replies.size(), 3U);
+    connect = client.replies.back();
+    connect.type = HandshakeType::Connect;
+    server.update(8'000);
+    client.send(server, connect);
+    network.advanceTo(4);
+    EXPECT_EQ(client.replies.size(), 3U);
+    EXPECT_EQ(server.metrics().sessionsOpened, 1U);
+}
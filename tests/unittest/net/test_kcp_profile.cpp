@@ -0,0 +1,206 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_kcp_profile.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief KCP 参数预设单元测试（预设生效、运行时切换、自适应周期与重传、端点默认预设）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/Session/KcpSession.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+class ProfileEndpoint : public KcpEndpoint
+{
+public:
+    ProfileEndpoint(IUdpTransport& transport, asio::io_context& ioc) : KcpEndpoint(transport), m_ioc(ioc) {}
+
+    std::shared_ptr<KcpSession> lastSession;
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        lastSession =
+            std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool, m_sessionProfile);
+        return lastSession;
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+private:
+    asio::io_context& m_ioc;
+};
+} // namespace
+
+// 测试 1: 预设决定窗口、周期与 MTU
+TEST(KcpProfileTest, ProfilesConfigureKcp)
+{
+    asio::io_context ioc;
+    MockUdpTransport wire;
+    const NetAddress address("127.0.0.1", 9000);
+
+    const auto turbo = std::make_shared<KcpSession>(1, wire, address, ioc.get_executor())->metrics();
+    EXPECT_EQ(turbo.sendWindow, 32U);
+    EXPECT_EQ(turbo.recvWindow, 128U);
+    EXPECT_EQ(turbo.intervalMs, 10U);
+
+    const auto bulk =
+        std::make_shared<KcpSession>(2, wire, address, ioc.get_executor(), nullptr, KcpProfile::bulk())->metrics();
+    EXPECT_EQ(bulk.sendWindow, 256U);
+    EXPECT_EQ(bulk.recvWindow, 256U);
+    EXPECT_EQ(bulk.intervalMs, 40U);
+
+    auto small = KcpProfile::turbo();
+    small.mtu = 576;
+    small.sendWindow = 128;
+    auto session = std::make_shared<KcpSession>(3, wire, address, ioc.get_executor(), nullptr, small);
+    session->send(std::vector<uint8_t>(4000, 0x5A));
+    session->update(0);
+    const auto packets = wire.getPackets();
+    ASSERT_GT(packets.size(), 1U);
+    EXPECT_TRUE(std::ranges::all_of(packets, [](const auto& packet) { return packet.data.size() <= 576; }));
+}
+
+// 测试 2: 运行时切换在下一次 update 时生效，并唤醒 Endpoint
+TEST(KcpProfileTest, SetProfileAppliesOnNextUpdate)
+{
+    asio::io_context ioc;
+    MockUdpTransport wire;
+    auto session = std::make_shared<KcpSession>(1, wire, NetAddress("127.0.0.1", 9000), ioc.get_executor());
+    int wakeups = 0;
+    session->setWakeCallback([&wakeups] { ++wakeups; });
+
+    session->setProfile(KcpProfile::bulk());
+    EXPECT_EQ(wakeups, 1);
+    EXPECT_EQ(session->profile(), KcpProfile::bulk());
+    EXPECT_EQ(session->metrics().sendWindow, 32U); // 尚未生效
+
+    session->update(0);
+    EXPECT_EQ(session->metrics().sendWindow, 256U);
+    EXPECT_EQ(session->metrics().intervalMs, 40U);
+
+    session->setProfile(KcpProfile::turbo());
+    session->flush(10);
+    EXPECT_EQ(session->metrics().sendWindow, 32U);
+    EXPECT_EQ(session->metrics().intervalMs, 10U);
+}
+
+// 测试 3: 自适应周期在静默时逐次翻倍，收发后回到基础周期
+TEST(KcpProfileTest, AdaptiveIntervalBacksOffWhenIdle)
+{
+    asio::io_context ioc;
+    MockUdpTransport aWire;
+    MockUdpTransport bWire;
+    const NetAddress address("127.0.0.1", 9000);
+    const auto profile = KcpProfile::normal(); // 20 ~ 200 ms
+    auto a = std::make_shared<KcpSession>(1, aWire, address, ioc.get_executor(), nullptr, profile);
+    auto b = std::make_shared<KcpSession>(1, bWire, address, ioc.get_executor(), nullptr, profile);
+
+    std::vector<uint32_t> intervals;
+    uint32_t now = 0;
+    for (int i = 0; i < 6; ++i)
+    {
+        a->update(now);
+        intervals.push_back(a->metrics().intervalMs);
+        now += 10;
+    }
+    EXPECT_EQ(intervals, (std::vector<uint32_t>{40, 80, 160, 200, 200, 200}));
+
+    // 发送后回到基础周期（Endpoint 被唤醒后调用 flush）
+    a->send(std::vector<uint8_t>(32, 1));
+    a->flush(now);
+    EXPECT_EQ(a->metrics().intervalMs, profile.intervalMs);
+
+    // 收到数据同样回到基础周期
+    b->update(now);
+    b->update(now + 10);
+    EXPECT_GT(b->metrics().intervalMs, profile.intervalMs);
+    for (const auto& packet : aWire.getPackets())
+    {
+        b->input(packet.data);
+    }
+    b->flush(now + 20);
+    EXPECT_EQ(b->metrics().intervalMs, profile.intervalMs);
+
+    // 未开启自适应的预设保持固定周期
+    auto fixed = std::make_shared<KcpSession>(2, aWire, address, ioc.get_executor());
+    for (int i = 0; i < 3; ++i)
+    {
+        fixed->update(now + (i * 10));
+    }
+    EXPECT_EQ(fixed->metrics().intervalMs, 10U);
+}
+
+// 测试 4: 自适应周期下丢失的段在 RTO 到期后的一个基础周期内重传，不被拉长的周期推迟
+TEST(KcpProfileTest, AdaptiveIntervalDoesNotDelayRetransmit)
+{
+    asio::io_context ioc;
+    MockUdpTransport wire;
+    const auto profile = KcpProfile::normal(); // 20 ~ 200 ms
+    auto session = std::make_shared<KcpSession>(1, wire, NetAddress("127.0.0.1", 9000), ioc.get_executor(),
+                                                nullptr, profile);
+
+    // 先静默到最长周期
+    uint32_t now = 0;
+    for (int i = 0; i < 6; ++i)
+    {
+        session->update(now);
+        now += 10;
+    }
+    ASSERT_EQ(session->metrics().intervalMs, profile.maxIntervalMs);
+
+    // 发出一个段后丢弃它，之后像 Endpoint 一样按 check() 给出的时间点驱动 update
+    session->send(std::vector<uint8_t>(32, 0x7E));
+    session->flush(now);
+    ASSERT_EQ(wire.getPackets().size(), 1U);
+    wire.clearPackets();
+    const uint32_t sentAt = now;
+    // 非 nodelay 模式下首次重传时刻为 RTO + RTO/8，之后最多再等一个基础周期的 flush
+    const uint32_t rto = session->metrics().rtoMs;
+    const uint32_t deadline = sentAt + rto + rto / 8 + profile.intervalMs;
+
+    while (wire.getPackets().empty() && now <= sentAt + 2000)
+    {
+        now = std::max(session->check(now), now + 1);
+        session->update(now);
+    }
+    ASSERT_FALSE(wire.getPackets().empty());
+    EXPECT_LE(now, deadline);
+    EXPECT_EQ(session->metrics().intervalMs, profile.intervalMs);
+}
+
+// 测试 5: 端点的默认预设用于新建会话
+TEST(KcpProfileTest, EndpointSessionProfile)
+{
+    asio::io_context ioc;
+    MockUdpTransport peerWire;
+    MockUdpTransport serverWire;
+    const NetAddress address("127.0.0.1", 9000);
+    KcpSession peer(7, peerWire, address, ioc.get_executor());
+    ProfileEndpoint endpoint(serverWire, ioc);
+    EXPECT_EQ(endpoint.sessionProfile(), KcpProfile::turbo());
+    endpoint.setSessionProfile(KcpProfile::normal());
+
+    peer.send(std::vector<uint8_t>(16, 0x22));
+    peer.update(0);
+    for (const auto& packet : peerWire.getPackets())
+    {
+        endpoint.input(address, packet.data);
+    }
+    ASSERT_NE(endpoint.lastSession, nullptr);
+    EXPECT_EQ(endpoint.lastSession->profile(), KcpProfile::normal());
+    EXPECT_EQ(endpoint.lastSession->metrics().sendWindow, 64U);
+}
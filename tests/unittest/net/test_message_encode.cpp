@@ -0,0 +1,70 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_message_encode.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief encodeMessage 就地编码单元测试（预留帧头、writer 复用）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/response/SendMessageToChatResponse.h"
+#include <string>
+
+namespace
+{
+SendMessageToChatResponse makeResponse(uint32_t sender, std::string text)
+{
+    SendMessageToChatResponse resp;
+    resp.sender = sender;
+    resp.chatMessage = std::move(text);
+    return resp;
+}
+} // namespace
+
+// 测试 1: 就地编码的帧可以完整解码
+TEST(MessageEncodeTest, EncodesFrameInPlace)
+{
+    shared::PacketWriter writer;
+    auto frame = encodeMessage(makeResponse(7, "hello"), writer);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->data(), writer.buffer.data());
+    EXPECT_EQ(frame->size(), FRAME_HEADER_SIZE + 4 + 2 + 5);
+
+    auto decoded = decodeMessage<SendMessageToChatResponse>(*frame);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->sender, 7U);
+    EXPECT_EQ(decoded->chatMessage, "hello");
+}
+
+// 测试 2: 复用 writer 时不再重新分配，且与单次编码结果一致
+TEST(MessageEncodeTest, ReusedWriterDoesNotReallocate)
+{
+    shared::PacketWriter writer;
+    ASSERT_TRUE(encodeMessage(makeResponse(1, std::string(100, 'x')), writer).has_value());
+    const uint8_t* storage = writer.buffer.data();
+
+    const auto message = makeResponse(2, "short");
+    auto frame = encodeMessage(message, writer);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->data(), storage);
+
+    auto owned = encodeMessage(message);
+    ASSERT_TRUE(owned.has_value());
+    EXPECT_TRUE(std::ranges::equal(*frame, *owned));
+}
+
+// 测试 3: 序列化失败（字符串超长）返回 SerializeFailed
+TEST(MessageEncodeTest, OversizedMessageFails)
+{
+    shared::PacketWriter writer;
+    auto frame = encodeMessage(makeResponse(3, std::string(UINT16_MAX + 1, 'y')), writer);
+    ASSERT_FALSE(frame.has_value());
+    EXPECT_EQ(frame.error(), MessageError::SerializeFailed);
+}
@@ -0,0 +1,123 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_message_schema.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 消息字段表单元测试（线上格式、精确长度、JSON 往返、增量编码）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/request/CreateRoomRequest.h"
+#include "src/shared/messages/response/DiscardCardResponse.h"
+#include "src/shared/messages/response/SettlementResponse.h"
+#include "src/shared/messages/response/UseCardResponse.h"
+#include <vector>
+
+namespace
+{
+UseCardResponse makeUseCard()
+{
+    UseCardResponse resp;
+    resp.player = 3;
+    resp.card = 0x0102;
+    resp.targets = {7, 8};
+    resp.success = true;
+    resp.message = "ok";
+    return resp;
+}
+} // namespace
+
+// 测试 1: 生成的编码与手写格式逐字节一致：字段按列出的顺序，字符串与数组以 u16 长度开头
+TEST(MessageSchemaTest, WireFormatMatchesFieldOrder)
+{
+    CreateRoomRequest create;
+    create.roomName = "ab";
+    create.maxPlayers = 6;
+    EXPECT_EQ(create.serialize(), (std::vector<uint8_t>{2, 0, 'a', 'b', 6, 0, 0}));
+
+    const std::vector<uint8_t> expected = {
+        3, 0, 0, 0, 0x02, 0x01, 0, 0, 2, 0, 7, 0, 0, 0, 8, 0, 0, 0, 1, 2, 0, 'o', 'k'};
+    EXPECT_EQ(makeUseCard().serialize(), expected);
+
+    auto decoded = UseCardResponse::deserialize(expected);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->targets, (std::vector<uint32_t>{7, 8}));
+    EXPECT_EQ(decoded->message, "ok");
+
+    auto truncated = UseCardResponse::deserialize(std::span(expected).first(12));
+    ASSERT_FALSE(truncated.has_value());
+    EXPECT_EQ(truncated.error(), MessageError::InvalidFormat);
+}
+
+// 测试 2: serializedSize 与实际编码长度一致，serialize 与 encodeMessage 一次分配到位
+TEST(MessageSchemaTest, SerializedSizeIsExact)
+{
+    const auto useCard = makeUseCard();
+    const auto bytes = useCard.serialize();
+    EXPECT_EQ(useCard.serializedSize(), bytes.size());
+    EXPECT_EQ(bytes.capacity(), bytes.size());
+
+    DiscardCardResponse discard;
+    discard.cardIndexs.assign(300, 1);
+    EXPECT_EQ(discard.serializedSize(), 4U + 2U + 300U * 4U);
+
+    auto frame = encodeMessage(discard);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->size(), FRAME_HEADER_SIZE + discard.serializedSize());
+    EXPECT_EQ(frame->capacity(), frame->size());
+}
+
+// 测试 3: toJson 与 fromJson 往返，缺少字段返回 DeserializeFailed
+TEST(MessageSchemaTest, JsonRoundTrip)
+{
+    const auto useCard = makeUseCard();
+    const auto json = useCard.toJson();
+    EXPECT_EQ(json.at("targets"), nlohmann::json({7, 8}));
+    EXPECT_EQ(json.at("message"), "ok");
+
+    auto parsed = UseCardResponse::fromJson(json);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->serialize(), useCard.serialize());
+
+    auto missing = SettlementResponse::fromJson({{"player", 1}});
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error(), MessageError::DeserializeFailed);
+}
+
+// 测试 4: 增量编码只写出变化的字段，接收端在上一条消息上还原；损坏的增量不改动消息
+TEST(MessageSchemaTest, DeltaEncodesChangedFieldsOnly)
+{
+    SettlementResponse previous;
+    previous.player = 1;
+    previous.card = 42;
+    previous.target = 2;
+    previous.message = "Strike deals 6 damage";
+
+    SettlementResponse current = previous;
+    current.target = 5;
+
+    shared::PacketWriter writer;
+    current.writeDeltaTo(previous, writer);
+    EXPECT_EQ(writer.buffer, (std::vector<uint8_t>{0b00100, 5, 0, 0, 0})); // 掩码 + target
+
+    SettlementResponse receiver = previous;
+    ASSERT_TRUE(receiver.applyDelta(writer.buffer).has_value());
+    EXPECT_EQ(receiver.serialize(), current.serialize());
+
+    writer.clear();
+    current.writeDeltaTo(current, writer);
+    EXPECT_EQ(writer.buffer, (std::vector<uint8_t>{0})); // 没有变化：只有掩码
+
+    const std::vector<uint8_t> corrupt = {0b10000, 9, 0}; // message 长度为 9 但数据不足
+    auto failed = receiver.applyDelta(corrupt);
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_EQ(failed.error(), MessageError::InvalidFormat);
+    EXPECT_EQ(receiver.message, previous.message);
+}
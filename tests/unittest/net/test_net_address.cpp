@@ -0,0 +1,77 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_net_address.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief NetAddress 值类型单元测试（往返转换、比较、哈希、sockaddr 规范化）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/net/common/NetAddress.h"
+#include <asio.hpp>
+#include <unordered_set>
+
+// 测试 1: IPv4 / IPv6 与字符串、endpoint 之间往返
+TEST(NetAddressTest, RoundTripsIpv4AndIpv6)
+{
+    const NetAddress v4("192.168.1.20", 7777);
+    EXPECT_EQ(v4.ip(), "192.168.1.20");
+    EXPECT_EQ(v4.port(), 7777);
+    EXPECT_EQ(v4.toString(), "192.168.1.20:7777");
+    EXPECT_EQ(v4.sockaddrSize(), sizeof(sockaddr_in));
+
+    const NetAddress v6("::1", 9000);
+    EXPECT_EQ(v6.ip(), "::1");
+    EXPECT_EQ(v6.port(), 9000);
+    EXPECT_EQ(v6.sockaddrSize(), sizeof(sockaddr_in6));
+    EXPECT_EQ(NetAddress(v6.toAsioEndpoint()), v6);
+
+    const NetAddress fallback("not-an-ip", 1234);
+    EXPECT_EQ(fallback.ip(), "0.0.0.0");
+    EXPECT_EQ(fallback.port(), 1234);
+    EXPECT_EQ(NetAddress().toString(), "0.0.0.0:0");
+}
+
+// 测试 2: 比较与哈希按地址和端口区分
+TEST(NetAddressTest, EqualityAndHash)
+{
+    const NetAddress a("10.0.0.1", 100);
+    const NetAddress b = a;
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_NE(a, NetAddress("10.0.0.1", 101));
+    EXPECT_NE(a, NetAddress("10.0.0.2", 100));
+
+    std::unordered_set<NetAddress> set;
+    for (uint16_t port = 1; port <= 1000; ++port)
+    {
+        set.insert(NetAddress("10.0.0.1", port));
+    }
+    set.insert(b);
+    EXPECT_EQ(set.size(), 1000U);
+}
+
+// 测试 3: 内核返回的 sockaddr 中的填充字节不影响比较
+TEST(NetAddressTest, FromSockaddrCanonicalizesPadding)
+{
+    sockaddr_in raw{};
+    raw.sin_family = AF_INET;
+    raw.sin_port = htons(5555);
+    raw.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    std::memset(raw.sin_zero, 0xCC, sizeof(raw.sin_zero));
+
+    const auto address = NetAddress::fromSockaddr(&raw, sizeof(raw));
+    EXPECT_EQ(address, NetAddress("127.0.0.1", 5555));
+    EXPECT_EQ(address.hash(), NetAddress("127.0.0.1", 5555).hash());
+
+    sockaddr_in back{};
+    std::memcpy(&back, address.sockaddrData(), address.sockaddrSize());
+    EXPECT_EQ(back.sin_port, raw.sin_port);
+    EXPECT_EQ(back.sin_addr.s_addr, raw.sin_addr.s_addr);
+}
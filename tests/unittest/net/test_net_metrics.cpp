@@ -0,0 +1,134 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_net_metrics.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 网络指标单元测试（会话 / 端点快照、JSON 导出）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/common/NetMetrics.h"
+#include <asio.hpp>
+#include <nlohmann/json.hpp>
+#include <functional>
+
+namespace
+{
+class MetricsEndpoint : public KcpEndpoint
+{
+public:
+    MetricsEndpoint(IUdpTransport& transport, asio::io_context& ioc) : KcpEndpoint(transport), m_ioc(ioc) {}
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+private:
+    asio::io_context& m_ioc;
+};
+
+void deliver(MockUdpTransport& from, const std::function<void(const MockUdpTransport::Packet&)>& sink)
+{
+    for (const auto& packet : from.getPackets())
+    {
+        sink(packet);
+    }
+    from.clearPackets();
+}
+} // namespace
+
+// 测试 1: 会话快照反映收发量、KCP 状态与通道占用
+TEST(NetMetricsTest, SessionSnapshotTracksTrafficAndKcpState)
+{
+    asio::io_context ioc;
+    MockUdpTransport aWire;
+    MockUdpTransport bWire;
+    const NetAddress address("127.0.0.1", 9000);
+    auto a = std::make_shared<KcpSession>(5, aWire, address, ioc.get_executor());
+    auto b = std::make_shared<KcpSession>(5, bWire, address, ioc.get_executor());
+
+    const std::vector<uint8_t> message(100, 0x11);
+    a->send(message);
+    a->send(message);
+    a->update(1'000);
+    deliver(aWire, [&](const auto& packet) { b->input(packet.data); });
+    b->update(1'010); // 回复 ACK
+    a->update(1'020); // ACK 在 20 ms 后到达
+    deliver(bWire, [&](const auto& packet) { a->input(packet.data); });
+
+    const auto sent = a->metrics();
+    EXPECT_EQ(sent.conv, 5U);
+    EXPECT_EQ(sent.messagesOut, 2U);
+    EXPECT_GE(sent.packetsOut, 1U);
+    EXPECT_GT(sent.bytesOut, 200U);
+    EXPECT_EQ(sent.waitSend, 0U); // 已全部确认
+    EXPECT_EQ(sent.rttMs, 20U);
+    EXPECT_GT(sent.rtoMs, 0U);
+    EXPECT_GT(sent.sendWindow, 0U);
+
+    const auto received = b->metrics();
+    EXPECT_EQ(received.messagesIn, 2U);
+    EXPECT_EQ(received.channelOccupancy, 2U);
+    EXPECT_EQ(received.packetsIn, sent.packetsOut);
+    EXPECT_EQ(received.bytesIn, sent.bytesOut);
+
+    // 业务取走一条后占用减少
+    b->recvAsync([](auto) {});
+    ioc.poll();
+    EXPECT_EQ(b->metrics().channelOccupancy, 1U);
+}
+
+// 测试 2: 端点快照统计收包、会话数与 update 次数，JSON 可解析
+TEST(NetMetricsTest, EndpointSnapshotAndJson)
+{
+    asio::io_context ioc;
+    MockUdpTransport peerWire;
+    MockUdpTransport serverWire;
+    const NetAddress address("127.0.0.1", 9000);
+    KcpSession peer(9, peerWire, address, ioc.get_executor());
+    MetricsEndpoint endpoint(serverWire, ioc);
+
+    peer.send(std::vector<uint8_t>(32, 0x22));
+    peer.update(0);
+    endpoint.update(1'000);
+    deliver(peerWire, [&](const auto& packet) { endpoint.input(packet.to, packet.data); });
+    endpoint.input(address, std::vector<uint8_t>{1, 2}); // 过短，被拒绝
+    endpoint.update(1'001);
+
+    const auto metrics = endpoint.metrics();
+    EXPECT_EQ(metrics.activeSessions, 1U);
+    EXPECT_EQ(metrics.sessionsOpened, 1U);
+    EXPECT_EQ(metrics.packetsIn, 1U);
+    EXPECT_EQ(metrics.packetsRejected, 1U);
+    EXPECT_EQ(metrics.updates, 2U);
+    EXPECT_GE(metrics.sessionsServiced, 1U);
+    EXPECT_GE(metrics.totalUpdateNs, metrics.maxUpdateNs);
+
+    const auto sessions = endpoint.sessionMetrics();
+    ASSERT_EQ(sessions.size(), 1U);
+    EXPECT_EQ(sessions.front().conv, 9U);
+    EXPECT_EQ(sessions.front().messagesIn, 1U);
+
+    const auto json = nlohmann::json::parse(toJson(metrics, sessions));
+    EXPECT_EQ(json["endpoint"]["packetsIn"], 1U);
+    EXPECT_EQ(json["sessions"][0]["conv"], 9U);
+    EXPECT_EQ(json["sessions"][0]["messagesIn"], 1U);
+
+    EndpointMetrics total = metrics;
+    total += metrics;
+    EXPECT_EQ(total.packetsIn, 2U);
+    EXPECT_EQ(total.maxUpdateNs, metrics.maxUpdateNs);
+}
@@ -0,0 +1,160 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_packet_pool.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief PacketPool / PacketBuffer 及 KcpSession 池化接收路径单元测试
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/net/common/PacketPool.h"
+#include "src/net/common/RingQueue.h"
+#include "src/net/Session/KcpSession.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// 测试 1: 归还的 slab 被复用，稳态下不再分配
+TEST(PacketPoolTest, ReusesReleasedSlabs)
+{
+    PacketPool pool(256, 2);
+    for (int i = 0; i < 100; ++i)
+    {
+        PacketBuffer first = pool.acquire(100);
+        PacketBuffer second = pool.acquire(200);
+        ASSERT_EQ(first.size(), 100U);
+        ASSERT_EQ(second.capacity(), 256U);
+    }
+    const auto stats = pool.stats();
+    EXPECT_EQ(stats.acquired, 200U);
+    EXPECT_EQ(stats.slabsAllocated, 2U);
+    EXPECT_EQ(stats.overflow, 0U);
+}
+
+// 测试 2: 超过 slab 大小的请求走溢出路径
+TEST(PacketPoolTest, OversizedRequestUsesOverflow)
+{
+    PacketPool pool(256, 1);
+    PacketBuffer big = pool.acquire(4096);
+    ASSERT_EQ(big.size(), 4096U);
+    EXPECT_GE(big.capacity(), 4096U);
+    std::fill(big.span().begin(), big.span().end(), 0xAB);
+    EXPECT_EQ(big.span().back(), 0xAB);
+    EXPECT_EQ(pool.stats().overflow, 1U);
+    EXPECT_EQ(pool.stats().slabsAllocated, 1U);
+}
+
+// 测试 3: share 共享同一块内存，最后一个句柄释放后才归还
+TEST(PacketPoolTest, ShareKeepsSlabAlive)
+{
+    PacketPool pool(64, 1);
+    PacketBuffer original = pool.acquire(8);
+    original.data()[0] = 42;
+    PacketBuffer copy = original.share();
+    EXPECT_EQ(copy.data(), original.data());
+
+    original = PacketBuffer();
+    EXPECT_EQ(copy.data()[0], 42);
+
+    // 唯一的 slab 仍被 copy 持有，再次获取必须新分配
+    PacketBuffer other = pool.acquire(8);
+    EXPECT_NE(other.data(), copy.data());
+    EXPECT_EQ(pool.stats().slabsAllocated, 2U);
+}
+
+// 测试 4: 缓冲区可以比池活得更久，也可以在其他线程归还
+TEST(PacketPoolTest, BuffersOutlivePoolAcrossThreads)
+{
+    std::vector<PacketBuffer> buffers;
+    {
+        PacketPool pool(128, 4);
+        for (int i = 0; i < 8; ++i)
+        {
+            buffers.push_back(pool.acquire(64));
+            buffers.back().data()[0] = static_cast<uint8_t>(i);
+        }
+    }
+    std::thread releaser([moved = std::move(buffers)]() mutable { moved.clear(); });
+    releaser.join();
+    SUCCEED();
+}
+
+// 测试 5: 环形队列增长后保持 FIFO 顺序
+TEST(PacketPoolTest, RingQueueKeepsOrderAcrossGrowth)
+{
+    RingQueue<std::unique_ptr<int>> queue;
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 7; ++i)
+        {
+            queue.push_back(std::make_unique<int>(next++));
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_EQ(*queue.front(), expected++);
+            queue.pop_front();
+        }
+    }
+    EXPECT_EQ(queue.size(), static_cast<size_t>(next - expected));
+    while (!queue.empty())
+    {
+        EXPECT_EQ(*queue.front(), expected++);
+        queue.pop_front();
+    }
+}
+
+// 测试 6: KcpSession 通过池接收小消息与超过 slab 的大消息
+TEST(PacketPoolTest, SessionDeliversSmallAndOversizedMessages)
+{
+    asio::io_context ioc;
+    MockUdpTransport wire;
+    MockUdpTransport sink;
+    const NetAddress peer("127.0.0.1", 9000);
+    auto pool = std::make_shared<PacketPool>(512, 4);
+
+    auto sender = std::make_shared<KcpSession>(7, wire, peer, ioc.get_executor());
+    auto receiver = std::make_shared<KcpSession>(7, sink, peer, ioc.get_executor(), pool);
+
+    std::vector<uint8_t> small(100, 0x11);
+    std::vector<uint8_t> large(3000);
+    for (size_t i = 0; i < large.size(); ++i)
+    {
+        large[i] = static_cast<uint8_t>(i);
+    }
+    sender->send(small);
+    sender->send(large);
+    sender->update(0);
+
+    for (const auto& packet : wire.getPackets())
+    {
+        receiver->input(packet.data);
+    }
+
+    std::vector<std::vector<uint8_t>> received;
+    for (int i = 0; i < 2; ++i)
+    {
+        receiver->recvAsync(
+            [&](std::expected<KcpSession::Packet, std::error_code> result)
+            {
+                ASSERT_TRUE(result.has_value());
+                received.emplace_back(result->begin(), result->end());
+            });
+    }
+    ioc.run_for(std::chrono::milliseconds(200));
+
+    ASSERT_EQ(received.size(), 2U);
+    EXPECT_EQ(received[0], small);
+    EXPECT_EQ(received[1], large);
+    EXPECT_EQ(pool->stats().overflow, 1U);
+    EXPECT_EQ(receiver->droppedPackets(), 0U);
+}
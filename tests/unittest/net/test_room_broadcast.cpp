@@ -0,0 +1,208 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_room_broadcast.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间广播单元测试（SharedFrame 编码、共享引用扇出、成员管理、唤醒合并）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/net/App/RoomBroadcaster.h"
+#include "src/net/protocol/SharedFrame.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr size_t PLAYERS = 8;
+constexpr uint16_t CMD_CARD_PLAYED = 0x2101;
+
+std::vector<uint8_t> bytesOf(std::string_view text)
+{
+    return {text.begin(), text.end()};
+}
+
+// 一个房间：服务端 PLAYERS 个会话共用一个传输层，每个玩家一个接收端
+struct RoomFixture
+{
+    asio::io_context ioc;
+    MockUdpTransport serverWire;
+    MockUdpTransport clientWire;
+    std::vector<std::shared_ptr<KcpSession>> servers;
+    std::vector<std::shared_ptr<KcpSession>> clients;
+
+    RoomFixture()
+    {
+        for (uint32_t i = 0; i < PLAYERS; ++i)
+        {
+            const NetAddress address("127.0.0.1", static_cast<uint16_t>(9000 + i));
+            servers.push_back(std::make_shared<KcpSession>(i + 1, serverWire, address, ioc.get_executor()));
+            clients.push_back(std::make_shared<KcpSession>(i + 1, clientWire, address, ioc.get_executor()));
+        }
+    }
+
+    // 服务端会话 update 一次，把发出的数据报按目的端口交给对应玩家，返回每个玩家收到的消息
+    std::vector<std::vector<std::vector<uint8_t>>> deliver(uint32_t nowMs)
+    {
+        for (auto& session : servers)
+        {
+            session->update(nowMs);
+        }
+        for (const auto& packet : serverWire.getPackets())
+        {
+            clients[packet.to.port() - 9000]->input(packet.data);
+        }
+        serverWire.clearPackets();
+
+        std::vector<std::vector<std::vector<uint8_t>>> received(PLAYERS);
+        for (size_t i = 0; i < PLAYERS; ++i)
+        {
+            clients[i]->recvAsync(
+                [&received, i](std::expected<KcpSession::Packet, std::error_code> result)
+                {
+                    if (result)
+                    {
+                        received[i].emplace_back(result->begin(), result->end());
+                    }
+                });
+        }
+        ioc.poll();
+        ioc.restart();
+        return received;
+    }
+};
+} // namespace
+
+// 测试 1: SharedFrame 的三种构造方式都得到可解码的帧
+TEST(RoomBroadcastTest, SharedFrameEncodesDecodableFrames)
+{
+    const auto payload = bytesOf(R"({"card":"Strike","target":3,"damage":6,"card":"Strike","target":3,"damage":6})");
+
+    auto plain = SharedFrame::encode(CMD_CARD_PLAYED, payload);
+    ASSERT_TRUE(plain.has_value());
+    EXPECT_EQ(plain->size(), FRAME_HEADER_SIZE + payload.size());
+    auto decoded = decodeFrame(plain->bytes());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->cmd, CMD_CARD_PLAYED);
+    EXPECT_TRUE(std::ranges::equal(decoded->payload, payload));
+
+    auto packed = SharedFrame::encode(CMD_CARD_PLAYED, payload, FrameCompression{});
+    ASSERT_TRUE(packed.has_value());
+    EXPECT_LT(packed->size(), plain->size());
+    std::vector<uint8_t> scratch;
+    auto unpacked = decodeFrame(packed->bytes(), scratch, nullptr);
+    ASSERT_TRUE(unpacked.has_value());
+    EXPECT_TRUE(std::ranges::equal(unpacked->payload, payload));
+
+    const auto copy = SharedFrame::copyOf(plain->bytes());
+    EXPECT_TRUE(std::ranges::equal(copy.bytes(), plain->bytes()));
+
+    const std::vector<uint8_t> huge(MAX_FRAME_PAYLOAD + 1);
+    EXPECT_EQ(SharedFrame::encode(CMD_CARD_PLAYED, huge).error(), CodecError::PayloadTooLarge);
+    EXPECT_TRUE(SharedFrame().empty());
+}
+
+// 测试 2: 广播只增加引用计数，各会话 update 后释放；每个玩家收到同一帧
+TEST(RoomBroadcastTest, BroadcastSharesOneBufferAcrossRoom)
+{
+    RoomFixture room;
+    RoomBroadcaster broadcaster;
+    for (const auto& session : room.servers)
+    {
+        broadcaster.join(7, session);
+    }
+
+    const auto payload = bytesOf("card played");
+    auto frame = SharedFrame::encode(CMD_CARD_PLAYED, payload);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(broadcaster.broadcast(7, *frame), PLAYERS);
+    EXPECT_EQ(frame->useCount(), static_cast<long>(1 + PLAYERS));
+    EXPECT_TRUE(room.servers.front()->hasPendingOutput());
+
+    const auto received = room.deliver(1'000);
+    EXPECT_EQ(frame->useCount(), 1);
+    for (const auto& messages : received)
+    {
+        ASSERT_EQ(messages.size(), 1U);
+        EXPECT_TRUE(std::ranges::equal(messages.front(), frame->bytes()));
+    }
+}
+
+// 测试 3: 同一 tick 内的共享帧与 queueFrame 的帧合并为一条 KCP 消息，共享帧保持排入顺序
+TEST(RoomBroadcastTest, SharedFramesJoinTheFrameBatch)
+{
+    RoomFixture room;
+    RoomBroadcaster broadcaster;
+    broadcaster.join(1, room.servers[0]);
+
+    ASSERT_TRUE(room.servers[0]->queueFrame(0x0001, bytesOf("direct")).has_value());
+    ASSERT_EQ(broadcaster.broadcast(1, 0x0002, bytesOf("first")).value(), 1U);
+    ASSERT_EQ(broadcaster.broadcast(1, 0x0003, bytesOf("second")).value(), 1U);
+
+    const auto received = room.deliver(1'000);
+    ASSERT_EQ(received[0].size(), 1U);
+    std::vector<uint16_t> cmds;
+    for (const auto& [cmd, payload] : decodeFrames(received[0].front()))
+    {
+        cmds.push_back(cmd);
+    }
+    EXPECT_EQ(cmds, (std::vector<uint16_t>{0x0001, 0x0002, 0x0003}));
+}
+
+// 测试 4: 成员管理：重复加入忽略、离开后不再接收、关闭的会话在广播时移出、空房间删除
+TEST(RoomBroadcastTest, MembershipFollowsJoinLeaveAndClose)
+{
+    RoomFixture room;
+    RoomBroadcaster broadcaster;
+    broadcaster.join(3, room.servers[0]);
+    broadcaster.join(3, room.servers[0]);
+    broadcaster.join(3, room.servers[1]);
+    broadcaster.join(3, room.servers[2]);
+    broadcaster.join(3, nullptr);
+    EXPECT_EQ(broadcaster.memberCount(3), 3U);
+
+    EXPECT_TRUE(broadcaster.leave(3, *room.servers[1]));
+    EXPECT_FALSE(broadcaster.leave(3, *room.servers[1]));
+    EXPECT_FALSE(broadcaster.leave(4, *room.servers[0]));
+
+    room.servers[2]->close();
+    EXPECT_EQ(broadcaster.broadcast(3, CMD_CARD_PLAYED, bytesOf("x")).value(), 1U);
+    EXPECT_EQ(broadcaster.memberCount(3), 1U);
+
+    EXPECT_EQ(broadcaster.broadcast(99, CMD_CARD_PLAYED, bytesOf("x")).value(), 0U);
+    EXPECT_TRUE(broadcaster.leave(3, *room.servers[0]));
+    EXPECT_EQ(broadcaster.roomCount(), 0U);
+
+    broadcaster.join(5, room.servers[3]);
+    broadcaster.removeRoom(5);
+    EXPECT_EQ(broadcaster.memberCount(5), 0U);
+}
+
+// 测试 5: 同一 tick 内多次排入只唤醒一次 Endpoint
+TEST(RoomBroadcastTest, QueueingWakesOncePerTick)
+{
+    RoomFixture room;
+    int wakes = 0;
+    room.servers[0]->setWakeCallback([&wakes] { ++wakes; });
+    const auto frame = SharedFrame::encode(CMD_CARD_PLAYED, bytesOf("tick")).value();
+
+    EXPECT_TRUE(room.servers[0]->queueSharedFrame(frame));
+    EXPECT_TRUE(room.servers[0]->queueSharedFrame(frame));
+    EXPECT_EQ(wakes, 1);
+
+    room.servers[0]->flush(1'000);
+    EXPECT_TRUE(room.servers[0]->queueSharedFrame(frame));
+    EXPECT_EQ(wakes, 2);
+
+    room.servers[0]->close();
+    EXPECT_FALSE(room.servers[0]->queueSharedFrame(frame));
+}
@@ -0,0 +1,331 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_rpc.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief RPC 层单元测试（类型化响应、协程处理器与乱序完成、错误状态、超时、取消、会话关闭）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/shared/messages/request/CreateRoomRequest.h"
+#include "src/shared/messages/request/SendMessageRequest.h"
+#include "src/shared/rpc/RpcClient.h"
+#include "src/shared/rpc/RpcServer.h"
+#include <asio.hpp>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace
+{
+using CreateRoomResult = std::expected<CreateRoomResponse, RpcError>;
+
+// 一对直连的会话：客户端的请求交给 RpcServer，服务端的响应交给 RpcClient
+struct RpcLink
+{
+    asio::io_context ioc;
+    MockUdpTransport clientWire;
+    MockUdpTransport serverWire;
+    std::shared_ptr<KcpSession> clientSession;
+    std::shared_ptr<KcpSession> serverSession;
+    std::optional<RpcClient> client;
+    RpcServer server{ioc.get_executor()};
+    bool dropRequests = false; // 模拟服务端不响应
+    uint32_t now = 1'000;
+
+    RpcLink()
+    {
+        const NetAddress address("127.0.0.1", 9000);
+        clientSession = std::make_shared<KcpSession>(7, clientWire, address, ioc.get_executor());
+        serverSession = std::make_shared<KcpSession>(7, serverWire, address, ioc.get_executor());
+        client.emplace(clientSession);
+
+        asio::co_spawn(
+            ioc,
+            [this]() -> asio::awaitable<void>
+            {
+                while (auto packet = co_await serverSession->recv())
+                {
+                    for (const auto& [cmd, payload] : decodeFrames(*packet))
+                    {
+                        if (!dropRequests)
+                        {
+                            server.onFrame(cmd, payload, replyTo(serverSession));
+                        }
+                    }
+                }
+            },
+            asio::detached);
+        asio::co_spawn(
+            ioc,
+            [this]() -> asio::awaitable<void>
+            {
+                while (auto packet = co_await clientSession->recv())
+                {
+                    for (const auto& [cmd, payload] : decodeFrames(*packet))
+                    {
+                        client->onFrame(cmd, payload);
+                    }
+                }
+            },
+            asio::detached);
+    }
+
+    ~RpcLink()
+    {
+        clientSession->close();
+        serverSession->close();
+        ioc.poll();
+    }
+
+    // 驱动两端若干轮：执行就绪的协程，双方 flush 并交换数据报
+    void pump(int rounds = 4)
+    {
+        for (int i = 0; i < rounds; ++i)
+        {
+            ioc.poll();
+            ioc.restart();
+            now += 10;
+            clientSession->flush(now);
+            deliver(clientWire, *serverSession);
+            serverSession->flush(now);
+            deliver(serverWire, *clientSession);
+        }
+        ioc.poll();
+        ioc.restart();
+    }
+
+    template <typename Request>
+    void start(Request request, std::optional<std::expected<typename Request::Response, RpcError>>& result)
+    {
+        asio::co_spawn(
+            ioc,
+            [this, request = std::move(request), &result]() -> asio::awaitable<void>
+            { result = co_await client->call(request); },
+            asio::detached);
+    }
+
+private:
+    static void deliver(MockUdpTransport& wire, KcpSession& target)
+    {
+        for (const auto& packet : wire.getPackets())
+        {
+            target.input(packet.data);
+        }
+        wire.clearPackets();
+    }
+};
+
+CreateRoomRequest makeRequest(std::string name, uint8_t maxPlayers = 4)
+{
+    CreateRoomRequest request;
+    request.roomName = std::move(name);
+    request.maxPlayers = maxPlayers;
+    return request;
+}
+} // namespace
+
+// 测试 1: 同步处理器的响应按类型解码后返回给调用方
+TEST(RpcTest, CallReturnsTypedResponse)
+{
+    RpcLink link;
+    link.server.registerHandler<CreateRoomRequest>(
+        [](const CreateRoomRequest& req)
+        {
+            const auto roomId = static_cast<uint32_t>(req.roomName.size()) * 100 + req.maxPlayers;
+            return CreateRoomResponse::createSuccess(roomId);
+        });
+
+    std::optional<CreateRoomResult> result;
+    link.start(makeRequest("tavern", 6), result);
+    link.pump();
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(result->has_value());
+    EXPECT_TRUE((*result)->success);
+    EXPECT_EQ((*result)->roomId, 606U);
+    EXPECT_EQ(link.client->pendingCalls(), 0U);
+}
+
+// 测试 2: 流水线上的多个调用由协程处理器并发处理，乱序完成时各自拿到自己的响应
+TEST(RpcTest, PipelinedCallsCompleteOutOfOrder)
+{
+    RpcLink link;
+    std::vector<std::shared_ptr<asio::steady_timer>> gates;
+    link.server.registerHandler<CreateRoomRequest>(
+        [&link, &gates](const CreateRoomRequest& req) -> asio::awaitable<CreateRoomResponse>
+        {
+            // 等到测试放行再回复
+            auto gate = std::make_shared<asio::steady_timer>(link.ioc, std::chrono::hours(1));
+            gates.push_back(gate);
+            std::error_code ec;
+            co_await gate->async_wait(asio::redirect_error(asio::use_awaitable, ec));
+            co_return CreateRoomResponse::createSuccess(req.maxPlayers);
+        });
+
+    constexpr uint8_t CALLS = 3;
+    std::vector<std::optional<CreateRoomResult>> results(CALLS);
+    for (uint8_t i = 0; i < CALLS; ++i)
+    {
+        link.start(makeRequest("room", i), results[i]);
+    }
+    link.pump();
+    ASSERT_EQ(gates.size(), CALLS); // 三个请求同时在处理
+    EXPECT_EQ(link.server.inFlight(), CALLS);
+    EXPECT_EQ(link.client->pendingCalls(), CALLS);
+
+    gates[2]->cancel(); // 最后一个先完成
+    link.pump();
+    ASSERT_TRUE(results[2].has_value());
+    EXPECT_FALSE(results[0].has_value());
+    EXPECT_EQ((*results[2])->roomId, 2U);
+
+    gates[0]->cancel();
+    gates[1]->cancel();
+    link.pump();
+    for (uint8_t i = 0; i < CALLS; ++i)
+    {
+        ASSERT_TRUE(results[i].has_value() && results[i]->has_value());
+        EXPECT_EQ((*results[i])->roomId, i);
+    }
+    EXPECT_EQ(link.server.inFlight(), 0U);
+}
+
+// 测试 3: 未注册的请求、无法解析的请求、处理器报错或抛出异常都以对应的错误返回
+TEST(RpcTest, ReportsServerErrors)
+{
+    RpcLink link;
+    link.server.registerHandler<CreateRoomRequest>(
+        [](const CreateRoomRequest& req) -> std::expected<CreateRoomResponse, RpcError>
+        {
+            if (req.roomName.empty())
+            {
+                throw std::runtime_error("empty name");
+            }
+            return std::unexpected(RpcError::HandlerFailed);
+        });
+
+    std::optional<std::expected<SendMessageToChatResponse, RpcError>> unknown;
+    link.start(SendMessageRequest{}, unknown);
+    std::optional<CreateRoomResult> failed;
+    link.start(makeRequest("full"), failed);
+    std::optional<CreateRoomResult> thrown;
+    link.start(makeRequest(""), thrown);
+    link.pump();
+
+    ASSERT_TRUE(unknown.has_value() && failed.has_value() && thrown.has_value());
+    EXPECT_EQ(unknown->error(), RpcError::UnknownCommand);
+    EXPECT_EQ(failed->error(), RpcError::HandlerFailed);
+    EXPECT_EQ(thrown->error(), RpcError::HandlerFailed);
+
+    // 截断的请求消息：服务端回复 BadRequest
+    std::vector<std::optional<SharedFrame>> replies;
+    RpcHeader header{.requestId = 42, .cmd = CreateRoomRequest::CMD_ID};
+    shared::PacketWriter writer;
+    auto payload = encodeRpcEnvelope(header, makeRequest("truncated"), writer);
+    ASSERT_TRUE(payload.has_value());
+    const RpcReply collect = [&replies](SharedFrame frame) { replies.push_back(std::move(frame)); };
+    EXPECT_TRUE(link.server.onFrame(CommandID::RPC_REQUEST, payload->first(RPC_HEADER_SIZE + 3), collect));
+    ASSERT_EQ(replies.size(), 1U);
+    auto frame = decodeFrame(replies.front()->bytes());
+    ASSERT_TRUE(frame.has_value());
+    auto envelope = parseRpcEnvelope(frame->payload);
+    ASSERT_TRUE(envelope.has_value());
+    EXPECT_EQ(envelope->header.requestId, 42U);
+    EXPECT_EQ(envelope->header.status, static_cast<uint8_t>(RpcError::BadRequest));
+
+    EXPECT_FALSE(link.server.onFrame(CreateRoomRequest::CMD_ID, {}, nullptr)); // 普通消息不归 RPC 处理
+}
+
+// 测试 4: 超时返回 Timeout，迟到的响应被丢弃
+TEST(RpcTest, TimesOutAndDropsLateResponse)
+{
+    RpcLink link;
+    link.server.registerHandler<CreateRoomRequest>([](const CreateRoomRequest&)
+                                                   { return CreateRoomResponse::createSuccess(1); });
+    link.dropRequests = true;
+
+    std::optional<CreateRoomResult> result;
+    asio::co_spawn(
+        link.ioc,
+        [&link, &result]() -> asio::awaitable<void>
+        { result = co_await link.client->call(makeRequest("slow"), std::chrono::milliseconds(20)); },
+        asio::detached);
+    link.pump();
+    EXPECT_EQ(link.client->pendingCalls(), 1U);
+
+    link.ioc.run_for(std::chrono::milliseconds(60));
+    link.ioc.restart();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->error(), RpcError::Timeout);
+    EXPECT_EQ(link.client->pendingCalls(), 0U);
+
+    // requestId 1 的响应迟到：不属于任何在途调用，被消费并丢弃
+    RpcHeader header{.requestId = 1, .cmd = CreateRoomResponse::CMD_ID};
+    shared::PacketWriter writer;
+    auto late = encodeRpcEnvelope(header, CreateRoomResponse::createSuccess(1), writer);
+    ASSERT_TRUE(late.has_value());
+    EXPECT_TRUE(link.client->onFrame(CommandID::RPC_RESPONSE, *late));
+}
+
+// 测试 5: 按操作取消、cancelAll 与 RpcClient 析构都让在途调用以 Cancelled 返回
+TEST(RpcTest, CancelsPendingCalls)
+{
+    RpcLink link;
+    link.dropRequests = true;
+
+    asio::cancellation_signal signal;
+    std::optional<CreateRoomResult> viaSlot;
+    asio::co_spawn(link.ioc,
+                   link.client->call(makeRequest("a")),
+                   asio::bind_cancellation_slot(signal.slot(),
+                                                [&viaSlot](std::exception_ptr, CreateRoomResult result)
+                                                { viaSlot = std::move(result); }));
+    std::optional<CreateRoomResult> viaCancelAll;
+    link.start(makeRequest("b"), viaCancelAll);
+    link.pump();
+    ASSERT_EQ(link.client->pendingCalls(), 2U);
+
+    signal.emit(asio::cancellation_type::terminal);
+    link.pump();
+    ASSERT_TRUE(viaSlot.has_value());
+    EXPECT_EQ(viaSlot->error(), RpcError::Cancelled);
+    EXPECT_EQ(link.client->pendingCalls(), 1U);
+
+    link.client->cancelAll();
+    link.pump();
+    ASSERT_TRUE(viaCancelAll.has_value());
+    EXPECT_EQ(viaCancelAll->error(), RpcError::Cancelled);
+
+    std::optional<CreateRoomResult> viaDestructor;
+    link.start(makeRequest("c"), viaDestructor);
+    link.pump();
+    link.client.reset();
+    link.pump();
+    ASSERT_TRUE(viaDestructor.has_value());
+    EXPECT_EQ(viaDestructor->error(), RpcError::Cancelled);
+}
+
+// 测试 6: 会话已关闭时帧不会发出，调用立即以 Cancelled 返回，不等到超时
+TEST(RpcTest, CallOnClosedSessionCompletesImmediately)
+{
+    RpcLink link;
+    link.clientSession->close();
+    const std::vector<uint8_t> payload(8, 0);
+    EXPECT_EQ(link.clientSession->queueFrame(CommandID::RPC_REQUEST, payload).error(), CodecError::SessionClosed);
+    EXPECT_EQ(link.clientSession->sendUnreliable(CommandID::RPC_REQUEST, payload).error(), CodecError::SessionClosed);
+
+    std::optional<CreateRoomResult> result;
+    link.start(makeRequest("closed"), result);
+    link.ioc.poll(); // 只执行就绪的处理器，不推进任何定时器
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->error(), RpcError::Cancelled);
+    EXPECT_EQ(link.client->pendingCalls(), 0U);
+}
@@ -0,0 +1,101 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_session_recv.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief KcpSession::recv 协程接收单元测试（数据交付即恢复、会话关闭时返回错误）
+ *
+ * 往返延迟的测量见 tests/benchmark/bench_echo_latency.cpp
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/net/Session/KcpSession.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace
+{
+using RecvResult = std::expected<KcpSession::Packet, std::error_code>;
+
+// 一对直连的会话，接收端的协程等待一次 recv()
+struct RecvLink
+{
+    asio::io_context ioc;
+    MockUdpTransport senderWire;
+    MockUdpTransport receiverWire;
+    std::shared_ptr<KcpSession> sender;
+    std::shared_ptr<KcpSession> receiver;
+    std::optional<RecvResult> result;
+
+    RecvLink()
+    {
+        const NetAddress address("127.0.0.1", 9000);
+        sender = std::make_shared<KcpSession>(3, senderWire, address, ioc.get_executor());
+        receiver = std::make_shared<KcpSession>(3, receiverWire, address, ioc.get_executor());
+        asio::co_spawn(
+            ioc, [this]() -> asio::awaitable<void> { result = co_await receiver->recv(); }, asio::detached);
+    }
+
+    // 发送方 flush 后把数据报交给接收方
+    void deliver(std::span<const uint8_t> message)
+    {
+        sender->send(message);
+        sender->flush(1'000);
+        for (const auto& packet : senderWire.getPackets())
+        {
+            receiver->input(packet.data);
+        }
+        senderWire.clearPackets();
+    }
+};
+} // namespace
+
+// 测试 1: 数据交付后 recv() 在下一次 poll 中恢复，路径上没有定时器
+TEST(SessionRecvTest, CompletesOnDelivery)
+{
+    RecvLink link;
+    link.ioc.poll();
+    ASSERT_FALSE(link.result.has_value()); // 挂起在 channel 上
+
+    const std::vector<uint8_t> message(64, 0x7E);
+    link.deliver(message);
+    link.ioc.poll(); // 只执行就绪的处理器，不等待任何时间
+    ASSERT_TRUE(link.result.has_value());
+    ASSERT_TRUE(link.result->has_value());
+    EXPECT_TRUE(std::ranges::equal(link.result->value().span(), message));
+
+    // 协程结束后没有遗留的异步操作（例如轮询用的定时器），io_context 随即停止
+    EXPECT_TRUE(link.ioc.stopped());
+}
+
+// 测试 2: 会话关闭时挂起的 recv() 立即以错误返回，之后的 recv() 也不再挂起
+TEST(SessionRecvTest, CompletesWithErrorOnClose)
+{
+    RecvLink link;
+    link.ioc.poll();
+    ASSERT_FALSE(link.result.has_value());
+
+    link.receiver->close();
+    link.ioc.poll();
+    ASSERT_TRUE(link.result.has_value());
+    EXPECT_FALSE(link.result->has_value());
+
+    link.ioc.restart();
+    link.result.reset();
+    asio::co_spawn(
+        link.ioc, [&link]() -> asio::awaitable<void> { link.result = co_await link.receiver->recv(); },
+        asio::detached);
+    link.ioc.poll();
+    ASSERT_TRUE(link.result.has_value());
+    EXPECT_EQ(link.result->error(), std::errc::operation_canceled);
+}
@@ -0,0 +1,116 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_session_table.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief SessionTable 单元测试（插入、查找、后移删除、扩容、遍历）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/net/App/SessionTable.h"
+#include <random>
+#include <set>
+#include <unordered_map>
+
+// 测试 1: 重复插入返回同一条目
+TEST(SessionTableTest, TryEmplaceFindsExistingEntry)
+{
+    SessionTable table;
+    auto [first, inserted] = table.tryEmplace(42);
+    ASSERT_TRUE(inserted);
+    first->lastActiveMs = 1234;
+
+    auto [second, again] = table.tryEmplace(42);
+    EXPECT_FALSE(again);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(second->lastActiveMs, 1234U);
+    EXPECT_EQ(second->timer, TimerWheel<uint32_t>::INVALID_HANDLE);
+    EXPECT_EQ(table.size(), 1U);
+    EXPECT_EQ(table.find(7), nullptr);
+}
+
+// 测试 2: 扩容后所有条目仍可找到
+TEST(SessionTableTest, GrowsAndKeepsEntries)
+{
+    SessionTable table(8);
+    for (uint32_t conv = 1; conv <= 1000; ++conv)
+    {
+        table.tryEmplace(conv).first->lastActiveMs = conv * 3;
+    }
+    EXPECT_EQ(table.size(), 1000U);
+    EXPECT_GE(table.capacity(), 1024U);
+    for (uint32_t conv = 1; conv <= 1000; ++conv)
+    {
+        auto* entry = table.find(conv);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->lastActiveMs, conv * 3);
+    }
+}
+
+// 测试 3: 删除后探测链保持连续（与 unordered_map 对照随机增删）
+TEST(SessionTableTest, EraseMatchesReferenceMap)
+{
+    SessionTable table(16);
+    std::unordered_map<uint32_t, uint32_t> reference;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> convs(0, 300);
+    for (uint32_t step = 0; step < 20'000; ++step)
+    {
+        const uint32_t conv = convs(rng);
+        if (rng() % 3 == 0)
+        {
+            EXPECT_EQ(table.erase(conv), reference.erase(conv) == 1);
+        }
+        else
+        {
+            table.tryEmplace(conv).first->lastActiveMs = step;
+            reference[conv] = step;
+        }
+    }
+
+    ASSERT_EQ(table.size(), reference.size());
+    for (uint32_t conv = 0; conv <= 300; ++conv)
+    {
+        auto* entry = table.find(conv);
+        auto iter = reference.find(conv);
+        ASSERT_EQ(entry != nullptr, iter != reference.end()) << "conv " << conv;
+        if (entry != nullptr)
+        {
+            EXPECT_EQ(entry->lastActiveMs, iter->second);
+        }
+    }
+}
+
+// 测试 4: 遍历只访问有效条目，删除会释放会话
+TEST(SessionTableTest, IteratesOccupiedEntriesAndReleasesSessions)
+{
+    SessionTable table;
+    auto owner = std::make_shared<int>(0);
+    std::weak_ptr<int> watcher = owner;
+    for (uint32_t conv : {3U, 900U, 77U})
+    {
+        table.tryEmplace(conv);
+    }
+
+    std::set<uint32_t> seen;
+    for (const auto& entry : table)
+    {
+        seen.insert(entry.conv);
+    }
+    EXPECT_EQ(seen, (std::set<uint32_t>{3, 77, 900}));
+
+    // 用别名构造借用 shared_ptr 控制块，验证删除时会话指针被释放
+    table.find(77)->session = std::shared_ptr<KcpSession>(owner, nullptr);
+    owner.reset();
+    EXPECT_FALSE(watcher.expired());
+    EXPECT_TRUE(table.erase(77));
+    EXPECT_TRUE(watcher.expired());
+    EXPECT_FALSE(table.erase(77));
+    EXPECT_EQ(table.size(), 2U);
+}
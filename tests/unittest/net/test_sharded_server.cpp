@@ -0,0 +1,250 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_sharded_server.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief ShardedServer 回环回显单元测试（reuseport 分流 / 共享 socket 转发 / 停止时关闭会话）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/net/App/ShardedServer.h"
+#include "src/net/App/Client.h"
+#include "src/net/transport/AsioUdpTransport.h"
+#include <asio.hpp>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace
+{
+struct ShardRecorder
+{
+    std::mutex mutex;
+    std::map<uint32_t, std::thread::id> sessionThreads;
+};
+
+// 每个会话回显收到的数据，并记录会话回调所在的线程
+void echo(const std::shared_ptr<KcpSession>& session)
+{
+    session->recvAsync(
+        [session](std::expected<KcpSession::Packet, std::error_code> result)
+        {
+            if (!result)
+            {
+                return;
+            }
+            session->send(*result);
+            echo(session);
+        });
+}
+
+struct EchoRun
+{
+    size_t echoed = 0;
+    std::vector<uint32_t> convs; // 服务器分配的 conv
+};
+
+uint32_t steadyMs()
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+// 客户端侧：count 个会话各自握手，发一条消息并等待全部回显
+EchoRun runEchoClients(uint16_t port, size_t count)
+{
+    asio::io_context ioc;
+    AsioUdpTransport transport(ioc.get_executor(), 0);
+    Client client(transport, ioc.get_executor());
+    transport.startBatchRecvLoop([&](std::span<const UdpDatagram> batch) { client.input(batch); });
+
+    EchoRun run;
+    const NetAddress server("127.0.0.1", port);
+    for (size_t i = 0; i < count; ++i)
+    {
+        client.handshake(server,
+                         [&run](std::expected<std::shared_ptr<KcpSession>, std::error_code> result)
+                         {
+                             if (!result)
+                             {
+                                 return;
+                             }
+                             const auto& session = *result;
+                             const uint32_t conv = session->metrics().conv;
+                             run.convs.push_back(conv);
+                             std::vector<uint8_t> message(32, static_cast<uint8_t>(conv));
+                             session->send(message);
+                             session->recvAsync(
+                                 [&run, conv](std::expected<KcpSession::Packet, std::error_code> echoed)
+                                 {
+                                     if (echoed && echoed->size() == 32 &&
+                                         echoed->data()[0] == static_cast<uint8_t>(conv))
+                                     {
+                                         ++run.echoed;
+                                     }
+                                 });
+                         });
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (run.echoed < count && std::chrono::steady_clock::now() < deadline)
+    {
+        client.update(steadyMs());
+        ioc.run_for(std::chrono::milliseconds(5));
+        ioc.restart();
+    }
+    transport.stop();
+    return run;
+}
+
+std::unique_ptr<ShardedServer> makeServer(bool reusePort, ShardRecorder& recorder)
+{
+    ShardedServer::Options options;
+    options.shardCount = 3;
+    options.reusePort = reusePort;
+    return std::make_unique<ShardedServer>(options,
+                                           [&recorder](uint32_t conv, const std::shared_ptr<KcpSession>& session)
+                                           {
+                                               {
+                                                   std::lock_guard lock(recorder.mutex);
+                                                   recorder.sessionThreads[conv] = std::this_thread::get_id();
+                                               }
+                                               echo(session);
+                                           });
+}
+} // namespace
+
+// 测试 1: reuseport 模式下所有会话回显成功，同一分片的会话在同一线程
+TEST(ShardedServerTest, EchoesAcrossShardsWithReusePort)
+{
+    ShardRecorder recorder;
+    auto server = makeServer(true, recorder);
+    server->start();
+
+    const auto run = runEchoClients(server->localPort(), 6);
+    EXPECT_EQ(run.echoed, 6U);
+    server->stop();
+    const auto& convs = run.convs;
+
+    std::lock_guard lock(recorder.mutex);
+    ASSERT_EQ(recorder.sessionThreads.size(), convs.size());
+    for (uint32_t conv : convs)
+    {
+        for (uint32_t other : convs)
+        {
+            if (server->shardOf(conv) == server->shardOf(other))
+            {
+                EXPECT_EQ(recorder.sessionThreads[conv], recorder.sessionThreads[other]);
+            }
+            else
+            {
+                EXPECT_NE(recorder.sessionThreads[conv], recorder.sessionThreads[other]);
+            }
+        }
+    }
+}
+
+// 测试 2: 共享 socket 模式下由收包分片转发到所属分片
+TEST(ShardedServerTest, SharedSocketForwardsToOwningShard)
+{
+    ShardRecorder recorder;
+    auto server = makeServer(false, recorder);
+    server->start();
+
+    // conv 由服务器分配，会话数足够多时三个分片都会分到会话
+    const auto run = runEchoClients(server->localPort(), 32);
+    EXPECT_EQ(run.echoed, 32U);
+    server->stop();
+
+    EXPECT_FALSE(server->kernelSteering());
+    EXPECT_GT(server->forwardedPackets(), 0U);
+    std::lock_guard lock(recorder.mutex);
+    std::set<std::thread::id> threads;
+    for (const auto& [conv, thread] : recorder.sessionThreads)
+    {
+        threads.insert(thread);
+    }
+    EXPECT_EQ(threads.size(), 3U);
+}
+
+// 测试 3: 未握手的 conv 被丢弃；握手都落在分片 0，会话建在 conv 所属的分片上
+TEST(ShardedServerTest, HandshakeOpensSessionsOnOwningShard)
+{
+    ShardRecorder recorder;
+    auto server = makeServer(true, recorder);
+    server->start();
+
+    {
+        asio::io_context ioc;
+        AsioUdpTransport transport(ioc.get_executor(), 0);
+        Client client(transport, ioc.get_executor());
+        auto session = client.connect(7, NetAddress("127.0.0.1", server->localPort()));
+        std::vector<uint8_t> message(32, 7);
+        session->send(message);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+        while (server->metrics().packetsRejected == 0 && std::chrono::steady_clock::now() < deadline)
+        {
+            client.update(steadyMs());
+            ioc.run_for(std::chrono::milliseconds(5));
+            ioc.restart();
+        }
+    }
+    EXPECT_GT(server->metrics().packetsRejected, 0U);
+    EXPECT_EQ(server->metrics().sessionsOpened, 0U);
+
+    const auto run = runEchoClients(server->localPort(), 12);
+    EXPECT_EQ(run.echoed, 12U);
+    std::vector<uint64_t> expected(server->shardCount());
+    for (uint32_t conv : run.convs)
+    {
+        ++expected[server->shardOf(conv)];
+    }
+    for (size_t shard = 0; shard < server->shardCount(); ++shard)
+    {
+        EXPECT_EQ(server->shardMetrics(shard).activeSessions, expected[shard]) << "shard " << shard;
+    }
+    server->stop();
+}
+
+// 测试 4: stop 先关闭各分片的会话，阻塞在 recv() 的业务协程在分片线程退出前结束
+TEST(ShardedServerTest, StopClosesSessionsBlockedInRecv)
+{
+    std::atomic<size_t> started{0};
+    std::atomic<size_t> finished{0};
+    ShardedServer::Options options;
+    options.shardCount = 3;
+    ShardedServer server(options,
+                         [&](uint32_t, const std::shared_ptr<KcpSession>& session)
+                         {
+                             ++started;
+                             asio::co_spawn(
+                                 session->executor(),
+                                 [session, &finished]() -> asio::awaitable<void>
+                                 {
+                                     while (auto packet = co_await session->recv())
+                                     {
+                                         session->send(*packet);
+                                     }
+                                     ++finished;
+                                 },
+                                 asio::detached);
+                         });
+    server.start();
+
+    const auto run = runEchoClients(server.localPort(), 6);
+    EXPECT_EQ(run.echoed, 6U);
+    EXPECT_EQ(finished.load(), 0U); // 回显之后各协程都停在下一次 recv()
+
+    server.stop();
+    EXPECT_EQ(started.load(), 6U);
+    EXPECT_EQ(finished.load(), 6U);
+    EXPECT_EQ(server.metrics().activeSessions, 0U);
+}
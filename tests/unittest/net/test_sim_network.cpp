@@ -0,0 +1,226 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_sim_network.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief 模拟网络单元测试（时延 / 丢包 / 带宽、可复现性、KCP 在丢包链路上的端到端收发）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/net/App/Client.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include "src/net/transport/SimulatedUdpTransport.h"
+#include <asio.hpp>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+struct Arrival
+{
+    uint64_t atUs;
+    uint32_t index;
+
+    bool operator==(const Arrival&) const = default;
+};
+
+// 以 index 作为载荷发出 count 个数据报，返回按到达顺序排列的 (时间, index)
+std::vector<Arrival> sendAndCollect(SimulatedNetwork& network,
+                                    const LinkConditions& conditions,
+                                    uint32_t count,
+                                    uint64_t untilUs)
+{
+    auto sender = network.createTransport();
+    auto receiver = network.createTransport();
+    sender->setConditions(conditions);
+
+    std::vector<Arrival> arrivals;
+    receiver->setRecvHandler(
+        [&](std::span<const UdpDatagram> batch)
+        {
+            for (const auto& datagram : batch)
+            {
+                uint32_t index = 0;
+                std::memcpy(&index, datagram.payload.data(), sizeof(index));
+                arrivals.push_back({network.nowUs(), index});
+            }
+        });
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        sender->send(receiver->localAddress(),
+                     std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&i), sizeof(i)));
+    }
+    network.advanceTo(untilUs);
+    return arrivals;
+}
+
+// 会话运行在 io_context 上的回显端点
+class EchoEndpoint : public KcpEndpoint
+{
+public:
+    EchoEndpoint(IUdpTransport& transport, asio::io_context& ioc) : KcpEndpoint(transport), m_ioc(ioc) {}
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+    void onSession(uint32_t, std::shared_ptr<KcpSession> session) override
+    {
+        asio::co_spawn(
+            m_ioc,
+            [session]() -> asio::awaitable<void>
+            {
+                while (auto packet = co_await session->recv())
+                {
+                    session->send(*packet);
+                }
+            },
+            asio::detached);
+    }
+
+private:
+    asio::io_context& m_ioc;
+};
+} // namespace
+
+// 测试 1: 固定时延 + 抖动决定到达时间窗口，丢包率近似符合配置
+TEST(SimNetworkTest, LatencyJitterAndLoss)
+{
+    SimulatedNetwork network;
+    const LinkConditions link{.latencyMs = 30, .jitterMs = 10, .lossRate = 0.1};
+
+    const auto arrivals = sendAndCollect(network, link, 1000, 40'000);
+    for (const auto& arrival : arrivals)
+    {
+        EXPECT_GE(arrival.atUs, 30'000U);
+        EXPECT_LE(arrival.atUs, 40'000U);
+    }
+
+    const auto stats = network.stats();
+    EXPECT_EQ(stats.sent, 1000U);
+    EXPECT_EQ(stats.delivered, arrivals.size());
+    EXPECT_EQ(stats.delivered + stats.lost, 1000U);
+    EXPECT_GT(stats.lost, 60U);
+    EXPECT_LT(stats.lost, 140U);
+    EXPECT_EQ(network.inFlight(), 0U);
+    EXPECT_EQ(network.nowMs(), 40U);
+}
+
+// 测试 2: 同一种子的到达序列完全一致，乱序确实发生
+TEST(SimNetworkTest, SameSeedReproducesTrace)
+{
+    const LinkConditions link{.latencyMs = 20, .jitterMs = 5, .reorderRate = 0.2, .reorderDelayMs = 15};
+    auto run = [&](uint64_t seed)
+    {
+        SimulatedNetwork network({}, seed);
+        return sendAndCollect(network, link, 500, 100'000);
+    };
+
+    const auto first = run(42);
+    ASSERT_EQ(first.size(), 500U);
+    EXPECT_EQ(first, run(42));
+    EXPECT_NE(first, run(43));
+
+    size_t outOfOrder = 0;
+    for (size_t i = 1; i < first.size(); ++i)
+    {
+        EXPECT_GE(first[i].atUs, first[i - 1].atUs);
+        outOfOrder += first[i].index < first[i - 1].index ? 1 : 0;
+    }
+    EXPECT_GT(outOfOrder, 0U);
+}
+
+// 测试 3: 带宽上限串行化发送，排队超过上限的数据报被丢弃
+TEST(SimNetworkTest, BandwidthSerializesAndQueueLimitDrops)
+{
+    SimulatedNetwork network;
+    auto sender = network.createTransport();
+    auto receiver = network.createTransport(NetAddress("192.168.0.1", 9000));
+    ASSERT_NE(receiver, nullptr);
+    EXPECT_EQ(network.createTransport(NetAddress("192.168.0.1", 9000)), nullptr);
+
+    // 100 KB/s：1000 字节需要 10 ms；队列最多容纳 3000 字节
+    sender->setConditions({.bandwidthBytesPerSec = 100'000, .queueLimitBytes = 3'000});
+    std::vector<uint64_t> arrivals;
+    receiver->setRecvHandler([&](std::span<const UdpDatagram>) { arrivals.push_back(network.nowUs()); });
+
+    const std::vector<uint8_t> payload(1000);
+    for (int i = 0; i < 5; ++i)
+    {
+        sender->send(receiver->localAddress(), payload);
+    }
+    network.advanceTo(1'000'000);
+
+    EXPECT_EQ(arrivals, (std::vector<uint64_t>{10'000, 20'000, 30'000}));
+    EXPECT_EQ(network.stats().queueDropped, 2U);
+
+    // 目标地址无人监听
+    sender->setConditions({});
+    sender->send(NetAddress("192.168.0.2", 9000), payload);
+    network.advanceTo(1'000'001);
+    EXPECT_EQ(network.stats().unroutable, 1U);
+}
+
+// 测试 4: Client 与回显端点在丢包、抖动链路上收发，消息完整且有序
+TEST(SimNetworkTest, KcpEchoOverLossyLink)
+{
+    asio::io_context ioc;
+    SimulatedNetwork network({.latencyMs = 20, .jitterMs = 5, .lossRate = 0.1}, 7);
+    auto serverWire = network.createTransport();
+    auto clientWire = network.createTransport();
+    EchoEndpoint server(*serverWire, ioc);
+    Client client(*clientWire, ioc.get_executor());
+    serverWire->setRecvHandler([&server](std::span<const UdpDatagram> batch) { server.input(batch); });
+    clientWire->setRecvHandler([&client](std::span<const UdpDatagram> batch) { client.input(batch); });
+
+    constexpr uint32_t MESSAGES = 200;
+    auto session = client.connect(1, serverWire->localAddress());
+    std::vector<uint32_t> echoed;
+    asio::co_spawn(
+        ioc,
+        [&]() -> asio::awaitable<void>
+        {
+            while (auto packet = co_await session->recv())
+            {
+                uint32_t value = 0;
+                std::memcpy(&value, packet->data(), sizeof(value));
+                echoed.push_back(value);
+            }
+        },
+        asio::detached);
+
+    for (uint32_t nowMs = 0; nowMs < 5'000 && echoed.size() < MESSAGES; ++nowMs)
+    {
+        if (nowMs < MESSAGES)
+        {
+            session->send(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&nowMs), sizeof(nowMs)));
+        }
+        network.advanceTo(uint64_t{nowMs} * 1'000);
+        server.update(nowMs);
+        client.update(nowMs);
+        ioc.poll();
+    }
+
+    ASSERT_EQ(echoed.size(), MESSAGES);
+    for (uint32_t i = 0; i < MESSAGES; ++i)
+    {
+        EXPECT_EQ(echoed[i], i);
+    }
+    EXPECT_GT(network.stats().lost, 0U);
+    EXPECT_GT(session->metrics().retransmits, 0U);
+
+    session->close();
+    ioc.poll();
+}
@@ -0,0 +1,161 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_static_dispatcher.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief StaticMessageDispatcher 单元测试（按类型分发、跳转表分页、未知命令与解析失败、写入调用方缓冲）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/StaticMessageDispatcher.h"
+#include "src/shared/messages/request/CreateRoomRequest.h"
+#include "src/shared/messages/request/SendMessageRequest.h"
+#include "src/shared/messages/response/SettlementResponse.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+using TestMessages = MessageList<CreateRoomRequest, SendMessageRequest, SettlementResponse>;
+
+// 返回值模式：记录收到的消息，回显其 CMD_ID
+struct RecordingHandlers
+{
+    std::vector<std::string> seen;
+
+    std::expected<uint16_t, MessageError> operator()(const CreateRoomRequest& req)
+    {
+        seen.push_back("create:" + req.roomName);
+        return CreateRoomRequest::CMD_ID;
+    }
+
+    std::expected<uint16_t, MessageError> operator()(const SendMessageRequest& req)
+    {
+        seen.push_back("chat:" + req.content);
+        return SendMessageRequest::CMD_ID;
+    }
+
+    std::expected<uint16_t, MessageError> operator()(const SettlementResponse& resp)
+    {
+        seen.push_back("settle:" + resp.message);
+        return SettlementResponse::CMD_ID;
+    }
+};
+
+// 写入模式：响应直接编码到调用方的 writer
+struct EncodingHandlers
+{
+    auto operator()(const CreateRoomRequest& req, shared::PacketWriter& out)
+    {
+        return encodeMessage(CreateRoomResponse::createSuccess(req.maxPlayers), out);
+    }
+
+    auto operator()(const SendMessageRequest& req, shared::PacketWriter& out)
+    {
+        SendMessageToChatResponse resp;
+        resp.sender = req.channelId;
+        resp.chatMessage = req.content;
+        return encodeMessage(resp, out);
+    }
+
+    std::expected<std::span<const uint8_t>, MessageError> operator()(const SettlementResponse&, shared::PacketWriter&)
+    {
+        return std::unexpected(MessageError::SerializeFailed);
+    }
+};
+
+template <typename Message>
+std::vector<uint8_t> payloadOf(const Message& message)
+{
+    return message.serialize();
+}
+
+CreateRoomRequest makeCreate(std::string name, uint8_t maxPlayers)
+{
+    CreateRoomRequest request;
+    request.roomName = std::move(name);
+    request.maxPlayers = maxPlayers;
+    return request;
+}
+} // namespace
+
+// 测试 1: 跳转表只为出现的命令段分页，hasHandler 在编译期可用
+TEST(StaticDispatcherTest, BuildsOnePagePerCommandRange)
+{
+    using Dispatcher = StaticMessageDispatcher<TestMessages, RecordingHandlers>;
+    static_assert(Dispatcher::pageCount() == 3); // 0x11xx、0x13xx、0x22xx
+    static_assert(Dispatcher::hasHandler(CommandID::CREATE_ROOM_REQ));
+    static_assert(!Dispatcher::hasHandler(CommandID::JOIN_ROOM)); // 同一段中未列出的命令
+    static_assert(StaticMessageDispatcher<MessageList<CreateRoomRequest>, RecordingHandlers>::pageCount() == 1);
+    EXPECT_FALSE(Dispatcher::hasHandler(CommandID::USE_CARD_REQ));
+}
+
+// 测试 2: 每个命令调用对应类型的处理器重载
+TEST(StaticDispatcherTest, DispatchesToTypedOverload)
+{
+    StaticMessageDispatcher<TestMessages, RecordingHandlers> dispatcher;
+
+    SendMessageRequest chat;
+    chat.content = "hi";
+    SettlementResponse settlement{};
+    settlement.message = "done";
+
+    EXPECT_EQ(dispatcher.dispatch(CommandID::CREATE_ROOM_REQ, payloadOf(makeCreate("tavern", 4))).value(),
+              CommandID::CREATE_ROOM_REQ);
+    EXPECT_EQ(dispatcher.dispatch(CommandID::SEND_MESSAGE_REQ, payloadOf(chat)).value(), CommandID::SEND_MESSAGE_REQ);
+    EXPECT_EQ(dispatcher.dispatch(CommandID::SETTLEMENT_RESP, payloadOf(settlement)).value(),
+              CommandID::SETTLEMENT_RESP);
+    EXPECT_EQ(dispatcher.handler().seen, (std::vector<std::string>{"create:tavern", "chat:hi", "settle:done"}));
+}
+
+// 测试 3: 未列出的命令（含未使用的段与已使用段中的空位）和无法解析的载荷返回 InvalidFormat，不调用处理器
+TEST(StaticDispatcherTest, RejectsUnknownCommandsAndBadPayloads)
+{
+    StaticMessageDispatcher<TestMessages, RecordingHandlers> dispatcher;
+    const auto payload = payloadOf(makeCreate("tavern", 4));
+
+    for (uint16_t cmd : {uint16_t{0}, CommandID::JOIN_ROOM, CommandID::USE_CARD_REQ, uint16_t{0xFFFF}})
+    {
+        auto result = dispatcher.dispatch(cmd, payload);
+        ASSERT_FALSE(result.has_value()) << cmd;
+        EXPECT_EQ(result.error(), MessageError::InvalidFormat);
+    }
+
+    auto truncated = dispatcher.dispatch(CommandID::CREATE_ROOM_REQ, std::span(payload).first(3));
+    ASSERT_FALSE(truncated.has_value());
+    EXPECT_EQ(truncated.error(), MessageError::InvalidFormat);
+    EXPECT_TRUE(dispatcher.handler().seen.empty());
+}
+
+// 测试 4: 写入模式的响应直接编码在调用方的 writer 中，与 MessageDispatcher 的结果一致
+TEST(StaticDispatcherTest, EncodesResponseIntoCallerBuffer)
+{
+    StaticMessageDispatcher<TestMessages, EncodingHandlers> dispatcher;
+    shared::PacketWriter writer;
+
+    auto frame = dispatcher.dispatch(CommandID::CREATE_ROOM_REQ, payloadOf(makeCreate("tavern", 6)), writer);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->data(), writer.buffer.data());
+    auto response = decodeMessage<CreateRoomResponse>(*frame);
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ(response->roomId, 6U);
+
+    MessageDispatcher dynamic;
+    dynamic.registerHandler<CreateRoomRequest>(
+        [](const CreateRoomRequest& req) -> std::expected<std::vector<uint8_t>, MessageError>
+        { return encodeMessage(CreateRoomResponse::createSuccess(req.maxPlayers)); });
+    auto expected = dynamic.dispatch(CommandID::CREATE_ROOM_REQ, payloadOf(makeCreate("tavern", 6)));
+    ASSERT_TRUE(expected.has_value());
+    EXPECT_TRUE(std::ranges::equal(*frame, *expected));
+
+    auto failed = dispatcher.dispatch(CommandID::SETTLEMENT_RESP, payloadOf(SettlementResponse{}), writer);
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_EQ(failed.error(), MessageError::SerializeFailed);
+}
@@ -0,0 +1,252 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_timer_wheel.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief TimerWheel 及基于时间轮的 KcpEndpoint 调度单元测试
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/net/common/TimerWheel.h"
+#include "src/net/App/KcpEndpoint.h"
+#include "src/net/App/PeekConv.h"
+#include <asio.hpp>
+#include <vector>
+
+namespace
+{
+struct Fired
+{
+    int id;
+    uint32_t at;
+};
+
+// 逐毫秒推进，记录每个定时器实际触发的时间
+std::vector<Fired> runTicks(TimerWheel<int>& wheel, uint32_t until)
+{
+    std::vector<Fired> fired;
+    while (wheel.now() != until)
+    {
+        const uint32_t next = wheel.now() + 1;
+        wheel.advance(next, [&](int id) { fired.push_back({id, next}); });
+    }
+    return fired;
+}
+} // namespace
+
+// 测试 1: 各层的定时器都在准确的时间点触发
+TEST(TimerWheelTest, FiresAtExactTimeAcrossLevels)
+{
+    TimerWheel<int> wheel(1000);
+    const std::vector<uint32_t> delays = {1, 5, 255, 256, 300, 65535, 65536, 70000, 200000};
+    for (size_t i = 0; i < delays.size(); ++i)
+    {
+        wheel.schedule(1000 + delays[i], static_cast<int>(i));
+    }
+
+    const auto fired = runTicks(wheel, 1000 + 200000);
+    ASSERT_EQ(fired.size(), delays.size());
+    for (const auto& entry : fired)
+    {
+        EXPECT_EQ(entry.at, 1000 + delays[entry.id]) << "timer " << entry.id;
+    }
+    EXPECT_TRUE(wheel.empty());
+}
+
+// 测试 2: 一次推进较长时间时到期定时器全部触发，未到期的保留
+TEST(TimerWheelTest, LargeAdvanceFiresOnlyDueTimers)
+{
+    TimerWheel<int> wheel(0);
+    wheel.schedule(10, 1);
+    wheel.schedule(5'000'000, 2);
+    wheel.schedule(30'000'000, 3);
+
+    std::vector<int> fired;
+    wheel.advance(20'000'000, [&](int id) { fired.push_back(id); });
+    EXPECT_EQ(fired, (std::vector<int>{1, 2}));
+    EXPECT_EQ(wheel.size(), 1U);
+
+    wheel.advance(30'000'000, [&](int id) { fired.push_back(id); });
+    EXPECT_EQ(fired, (std::vector<int>{1, 2, 3}));
+}
+
+// 测试 3: 取消与改期
+TEST(TimerWheelTest, CancelAndReschedule)
+{
+    TimerWheel<int> wheel(0);
+    auto cancelled = wheel.schedule(50, 1);
+    auto moved = wheel.schedule(100, 2);
+    wheel.cancel(cancelled);
+    wheel.reschedule(moved, 20);
+
+    const auto fired = runTicks(wheel, 200);
+    ASSERT_EQ(fired.size(), 1U);
+    EXPECT_EQ(fired[0].id, 2);
+    EXPECT_EQ(fired[0].at, 20U);
+}
+
+// 测试 4: 32 位时间回绕
+TEST(TimerWheelTest, HandlesClockWrapAround)
+{
+    const uint32_t start = UINT32_MAX - 100;
+    TimerWheel<int> wheel(start);
+    wheel.schedule(start + 50, 1);
+    wheel.schedule(start + 300, 2); // 回绕后 = 199
+
+    std::vector<int> fired;
+    wheel.advance(start + 50, [&](int id) { fired.push_back(id); });
+    EXPECT_EQ(fired, (std::vector<int>{1}));
+    wheel.advance(199, [&](int id) { fired.push_back(id); });
+    EXPECT_EQ(fired, (std::vector<int>{1, 2}));
+}
+
+// 测试 5: 回调内重新调度（包括已过期的时间）不会在同一 tick 重入
+TEST(TimerWheelTest, RescheduleFromCallbackFiresNextTick)
+{
+    TimerWheel<int> wheel(0);
+    wheel.schedule(1, 0);
+    int count = 0;
+    for (uint32_t now = 1; now <= 5; ++now)
+    {
+        wheel.advance(now,
+                      [&](int id)
+                      {
+                          ++count;
+                          wheel.schedule(0, id); // 过期时间被推迟到下一个 tick
+                      });
+    }
+    EXPECT_EQ(count, 5);
+    EXPECT_EQ(wheel.size(), 1U);
+}
+
+// 测试 6: 时间倒退时不触发任何定时器，之后按原时间继续推进
+TEST(TimerWheelTest, IgnoresBackwardAdvance)
+{
+    const uint32_t start = UINT32_MAX - 10; // 倒退的判断同样适用于回绕前后
+    TimerWheel<int> wheel(start);
+    wheel.schedule(start + 5, 1);
+    wheel.schedule(start + 5'000, 2);
+
+    std::vector<int> fired;
+    wheel.advance(start - 1, [&](int id) { fired.push_back(id); });
+    EXPECT_TRUE(fired.empty());
+    EXPECT_EQ(wheel.now(), start);
+    EXPECT_EQ(wheel.size(), 2U);
+
+    wheel.advance(start + 5, [&](int id) { fired.push_back(id); });
+    EXPECT_EQ(fired, (std::vector<int>{1}));
+    wheel.advance(start + 4, [&](int id) { fired.push_back(id); });
+    EXPECT_EQ(fired, (std::vector<int>{1}));
+    EXPECT_EQ(wheel.size(), 1U);
+}
+
+namespace
+{
+class TestEndpoint : public KcpEndpoint
+{
+public:
+    TestEndpoint(IUdpTransport& transport, asio::io_context& ioc) : KcpEndpoint(transport), m_ioc(ioc) {}
+
+    using KcpEndpoint::m_sessions;
+    using KcpEndpoint::nowMs;
+    size_t closed = 0;
+
+protected:
+    std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override
+    {
+        return std::make_shared<KcpSession>(conv, m_transport, peer, m_ioc.get_executor(), m_packetPool);
+    }
+
+    uint32_t selectConv(const NetAddress&, std::span<const uint8_t> data) override { return peekConv(data); }
+
+    void onSessionClosed(uint32_t) override { ++closed; }
+
+private:
+    asio::io_context& m_ioc;
+};
+} // namespace
+
+// 测试 7: 收到数据的会话在下一个 tick 回复 ACK，空闲会话在超时后被清理
+TEST(TimerWheelTest, EndpointAcksInputAndExpiresIdleSessions)
+{
+    asio::io_context ioc;
+    MockUdpTransport peerWire;
+    MockUdpTransport serverWire;
+    const NetAddress address("127.0.0.1", 9000);
+
+    KcpSession peer(42, peerWire, address, ioc.get_executor());
+    TestEndpoint endpoint(serverWire, ioc);
+
+    const std::vector<uint8_t> payload(64, 0x33);
+    peer.send(payload);
+    peer.update(0);
+
+    uint32_t now = 1'000;
+    endpoint.update(now, std::chrono::seconds(1));
+    for (const auto& packet : peerWire.getPackets())
+    {
+        endpoint.input(packet.to, packet.data);
+    }
+    ASSERT_EQ(endpoint.m_sessions.size(), 1U);
+
+    endpoint.update(++now, std::chrono::seconds(1));
+    EXPECT_GT(serverWire.getSendCount(), 0U); // ACK 已发出
+
+    // 静默期间不再产生输出
+    serverWire.clearPackets();
+    for (int i = 0; i < 50; ++i)
+    {
+        now += 10;
+        endpoint.update(now, std::chrono::seconds(1));
+    }
+    EXPECT_EQ(serverWire.getSendCount(), 0U);
+    EXPECT_EQ(endpoint.m_sessions.size(), 1U);
+
+    now += 1'000;
+    endpoint.update(now, std::chrono::seconds(1));
+    EXPECT_EQ(endpoint.m_sessions.size(), 0U);
+    EXPECT_EQ(endpoint.closed, 1U);
+}
+
+// 测试 8: Endpoint 的时钟倒退时停在上一次的时间，会话既不被误判超时也不被提前调度
+TEST(TimerWheelTest, EndpointClampsBackwardClock)
+{
+    asio::io_context ioc;
+    MockUdpTransport peerWire;
+    MockUdpTransport serverWire;
+    const NetAddress address("127.0.0.1", 9000);
+
+    KcpSession peer(42, peerWire, address, ioc.get_executor());
+    TestEndpoint endpoint(serverWire, ioc);
+
+    const std::vector<uint8_t> payload(64, 0x33);
+    peer.send(payload);
+    peer.update(0);
+
+    endpoint.update(10'000, std::chrono::seconds(1));
+    for (const auto& packet : peerWire.getPackets())
+    {
+        endpoint.input(packet.to, packet.data);
+    }
+    endpoint.update(10'001, std::chrono::seconds(1));
+    ASSERT_EQ(endpoint.m_sessions.size(), 1U);
+
+    endpoint.update(9'000, std::chrono::seconds(1));
+    EXPECT_EQ(endpoint.nowMs(), 10'001U);
+    EXPECT_EQ(endpoint.m_sessions.size(), 1U);
+    EXPECT_EQ(endpoint.closed, 0U);
+
+    // 时钟恢复后按正常时间超时
+    endpoint.update(10'500, std::chrono::seconds(1));
+    EXPECT_EQ(endpoint.m_sessions.size(), 1U);
+    endpoint.update(11'100, std::chrono::seconds(1));
+    EXPECT_EQ(endpoint.m_sessions.size(), 0U);
+    EXPECT_EQ(endpoint.closed, 1U);
+}
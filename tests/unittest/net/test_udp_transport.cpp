@@ -0,0 +1,192 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_udp_transport.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-15
+ * @version 0.1
+ * @brief AsioUdpTransport 回环收发单元测试（批量接收 / 发送队列 / 单个目标失败）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/net/transport/AsioUdpTransport.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+class UdpTransportTest : public ::testing::Test
+{
+protected:
+    asio::io_context m_ioc;
+
+    // 驱动 io_context 直到条件满足或超时
+    template <typename Pred>
+    bool runUntil(Pred&& pred, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000))
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!pred() && std::chrono::steady_clock::now() < deadline)
+        {
+            m_ioc.run_for(std::chrono::milliseconds(5));
+            m_ioc.restart();
+        }
+        return pred();
+    }
+};
+
+// 测试 1: 批量接收能收到所有数据报且载荷完整
+TEST_F(UdpTransportTest, BatchRecvDeliversAllDatagrams)
+{
+    AsioUdpTransport receiver(m_ioc.get_executor(), 0);
+    AsioUdpTransport sender(m_ioc.get_executor(), 0);
+
+    std::vector<uint8_t> firstBytes;
+    receiver.startBatchRecvLoop(
+        [&](std::span<const UdpDatagram> batch)
+        {
+            for (const auto& datagram : batch)
+            {
+                ASSERT_EQ(datagram.payload.size(), 16U);
+                EXPECT_EQ(datagram.from.port(), sender.localPort());
+                firstBytes.push_back(datagram.payload[0]);
+            }
+        },
+        8);
+
+    const NetAddress target("127.0.0.1", receiver.localPort());
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+        std::vector<uint8_t> payload(16, i);
+        sender.send(target, payload);
+    }
+
+    ASSERT_TRUE(runUntil([&] { return firstBytes.size() == 20; }));
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(firstBytes[i], i);
+    }
+    receiver.stop();
+}
+
+// 测试 2: 发送队列在 flush 前不发送，flush 后整批发出并记录统计
+TEST_F(UdpTransportTest, BatchedSendFlushesQueue)
+{
+    AsioUdpTransport receiver(m_ioc.get_executor(), 0);
+    AsioUdpTransport sender(m_ioc.get_executor(), 0);
+
+    size_t received = 0;
+    receiver.startRecvLoop([&](const NetAddress&, std::span<const uint8_t>) { ++received; });
+
+    const NetAddress target("127.0.0.1", receiver.localPort());
+    sender.beginBatch();
+    for (int i = 0; i < 10; ++i)
+    {
+        std::vector<uint8_t> payload(100, static_cast<uint8_t>(i));
+        sender.send(target, payload);
+    }
+
+    m_ioc.run_for(std::chrono::milliseconds(20));
+    m_ioc.restart();
+    EXPECT_EQ(received, 0U);
+
+    sender.flush();
+    ASSERT_TRUE(runUntil([&] { return received == 10; }));
+
+    const auto stats = sender.sendStats();
+    EXPECT_EQ(stats.flushes, 1U);
+    EXPECT_EQ(stats.datagrams, 10U);
+    EXPECT_GE(stats.syscalls, 1U);
+    EXPECT_LE(stats.syscalls, stats.datagrams);
+    EXPECT_EQ(stats.syscallsSaved(), stats.datagrams - stats.syscalls);
+    receiver.stop();
+}
+
+// 测试 3: flush 之后恢复立即发送
+TEST_F(UdpTransportTest, SendIsImmediateOutsideBatch)
+{
+    AsioUdpTransport receiver(m_ioc.get_executor(), 0);
+    AsioUdpTransport sender(m_ioc.get_executor(), 0);
+
+    size_t received = 0;
+    receiver.startRecvLoop([&](const NetAddress&, std::span<const uint8_t>) { ++received; });
+
+    sender.beginBatch();
+    sender.flush();
+
+    std::vector<uint8_t> payload(32, 0x5A);
+    sender.send(NetAddress("127.0.0.1", receiver.localPort()), payload);
+    ASSERT_TRUE(runUntil([&] { return received == 1; }));
+    EXPECT_EQ(sender.sendStats().flushes, 0U);
+    receiver.stop();
+}
+
+// 测试 4: 按 conv 分流时，4 字节以上的数据报按 conv 取模选 socket，不足 4 字节的由内核按四元组哈希分散
+TEST_F(UdpTransportTest, ConvSteeringFallsBackToHashForShortDatagrams)
+{
+    AsioUdpTransport first(m_ioc.get_executor(), 0, true);
+    AsioUdpTransport second(m_ioc.get_executor(), first.localPort(), true);
+    if (!first.steerByConv(2))
+    {
+        GTEST_SKIP() << "平台不支持 SO_ATTACH_REUSEPORT_CBPF";
+    }
+
+    std::array<std::vector<size_t>, 2> sizes;
+    first.startRecvLoop([&](const NetAddress&, std::span<const uint8_t> data) { sizes[0].push_back(data.size()); });
+    second.startRecvLoop([&](const NetAddress&, std::span<const uint8_t> data) { sizes[1].push_back(data.size()); });
+
+    const NetAddress target("127.0.0.1", first.localPort());
+    std::vector<std::unique_ptr<AsioUdpTransport>> senders;
+    constexpr size_t SENDERS = 32;
+    for (size_t i = 0; i < SENDERS; ++i)
+    {
+        senders.push_back(std::make_unique<AsioUdpTransport>(m_ioc.get_executor(), 0));
+        const std::array<uint8_t, 4> conv{static_cast<uint8_t>(i % 2), 0, 0, 0};
+        const std::array<uint8_t, 2> shortPayload{0xAB, 0xCD};
+        senders.back()->send(target, conv);
+        senders.back()->send(target, shortPayload);
+    }
+
+    ASSERT_TRUE(runUntil([&] { return sizes[0].size() + sizes[1].size() == SENDERS * 2; }));
+    for (const auto& received : sizes)
+    {
+        // 每个 socket 恰好收到一半的 conv 报文，且至少收到一个短报文（全部落到同一 socket 的概率为 2^-31）
+        EXPECT_EQ(std::ranges::count(received, 4U), static_cast<std::ptrdiff_t>(SENDERS / 2));
+        EXPECT_GE(std::ranges::count(received, 2U), 1);
+    }
+    first.stop();
+    second.stop();
+}
+
+// 测试 5: 批次中间某个目标发送失败时只丢弃发往该目标的数据报，其后的数据报照常发出
+TEST_F(UdpTransportTest, BatchedSendSkipsFailingDestination)
+{
+    AsioUdpTransport receiver(m_ioc.get_executor(), 0);
+    AsioUdpTransport sender(m_ioc.get_executor(), 0);
+
+    std::vector<uint8_t> firstBytes;
+    receiver.startRecvLoop([&](const NetAddress&, std::span<const uint8_t> data) { firstBytes.push_back(data[0]); });
+
+    // 未开启 SO_BROADCAST 时发往广播地址会被内核以 EACCES 拒绝
+    const NetAddress unroutable("255.255.255.255", receiver.localPort());
+    const NetAddress target("127.0.0.1", receiver.localPort());
+    sender.beginBatch();
+    for (uint8_t i = 0; i < 10; ++i)
+    {
+        std::vector<uint8_t> payload(64, i);
+        sender.send(i == 4 ? unroutable : target, payload);
+    }
+    sender.flush();
+
+    ASSERT_TRUE(runUntil([&] { return firstBytes.size() == 9; }));
+    EXPECT_EQ(firstBytes, (std::vector<uint8_t>{0, 1, 2, 3, 5, 6, 7, 8, 9}));
+
+    const auto stats = sender.sendStats();
+    EXPECT_EQ(stats.datagrams, 10U);
+    EXPECT_EQ(stats.dropped, 1U);
+    receiver.stop();
+}
@@ -0,0 +1,238 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_unreliable_channel.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 不可靠有序通道单元测试（数据报头、序号比较、旧包丢弃、不受可靠流队头阻塞、错误处理）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "MockUdpTransport.h"
+#include "src/net/protocol/HandshakePacket.h"
+#include "src/net/protocol/UnreliableHeader.h"
+#include "src/net/Session/KcpSession.h"
+#include <asio.hpp>
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr uint16_t CMD_CURSOR = 0x3001;
+
+std::vector<uint8_t> bytesOf(std::string_view text)
+{
+    return {text.begin(), text.end()};
+}
+
+struct Link
+{
+    asio::io_context ioc;
+    MockUdpTransport senderWire;
+    MockUdpTransport receiverWire;
+    std::shared_ptr<KcpSession> sender;
+    std::shared_ptr<KcpSession> receiver;
+
+    Link()
+    {
+        const NetAddress address("127.0.0.1", 9000);
+        sender = std::make_shared<KcpSession>(5, senderWire, address, ioc.get_executor());
+        receiver = std::make_shared<KcpSession>(5, receiverWire, address, ioc.get_executor());
+    }
+
+    // 取走发送方发出的数据报
+    std::vector<std::vector<uint8_t>> take()
+    {
+        std::vector<std::vector<uint8_t>> datagrams;
+        for (auto& packet : senderWire.getPackets())
+        {
+            datagrams.push_back(std::move(packet.data));
+        }
+        senderWire.clearPackets();
+        return datagrams;
+    }
+
+    // 取出接收方已交付的全部消息
+    std::vector<std::vector<uint8_t>> received()
+    {
+        std::vector<std::vector<uint8_t>> messages;
+        const size_t pending = receiver->metrics().channelOccupancy;
+        for (size_t i = 0; i < pending; ++i)
+        {
+            receiver->recvAsync(
+                [&messages](std::expected<KcpSession::Packet, std::error_code> result)
+                {
+                    if (result)
+                    {
+                        messages.emplace_back(result->begin(), result->end());
+                    }
+                });
+        }
+        ioc.poll();
+        ioc.restart();
+        return messages;
+    }
+};
+
+uint16_t cmdOf(const std::vector<uint8_t>& message)
+{
+    auto frame = decodeFrame(message);
+    return frame ? frame->cmd : 0;
+}
+} // namespace
+
+// 测试 1: marker 与 KCP 段、握手报文在同一字节位置上互不冲突
+TEST(UnreliableChannelTest, MarkerIsDistinctFromKcpAndHandshake)
+{
+    Link link;
+    link.sender->send(bytesOf("reliable"));
+    link.sender->update(1'000);
+    const auto kcpDatagrams = link.take();
+    ASSERT_FALSE(kcpDatagrams.empty());
+    EXPECT_FALSE(isUnreliableDatagram(kcpDatagrams.front()));
+
+    const HandshakePacket hello{.type = HandshakeType::Hello};
+    EXPECT_FALSE(isUnreliableDatagram(handshakeBytes(hello)));
+
+    std::vector<uint8_t> datagram(UNRELIABLE_HEADER_SIZE);
+    UnreliableHeader header{.conv = 5, .channel = UNRELIABLE_CHANNELS, .sequence = 1};
+    std::memcpy(datagram.data(), &header, UNRELIABLE_HEADER_SIZE);
+    EXPECT_TRUE(isUnreliableDatagram(datagram));
+    EXPECT_FALSE(parseUnreliableHeader(datagram).has_value()); // 通道越界
+    EXPECT_FALSE(parseUnreliableHeader(std::span(datagram).first(UNRELIABLE_HEADER_SIZE - 1)).has_value());
+
+    EXPECT_TRUE(isNewerSequence(1, 0));
+    EXPECT_FALSE(isNewerSequence(3, 3));
+    EXPECT_FALSE(isNewerSequence(2, 3));
+    EXPECT_TRUE(isNewerSequence(2, UINT32_MAX - 1)); // 回绕
+}
+
+// 测试 2: 一帧一个数据报直接发出，不进入 KCP；接收方按帧解码
+TEST(UnreliableChannelTest, SendsOneDatagramOutsideKcp)
+{
+    Link link;
+    const auto payload = bytesOf("x=120,y=48");
+    ASSERT_TRUE(link.sender->sendUnreliable(CMD_CURSOR, payload).has_value());
+    EXPECT_FALSE(link.sender->hasPendingOutput());
+    EXPECT_EQ(link.sender->metrics().waitSend, 0U);
+
+    const auto datagrams = link.take();
+    ASSERT_EQ(datagrams.size(), 1U);
+    EXPECT_EQ(datagrams.front().size(), UNRELIABLE_HEADER_SIZE + FRAME_HEADER_SIZE + payload.size());
+    const auto header = parseUnreliableHeader(datagrams.front());
+    ASSERT_TRUE(header.has_value());
+    EXPECT_EQ(header->conv, 5U);
+    EXPECT_EQ(header->sequence, 1U);
+
+    link.receiver->input(datagrams.front());
+    EXPECT_FALSE(link.receiver->hasPendingOutput()); // 不需要回 ACK
+    const auto messages = link.received();
+    ASSERT_EQ(messages.size(), 1U);
+    auto frame = decodeFrame(messages.front());
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->cmd, CMD_CURSOR);
+    EXPECT_TRUE(std::ranges::equal(frame->payload, payload));
+
+    const auto metrics = link.receiver->metrics();
+    EXPECT_EQ(metrics.unreliableIn, 1U);
+    EXPECT_EQ(metrics.messagesIn, 0U);
+    EXPECT_EQ(link.sender->metrics().unreliableOut, 1U);
+}
+
+// 测试 3: 乱序与重复的旧数据报被丢弃，各通道独立编号
+TEST(UnreliableChannelTest, DropsStaleAndDuplicateDatagrams)
+{
+    Link link;
+    for (uint16_t i = 1; i <= 3; ++i)
+    {
+        ASSERT_TRUE(link.sender->sendUnreliable(CMD_CURSOR + i, bytesOf("pos")).has_value());
+    }
+    ASSERT_TRUE(link.sender->sendUnreliable(0x4000, bytesOf("choosing"), 1).has_value());
+    const auto datagrams = link.take();
+    ASSERT_EQ(datagrams.size(), 4U);
+
+    // 通道 0 的第 3 个先到，随后第 1、2 个和重复的第 3 个；通道 1 的第 1 个最后到
+    for (size_t index : {2, 0, 1, 2, 3})
+    {
+        link.receiver->input(datagrams[index]);
+    }
+    const auto messages = link.received();
+    ASSERT_EQ(messages.size(), 2U);
+    EXPECT_EQ(cmdOf(messages[0]), CMD_CURSOR + 3);
+    EXPECT_EQ(cmdOf(messages[1]), 0x4000);
+    EXPECT_EQ(link.receiver->metrics().unreliableStale, 3U);
+}
+
+// 测试 4: 可靠流丢包等待重传时，不可靠数据报照常立即交付
+TEST(UnreliableChannelTest, BypassesReliableHeadOfLineBlocking)
+{
+    Link link;
+    ASSERT_TRUE(link.sender->queueFrame(0x1001, bytesOf("play card")).has_value());
+    link.sender->update(1'000);
+    ASSERT_FALSE(link.take().empty()); // 可靠消息在链路上丢失
+    ASSERT_TRUE(link.sender->queueFrame(0x1002, bytesOf("end turn")).has_value());
+    link.sender->update(1'010);
+    for (const auto& datagram : link.take())
+    {
+        link.receiver->input(datagram); // 第二条可靠消息到达，但被第一条阻塞
+    }
+    ASSERT_TRUE(link.sender->sendUnreliable(CMD_CURSOR, bytesOf("hover")).has_value());
+    for (const auto& datagram : link.take())
+    {
+        link.receiver->input(datagram);
+    }
+
+    auto messages = link.received();
+    ASSERT_EQ(messages.size(), 1U);
+    EXPECT_EQ(cmdOf(messages.front()), CMD_CURSOR);
+
+    // 重传到达后可靠消息按顺序交付
+    for (uint32_t now = 1'020; now < 2'000 && messages.size() < 3; now += 10)
+    {
+        link.sender->update(now);
+        for (const auto& datagram : link.take())
+        {
+            link.receiver->input(datagram);
+        }
+        link.receiver->update(now);
+        link.receiverWire.clearPackets(); // 丢弃 ACK：发送方按超时重传
+        for (auto& message : link.received())
+        {
+            messages.push_back(std::move(message));
+        }
+    }
+    ASSERT_EQ(messages.size(), 3U);
+    EXPECT_EQ(cmdOf(messages[1]), 0x1001);
+    EXPECT_EQ(cmdOf(messages[2]), 0x1002);
+}
+
+// 测试 5: 通道越界、超过 MTU 的载荷、已关闭的会话、不属于本会话的数据报都被拒绝，且不消耗序号
+TEST(UnreliableChannelTest, RejectsInvalidInput)
+{
+    Link link;
+    EXPECT_EQ(link.sender->sendUnreliable(CMD_CURSOR, bytesOf("x"), UNRELIABLE_CHANNELS).error(),
+              CodecError::InvalidChannel);
+    const std::vector<uint8_t> large(link.sender->profile().mtu, 0x5A);
+    EXPECT_EQ(link.sender->sendUnreliable(CMD_CURSOR, large).error(), CodecError::PayloadTooLarge);
+    EXPECT_TRUE(link.take().empty());
+
+    ASSERT_TRUE(link.sender->sendUnreliable(CMD_CURSOR, bytesOf("x")).has_value());
+    auto datagrams = link.take();
+    ASSERT_EQ(datagrams.size(), 1U);
+    EXPECT_EQ(parseUnreliableHeader(datagrams.front())->sequence, 1U);
+
+    auto foreign = datagrams.front();
+    foreign[0] ^= 0xFF; // 其他 conv
+    link.receiver->input(foreign);
+    EXPECT_TRUE(link.received().empty());
+
+    link.sender->close();
+    EXPECT_EQ(link.sender->sendUnreliable(CMD_CURSOR, bytesOf("x")).error(), CodecError::SessionClosed);
+    EXPECT_TRUE(link.take().empty());
+}
@@ -0,0 +1,258 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_card_database.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 卡牌数据库单元测试（JSON 编译、加载与索引、各类损坏数据的拒绝、未对齐数据）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/server/data/CardDatabase.h"
+#include "src/server/data/CardDbCompiler.h"
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// 两种牌、五张：杀 ♠7 ♥A ♠7，火攻 ♦Q ♥3
+const nlohmann::json SMALL_DECK = nlohmann::json::parse(R"({ "cards": [
+    { "name": "杀", "type": "BASIC", "subtype": "STRIKE", "description": "造成一点伤害",
+      "target": { "need": true, "min": 1, "max": 1, "range": 1 }, "deck": ["♠7", "♥A", "♠7"] },
+    { "name": "火攻", "type": "STRATEGY", "subtype": "FIRE_ATTACK",
+      "target": { "need": true, "min": 1, "max": 1 }, "deck": ["♦Q", "♥3"] }
+] })");
+
+std::vector<char> compile(const nlohmann::json& document)
+{
+    carddb::Compiler compiler;
+    for (const auto& card : document.at("cards"))
+    {
+        compiler.addKind(card);
+    }
+    return compiler.build();
+}
+
+template <typename T>
+void patch(std::vector<char>& blob, size_t offset, T value)
+{
+    std::memcpy(blob.data() + offset, &value, sizeof(value));
+}
+
+carddb::Header headerOf(const std::vector<char>& blob)
+{
+    carddb::Header header{};
+    std::memcpy(&header, blob.data(), sizeof(header));
+    return header;
+}
+
+std::expected<CardDatabase, CardDatabaseError> load(const std::vector<char>& blob)
+{
+    return CardDatabase::load(blob);
+}
+} // namespace
+
+// 测试 1: JSON 编译后的数据可加载，种类、各张牌与字符串都与 JSON 一致
+TEST(CardDatabaseTest, LoadsCompiledBlob)
+{
+    const auto blob = compile(SMALL_DECK);
+    const auto database = load(blob);
+    ASSERT_TRUE(database.has_value());
+
+    ASSERT_EQ(database->kinds().size(), 2U);
+    ASSERT_EQ(database->deckSize(), 5U);
+
+    const auto& strike = database->kinds()[0];
+    EXPECT_EQ(database->text(strike.name), "杀");
+    EXPECT_EQ(database->text(strike.description), "造成一点伤害");
+    EXPECT_EQ(strike.type, static_cast<uint8_t>(carddb::Type::BASIC));
+    EXPECT_EQ(strike.subtype, static_cast<uint8_t>(carddb::BasicType::STRIKE));
+    EXPECT_EQ(strike.range, 1);
+
+    const auto& fireAttack = database->kinds()[1];
+    EXPECT_EQ(database->text(fireAttack.name), "火攻");
+    EXPECT_EQ(database->text(fireAttack.description), "");
+    EXPECT_EQ(fireAttack.type, static_cast<uint8_t>(carddb::Type::STRATEGY));
+    EXPECT_EQ(fireAttack.subtype, static_cast<uint8_t>(carddb::StrategyType::FIRE_ATTACK));
+    EXPECT_EQ(fireAttack.range, 0); // 省略 range 表示无距离限制
+
+    EXPECT_EQ(database->id(0), cards::STRIKE);
+    EXPECT_EQ(database->suit(1), carddb::Suit::HEART);
+    EXPECT_EQ(database->point(1), 1);
+    EXPECT_EQ(database->id(3), cards::FIRE_ATTACK);
+    EXPECT_EQ(database->suit(3), carddb::Suit::DIAMOND);
+    EXPECT_EQ(database->point(3), 12);
+    EXPECT_EQ(utils::text(database->id(4)), "火攻");
+}
+
+// 测试 2: 按牌与按 (牌, 花色, 点数) 的索引给出整副牌中的全部下标
+TEST(CardDatabaseTest, BuildsLookupIndex)
+{
+    const auto blob = compile(SMALL_DECK);
+    const auto database = load(blob);
+    ASSERT_TRUE(database.has_value());
+
+    const auto strikes = database->find(cards::STRIKE);
+    EXPECT_EQ(std::vector<uint16_t>(strikes.begin(), strikes.end()), (std::vector<uint16_t>{0, 1, 2}));
+    const auto spadeSevens = database->find(CardKey{.card = cards::STRIKE, .suit = carddb::Suit::SPADE, .rank = 7});
+    EXPECT_EQ(std::vector<uint16_t>(spadeSevens.begin(), spadeSevens.end()), (std::vector<uint16_t>{0, 2}));
+    const auto heartThree =
+        database->find(CardKey{.card = cards::FIRE_ATTACK, .suit = carddb::Suit::HEART, .rank = 3});
+    EXPECT_EQ(std::vector<uint16_t>(heartThree.begin(), heartThree.end()), (std::vector<uint16_t>{4}));
+
+    EXPECT_TRUE(database->find(cards::DUEL).empty());
+    EXPECT_TRUE(database->find(CardKey{.card = cards::STRIKE, .suit = carddb::Suit::CLUB, .rank = 7}).empty());
+}
+
+// 测试 3: 编译器拒绝未知的类型、子类型、花色、点数，重复的牌名，以及缺少字段的定义
+TEST(CardDatabaseTest, CompilerRejectsMalformedJson)
+{
+    const auto withCard = [](const char* key, nlohmann::json value)
+    {
+        auto document = SMALL_DECK;
+        document["cards"][0][key] = std::move(value);
+        return document;
+    };
+
+    EXPECT_THROW(compile(withCard("type", "SPELL")), std::runtime_error);
+    EXPECT_THROW(compile(withCard("subtype", "DUEL")), std::runtime_error);
+    EXPECT_THROW(compile(withCard("deck", {"☆7"})), std::runtime_error);
+    EXPECT_THROW(compile(withCard("deck", {"♠14"})), std::runtime_error);
+    EXPECT_THROW(compile(withCard("deck", {"♠"})), std::runtime_error);
+    EXPECT_THROW(compile(withCard("name", "火攻")), std::runtime_error);
+
+    auto missing = SMALL_DECK;
+    missing["cards"][1].erase("target");
+    EXPECT_THROW(compile(missing), nlohmann::json::exception);
+    EXPECT_THROW(compile(withCard("deck", {7})), nlohmann::json::exception);
+}
+
+// 测试 4: 头部损坏（过短、magic、版本）时拒绝加载
+TEST(CardDatabaseTest, RejectsCorruptHeader)
+{
+    const auto blob = compile(SMALL_DECK);
+
+    const std::vector<char> tooSmall(blob.begin(), blob.begin() + sizeof(carddb::Header) - 1);
+    EXPECT_EQ(load(tooSmall).error(), CardDatabaseError::TooSmall);
+
+    auto badMagic = blob;
+    badMagic[0] = 'X';
+    EXPECT_EQ(load(badMagic).error(), CardDatabaseError::BadMagic);
+
+    auto badVersion = blob;
+    patch(badVersion, offsetof(carddb::Header, version), static_cast<uint16_t>(carddb::VERSION + 1));
+    EXPECT_EQ(load(badVersion).error(), CardDatabaseError::UnsupportedVersion);
+}
+
+// 测试 5: 记录或字符串区超出数据长度时拒绝加载
+TEST(CardDatabaseTest, RejectsTruncatedBlob)
+{
+    const auto blob = compile(SMALL_DECK);
+    const auto header = headerOf(blob);
+
+    const std::vector<char> truncated(blob.begin(), blob.end() - 1);
+    EXPECT_EQ(load(truncated).error(), CardDatabaseError::Truncated);
+
+    const std::vector<char> headerOnly(blob.begin(), blob.begin() + sizeof(carddb::Header));
+    EXPECT_EQ(load(headerOnly).error(), CardDatabaseError::Truncated);
+
+    auto tooManyCards = blob;
+    patch(tooManyCards, offsetof(carddb::Header, cardCount), static_cast<uint16_t>(header.cardCount + 100));
+    EXPECT_EQ(load(tooManyCards).error(), CardDatabaseError::Truncated);
+
+    auto longStrings = blob;
+    patch(longStrings, offsetof(carddb::Header, stringBytes), header.stringBytes + 1);
+    EXPECT_EQ(load(longStrings).error(), CardDatabaseError::Truncated);
+}
+
+// 测试 6: 字符串引用越界、引用不存在的种类、枚举值越界、牌名与 id 不符或哈希冲突时拒绝加载
+TEST(CardDatabaseTest, RejectsBadReferences)
+{
+    const auto blob = compile(SMALL_DECK);
+    const auto header = headerOf(blob);
+    const size_t firstKind = carddb::kindsOffset();
+    const size_t nameRef = firstKind + offsetof(carddb::KindRecord, name);
+    const size_t descriptionRef = firstKind + offsetof(carddb::KindRecord, description);
+
+    auto nameOffset = blob;
+    patch(nameOffset, nameRef + offsetof(carddb::StringRef, offset), header.stringBytes);
+    EXPECT_EQ(load(nameOffset).error(), CardDatabaseError::BadReference);
+
+    auto nameSize = blob;
+    patch(nameSize, nameRef + offsetof(carddb::StringRef, size), header.stringBytes + 1);
+    EXPECT_EQ(load(nameSize).error(), CardDatabaseError::BadReference);
+
+    // offset + size 回绕时也不能越过检查
+    auto wrapped = blob;
+    patch(wrapped, descriptionRef + offsetof(carddb::StringRef, offset), UINT32_MAX);
+    patch(wrapped, descriptionRef + offsetof(carddb::StringRef, size), uint32_t{2});
+    EXPECT_EQ(load(wrapped).error(), CardDatabaseError::BadReference);
+
+    auto badKind = blob;
+    patch(badKind, carddb::cardsOffset(header) + offsetof(carddb::CardRecord, kind), header.kindCount);
+    EXPECT_EQ(load(badKind).error(), CardDatabaseError::BadReference);
+
+    auto badId = blob;
+    patch(badId, firstKind + offsetof(carddb::KindRecord, id), cards::DUEL.value);
+    EXPECT_EQ(load(badId).error(), CardDatabaseError::BadReference);
+
+    // 花色、类型、子类型超出枚举范围；JOKER 表示无花色，不会出现在牌表中
+    auto jokerSuit = blob;
+    patch(jokerSuit, carddb::cardsOffset(header) + offsetof(carddb::CardRecord, suit),
+          static_cast<uint8_t>(carddb::Suit::JOKER));
+    EXPECT_EQ(load(jokerSuit).error(), CardDatabaseError::BadReference);
+
+    auto badSuit = blob;
+    patch(badSuit, carddb::cardsOffset(header) + offsetof(carddb::CardRecord, suit),
+          static_cast<uint8_t>(static_cast<uint8_t>(carddb::Suit::JOKER) + 1));
+    EXPECT_EQ(load(badSuit).error(), CardDatabaseError::BadReference);
+
+    auto badType = blob;
+    patch(badType, firstKind + offsetof(carddb::KindRecord, type),
+          static_cast<uint8_t>(static_cast<uint8_t>(carddb::Type::STRATEGY) + 1));
+    EXPECT_EQ(load(badType).error(), CardDatabaseError::BadReference);
+
+    auto badSubtype = blob;
+    patch(badSubtype, firstKind + offsetof(carddb::KindRecord, subtype),
+          static_cast<uint8_t>(static_cast<uint8_t>(carddb::BasicType::ALCOHOL) + 1));
+    EXPECT_EQ(load(badSubtype).error(), CardDatabaseError::BadReference);
+
+    // 校验失败时不登记牌名
+    auto unknown = SMALL_DECK;
+    unknown["cards"][0]["name"] = "未登记的牌";
+    auto unknownBadSuit = compile(unknown);
+    patch(unknownBadSuit, carddb::cardsOffset(header) + offsetof(carddb::CardRecord, suit), uint8_t{0xFF});
+    EXPECT_EQ(load(unknownBadSuit).error(), CardDatabaseError::BadReference);
+    EXPECT_TRUE(utils::text(CardId{"未登记的牌"}).empty());
+
+    // 牌名与已登记的另一文本哈希冲突（FNV-1a 32 位：两者均为 0xd2c495d7），返回错误而不是抛出异常
+    utils::intern<CardId>("card_amoczw");
+    auto colliding = SMALL_DECK;
+    colliding["cards"][0]["name"] = "card_awfbpa";
+    EXPECT_EQ(load(compile(colliding)).error(), CardDatabaseError::BadReference);
+    EXPECT_EQ(utils::text(CardId{"card_awfbpa"}), "card_amoczw");
+}
+
+// 测试 7: 未按 4 字节对齐的数据复制到内部缓冲后加载，内容不变
+TEST(CardDatabaseTest, LoadsMisalignedBlob)
+{
+    const auto blob = compile(SMALL_DECK);
+    std::vector<char> buffer(blob.size() + 1);
+    std::memcpy(buffer.data() + 1, blob.data(), blob.size());
+    const std::span<const char> misaligned(buffer.data() + 1, blob.size());
+    ASSERT_NE(reinterpret_cast<uintptr_t>(misaligned.data()) % alignof(carddb::KindRecord), 0U);
+
+    const auto database = CardDatabase::load(misaligned);
+    ASSERT_TRUE(database.has_value());
+    EXPECT_EQ(database->deckSize(), 5U);
+    EXPECT_EQ(database->text(database->kinds()[1].name), "火攻");
+    EXPECT_EQ(database->find(cards::STRIKE).size(), 3U);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(database->kinds().data()) % alignof(carddb::KindRecord), 0U);
+}
@@ -0,0 +1,424 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_deck_system.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief DeckSystem 单元测试（摸牌、使用与弃置、洗牌与种子、检索，以及每种移牌之后 CardLocation、检索索引与各牌区一致）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/server/systems/DeckSystem.h"
+#include <asio/io_context.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+std::shared_ptr<spdlog::logger> nullLogger()
+{
+    return std::make_shared<spdlog::logger>("deck_test", std::make_shared<spdlog::sinks::null_sink_mt>());
+}
+
+// 记录 DeckSystem 派生的事件
+struct Recorder
+{
+    std::vector<entt::entity> drawn;
+    int gameEnds = 0;
+
+    void onCardDrawn(const events::CardDrawn& event) { drawn.assign(event.cards.begin(), event.cards.end()); }
+    void onGameEnd(const events::GameEnd&) { ++gameEnds; }
+};
+
+class DeckSystemTest : public testing::Test
+{
+protected:
+    static constexpr size_t PLAYERS = 3;
+
+    void SetUp() override
+    {
+        for (uint32_t i = 0; i < PLAYERS; ++i)
+        {
+            MetaPlayerInfo meta{.playerName = "p" + std::to_string(i), .playerID = i};
+            CharacterInfo character{};
+            HandCards hand{};
+            Equipments equipments{};
+            LiveStatus live{};
+            players.push_back(CreatePlayer(context.registry, meta, character, hand, equipments, live));
+        }
+        context.dispatcher.sink<events::CardDrawn>().connect<&Recorder::onCardDrawn>(recorder);
+        context.dispatcher.sink<events::GameEnd>().connect<&Recorder::onGameEnd>(recorder);
+        deck.registerEvents();
+    }
+
+    void TearDown() override { deck.unregisterEvents(); }
+
+    template <typename Event>
+    void trigger(Event&& event)
+    {
+        context.dispatcher.trigger(std::forward<Event>(event));
+    }
+
+    std::vector<entt::entity>& hand(size_t player) { return context.registry.get<HandCards>(players[player]).handCards; }
+
+    [[nodiscard]] const CardLocation& location(entt::entity card) const
+    {
+        return context.registry.get<CardLocation>(card);
+    }
+
+    [[nodiscard]] CardId idOf(entt::entity card) const
+    {
+        return deck.database().id(context.registry.get<CardEntry>(card).index);
+    }
+
+    void deal(size_t player, size_t count)
+    {
+        while (count > 0)
+        {
+            const auto batch = static_cast<uint8_t>(std::min<size_t>(count, UINT8_MAX));
+            trigger(events::DealCards{.player = players[player], .count = batch});
+            count -= batch;
+        }
+    }
+
+    // 弃置玩家的前 count 张手牌，并结束回合让它们进入弃牌堆
+    void discardAndEndTurn(size_t player, size_t count)
+    {
+        std::vector<entt::entity> cards(hand(player).begin(), hand(player).begin() + static_cast<std::ptrdiff_t>(count));
+        trigger(events::CardDiscarded{.player = players[player], .card = cards, .count = static_cast<uint8_t>(count)});
+        trigger(events::NextTurn{});
+    }
+
+    /**
+     * @brief 每个牌区第 i 张牌的 CardLocation 都指回该牌区的第 i 个位置，且所有牌恰好各在一处
+     */
+    testing::AssertionResult slotsMatchZones() const
+    {
+        size_t placed = 0;
+        auto checkZone = [&](const std::vector<entt::entity>& cards, CardZone zone, entt::entity owner)
+        {
+            for (uint32_t i = 0; i < cards.size(); ++i)
+            {
+                const auto& at = location(cards[i]);
+                if (at.zone != zone || at.owner != owner || at.slot != i)
+                {
+                    return testing::AssertionFailure()
+                           << "zone " << static_cast<int>(zone) << " position " << i << " is recorded as zone "
+                           << static_cast<int>(at.zone) << " slot " << at.slot;
+                }
+            }
+            placed += cards.size();
+            return testing::AssertionSuccess();
+        };
+
+        const auto& piles = deck.deck();
+        for (auto result : {checkZone(piles.drawPile, CardZone::DRAW_PILE, entt::null),
+                            checkZone(piles.discardPile, CardZone::DISCARD_PILE, entt::null),
+                            checkZone(piles.processingArea, CardZone::PROCESSING_AREA, entt::null)})
+        {
+            if (!result)
+            {
+                return result;
+            }
+        }
+        for (auto player : players)
+        {
+            if (auto result = checkZone(context.registry.get<HandCards>(player).handCards, CardZone::HAND, player);
+                !result)
+            {
+                return result;
+            }
+            const auto& equipments = context.registry.get<Equipments>(player);
+            const std::array slots = {
+                equipments.weapon, equipments.armor, equipments.attackhorse, equipments.defensehorse};
+            for (uint32_t slot = 0; slot < slots.size(); ++slot)
+            {
+                if (slots[slot] == entt::null)
+                {
+                    continue;
+                }
+                const auto& at = location(slots[slot]);
+                if (at.zone != CardZone::EQUIPMENT || at.owner != player || at.slot != slot)
+                {
+                    return testing::AssertionFailure() << "equipment slot " << slot << " is out of sync";
+                }
+                ++placed;
+            }
+        }
+
+        const size_t cards = context.registry.view<CardLocation>().size();
+        if (placed != cards)
+        {
+            return testing::AssertionFailure() << placed << " positions for " << cards << " cards";
+        }
+        return testing::AssertionSuccess();
+    }
+
+    asio::io_context ioc;
+    GameContext context{ioc.get_executor(), nullLogger()};
+    DeckSystem deck{context};
+    Recorder recorder;
+    std::vector<entt::entity> players;
+};
+} // namespace
+
+// 测试 1: 初始化后整副牌都在抽牌堆中
+TEST_F(DeckSystemTest, InitialDeckFillsDrawPile)
+{
+    EXPECT_EQ(deck.deck().drawPile.size(), deck.database().deckSize());
+    EXPECT_TRUE(deck.deck().discardPile.empty());
+    EXPECT_TRUE(deck.deck().processingArea.empty());
+    EXPECT_TRUE(slotsMatchZones());
+}
+
+// 测试 2: 摸牌从抽牌堆顶（尾部）依次取牌，CardDrawn 给出摸到的牌
+TEST_F(DeckSystemTest, DrawTakesCardsFromTopOfDrawPile)
+{
+    const auto& drawPile = deck.deck().drawPile;
+    const size_t before = drawPile.size();
+    const std::vector<entt::entity> top(drawPile.rbegin(), drawPile.rbegin() + 3);
+
+    deal(0, 3);
+    EXPECT_EQ(hand(0), top);
+    EXPECT_EQ(recorder.drawn, top);
+    EXPECT_EQ(drawPile.size(), before - 3);
+    EXPECT_TRUE(slotsMatchZones());
+}
+
+// 测试 3: 使用与弃置的牌进入处理区，结算完成或回合结束后进入弃牌堆
+TEST_F(DeckSystemTest, UsedAndDiscardedCardsReachDiscardPile)
+{
+    deal(0, 5);
+    const auto used = hand(0)[1];
+    entt::entity target = players[1];
+
+    // 只能使用自己的手牌
+    trigger(events::CardUsed{.user = players[1], .target = std::span(&target, 1), .card = used});
+    EXPECT_EQ(location(used).zone, CardZone::HAND);
+
+    trigger(events::CardUsed{.user = players[0], .target = std::span(&target, 1), .card = used});
+    EXPECT_EQ(location(used).zone, CardZone::PROCESSING_AREA);
+    EXPECT_EQ(hand(0).size(), 4U);
+    EXPECT_TRUE(slotsMatchZones());
+
+    const std::vector<entt::entity> discarded(hand(0).begin(), hand(0).begin() + 2);
+    trigger(events::CardDiscarded{.player = players[0], .card = discarded, .count = 2});
+    EXPECT_EQ(deck.deck().processingArea.size(), 3U);
+    EXPECT_TRUE(slotsMatchZones());
+
+    trigger(events::DetailFinish{.player = players[0], .cards = {used}});
+    EXPECT_EQ(location(used).zone, CardZone::DISCARD_PILE);
+    EXPECT_EQ(deck.deck().processingArea.size(), 2U);
+    EXPECT_TRUE(slotsMatchZones());
+
+    trigger(events::NextTurn{});
+    EXPECT_TRUE(deck.deck().processingArea.empty());
+    EXPECT_EQ(deck.deck().discardPile.size(), 3U);
+    for (auto card : discarded)
+    {
+        EXPECT_EQ(location(card).zone, CardZone::DISCARD_PILE);
+    }
+    EXPECT_TRUE(slotsMatchZones());
+}
+
+// 测试 4: 洗牌把打乱的弃牌堆垫到抽牌堆下面，抽牌堆原有的牌保持顺序留在顶部
+TEST_F(DeckSystemTest, ShuffleKeepsDrawPileOnTopOfDiscards)
+{
+    deal(0, 6);
+    discardAndEndTurn(0, 4);
+    auto discards = deck.deck().discardPile;
+    const auto draws = deck.deck().drawPile;
+    ASSERT_EQ(discards.size(), 4U);
+
+    trigger(events::ShuffleDeck{});
+    const auto& drawPile = deck.deck().drawPile;
+    ASSERT_EQ(drawPile.size(), draws.size() + discards.size());
+    EXPECT_TRUE(std::equal(draws.begin(), draws.end(), drawPile.begin() + static_cast<std::ptrdiff_t>(discards.size())));
+    std::vector<entt::entity> bottom(drawPile.begin(), drawPile.begin() + static_cast<std::ptrdiff_t>(discards.size()));
+    std::ranges::sort(bottom);
+    std::ranges::sort(discards);
+    EXPECT_EQ(bottom, discards);
+    EXPECT_TRUE(deck.deck().discardPile.empty());
+    EXPECT_TRUE(slotsMatchZones());
+}
+
+// 测试 5: 抽牌堆不足时先洗入弃牌堆；两者都空时宣告游戏结束
+TEST_F(DeckSystemTest, DealingPastDrawPileReshufflesThenEndsGame)
+{
+    deal(0, deck.deck().drawPile.size() - 2);
+    discardAndEndTurn(0, 5);
+    ASSERT_EQ(deck.deck().drawPile.size(), 2U);
+
+    deal(1, 4);
+    EXPECT_EQ(hand(1).size(), 4U);
+    EXPECT_EQ(deck.deck().drawPile.size(), 3U);
+    EXPECT_TRUE(deck.deck().discardPile.empty());
+    EXPECT_TRUE(slotsMatchZones());
+
+    // 洗牌后仍不足时能发几张发几张
+    deal(2, 5);
+    EXPECT_EQ(hand(2).size(), 3U);
+    EXPECT_EQ(recorder.gameEnds, 0);
+    EXPECT_TRUE(slotsMatchZones());
+
+    deal(2, 1);
+    EXPECT_EQ(recorder.gameEnds, 1);
+    EXPECT_TRUE(slotsMatchZones());
+}
+
+// 测试 6: 按牌或按牌 + 花色 + 点数检索，与逐张扫描牌区的结果一致
+TEST_F(DeckSystemTest, FindCardAgreesWithLinearScan)
+{
+    deal(0, 40);
+    const auto& database = deck.database();
+    using Zone = std::pair<CardZone, const std::vector<entt::entity>*>;
+    const std::array zones = {Zone{CardZone::DRAW_PILE, &deck.deck().drawPile}, Zone{CardZone::HAND, &hand(0)}};
+
+    for (const auto& kind : database.kinds())
+    {
+        const auto id = CardId::fromValue(kind.id);
+        for (const auto& [zone, cards] : zones)
+        {
+            const bool present = std::ranges::any_of(*cards, [&](auto card) { return idOf(card) == id; });
+            const auto found = deck.findCard(zone, id, SuitType::JOKER, 0);
+            EXPECT_EQ(found != entt::null, present);
+            if (found != entt::null)
+            {
+                EXPECT_EQ(location(found).zone, zone);
+                EXPECT_EQ(idOf(found), id);
+            }
+        }
+    }
+
+    for (auto card : hand(0))
+    {
+        const auto index = context.registry.get<CardEntry>(card).index;
+        const auto found =
+            deck.findCard(CardZone::HAND, database.id(index), toSuitType(database.suit(index)), database.point(index));
+        ASSERT_TRUE(found != entt::null);
+        const auto foundIndex = context.registry.get<CardEntry>(found).index;
+        EXPECT_EQ(location(found).zone, CardZone::HAND);
+        EXPECT_EQ(database.id(foundIndex), database.id(index));
+        EXPECT_EQ(database.suit(foundIndex), database.suit(index));
+        EXPECT_EQ(database.point(foundIndex), database.point(index));
+
+        trigger(events::FindCardInHandCardsArea{.card = database.id(index),
+                                                .suitType = toSuitType(database.suit(index)),
+                                                .rank = database.point(index)});
+        EXPECT_EQ(deck.foundCard(), found);
+    }
+}
+
+// 测试 7: 任意顺序的移牌（含装备替换）之后，每张牌的下标始终与所在牌区一致
+TEST_F(DeckSystemTest, RandomMovesKeepSlotsInSync)
+{
+    std::vector<entt::entity> cards;
+    for (auto card : context.registry.view<CardLocation>())
+    {
+        cards.push_back(card);
+    }
+    constexpr std::array zones = {
+        CardZone::DRAW_PILE, CardZone::DISCARD_PILE, CardZone::PROCESSING_AREA, CardZone::HAND, CardZone::EQUIPMENT};
+
+    std::mt19937 rng(7);
+    for (int step = 0; step < 2'000; ++step)
+    {
+        const auto card = cards[rng() % cards.size()];
+        const auto zone = zones[rng() % zones.size()];
+        const auto owner = players[rng() % players.size()];
+        const bool owned = zone == CardZone::HAND || zone == CardZone::EQUIPMENT;
+        deck.moveCard(card, zone, owned ? owner : entt::null, static_cast<uint32_t>(rng() % 4));
+        ASSERT_EQ(location(card).zone, zone) << "step " << step;
+        ASSERT_TRUE(slotsMatchZones()) << "step " << step;
+    }
+}
+
+// 测试 8: 给定种子时洗牌顺序可复现，不同种子给出不同顺序
+TEST(DeckSystemSeedTest, SeededShuffleIsReproducible)
+{
+    auto shuffledOrder = [](uint64_t seed)
+    {
+        asio::io_context ioc;
+        GameContext context{ioc.get_executor(), nullLogger()};
+        const auto& database = BuiltinCardDatabase();
+        DeckSystem deck(context, database, database.deckSize(), seed);
+        deck.registerEvents();
+        std::vector<uint16_t> order;
+        for (auto card : deck.deck().drawPile)
+        {
+            order.push_back(context.registry.get<CardEntry>(card).index);
+        }
+        deck.unregisterEvents();
+        return order;
+    };
+
+    EXPECT_EQ(shuffledOrder(42), shuffledOrder(42));
+    EXPECT_NE(shuffledOrder(42), shuffledOrder(43));
+}
+
+// 测试 9: 任意顺序的移牌、洗牌与回合结束之后，各牌区的检索结果与逐张扫描一致
+TEST_F(DeckSystemTest, FindCardTracksRandomMoves)
+{
+    const auto& database = deck.database();
+    std::vector<entt::entity> cards;
+    for (auto card : context.registry.view<CardLocation>())
+    {
+        cards.push_back(card);
+    }
+    constexpr std::array zones = {
+        CardZone::DRAW_PILE, CardZone::DISCARD_PILE, CardZone::PROCESSING_AREA, CardZone::HAND, CardZone::EQUIPMENT};
+
+    // 对照：逐张扫描该牌区中是否有同键（rank 为 0 时同种）的牌，并检查 findCard 的结果
+    auto agrees = [&](entt::entity probe, CardZone zone, bool byKey)
+    {
+        const auto probeIndex = context.registry.get<CardEntry>(probe).index;
+        auto matches = [&](entt::entity card)
+        {
+            const auto index = context.registry.get<CardEntry>(card).index;
+            return database.id(index) == database.id(probeIndex) &&
+                   (!byKey || (database.suit(index) == database.suit(probeIndex) &&
+                               database.point(index) == database.point(probeIndex)));
+        };
+        const bool present = std::ranges::any_of(cards, [&](auto card) { return location(card).zone == zone && matches(card); });
+        const auto found = deck.findCard(zone,
+                                         database.id(probeIndex),
+                                         toSuitType(database.suit(probeIndex)),
+                                         byKey ? database.point(probeIndex) : uint8_t{0});
+        return found == entt::null ? !present : location(found).zone == zone && matches(found);
+    };
+
+    std::mt19937 rng(11);
+    for (int step = 0; step < 2'000; ++step)
+    {
+        const auto card = cards[rng() % cards.size()];
+        const auto zone = zones[rng() % zones.size()];
+        const auto owner = players[rng() % players.size()];
+        const bool owned = zone == CardZone::HAND || zone == CardZone::EQUIPMENT;
+        switch (rng() % 8)
+        {
+        case 0:
+            trigger(events::ShuffleDeck{});
+            break;
+        case 1:
+            trigger(events::NextTurn{});
+            break;
+        default:
+            deck.moveCard(card, zone, owned ? owner : entt::null, static_cast<uint32_t>(rng() % 4));
+            break;
+        }
+
+        const auto probe = cards[rng() % cards.size()];
+        for (auto target : zones)
+        {
+            ASSERT_TRUE(agrees(card, target, true)) << "step " << step;
+            ASSERT_TRUE(agrees(probe, target, false)) << "step " << step;
+        }
+    }
+}
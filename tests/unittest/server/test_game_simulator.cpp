@@ -0,0 +1,82 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_game_simulator.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 对局模拟器冒烟测试：机器人对局全部在回合上限内结束，结束原因可解释，同一种子结果可复现
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/server/sim/GameSimulator.h"
+#include <asio/io_context.hpp>
+#include <spdlog/sinks/null_sink.h>
+
+namespace
+{
+constexpr uint32_t GAMES = 64;
+
+std::shared_ptr<spdlog::logger> nullLogger()
+{
+    return std::make_shared<spdlog::logger>("sim_test", std::make_shared<spdlog::sinks::null_sink_mt>());
+}
+} // namespace
+
+// 测试 1: 每一局单独运行都会结束：只剩一名存活玩家、牌堆耗尽或达到回合上限
+TEST(GameSimulatorTest, EveryBotGameTerminates)
+{
+    asio::io_context ioc;
+    for (auto policy : {sim::BotPolicy::Random, sim::BotPolicy::Aggressive})
+    {
+        const sim::SimConfig config{.players = 5, .maxTurns = 150, .policy = policy};
+        for (uint64_t seed = 0; seed < GAMES; ++seed)
+        {
+            GameContext context(ioc.get_executor(), nullLogger());
+            sim::SimulatedGame game(context, config, seed);
+            const auto stats = game.play();
+
+            SCOPED_TRACE(testing::Message() << sim::toString(policy) << " seed " << seed);
+            EXPECT_EQ(stats.games, 1U);
+            EXPECT_EQ(stats.failed, 0U);
+            EXPECT_LE(stats.turns, config.maxTurns);
+            EXPECT_GT(stats.events, 0U);
+            const bool lastStanding = stats.kills + 1 >= config.players;
+            EXPECT_TRUE(lastStanding || stats.deckOuts == 1 || stats.turns == config.maxTurns);
+        }
+    }
+}
+
+// 测试 2: 在 RoomHost 上并行打多局，全部返回且没有失败的对局，房间随对局结束关闭
+TEST(GameSimulatorTest, ParallelGamesAllFinish)
+{
+    RoomHost host(4, nullLogger());
+    const sim::SimConfig config{.games = GAMES, .players = 4, .maxTurns = 150};
+    const auto stats = sim::runGames(host, config);
+
+    EXPECT_EQ(stats.games, GAMES);
+    EXPECT_EQ(stats.failed, 0U);
+    EXPECT_LE(stats.turns, uint64_t{GAMES} * config.maxTurns);
+    EXPECT_EQ(host.roomCount(), 0U);
+}
+
+// 测试 3: 同一种子重复运行（线程数不同）得到完全相同的汇总，洗牌不引入系统随机源
+TEST(GameSimulatorTest, SameSeedGivesIdenticalTotals)
+{
+    const sim::SimConfig config{.games = GAMES, .players = 4, .maxTurns = 150, .seed = 7};
+    RoomHost first(4, nullLogger());
+    RoomHost second(2, nullLogger());
+    const auto a = sim::runGames(first, config);
+    const auto b = sim::runGames(second, config);
+
+    EXPECT_EQ(a.games, b.games);
+    EXPECT_EQ(a.turns, b.turns);
+    EXPECT_EQ(a.events, b.events);
+    EXPECT_EQ(a.kills, b.kills);
+    EXPECT_EQ(a.deckOuts, b.deckOuts);
+    EXPECT_EQ(a.failed, 0U);
+}
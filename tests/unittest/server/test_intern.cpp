@@ -0,0 +1,107 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_intern.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 字符串驻留单元测试（标识与文本往返、相同文本相同标识、哈希冲突时登记失败）
+ *
+ * InternTable 是进程级单例，各测试使用互不相同的文本，避免与其他测试登记的卡牌、技能名互相影响。
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/utils/Intern.h"
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using TestId = utils::Interned<struct InternTestTag>;
+
+// 两段 FNV-1a 32 位哈希相同的文本，用于构造冲突
+constexpr std::string_view COLLIDING_A = "n2nq1s";
+constexpr std::string_view COLLIDING_B = "0pd3ce";
+static_assert(TestId{COLLIDING_A} == TestId{COLLIDING_B});
+} // namespace
+
+// 测试 1: 登记后可由标识取回文本，未登记的标识取回空串
+TEST(InternTest, TextRoundTripsThroughId)
+{
+    auto& table = utils::InternTable::getInstance();
+    const auto id = utils::intern<TestId>("驻留测试·往返");
+
+    EXPECT_EQ(utils::text(id), "驻留测试·往返");
+    EXPECT_EQ(table.text(id.value), "驻留测试·往返");
+    EXPECT_EQ(TestId::fromValue(id.value), id);
+    EXPECT_EQ(utils::text(TestId{"驻留测试·未登记"}), "");
+}
+
+// 测试 2: 相同文本无论来源都得到相同标识，重复登记不增加表项；不同文本得到不同标识
+TEST(InternTest, EqualTextsGiveEqualIds)
+{
+    auto& table = utils::InternTable::getInstance();
+    const std::string owned = std::string("驻留测试") + "·相同";
+    const auto first = table.intern("驻留测试·相同");
+    const size_t size = table.size();
+
+    EXPECT_EQ(table.intern(owned), first);
+    EXPECT_EQ(table.size(), size);
+    EXPECT_EQ(utils::intern<TestId>(owned).value, first);
+    EXPECT_EQ(TestId{owned}, TestId{"驻留测试·相同"});
+    EXPECT_NE(utils::intern<TestId>("驻留测试·不同"), TestId{owned});
+}
+
+// 测试 3: 与已登记文本哈希冲突的另一文本登记失败，已登记的文本不受影响
+TEST(InternTest, CollidingTextThrowsLogicError)
+{
+    auto& table = utils::InternTable::getInstance();
+    const auto id = table.intern(COLLIDING_A);
+    const size_t size = table.size();
+
+    EXPECT_THROW(table.intern(COLLIDING_B), std::logic_error);
+    EXPECT_THROW(utils::intern<TestId>(COLLIDING_B), std::logic_error);
+    EXPECT_EQ(table.size(), size);
+    EXPECT_EQ(table.text(id), COLLIDING_A);
+    EXPECT_EQ(table.intern(COLLIDING_A), id);
+}
+
+// 测试 4: 多线程同时登记同一批文本，所有线程得到的标识一致且每段文本只登记一次
+TEST(InternTest, ConcurrentInterningAgrees)
+{
+    constexpr int THREADS = 8;
+    constexpr int TEXTS = 500;
+    auto& table = utils::InternTable::getInstance();
+    const size_t before = table.size();
+
+    std::vector<std::vector<utils::InternId>> ids(THREADS);
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(
+            [&ids, &table, t]
+            {
+                for (int i = 0; i < TEXTS; ++i)
+                {
+                    ids[t].push_back(table.intern("驻留测试·并发·" + std::to_string(i)));
+                }
+            });
+    }
+    threads.clear();
+
+    EXPECT_EQ(table.size(), before + TEXTS);
+    for (int t = 1; t < THREADS; ++t)
+    {
+        EXPECT_EQ(ids[t], ids[0]);
+    }
+    for (int i = 0; i < TEXTS; ++i)
+    {
+        EXPECT_EQ(table.text(ids[0][i]), "驻留测试·并发·" + std::to_string(i));
+    }
+}
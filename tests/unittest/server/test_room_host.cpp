@@ -0,0 +1,162 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_room_host.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief RoomHost 单元测试（房间内串行有序、房间间并行、任务异常隔离、关闭与析构时排空任务）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include "src/server/context/RoomHost.h"
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+std::shared_ptr<spdlog::logger> nullLogger()
+{
+    return std::make_shared<spdlog::logger>("room_host_test", std::make_shared<spdlog::sinks::null_sink_mt>());
+}
+} // namespace
+
+// 测试 1: 同一房间的任务（含初始化）串行且按投递顺序执行，即使宿主有多个工作线程
+TEST(RoomHostTest, TasksInOneRoomRunSeriallyInOrder)
+{
+    constexpr int TASKS = 2'000;
+    std::vector<int> order;
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+    {
+        RoomHost host(4, nullLogger());
+        const auto room = host.createRoom([&order](GameContext&) { order.push_back(-1); });
+        for (int i = 0; i < TASKS; ++i)
+        {
+            ASSERT_TRUE(host.post(room,
+                                  [&, i](GameContext&)
+                                  {
+                                      if (running.fetch_add(1) != 0)
+                                      {
+                                          overlapped = true;
+                                      }
+                                      order.push_back(i);
+                                      running.fetch_sub(1);
+                                  }));
+        }
+        host.join();
+    }
+
+    EXPECT_FALSE(overlapped);
+    ASSERT_EQ(order.size(), static_cast<size_t>(TASKS) + 1);
+    for (int i = -1; i < TASKS; ++i)
+    {
+        ASSERT_EQ(order[static_cast<size_t>(i + 1)], i);
+    }
+}
+
+// 测试 2: 不同房间并行推进：房间 A 的任务等待房间 B 的任务完成，房间之间若被串行化会超时
+TEST(RoomHostTest, RoomsMakeProgressConcurrently)
+{
+    RoomHost host(2, nullLogger());
+    const auto roomA = host.createRoom();
+    const auto roomB = host.createRoom();
+
+    std::promise<void> bDone;
+    auto bFinished = bDone.get_future();
+    std::promise<bool> aSawB;
+    auto result = aSawB.get_future();
+
+    host.post(roomA,
+              [&](GameContext&)
+              { aSawB.set_value(bFinished.wait_for(std::chrono::seconds(5)) == std::future_status::ready); });
+    host.post(roomB, [&](GameContext&) { bDone.set_value(); });
+
+    EXPECT_TRUE(result.get());
+    host.join();
+}
+
+// 测试 3: 任务抛出的异常被记录并丢弃，工作线程与房间继续处理后续任务
+TEST(RoomHostTest, ThrowingTaskKeepsWorkerAndRoomAlive)
+{
+    std::ostringstream log;
+    auto logger =
+        std::make_shared<spdlog::logger>("room_host_test", std::make_shared<spdlog::sinks::ostream_sink_mt>(log));
+    RoomHost host(1, logger);
+    const auto room = host.createRoom();
+    const auto other = host.createRoom();
+
+    int afterThrow = 0;
+    int otherRan = 0;
+    host.post(room, [](GameContext&) { throw std::runtime_error("boom"); });
+    host.post(room, [](GameContext&) { throw 42; });
+    host.post(room, [&afterThrow](GameContext&) { ++afterThrow; });
+    host.post(other, [&otherRan](GameContext&) { ++otherRan; });
+    host.join();
+
+    EXPECT_EQ(afterThrow, 1);
+    EXPECT_EQ(otherRan, 1);
+    EXPECT_NE(host.find(room), nullptr);
+    EXPECT_NE(log.str().find("boom"), std::string::npos);
+    EXPECT_NE(log.str().find("未知异常"), std::string::npos);
+}
+
+// 测试 4: 关闭房间后不再接受新任务，已投递的任务全部执行完，房间随最后一个任务销毁
+TEST(RoomHostTest, ClosingRoomDrainsPendingWork)
+{
+    constexpr int TASKS = 100;
+    RoomHost host(1, nullLogger());
+    const auto room = host.createRoom();
+    std::weak_ptr<GameContext> context = host.find(room);
+
+    // 先用一个阻塞的任务占住工作线程，保证后续任务在关闭时仍在排队
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    int executed = 0;
+    host.post(room, [opened](GameContext&) { opened.wait(); });
+    for (int i = 0; i < TASKS; ++i)
+    {
+        host.post(room, [&executed](GameContext&) { ++executed; });
+    }
+
+    EXPECT_TRUE(host.closeRoom(room));
+    EXPECT_FALSE(host.closeRoom(room));
+    EXPECT_FALSE(host.post(room, [&executed](GameContext&) { executed += 1'000; }));
+    EXPECT_EQ(host.roomCount(), 0U);
+    EXPECT_FALSE(context.expired()); // 排队的任务仍持有房间
+
+    gate.set_value();
+    host.join();
+    EXPECT_EQ(executed, TASKS);
+    EXPECT_TRUE(context.expired());
+}
+
+// 测试 5: 销毁宿主时等待所有房间已投递的任务执行完
+TEST(RoomHostTest, DestroyingHostDrainsPendingWork)
+{
+    constexpr int ROOMS = 8;
+    constexpr int TASKS = 200;
+    std::atomic<int> executed{0};
+    {
+        RoomHost host(2, nullLogger());
+        for (int r = 0; r < ROOMS; ++r)
+        {
+            const auto room = host.createRoom();
+            for (int i = 0; i < TASKS; ++i)
+            {
+                host.post(room, [&executed](GameContext&) { executed.fetch_add(1, std::memory_order_relaxed); });
+            }
+        }
+    }
+    EXPECT_EQ(executed.load(), ROOMS * TASKS);
+}